@@ -0,0 +1,104 @@
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../include/common/BitwiseOperations.h"
+
+namespace {
+    constexpr int OPERAND_COUNT = 1 << 16;
+    constexpr int ROUND_COUNT = 64;
+
+    // Bit serial ripple carry adder the datapath used before BitwiseOperations switched to native words
+    std::bitset<WORD_BIT_COUNT> rippleCarryAddInputs(std::bitset<WORD_BIT_COUNT> value1,
+                                                     std::bitset<WORD_BIT_COUNT> value2) {
+        bool carry = false;
+        std::bitset<WORD_BIT_COUNT> result;
+
+        for (int i = 0; i < WORD_BIT_COUNT; ++i) {
+            bool input_1_bit = value1.test(i);
+            bool input_2_bit = value2.test(i);
+
+            result[i] = input_1_bit ^ input_2_bit ^ carry;
+            carry = (input_1_bit && input_2_bit) || (carry && (input_1_bit ^ input_2_bit));
+        }
+
+        return result;
+    }
+
+    std::bitset<WORD_BIT_COUNT> rippleCarrySubtractInputs(std::bitset<WORD_BIT_COUNT> value1,
+                                                          std::bitset<WORD_BIT_COUNT> value2) {
+        std::bitset<WORD_BIT_COUNT> one;
+        one.set(0);
+
+        return rippleCarryAddInputs(value1, rippleCarryAddInputs(~value2, one));
+    }
+
+    template<typename Operand, typename Operation>
+    void benchmark(const std::string &name, const std::vector<Operand> &operands_1,
+                   const std::vector<Operand> &operands_2, Operation operation) {
+        unsigned long checksum = 0;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (int round = 0; round < ROUND_COUNT; ++round) {
+            for (int i = 0; i < OPERAND_COUNT; ++i) {
+                checksum += static_cast<unsigned long>(operation(operands_1[i], operands_2[i]));
+            }
+        }
+
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        double nanoseconds_per_operation = std::chrono::duration<double, std::nano>(elapsed).count() /
+                (static_cast<double>(OPERAND_COUNT) * ROUND_COUNT);
+
+        std::cout << name << ": " << nanoseconds_per_operation << " ns/op (checksum " << checksum << ")" << std::endl;
+    }
+}
+
+int main() {
+    std::mt19937 generator (42);
+    std::vector<uint32_t> words_1 (OPERAND_COUNT);
+    std::vector<uint32_t> words_2 (OPERAND_COUNT);
+    std::vector<std::bitset<WORD_BIT_COUNT>> bitsets_1 (OPERAND_COUNT);
+    std::vector<std::bitset<WORD_BIT_COUNT>> bitsets_2 (OPERAND_COUNT);
+
+    for (int i = 0; i < OPERAND_COUNT; ++i) {
+        words_1[i] = generator();
+        words_2[i] = generator();
+        bitsets_1[i] = words_1[i];
+        bitsets_2[i] = words_2[i];
+
+        if (rippleCarryAddInputs(bitsets_1[i], bitsets_2[i]) != BitwiseOperations::addInputs(bitsets_1[i], bitsets_2[i]) ||
+                rippleCarrySubtractInputs(bitsets_1[i], bitsets_2[i]) != BitwiseOperations::subtractInputs(bitsets_1[i], bitsets_2[i])) {
+            std::cerr << "Mismatch for operands " << words_1[i] << " and " << words_2[i] << std::endl;
+            return 1;
+        }
+    }
+
+    auto to_word = [](std::bitset<WORD_BIT_COUNT> value) { return value.to_ulong(); };
+
+    benchmark("add, ripple carry bitset", bitsets_1, bitsets_2, [&](auto a, auto b) {
+        return to_word(rippleCarryAddInputs(a, b));
+    });
+    benchmark("add, bitset adapter", bitsets_1, bitsets_2, [&](auto a, auto b) {
+        return to_word(BitwiseOperations::addInputs(a, b));
+    });
+    benchmark("add, native word", words_1, words_2, [](uint32_t a, uint32_t b) {
+        return BitwiseOperations::addWords(a, b);
+    });
+
+    benchmark("subtract, ripple carry bitset", bitsets_1, bitsets_2, [&](auto a, auto b) {
+        return to_word(rippleCarrySubtractInputs(a, b));
+    });
+    benchmark("subtract, bitset adapter", bitsets_1, bitsets_2, [&](auto a, auto b) {
+        return to_word(BitwiseOperations::subtractInputs(a, b));
+    });
+    benchmark("subtract, native word", words_1, words_2, [](uint32_t a, uint32_t b) {
+        return BitwiseOperations::subtractWords(a, b);
+    });
+
+    return 0;
+}
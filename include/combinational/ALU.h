@@ -2,8 +2,11 @@
 #define RISC_V_SIMULATOR_ALU_H
 
 #include <bitset>
+#include <cstdint>
+#include <stdexcept>
 
 #include "../common/Module.h"
+#include "../common/Signal.h"
 #include "../common/BitwiseOperations.h"
 #include "../common/StageSynchronizer.h"
 #include "../common/Control.h"
@@ -18,31 +21,25 @@ public:
     static constexpr int ALU_OP_BIT_COUNT = 4;
 
 private:
-    std::bitset<WORD_BIT_COUNT> input1;
-    std::bitset<WORD_BIT_COUNT> input2;
-    std::bitset<WORD_BIT_COUNT> result;
+    Signal<uint32_t> input1;
+    Signal<uint32_t> input2;
+    Signal<std::bitset<ALU_OP_BIT_COUNT>> alu_op;
 
+    uint32_t result;
     bool is_result_zero;
-    bool is_input1_set;
-    bool is_input2_set;
-    bool is_alu_op_set;
 
-    bool is_reset_flag_set;
+    static constexpr uint32_t INPUT1_SET = 1U << 0;
+    static constexpr uint32_t INPUT2_SET = 1U << 1;
+    static constexpr uint32_t ALU_OP_SET = 1U << 2;
+    static constexpr uint32_t RESET_FLAG_SET = 1U << 3;
 
-    std::bitset<ALU_OP_BIT_COUNT> alu_op;
-
-    static ALU *current_instance;
-    static std::mutex initialization_mutex;
+    static constexpr uint32_t INPUT_BITS = INPUT1_SET | INPUT2_SET | ALU_OP_SET;
 
     EXMEMStageRegisters *ex_mem_stage_registers;
     StageSynchronizer *stage_synchronizer;
 
 public:
-    ALU();
-
-    static ALU *init();
-
-    void run() override;
+    explicit ALU(SimulationContext *context);
 
     void reset();
 
@@ -51,11 +48,22 @@ public:
 
     void setALUOp(std::bitset<ALU_OP_BIT_COUNT> value);
 
+    static uint32_t evaluate(std::bitset<ALU_OP_BIT_COUNT> alu_op, uint32_t value1, uint32_t value2);
+    static std::bitset<WORD_BIT_COUNT> evaluate(std::bitset<ALU_OP_BIT_COUNT> alu_op,
+                                                std::bitset<WORD_BIT_COUNT> value1,
+                                                std::bitset<WORD_BIT_COUNT> value2);
+
 private:
     void computeResult();
     void passZeroFlagToEXMEMStageRegisters(bool is_flag_asserted);
     void passResultToEXMEMStageRegisters(std::bitset<WORD_BIT_COUNT> data);
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
+
+    bool isEvaluationSkippable() override;
+    void markInputsEvaluated() override;
+    void holdInput(SignalBase &input) override;
 
     void resetState();
 
@@ -2,13 +2,16 @@
 #define RISC_V_SIMULATOR_FORWARDINGUNIT_H
 
 #include "../common/Module.h"
+#include "../common/Signal.h"
 #include "../common/Config.h"
 #include "../common/Logger.h"
 #include "../combinational/mux/forwarding/ALUInput1ForwardingMux.h"
 #include "../combinational/mux/forwarding/ALUInput2ForwardingMux.h"
 #include "../common/StageSynchronizer.h"
 
+#include <cstdint>
 #include <iostream>
+#include <optional>
 
 class ALUInput1ForwardingMux;
 class ALUInput2ForwardingMux;
@@ -16,26 +19,25 @@ class Logger;
 class StageSynchronizer;
 
 class ForwardingUnit: public Module {
-    unsigned long register_source1;
-    unsigned long register_source2;
-    unsigned long ex_mem_stage_register_destination;
-    unsigned long mem_wb_stage_register_destination;
-
-    bool is_single_register_source_set;
-    bool is_double_register_source_set;
-    bool is_ex_mem_stage_register_destination_set;
-    bool is_mem_wb_stage_register_destination_set;
-
-    bool is_ex_mem_reg_write_asserted;
-    bool is_mem_wb_reg_write_asserted;
-
-    bool is_ex_mem_reg_write_set;
-    bool is_mem_wb_reg_write_set;
-
-    bool is_reset_flag_set;
-
-    static ForwardingUnit *current_instance;
-    static std::mutex initialization_mutex;
+    Signal<unsigned long> register_source1;
+    Signal<std::optional<unsigned long>> register_source2;  // Empty for instructions reading a single register
+    Signal<unsigned long> ex_mem_stage_register_destination;
+    Signal<unsigned long> mem_wb_stage_register_destination;
+
+    Signal<bool> ex_mem_reg_write;
+    Signal<bool> mem_wb_reg_write;
+
+    // Bits of the readiness mask, both register sources are set by one setter
+    static constexpr uint32_t REGISTER_SOURCE_SET = 1U << 0;
+    static constexpr uint32_t EX_MEM_REGISTER_DESTINATION_SET = 1U << 1;
+    static constexpr uint32_t MEM_WB_REGISTER_DESTINATION_SET = 1U << 2;
+    static constexpr uint32_t EX_MEM_REG_WRITE_SET = 1U << 3;
+    static constexpr uint32_t MEM_WB_REG_WRITE_SET = 1U << 4;
+    static constexpr uint32_t RESET_FLAG_SET = 1U << 5;
+
+    static constexpr uint32_t INPUT_BITS = REGISTER_SOURCE_SET | EX_MEM_REGISTER_DESTINATION_SET |
+                                           MEM_WB_REGISTER_DESTINATION_SET | EX_MEM_REG_WRITE_SET |
+                                           MEM_WB_REG_WRITE_SET;
 
     ALUInput1ForwardingMux *alu_input_1_mux;
     ALUInput2ForwardingMux *alu_input_2_mux;
@@ -46,11 +48,7 @@ class ForwardingUnit: public Module {
     ALUInputMuxControlSignals alu_input_2_mux_control_signal;
 
 public:
-    ForwardingUnit();
-
-    static ForwardingUnit *init();
-
-    void run() override;
+    explicit ForwardingUnit(SimulationContext *context);
 
     void setSingleRegisterSource(unsigned long rs1);
     void setDoubleRegisterSource(unsigned long rs1, unsigned long rs2);
@@ -59,6 +57,7 @@ public:
     void setEXMEMStageRegisterRegWrite(bool is_asserted);
     void setMEMWBStageRegisterRegWrite(bool is_asserted);
 
+    void setPipelineType(PipelineType current_type) override;
     void reset();
 
 private:
@@ -68,7 +67,14 @@ private:
     void resetState();
     void computeControlSignals();
 
+    static uint32_t getRequiredBits(PipelineType current_type);
+
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
+
+    bool isEvaluationSkippable() override;
+    void markInputsEvaluated() override;
 
     std::string getModuleTag() override;
     Stage getModuleStage() override;
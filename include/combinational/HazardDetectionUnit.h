@@ -1,7 +1,10 @@
 #ifndef RISC_V_SIMULATOR_HAZARDDETECTIONUNIT_H
 #define RISC_V_SIMULATOR_HAZARDDETECTIONUNIT_H
 
+#include <cstdint>
+
 #include "../common/Module.h"
+#include "../common/Signal.h"
 #include "../common/Logger.h"
 #include "../state/Driver.h"
 #include "../state/stage-registers/IFIDStageRegisters.h"
@@ -15,20 +18,18 @@ class IDEXStageRegisters;
 class StageSynchronizer;
 
 class HazardDetectionUnit: public Module {
-    unsigned long id_ex_register_destination;
-    Instruction *instruction;
-    bool is_id_ex_mem_read_asserted;
+    Signal<unsigned long> id_ex_register_destination;
+    Signal<const Instruction *> instruction;
+    Signal<bool> id_ex_mem_read_signal;
     bool is_hazard_detected_flag_asserted;
 
-    bool is_id_ex_register_destination_set;
-    bool is_id_ex_mem_read_set;
-    bool is_instruction_set;
-
-    bool is_reset_flag_set;
-    bool is_pause_flag_set;
+    static constexpr uint32_t ID_EX_REGISTER_DESTINATION_SET = 1U << 0;
+    static constexpr uint32_t INSTRUCTION_SET = 1U << 1;
+    static constexpr uint32_t ID_EX_MEM_READ_SET = 1U << 2;
+    static constexpr uint32_t PAUSE_FLAG_SET = 1U << 3;
+    static constexpr uint32_t RESET_FLAG_SET = 1U << 4;
 
-    static HazardDetectionUnit *current_instance;
-    static std::mutex initialization_mutex;
+    static constexpr uint32_t INPUT_BITS = ID_EX_REGISTER_DESTINATION_SET | INSTRUCTION_SET | ID_EX_MEM_READ_SET;
 
     Driver *driver;
     IFIDStageRegisters *if_id_stage_registers;
@@ -36,21 +37,20 @@ class HazardDetectionUnit: public Module {
     StageSynchronizer *stage_synchronizer;
 
 public:
-    HazardDetectionUnit();
-
-    static HazardDetectionUnit *init();
+    explicit HazardDetectionUnit(SimulationContext *context);
 
-    void run() override;
     void reset();
     void pause();
     void resume();
 
     void setIDEXRegisterDestination(unsigned  long rd);
-    void setInstruction(Instruction *new_instruction);
+    void setInstruction(const Instruction *new_instruction);
     void setIDEXMemRead(bool is_asserted);
 
 private:
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
 
     void passHazardDetectedFlagToDriver();
     void passHazardDetectedFlagToIFIDStageRegisters();
@@ -1,7 +1,10 @@
 #ifndef RISC_V_SIMULATOR_IMMEDIATEGENERATOR_H
 #define RISC_V_SIMULATOR_IMMEDIATEGENERATOR_H
 
+#include <cstdint>
+
 #include "../common/Module.h"
+#include "../common/Signal.h"
 #include "../common/Instruction.h"
 #include "../common/Config.h"
 #include "../common/Logger.h"
@@ -14,27 +17,28 @@ class Logger;
 class ImmediateGenerator: public Module {
     static constexpr int WORD_BIT_COUNT = 32;
 
-    static ImmediateGenerator *current_instance;
-    static std::mutex initialization_mutex;
-
     const Instruction *instruction;
+    Signal<uint32_t> instruction_bits;  // The immediate only depends on the encoding
 
-    IDEXStageRegisters *id_ex_stage_registers;
-
-    bool is_instruction_set;
+    std::bitset<WORD_BIT_COUNT> immediate;
 
-public:
-    ImmediateGenerator();
+    static constexpr uint32_t INSTRUCTION_SET = 1U << 0;
 
-    static ImmediateGenerator *init();
+    IDEXStageRegisters *id_ex_stage_registers;
 
-    void run() override;
+public:
+    explicit ImmediateGenerator(SimulationContext *context);
 
     void setInstruction(const Instruction *current_instruction);
 
 private:
-    void loadImmediateToIDEXStageRegisters();
+    void loadImmediateToIDEXStageRegisters(std::bitset<WORD_BIT_COUNT> current_immediate);
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
+
+    bool isEvaluationSkippable() override;
+    void markInputsEvaluated() override;
 
     std::string getModuleTag() override;
     Stage getModuleStage() override;
@@ -2,13 +2,14 @@
 #define RISC_V_SIMULATOR_ADDERBASE_H
 
 #include "../../common/Config.h"
-#include "../../common/Module.h"
+#include "../../common/PortedModule.h"
 
 #include <stdexcept>
 
-class AdderBase: public Module {
+template<typename Derived>
+class AdderBase: public PortedModule<Derived> {
 public:
-    virtual void setInput(const AdderInputType &type, const AdderInputDataType &value) = 0;
+    using PortedModule<Derived>::PortedModule;
 };
 
 
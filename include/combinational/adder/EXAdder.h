@@ -2,6 +2,7 @@
 #define RISC_V_SIMULATOR_EXADDER_H
 
 #include <bitset>
+#include <cstdint>
 #include <iostream>
 
 #include "AdderBase.h"
@@ -11,35 +12,32 @@
 
 class EXMEMStageRegisters;
 
-class EXAdder: public AdderBase {
-    static constexpr int WORD_BIT_COUNT = 32;
-
-    unsigned long program_counter;
-    std::bitset<WORD_BIT_COUNT> immediate;
+class EXAdder: public AdderBase<EXAdder> {
+    InputPort<EXAdderInputType::PCValue, unsigned long> program_counter;
+    InputPort<EXAdderInputType::ImmediateValue, std::bitset<WORD_BIT_COUNT>> immediate;
     unsigned long result;
 
-    bool is_program_counter_set;
-    bool is_immediate_set;
-
     EXMEMStageRegisters *ex_mem_stage_registers;
 
-    static EXAdder *current_instance;
-    static std::mutex initialization_mutex;
-
 public:
-    EXAdder();
-    static EXAdder* init();
-
-    void run() override;
-    void setInput(const AdderInputType &type, const AdderInputDataType &value) override;
+    explicit EXAdder(SimulationContext *context);
 
 private:
+    auto getInputPorts() { return std::tie(this->program_counter, this->immediate); }
+
     void computeResult();
     void passBranchAddressToEXMEMStageRegisters();
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
+
+    bool isEvaluationSkippable() override;
+    void markInputsEvaluated() override;
 
     std::string getModuleTag() override;
     Stage getModuleStage() override;
+
+    friend PortedModule;
 };
 
 #endif //RISC_V_SIMULATOR_EXADDER_H
@@ -5,32 +5,34 @@
 #include "../../common/Config.h"
 #include "../mux/IFMux.h"
 #include "../../common/Logger.h"
+#include "../../common/BitwiseOperations.h"
 
 class IFMux;
 class Logger;
 
-class IFAdder: public AdderBase {
-    unsigned long program_counter;
-    bool is_program_counter_set;
-
-    static IFAdder *current_instance;
-    static std::mutex initialization_mutex;
+class IFAdder: public AdderBase<IFAdder> {
+    InputPort<IFAdderInputType::PCValue, unsigned long> program_counter;
 
     IFMux *if_mux;
 
 public:
-    IFAdder();
-    static IFAdder *init();
-
-    void run() override;
-    void setInput(const AdderInputType &type, const AdderInputDataType &value) override;
+    explicit IFAdder(SimulationContext *context);
 
 private:
-    void passProgramCounterToIFMux();
+    auto getInputPorts() { return std::tie(this->program_counter); }
+
+    void passProgramCounterToIFMux(unsigned long incremented_program_counter);
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
+
+    bool isEvaluationSkippable() override;
+    void markInputsEvaluated() override;
 
     std::string getModuleTag() override;
     Stage getModuleStage() override;
+
+    friend PortedModule;
 };
 
 #endif //RISC_V_SIMULATOR_IFADDER_H
@@ -7,48 +7,39 @@
 #include "forwarding/ALUInput1ForwardingMux.h"
 #include "../../common/Logger.h"
 
-class MuxBase;
 class ALUInput1ForwardingMux;
 class Logger;
 
-class EXMuxALUInput1: public MuxBase {
-    std::bitset<WORD_BIT_COUNT> program_counter;
-    std::bitset<WORD_BIT_COUNT> read_data_1;
-
-    bool is_program_counter_set;
-    bool is_read_data_1_set;
-
-    bool is_pass_program_counter_flag_asserted;
-    bool is_pass_program_counter_flag_set;
-
-    bool is_reset_flag_set;
+class EXMuxALUInput1: public MuxBase<EXMuxALUInput1> {
+    InputPort<EXStageMuxALUInput1InputType::ProgramCounter, unsigned long> program_counter;
+    InputPort<EXStageMuxALUInput1InputType::ReadData1, std::bitset<WORD_BIT_COUNT>> read_data_1;
 
     ALUInput1ForwardingMux *alu_input_1_forwarding_mux;
 
-    static EXMuxALUInput1 *current_instance;
-    static std::mutex initialization_mutex;
-
 public:
-    EXMuxALUInput1();
-
-    static EXMuxALUInput1 *init();
+    explicit EXMuxALUInput1(SimulationContext *context);
 
-    void run() override;
-
-    void setInput(MuxInputType type, MuxInputDataType value) override;
-    void assertControlSignal(bool is_asserted) override;
     void assertJALCustomControlSignal(bool is_asserted);
 
     void reset();
 
 protected:
-    void passOutput() override;
+    auto getInputPorts() { return std::tie(this->program_counter, this->read_data_1); }
+
+    void passOutput(std::bitset<WORD_BIT_COUNT> output);
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
+
+    bool isEvaluationSkippable() override;
+    void markInputsEvaluated() override;
 
     void resetState();
 
     std::string getModuleTag() override;
     Stage getModuleStage() override;
+
+    friend PortedModule;
 };
 
 #endif //RISC_V_SIMULATOR_EXMUXALUINPUT1_H
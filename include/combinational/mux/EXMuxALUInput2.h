@@ -8,47 +8,43 @@
 
 #include <iostream>
 
-class MuxBase;
 class ALUInput2ForwardingMux;
 
-class EXMuxALUInput2: public MuxBase {
-    std::bitset<WORD_BIT_COUNT> immediate;
-    std::bitset<WORD_BIT_COUNT> read_data_2;
+class EXMuxALUInput2: public MuxBase<EXMuxALUInput2> {
+    InputPort<EXStageMuxALUInput2InputType::ImmediateValue, std::bitset<WORD_BIT_COUNT>> immediate;
+    InputPort<EXStageMuxALUInput2InputType::ReadData2, std::bitset<WORD_BIT_COUNT>> read_data_2;
 
-    bool is_immediate_set;
-    bool is_read_data_2_set;
-    bool is_pass_four_flag_set;
+    Signal<bool> pass_four_flag;  // The ALU source is the control signal, JAL overrides it with 4
 
-    bool is_alu_src_asserted;
-    bool is_pass_four_flag_asserted;
-
-    bool is_reset_flag_set;
+    static constexpr uint32_t PASS_FOUR_FLAG_SET = FIRST_DERIVED_BIT;
 
     ALUInput2ForwardingMux *alu_input_2_forwarding_mux;
 
-    static EXMuxALUInput2 *current_instance;
-    static std::mutex initialization_mutex;
-
 public:
-    EXMuxALUInput2();
-
-    static EXMuxALUInput2 *init();
+    explicit EXMuxALUInput2(SimulationContext *context);
 
-    void run() override;
-    void setInput(MuxInputType type, MuxInputDataType value) override;
-    void assertControlSignal(bool is_asserted) override;
+    void assertControlSignal(bool is_asserted);
     void assertJALCustomControlSignal(bool is_asserted);
 
     void reset();
 
 protected:
-    void passOutput() override;
+    auto getInputPorts() { return std::tie(this->immediate, this->read_data_2); }
+
+    void passOutput(std::bitset<WORD_BIT_COUNT> output);
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
+
+    bool isEvaluationSkippable() override;
+    void markInputsEvaluated() override;
 
     void resetState();
 
     std::string getModuleTag() override;
     Stage getModuleStage() override;
+
+    friend PortedModule;
 };
 
 #endif //RISC_V_SIMULATOR_EXMUXALUINPUT2_H
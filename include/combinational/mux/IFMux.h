@@ -11,35 +11,32 @@
 class Driver;
 class Logger;
 
-class IFMux: public MuxBase {
-    unsigned long incremented_pc;
-    unsigned long branched_pc;
-
-    bool is_incremented_pc_set;
-    bool is_branched_pc_set;
-
-    bool is_pc_src_signal_asserted;
+class IFMux: public MuxBase<IFMux> {
+    InputPort<IFStageMuxInputType::IncrementedPc, unsigned long> incremented_pc;
+    InputPort<IFStageMuxInputType::BranchedPc, unsigned long> branched_pc;
 
     Driver *driver;
 
-    static IFMux *current_instance;
-    static std::mutex initialization_mutex;
-
 public:
-    IFMux();
-
-    static IFMux *init();
+    explicit IFMux(SimulationContext *context);
 
-    void run() override;
-    void setInput(MuxInputType type, MuxInputDataType value) override;
-    void assertControlSignal(bool is_asserted) override;
+    void assertControlSignal(bool is_asserted);
 
 protected:
-    void passOutput() override;
+    auto getInputPorts() { return std::tie(this->incremented_pc, this->branched_pc); }
+
+    void passOutput(bool is_branch_taken, unsigned long program_counter);
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
+
+    bool isEvaluationSkippable() override;
+    void markInputsEvaluated() override;
 
     std::string getModuleTag() override;
     Stage getModuleStage() override;
+
+    friend PortedModule;
 };
 
 #endif //RISC_V_SIMULATOR_IFMUX_H
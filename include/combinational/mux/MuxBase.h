@@ -1,20 +1,46 @@
 #ifndef RISC_V_SIMULATOR_MUXBASE_H
 #define RISC_V_SIMULATOR_MUXBASE_H
 
-#include <variant>
+#include <cstdint>
 
-#include "../../common/Module.h"
+#include "../../common/PortedModule.h"
+#include "../../common/Signal.h"
 
-class Module;
-
-class MuxBase: public Module {
+template<typename Derived, typename ControlSignal = bool>
+class MuxBase: public PortedModule<Derived> {
 public:
-    virtual void setInput(MuxInputType type, MuxInputDataType value) = 0;
-    virtual void assertControlSignal(bool is_asserted);
+    explicit MuxBase(SimulationContext *context);
 
 protected:
-    bool is_control_signal_set;
-    virtual void passOutput() = 0;
+    static constexpr uint32_t CONTROL_SIGNAL_SET = 1U << PortedModule<Derived>::PORT_BIT_COUNT;
+    static constexpr uint32_t RESET_FLAG_SET = CONTROL_SIGNAL_SET << 1;  // Muxes reset between pipelines only
+    static constexpr uint32_t FIRST_DERIVED_BIT = RESET_FLAG_SET << 1;
+
+    Signal<ControlSignal> control_signal;
+
+    void setControlSignal(ControlSignal new_signal);
+
+    void holdInput(SignalBase &input) override;
 };
 
+template<typename Derived, typename ControlSignal>
+MuxBase<Derived, ControlSignal>::MuxBase(SimulationContext *context) : PortedModule<Derived>(context) {}
+
+template<typename Derived, typename ControlSignal>
+void MuxBase<Derived, ControlSignal>::setControlSignal(ControlSignal new_signal) {
+    this->control_signal.set(new_signal);
+    this->setReadiness(CONTROL_SIGNAL_SET);
+}
+
+template<typename Derived, typename ControlSignal>
+void MuxBase<Derived, ControlSignal>::holdInput(SignalBase &input) {
+    if (&input != &this->control_signal) {
+        PortedModule<Derived>::holdInput(input);
+        return;
+    }
+
+    input.hold();
+    this->setReadiness(CONTROL_SIGNAL_SET);
+}
+
 #endif //RISC_V_SIMULATOR_MUXBASE_H
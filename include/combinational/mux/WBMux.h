@@ -12,17 +12,9 @@ class ALUInput2ForwardingMux;
 class RegisterFile;
 class Logger;
 
-class WBMux: public MuxBase {
-    std::bitset<WORD_BIT_COUNT> read_data;
-    std::bitset<WORD_BIT_COUNT> alu_result;
-
-    bool is_mem_to_reg_asserted;
-
-    bool is_read_data_set;
-    bool is_alu_result_set;
-
-    static WBMux *current_instance;
-    static std::mutex initialization_mutex;
+class WBMux: public MuxBase<WBMux> {
+    InputPort<WBStageMuxInputType::ReadData, std::bitset<WORD_BIT_COUNT>> read_data;
+    InputPort<WBStageMuxInputType::ALUResult, std::bitset<WORD_BIT_COUNT>> alu_result;
 
     RegisterFile *register_file;
 
@@ -30,21 +22,26 @@ class WBMux: public MuxBase {
     ALUInput2ForwardingMux *alu_input_2_forwarding_mux;
 
 public:
-    WBMux();
-
-    static WBMux *init();
+    explicit WBMux(SimulationContext *context);
 
-    void run() override;
-    void setInput(MuxInputType type, MuxInputDataType value) override;
-    void assertControlSignal(bool is_asserted) override;
+    void assertControlSignal(bool is_asserted);
 
 protected:
-    void passOutput() override;
-    void passOutputToForwardingMuxes();
+    auto getInputPorts() { return std::tie(this->read_data, this->alu_result); }
+
+    void passOutput(std::bitset<WORD_BIT_COUNT> write_data);
+    void passOutputToForwardingMuxes(std::bitset<WORD_BIT_COUNT> write_data);
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
+
+    bool isEvaluationSkippable() override;
+    void markInputsEvaluated() override;
 
     std::string getModuleTag() override;
     Stage getModuleStage() override;
+
+    friend PortedModule;
 };
 
 #endif //RISC_V_SIMULATOR_WBMUX_H
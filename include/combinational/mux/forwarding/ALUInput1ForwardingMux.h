@@ -6,20 +6,19 @@
 #include "../../../common/Config.h"
 #include "../../../../include/combinational/mux/forwarding/ALUInputForwardingMuxBase.h"
 
-class MuxBase;
 class ALUInput1ForwardingMux;
 class ALU;
 
-class ALUInput1ForwardingMux: public ALUInputForwardingMuxBase {
-    static ALUInput1ForwardingMux *current_instance;
-    static std::mutex initialization_mutex;
-
+class ALUInput1ForwardingMux: public ALUInputForwardingMuxBase<ALUInput1ForwardingMux> {
 public:
-    static ALUInput1ForwardingMux *init();
+    using ALUInputForwardingMuxBase::ALUInputForwardingMuxBase;
 
 protected:
-    void passOutput() override;
+    void passOutput(std::bitset<WORD_BIT_COUNT> output);
+    void initDependencies() override;
     std::string getModuleTag() override;
+
+    friend ALUInputForwardingMuxBase;
 };
 
 #endif //RISC_V_SIMULATOR_ALUINPUT1FORWARDINGMUX_H
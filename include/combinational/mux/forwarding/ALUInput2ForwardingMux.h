@@ -4,18 +4,17 @@
 #include "ALUInputForwardingMuxBase.h"
 
 class ALU;
-class ALUInputForwardingMuxBase;
-
-class ALUInput2ForwardingMux: public ALUInputForwardingMuxBase {
-    static ALUInput2ForwardingMux *current_instance;
-    static std::mutex initialization_mutex;
 
+class ALUInput2ForwardingMux: public ALUInputForwardingMuxBase<ALUInput2ForwardingMux> {
 public:
-    static ALUInput2ForwardingMux *init();
+    using ALUInputForwardingMuxBase::ALUInputForwardingMuxBase;
 
 protected:
-    void passOutput() override;
+    void passOutput(std::bitset<WORD_BIT_COUNT> output);
+    void initDependencies() override;
     std::string getModuleTag() override;
+
+    friend ALUInputForwardingMuxBase;
 };
 
 #endif //RISC_V_SIMULATOR_ALUINPUT2FORWARDINGMUX_H
@@ -1,6 +1,7 @@
 #ifndef RISC_V_SIMULATOR_ALUINPUTFORWARDINGMUXBASE_H
 #define RISC_V_SIMULATOR_ALUINPUTFORWARDINGMUXBASE_H
 
+#include <cstdint>
 #include <string>
 
 #include "../../../common/Config.h"
@@ -9,39 +10,50 @@
 
 class ALU;
 class Logger;
-class MuxBase;
 
-class ALUInputForwardingMuxBase: public MuxBase {
+/**
+ * Shared by both forwarding muxes, Derived provides passOutput() and connects the input from its EX stage mux. Instantiated for ALUInput1ForwardingMux and
+ * ALUInput2ForwardingMux at the end of ALUInputForwardingMuxBase.cpp.
+ */
+template<typename Derived>
+class ALUInputForwardingMuxBase: public MuxBase<Derived, ALUInputMuxControlSignals> {
 protected:
-    std::bitset<WORD_BIT_COUNT> id_ex_stage_registers_value;
-    std::bitset<WORD_BIT_COUNT> ex_mem_stage_registers_value;
-    std::bitset<WORD_BIT_COUNT> mem_wb_stage_registers_value;
-
-    ALUInputMuxControlSignals control_signal;
-
-    bool is_id_ex_stage_registers_value_set;
-    bool is_ex_mem_stage_registers_value_set;
-    bool is_mem_wb_stage_registers_value_set;
-
-    bool is_reset_flag_set;
+    InputPort<ALUInputMuxInputTypes::IDEXStageRegisters, std::bitset<WORD_BIT_COUNT>> id_ex_stage_registers_value;
+    InputPort<ALUInputMuxInputTypes::EXMEMStageRegisters, std::bitset<WORD_BIT_COUNT>> ex_mem_stage_registers_value;
+    InputPort<ALUInputMuxInputTypes::MEMWBStageRegisters, std::bitset<WORD_BIT_COUNT>> mem_wb_stage_registers_value;
 
     ALU *alu;
 
 public:
-    ALUInputForwardingMuxBase();
-
-    void run() override;
+    explicit ALUInputForwardingMuxBase(SimulationContext *context);
 
-    void setInput(MuxInputType type, MuxInputDataType value) override;
     void setMuxControlSignal(ALUInputMuxControlSignals new_signal);
+    void setPipelineType(PipelineType current_type) override;
 
     void reset();
 
 protected:
+    auto getInputPorts() {
+        return std::tie(
+                this->id_ex_stage_registers_value,
+                this->ex_mem_stage_registers_value,
+                this->mem_wb_stage_registers_value
+        );
+    }
+
+    uint32_t getRequiredBits(PipelineType current_type);
+
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
     void resetState();
 
+    bool isEvaluationSkippable() override;
+    void markInputsEvaluated() override;
+
     Stage getModuleStage() override;
+
+    friend PortedModule<Derived>;
 };
 
 #endif //RISC_V_SIMULATOR_ALUINPUTFORWARDINGMUXBASE_H
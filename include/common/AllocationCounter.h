@@ -0,0 +1,55 @@
+#ifndef RISC_V_SIMULATOR_ALLOCATIONCOUNTER_H
+#define RISC_V_SIMULATOR_ALLOCATIONCOUNTER_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+/**
+ * Counts the heap allocations of a class T deriving from AllocationCounter<T>, through the class specific operator
+ * new. Objects held by value (stage register members, signals in flight) are not heap allocations of their own and are
+ * not counted.
+ */
+template<typename T>
+class AllocationCounter {
+    static inline std::atomic<unsigned long> allocation_count = 0UL;
+    static inline std::atomic<unsigned long> live_count = 0UL;
+
+public:
+    static void *operator new(std::size_t size);
+    static void operator delete(void *object);
+
+    [[nodiscard]] static unsigned long getAllocationCount();
+    [[nodiscard]] static unsigned long getLiveCount();
+};
+
+template<typename T>
+void *AllocationCounter<T>::operator new(std::size_t size) {
+    void *object = ::operator new(size);
+
+    allocation_count.fetch_add(1UL, std::memory_order_relaxed);
+    live_count.fetch_add(1UL, std::memory_order_relaxed);
+
+    return object;
+}
+
+template<typename T>
+void AllocationCounter<T>::operator delete(void *object) {
+    if (object) {
+        live_count.fetch_sub(1UL, std::memory_order_relaxed);
+    }
+
+    ::operator delete(object);
+}
+
+template<typename T>
+unsigned long AllocationCounter<T>::getAllocationCount() {
+    return allocation_count.load(std::memory_order_relaxed);
+}
+
+template<typename T>
+unsigned long AllocationCounter<T>::getLiveCount() {
+    return live_count.load(std::memory_order_relaxed);
+}
+
+#endif //RISC_V_SIMULATOR_ALLOCATIONCOUNTER_H
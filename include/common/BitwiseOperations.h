@@ -1,10 +1,22 @@
 #ifndef RISC_V_SIMULATOR_BITWISEOPERATIONS_H
 #define RISC_V_SIMULATOR_BITWISEOPERATIONS_H
 
+#include <cstdint>
+
 #include "Config.h"
 
 class BitwiseOperations {
 public:
+    // Native word datapath, wraps around at 32 bits like the hardware adder
+    static constexpr uint32_t addWords(uint32_t value1, uint32_t value2) {
+        return value1 + value2;
+    }
+
+    static constexpr uint32_t subtractWords(uint32_t value1, uint32_t value2) {
+        return value1 - value2;
+    }
+
+    // Bitset adapters over the native word datapath
     static std::bitset<WORD_BIT_COUNT> addInputs(std::bitset<WORD_BIT_COUNT> value1,
                                                  std::bitset<WORD_BIT_COUNT> value2);
 
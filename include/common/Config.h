@@ -1,7 +1,6 @@
 #ifndef RISC_V_SIMULATOR_CONFIG_H
 #define RISC_V_SIMULATOR_CONFIG_H
 
-#include <variant>
 #include <string>
 #include <bitset>
 
@@ -14,8 +13,6 @@ enum class EXAdderInputType {
     ImmediateValue
 };
 
-using AdderInputType = std::variant<IFAdderInputType, EXAdderInputType>;
-
 enum class IFStageMuxInputType {
     IncrementedPc = 0,
     BranchedPc
@@ -41,20 +38,55 @@ enum class PipelineType {
     Five
 };
 
+enum class ExecutionMode {
+    Threaded = 0,  // Every module runs on its own thread and signals wake peers through condition variables
+    CycleDriven,  // Modules are evaluated in a fixed order on the calling thread, once per clock edge
+    EventDriven,  // Cycle-driven, modules whose Signal inputs did not change replay their previous outputs
+    Coroutine,  // Cycle-driven, every module is a coroutine resumed on the calling thread when a signal reaches it
+    Functional  // Instructions are executed one at a time against the architectural state, no module is evaluated
+};
+
+enum class LogLevel {
+    Trace = 0,  // Lock hand-offs and signal passing inside a cycle
+    Info,  // Lifecycle events such as file loads, resets, pauses and pipeline type changes
+    Error,
+    Off
+};
+
+enum class LogFormat {
+    Text = 0,  // <Stage>.log, one "[<module>] <message>" line per event
+    Binary,  // <Stage>.bin, variable length event records, rendered back to text by RISC_V_EventLogDecoder
+    None  // No stage logs, the Logger opens no files and starts no threads
+};
+
+enum class ThreadPlacementPolicy {
+    None = 0,  // Module and Logger writer threads run wherever the OS schedules them
+    Stage  // Module threads of a pipeline stage share a core cluster, Logger writers run on cores of their own
+};
+
+enum class RegisterFileTraceMode {
+    Full = 0,  // RegisterFile-<SS|FS>.log, all registers after every cycle
+    Delta  // RegisterFile-<SS|FS>.delta, only the registers a cycle changed
+};
+
+enum class DataMemoryModel {
+    Flat = 0,  // One contiguous byte array of the configured size, dumped in full
+    Paged  // Sparse 4 KiB pages over the whole 32-bit address space, only touched pages are dumped
+};
+
+// Lowest level Module::log compiles in, selected with the RISC_V_SIMULATOR_LOG_LEVEL CMake option
+#ifndef RISC_V_SIMULATOR_LOG_LEVEL
+#define RISC_V_SIMULATOR_LOG_LEVEL 0
+#endif
+
+constexpr LogLevel COMPILED_LOG_LEVEL = static_cast<LogLevel>(RISC_V_SIMULATOR_LOG_LEVEL);
+
 enum class ALUInputMuxInputTypes {
     IDEXStageRegisters = 0,
     EXMEMStageRegisters,
     MEMWBStageRegisters
 };
 
-
-/**
- * MuxInputType can hold either the value of IFStageMuxInputType, EXStageMuxALUInput2InputType,
- * WBStageMuxInputType.
- * */
-using MuxInputType = std::variant<IFStageMuxInputType, EXStageMuxALUInput2InputType, EXStageMuxALUInput1InputType,
-                                    WBStageMuxInputType, ALUInputMuxInputTypes>;
-
 enum class InstructionType {
     R = 0,
     I,
@@ -82,7 +114,4 @@ enum class Stage {
 
 constexpr int WORD_BIT_COUNT = 32;
 
-using MuxInputDataType = std::variant<std::bitset<WORD_BIT_COUNT>, unsigned long>;
-using AdderInputDataType = std::variant<std::bitset<WORD_BIT_COUNT>, unsigned long>;
-
 #endif //RISC_V_SIMULATOR_CONFIG_H
@@ -2,19 +2,11 @@
 #define RISC_V_SIMULATOR_CONTROL_H
 
 #include "Module.h"
+#include "AllocationCounter.h"
 #include "Instruction.h"
-#include "../state/RegisterFile.h"
-#include "../combinational/mux/IFMux.h"
-#include "../combinational/mux/WBMux.h"
-#include "../combinational/mux/EXMuxALUInput2.h"
-#include "../combinational/mux/EXMuxALUInput1.h"
-#include "../combinational/ALU.h"
-#include "../state/DataMemory.h"
-#include "../state/stage-registers/IFIDStageRegisters.h"
-#include "../state/stage-registers/IDEXStageRegisters.h"
-#include "../state/stage-registers/EXMEMStageRegisters.h"
 
 #include <bitset>
+#include <ostream>
 
 class RegisterFile;
 class IFMux;
@@ -26,13 +18,16 @@ class WBMux;
 class IFIDStageRegisters;
 class IDEXStageRegisters;
 class EXMEMStageRegisters;
+class StageSynchronizer;
+class FunctionalSimulator;
+class SimulationContext;
 
-class Control {
+class Control: public AllocationCounter<Control> {
 public:
     static constexpr int ALU_OP_BIT_COUNT = 4;
 
 private:
-    Instruction *instruction;
+    const Instruction *instruction;
     PipelineType pipeline_type;
 
     RegisterFile *register_file;
@@ -46,6 +41,9 @@ private:
     IDEXStageRegisters *id_ex_stage_registers;
     EXMEMStageRegisters *ex_mem_stage_registers;
 
+    SimulationContext *context;
+    ExecutionEngine *execution_engine;
+
     bool is_reg_write_asserted;
     bool is_pc_src_asserted;
     bool is_alu_src_asserted;
@@ -65,10 +63,14 @@ private:
     friend EXMEMStageRegisters;
     friend MEMWBStageRegisters;
     friend StageSynchronizer;
+    friend FunctionalSimulator;
 
 public:
-    explicit Control(Instruction *instruction, PipelineType current_pipeline_type);
-    static Control *deepCopy(Control *source);
+    Control(const Instruction *instruction, PipelineType current_pipeline_type, SimulationContext *context);
+
+    // Handed to the next stage by value: the decoded signals and the nop flag, the ALU zero flag and the taken branch
+    // stay with this stage
+    [[nodiscard]] Control getNextStageControl() const;
 
     void setIsALUResultZero(bool is_result_zero);
     void setNop(bool is_asserted);
@@ -80,16 +82,13 @@ public:
     [[nodiscard]] bool isRegWriteAsserted() const;
     [[nodiscard]] bool isMemReadAsserted() const;
 
-    void printState();
+    void printState(std::ostream &state) const;
 
 private:
     void generateSignals();
     void generateALUOpCode();
+    [[nodiscard]] bool isBranchTaken() const;
     void initDependencies();
-
-    void passNopToIFIDStageRegisters(bool is_signal_asserted);
-    void passNopToIDEXStageRegisters(bool is_signal_asserted);
-    void passNopToEXMEMStageRegisters(bool is_signal_asserted);
 };
 
 #endif //RISC_V_SIMULATOR_CONTROL_H
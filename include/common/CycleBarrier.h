@@ -0,0 +1,40 @@
+#ifndef RISC_V_SIMULATOR_CYCLEBARRIER_H
+#define RISC_V_SIMULATOR_CYCLEBARRIER_H
+
+#include <atomic>
+#include <functional>
+
+/**
+ * Reusable barrier the threads of one pipeline meet at once per cycle.
+ *
+ * The last thread to arrive runs the completion and then releases the others. Threads that only have to be counted
+ * arrive() without waiting. Waiting threads spin for a short while
+ * before they park on the phase counter, since most cycles complete within the spin window and a wake-up through the
+ * kernel costs more than the cycle itself. Participants are registered while no thread waits on the barrier.
+ */
+class CycleBarrier {
+    std::function<void()> on_completion;
+
+    int participant_count;
+    std::atomic<int> arrived_count;
+    std::atomic<unsigned long> phase;
+
+    static constexpr int SPIN_ITERATION_COUNT = 2048;
+
+public:
+    explicit CycleBarrier(std::function<void()> on_completion);
+
+    CycleBarrier(const CycleBarrier &) = delete;
+    CycleBarrier &operator=(const CycleBarrier &) = delete;
+
+    void registerParticipants(int count);
+    [[nodiscard]] int getParticipantCount() const;
+
+    void arrive();
+    void arriveAndWait();
+
+private:
+    void complete();
+};
+
+#endif //RISC_V_SIMULATOR_CYCLEBARRIER_H
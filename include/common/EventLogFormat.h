@@ -0,0 +1,72 @@
+#ifndef RISC_V_SIMULATOR_EVENTLOGFORMAT_H
+#define RISC_V_SIMULATOR_EVENTLOGFORMAT_H
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string_view>
+
+enum class EventLogRecordKind : uint8_t {
+    Event = 0,
+    ModuleDefinition,  // Followed by `length` bytes of module tag
+    EventDefinition,  // Followed by `length` bytes of message format
+    DroppedMessages
+};
+
+struct EventLogHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+};
+
+/**
+ * Record of a binary stage log. A stage log is an EventLogHeader followed by records, module tags and message formats
+ * are defined once per file right before the first event that refers to them. The stage is implied by the file.
+ *
+ * On disk a record is variable length: a tag byte holding the kind, which payloads follow and the cycle difference to
+ * the previous record (15 escapes to a varint), then the event and module IDs packed into one varint, then the
+ * non-zero payloads as varints. Definitions carry no cycle.
+ */
+struct EventLogRecord {
+    uint64_t cycle;
+    uint32_t payload_1;  // Message length for definitions, message count for DroppedMessages
+    uint32_t payload_2;
+    uint16_t event_id;
+    uint8_t module_id;
+    EventLogRecordKind kind;
+};
+
+class EventLogFormat {
+public:
+    static constexpr char MAGIC[8] = {'R', 'V', 'E', 'V', 'L', 'O', 'G', '\0'};
+    static constexpr uint32_t VERSION = 2;
+
+    static constexpr std::string_view PAYLOAD_PLACEHOLDER = "{}";
+
+    static EventLogHeader makeHeader();
+    static bool isValidHeader(const EventLogHeader &header);
+
+    // previous_cycle starts at 0 for every file and is advanced by each record, the writer and reader keep their own
+    static void writeRecord(std::ostream &output, const EventLogRecord &record, uint64_t &previous_cycle);
+    static bool readRecord(std::istream &input, EventLogRecord &record, uint64_t &previous_cycle);
+
+    // Renders an event the way the text stage logs print it: "[<tag>] <message>", placeholders replaced by payloads
+    static void writeEventText(std::ostream &output, std::string_view module_tag, std::string_view message_format,
+                               uint32_t payload_1, uint32_t payload_2);
+    static void writeDroppedMessagesText(std::ostream &output, unsigned long dropped_messages_count);
+
+private:
+    static constexpr uint8_t KIND_MASK = 0x03;
+    static constexpr uint8_t PAYLOAD_1_FLAG = 1U << 2;
+    static constexpr uint8_t PAYLOAD_2_FLAG = 1U << 3;
+    static constexpr int CYCLE_DELTA_SHIFT = 4;
+    static constexpr uint8_t CYCLE_DELTA_ESCAPE = 0x0F;  // The zigzag encoded difference follows as a varint
+
+    static constexpr int MODULE_ID_BIT_COUNT = 8;
+    static constexpr unsigned long MAX_ENCODED_RECORD_SIZE = 32;
+
+    static char *writeVarint(char *output, uint64_t value);
+    static bool readVarint(std::istream &input, uint64_t &value);
+};
+
+#endif //RISC_V_SIMULATOR_EVENTLOGFORMAT_H
@@ -0,0 +1,134 @@
+#ifndef RISC_V_SIMULATOR_EXECUTIONENGINE_H
+#define RISC_V_SIMULATOR_EXECUTIONENGINE_H
+
+#include <coroutine>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Config.h"
+#include "ModuleCoroutine.h"
+#include "WorkerPool.h"
+#include "SimulationContext.h"
+
+class Module;
+class SignalBase;
+class SimulationContext;
+class StageSynchronizer;
+class WorkerPool;
+
+struct ModuleEvaluationStatistics {
+    std::string module_tag;
+    unsigned long evaluation_count;
+    unsigned long skipped_evaluation_count;
+};
+
+/**
+ * Decides how modules exchange signals and when they are evaluated.
+ *
+ * Threaded: signals are delivered on a shared worker pool and modules wake up through their condition variables.
+ * Five stage setters defer their updates like in CycleDriven, the last arrival at the five stage barrier hands the
+ * clock edge to the pool. Signals sent through dispatchAndWait run on the calling module thread.
+ * CycleDriven: registered modules are evaluated on the calling thread in registration (topological) order until no
+ * module is ready, after which the clock edge is completed. Stage register updates issued during a five stage cycle
+ * are held back and replayed at the edge, which mirrors the five stage barrier of the threaded mode.
+ * EventDriven: evaluated like CycleDriven, but a module whose inputs did not change since its last evaluation is not
+ * executed. Its outputs are connected inputs of other modules (Module::connectInput), which are held with the values
+ * they already have.
+ * Coroutine: clocked like CycleDriven, but every module runs as a coroutine (Module::runCoroutine) that awaits its next
+ * signal. A signal that reaches a module puts it on the run queue, and only queued modules are resumed. A signal that
+ * reaches a module which already arrived in this cycle is kept until the clock edge.
+ */
+class ExecutionEngine {
+    ExecutionMode execution_mode;
+
+    std::vector<Module *> modules;
+    std::vector<bool> is_module_arrived;
+    int executing_module_index;
+
+    // Coroutine mode only, indexed like modules
+    std::vector<ModuleCoroutine> module_coroutines;
+    std::vector<bool> is_module_waiting;
+    std::vector<bool> is_module_scheduled;
+    std::deque<int> scheduled_module_indices;
+    std::vector<int> next_cycle_module_indices;  // Scheduled after they arrived, resumed in the next cycle
+
+    std::mutex connection_mutex;
+
+    std::queue<std::function<void()>> pending_signals;
+    std::vector<std::function<void()>> clock_edge_nop_updates;
+    std::vector<std::function<void()>> clock_edge_updates;
+    std::mutex clock_edge_mutex;
+
+    // Per thread, pool workers keep deferring the updates of the next cycle while another one applies a clock edge
+    static thread_local bool is_applying_clock_edge;
+
+    SimulationContext *context;
+    StageSynchronizer *stage_synchronizer;
+
+    std::unique_ptr<WorkerPool> worker_pool;
+    std::once_flag worker_pool_initialization_flag;
+
+    static constexpr int NO_EXECUTING_MODULE = -1;
+
+public:
+    // Awaited by a module coroutine until a signal reaches the module
+    class SignalAwaiter {
+        ExecutionEngine *execution_engine;
+        int module_index;
+
+    public:
+        SignalAwaiter(ExecutionEngine *execution_engine, int module_index);
+
+        [[nodiscard]] bool await_ready() const noexcept;
+        void await_suspend(std::coroutine_handle<> handle) const;
+        void await_resume() const noexcept;
+    };
+
+    explicit ExecutionEngine(SimulationContext *context);
+    ~ExecutionEngine();  // Joins the worker pool threads
+
+    void setExecutionMode(ExecutionMode new_execution_mode);
+    [[nodiscard]] ExecutionMode getExecutionMode() const;
+    [[nodiscard]] bool isCycleDriven() const;
+    [[nodiscard]] bool isEventDriven() const;
+    [[nodiscard]] bool isCoroutineDriven() const;
+
+    void registerModule(Module *module);
+    void scheduleModule(Module *module);
+    SignalAwaiter waitForSignal(Module *module);
+
+    void connectInput(SignalBase &input, Module *owner, Module *driver);
+
+    void dispatch(std::function<void()> signal);
+    void dispatchAndWait(std::initializer_list<std::function<void()>> signals);
+
+    bool deferUntilClockEdge(std::function<void()> update, bool is_nop_signal);
+    void submitClockEdge();  // Threaded mode, applies the deferred updates on the worker pool
+    void arriveSingleStage();
+
+    void runUntilPaused();
+
+    WorkerPool *getWorkerPool();
+
+    // One entry per registered module, in registration order
+    [[nodiscard]] std::vector<ModuleEvaluationStatistics> getEvaluationStatistics() const;
+
+private:
+    void initDependencies();
+
+    bool evaluateModules();
+    bool isEvaluationSkipped(Module *module);
+    bool resumeModuleCoroutines();
+    void scheduleModule(int module_index);
+    void drainPendingSignals();
+    void applyClockEdge();
+};
+
+#endif //RISC_V_SIMULATOR_EXECUTIONENGINE_H
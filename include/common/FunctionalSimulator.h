@@ -0,0 +1,64 @@
+#ifndef RISC_V_SIMULATOR_FUNCTIONALSIMULATOR_H
+#define RISC_V_SIMULATOR_FUNCTIONALSIMULATOR_H
+
+#include <bitset>
+#include <limits>
+#include <mutex>
+
+#include "Config.h"
+#include "Control.h"
+#include "Instruction.h"
+#include "BitwiseOperations.h"
+#include "SimulationContext.h"
+#include "../state/InstructionMemory.h"
+#include "../state/DataMemory.h"
+#include "../state/RegisterFile.h"
+#include "../state/Driver.h"
+#include "../combinational/ALU.h"
+
+class InstructionMemory;
+class DataMemory;
+class RegisterFile;
+class Driver;
+
+/**
+ * Instruction set simulator that executes one instruction per step straight against the architectural state held by
+ * InstructionMemory, DataMemory and RegisterFile, without evaluating any pipeline module.
+ *
+ * Control signals, ALU operations and immediates come from the same code the single stage pipeline uses, so a run
+ * leaves the register file and data memory (and their -SS output files) exactly as the single stage pipeline would.
+ * fastForward() runs without writing the output files and hands the state over to the pipeline instead.
+ */
+class FunctionalSimulator {
+    unsigned long program_counter;
+    unsigned long executed_instruction_count;
+    bool is_halted;
+
+    // The ID/EX register only refreshes read data 2 on double register reads, I and S types see the previous value
+    std::bitset<WORD_BIT_COUNT> read_data_2;
+
+    SimulationContext *context;
+
+    InstructionMemory *instruction_memory;
+    DataMemory *data_memory;
+    RegisterFile *register_file;
+    Driver *driver;
+
+public:
+    static constexpr unsigned long NO_INSTRUCTION_LIMIT = std::numeric_limits<unsigned long>::max();
+
+    explicit FunctionalSimulator(SimulationContext *context);
+
+    bool run(unsigned long max_instruction_count = NO_INSTRUCTION_LIMIT);
+    bool fastForward(unsigned long instruction_count);
+    void reset();
+
+    [[nodiscard]] unsigned long getProgramCounter() const;
+    [[nodiscard]] unsigned long getExecutedInstructionCount() const;
+    [[nodiscard]] bool isHalted() const;
+
+private:
+    void step(bool is_output_written);
+};
+
+#endif //RISC_V_SIMULATOR_FUNCTIONALSIMULATOR_H
@@ -0,0 +1,18 @@
+#ifndef RISC_V_SIMULATOR_INPUTPORT_H
+#define RISC_V_SIMULATOR_INPUTPORT_H
+
+#include "Signal.h"
+
+/**
+ * Statically typed input of a module, named by an enumerator of the module's input type in Config.h. isSet() takes the
+ * place of the is_*_set flag, markEvaluated() clears it once the module consumed the value.
+ */
+template<auto Input, typename T>
+class InputPort: public Signal<T> {
+public:
+    static constexpr auto input = Input;
+
+    using Signal<T>::Signal;
+};
+
+#endif //RISC_V_SIMULATOR_INPUTPORT_H
@@ -2,15 +2,16 @@
 #define RISC_V_SIMULATOR_INSTRUCTION_H
 
 #include <bitset>
+#include <cstdint>
 #include <string>
-#include <vector>
-#include <variant>
-#include <unordered_map>
 #include <iostream>
 
 #include "Config.h"
+#include "AllocationCounter.h"
 
-class Instruction {
+class Control;
+
+class Instruction: public AllocationCounter<Instruction> {
 public:
     static constexpr int FUNCT7_BIT_COUNT = 7;
     static constexpr int FUNCT3_BIT_COUNT = 3;
@@ -20,24 +21,38 @@ public:
     static constexpr int J_TYPE_IMMEDIATE_BIT_COUNT = 20;
 
 private:
-    std::string instruction;
+    // Every field is extracted once when the instruction is built, getters only hand out copies
+    struct DecodedFields {
+        uint8_t funct7;
+        uint8_t funct3;
+        uint8_t rs1;
+        uint8_t rs2;
+        uint8_t rd;
+        uint8_t opcode;
+        InstructionType type;
+        uint16_t immediate;
+        uint32_t immediate_j;
+        uint32_t sign_extended_immediate;
+    };
 
-    std::unordered_map<std::string, InstructionType> opcode_to_type_mapping;
+    uint32_t instruction;
+    DecodedFields fields;
 
-    static constexpr int FUNCT7_BASE_STRING_INDEX = 0;
-    static constexpr int FUNCT3_BASE_STRING_INDEX = 17;
-    static constexpr int RS1_BASE_STRING_INDEX = 12;
-    static constexpr int RS2_BASE_STRING_INDEX = 7;
-    static constexpr int RD_BASE_STRING_INDEX = 20;
-    static constexpr int OPCODE_BASE_STRING_INDEX = 25;
+    static constexpr int FUNCT7_BASE_BIT_INDEX = 25;
+    static constexpr int FUNCT3_BASE_BIT_INDEX = 12;
+    static constexpr int RS1_BASE_BIT_INDEX = 15;
+    static constexpr int RS2_BASE_BIT_INDEX = 20;
+    static constexpr int RD_BASE_BIT_INDEX = 7;
+    static constexpr int OPCODE_BASE_BIT_INDEX = 0;
+    static constexpr int J_TYPE_IMMEDIATE_BASE_BIT_INDEX = 12;
 
-    // segments contain pairs (start index of segment and segment size)
-    const std::vector<std::pair<int, int>> I_TYPE_IMMEDIATE_SEGMENTS {{0, 12}};
-    const std::vector<std::pair<int, int>> SB_TYPE_IMMEDIATE_SEGMENTS {{0, 1}, {24, 1}, {1, 6}, {20, 4}};
-    const std::vector<std::pair<int, int>> J_TYPE_IMMEDIATE_SEGMENTS {{0, 20}};
+    void decode();
+    static InstructionType decodeType(uint8_t opcode);
+    static uint32_t extractBits(uint32_t bits, int base_bit_index, int bit_count);
 
 public:
-    explicit Instruction(std::string instruction);
+    explicit Instruction(uint32_t instruction);
+    explicit Instruction(const std::string &instruction);
 
     std::bitset<FUNCT7_BIT_COUNT> getFunct7() const;
     std::bitset<FUNCT3_BIT_COUNT> getFunct3() const;
@@ -47,9 +62,26 @@ public:
     std::bitset<OPCODE_BIT_COUNT> getOpcode() const;
     std::bitset<GENERAL_IMMEDIATE_BIT_COUNT> getImmediate() const;
     std::bitset<J_TYPE_IMMEDIATE_BIT_COUNT> getImmediateJ() const;
+    std::bitset<WORD_BIT_COUNT> getSignExtendedImmediate() const;
+    [[nodiscard]] uint32_t getBits() const;
 
     InstructionType getType() const;
-    static Instruction *deepCopy(const Instruction *source);
+
+    // LUI, AUIPC, JALR and the SYSTEM opcodes have no datapath, see InstructionMemory::rejectUnsupportedInstructions
+    static bool isSupportedOpcode(uint8_t opcode);
+
+    // Held by stage registers after a reset, instructions are immutable so one object serves every context
+    static const Instruction *getZeroInstruction();
+};
+
+/**
+ * Fetched instruction as handed from InstructionMemory to IFIDStageRegisters. Both objects are owned by the decoded
+ * instruction cache and shared between fetches of the same program counter: the instruction is never modified and the
+ * control is copied before use.
+ */
+struct DecodedInstruction {
+    const Instruction *instruction = nullptr;
+    const Control *control_template = nullptr;
 };
 
 #endif //RISC_V_SIMULATOR_INSTRUCTION_H
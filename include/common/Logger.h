@@ -1,77 +1,130 @@
 #ifndef RISC_V_SIMULATOR_LOGGER_H
 #define RISC_V_SIMULATOR_LOGGER_H
 
-#include <mutex>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
-#include <string>
+#include <cstdint>
+#include <deque>
 #include <fstream>
-#include <queue>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "Config.h"
+#include "EventLogFormat.h"
+#include "SimulationContext.h"
+#include "ThreadPlacement.h"
 
 class Logger {
-    std::mutex if_stage_mutex;
-    std::mutex id_stage_mutex;
-    std::mutex ex_stage_mutex;
-    std::mutex mem_stage_mutex;
-    std::mutex wb_stage_mutex;
-
-    std::mutex log_mutex;
-
-    std::condition_variable if_stage_condition_variable;
-    std::condition_variable id_stage_condition_variable;
-    std::condition_variable ex_stage_condition_variable;
-    std::condition_variable mem_stage_condition_variable;
-    std::condition_variable wb_stage_condition_variable;
+public:
+    static constexpr int STAGE_COUNT = 5;
+    static constexpr unsigned long MESSAGE_RING_BUFFER_CAPACITY = 4096;  // Must be a power of two
+    static constexpr unsigned long MAX_MODULE_COUNT = 256;
+    static constexpr unsigned long MAX_EVENT_COUNT = 65536;
 
-    std::queue<std::string> if_stage_messages_queue;
-    std::queue<std::string> id_stage_messages_queue;
-    std::queue<std::string> ex_stage_messages_queue;
-    std::queue<std::string> mem_stage_messages_queue;
-    std::queue<std::string> wb_stage_messages_queue;
+private:
+    struct LogRecord {
+        std::atomic<unsigned long> sequence;
+        EventLogRecord event;
+    };
+
+    /**
+     * Bounded multi-producer, single-consumer ring buffer of preallocated records for one stage. Producers claim a
+     * slot with a single compare-and-swap and drop the message when the buffer is full, they never wait on the writer.
+     */
+    struct StageLog {
+        std::unique_ptr<LogRecord[]> records;
+
+        alignas(64) std::atomic<unsigned long> enqueue_position;
+        alignas(64) unsigned long dequeue_position;  // Only touched by the writer thread
+        uint64_t previous_cycle;  // Cycle of the last record written, binary records store the difference to it
+
+        std::atomic<unsigned long> dropped_messages_count;
+
+        // Writer thread copies of the registry, an entry is filled (and defined in a binary file) on first use
+        std::vector<std::string_view> module_tags;
+        std::vector<std::string_view> event_formats;
+
+        std::unique_ptr<char[]> log_file_buffer;
+        std::ofstream log_file;
+        std::thread writer;
+    };
+
+    static constexpr std::chrono::milliseconds WRITER_IDLE_INTERVAL {1};
+    static constexpr unsigned long LOG_FILE_BUFFER_SIZE = 1UL << 16;
+
+    const std::array<std::string, STAGE_COUNT> STAGE_LOG_FILE_NAMES = {
+            "IFStage", "IDStage", "EXStage", "MEMStage", "WBStage"
+    };
+
+    const std::string TEXT_LOG_FILE_EXTENSION = ".log";
+    const std::string BINARY_LOG_FILE_EXTENSION = ".bin";
+
+    LogFormat log_format;
+    unsigned long serial_number;
+
+    std::atomic<bool> is_killed;
+    std::atomic<unsigned long> current_cycle;
+
+    std::array<StageLog, STAGE_COUNT> stage_logs;
+
+    // Console text is written in submission order by its own thread, so no simulation thread waits on the terminal
+    std::mutex console_mutex;
+    std::condition_variable console_condition_variable;
+    std::deque<std::string> console_texts;
+    bool is_console_writing;
+    std::thread console_writer;
+
+    // Interned module tags and message formats, the deques keep every string in place so views into them stay valid
+    std::mutex registry_mutex;
+    std::deque<std::string> module_tags;
+    std::deque<std::string> event_formats;
+    std::unordered_map<std::string_view, uint16_t> event_ids;
+
+    static LogFormat configured_log_format;
+    static bool is_log_format_used;  // Set by the first Logger, the format is shared by every context
+    static std::mutex initialization_mutex;
 
-    const std::string LOG_DIRECTORY_PATH = "../logs/";
+    static constexpr unsigned long NO_LOGGER_SERIAL_NUMBER = std::numeric_limits<unsigned long>::max();
+    static std::atomic<unsigned long> next_serial_number;
 
-    const std::string IF_STAGE_LOG_FILE_NAME = "IFStage.log";
-    const std::string ID_STAGE_LOG_FILE_NAME = "IDStage.log";
-    const std::string EX_STAGE_LOG_FILE_NAME = "EXStage.log";
-    const std::string MEM_STAGE_LOG_FILE_NAME = "MEMStage.log";
-    const std::string WB_STAGE_LOG_FILE_NAME = "WBStage.log";
+public:
+    explicit Logger(SimulationContext *context);
+    ~Logger();
 
-    const int MAX_MESSAGE_QUEUE_SIZE = 20;
+    static void setLogFormat(LogFormat new_log_format);
 
-    bool is_killed;
+    void log(Stage current_stage, uint8_t module_id, std::string_view message, uint32_t payload_1, uint32_t payload_2);
+    void kill();
 
-    std::ofstream if_stage_log_file;
-    std::ofstream id_stage_log_file;
-    std::ofstream ex_stage_log_file;
-    std::ofstream mem_stage_log_file;
-    std::ofstream wb_stage_log_file;
+    uint8_t registerModule(std::string_view module_tag);
+    void setCurrentCycle(unsigned long cycle);
 
-    static Logger *current_instance;
-    static std::mutex initialization_mutex;
+    void writeToConsole(std::string text);
+    void waitForConsoleOutput();
 
-public:
-    Logger();
-    ~Logger();
+    [[nodiscard]] unsigned long getDroppedMessagesCount() const;
 
-    static Logger *init();
+private:
+    uint16_t internEvent(std::string_view message_format);
+    bool tryEnqueueEvent(StageLog &stage_log, const EventLogRecord &event);
 
-    void log(Stage current_stage, const std::string &message);
-    void kill();
+    std::string_view getWriterModuleTag(StageLog &stage_log, uint8_t module_id);
+    std::string_view getWriterEventFormat(StageLog &stage_log, uint16_t event_id);
+    void writeDefinition(StageLog &stage_log, EventLogRecordKind kind, uint16_t id, std::string_view text);
+    void writeEvent(StageLog &stage_log, const EventLogRecord &event);
 
-private:
-    void enqueueIFStageMessage(const std::string &message);
-    void enqueueIDStageMessage(const std::string &message);
-    void enqueueEXStageMessage(const std::string &message);
-    void enqueueMEMStageMessage(const std::string &message);
-    void enqueueWBStageMessage(const std::string &message);
-
-    void writeIFStageMessagesToFile();
-    void writeIDStageMessagesToFile();
-    void writeEXStageMessagesToFile();
-    void writeMEMStageMessagesToFile();
-    void writeWBStageMessagesToFile();
+    bool writeQueuedMessagesToFile(StageLog &stage_log);
+    void writeStageMessagesToFile(StageLog &stage_log, Stage stage, const std::string &thread_name);
+    void writeConsoleTexts();
 };
 
 #endif //RISC_V_SIMULATOR_LOGGER_H
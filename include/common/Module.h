@@ -1,15 +1,29 @@
 #ifndef RISC_V_SIMULATOR_MODULE_H
 #define RISC_V_SIMULATOR_MODULE_H
 
+#include <atomic>
+#include <cstdint>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
 #include <string>
+#include <string_view>
+#include <functional>
+#include <initializer_list>
+#include <vector>
 
 #include "Config.h"
 #include "Logger.h"
+#include "ExecutionEngine.h"
+#include "SimulationContext.h"
+#include "Signal.h"
+#include "ModuleCoroutine.h"
+#include "ReadinessMask.h"
+#include "ThreadPlacement.h"
 
 class Logger;
+class ExecutionEngine;
+class SimulationContext;
 
 class Module {
     bool is_alive;
@@ -17,15 +31,37 @@ class Module {
     std::mutex module_mutex;
     std::condition_variable module_condition_variable;
 
-    std::mutex log_mutex;
     std::mutex dependency_mutex;
 
+    std::atomic<int> log_module_id;
+
+    static constexpr int NO_LOG_MODULE_ID = -1;
+
     PipelineType pipeline_type;
 
+    // Counted by the ExecutionEngine in the cycle-driven modes only, skips in the event-driven mode
+    unsigned long evaluation_count;
+    unsigned long skipped_evaluation_count;
+
+    int registration_index;  // Position in the ExecutionEngine, NOT_REGISTERED until registered
+
+    std::vector<SignalBase *> driven_inputs;  // Inputs of other modules connected to this module's outputs
+
+    static constexpr int NOT_REGISTERED = -1;
+
+    friend class ExecutionEngine;
+
+    Logger *resolveLogger();  // Loaded by initDependencies, which a module may not have run yet
+
 public:
-    Module();
+    explicit Module(SimulationContext *context);
+    virtual ~Module() = default;
+
+    // Runs initDependencies ahead of run(), barrier participants register there before any module thread arrives
+    void resolveDependencies();
 
-    virtual void run() = 0;
+    virtual void run();
+    ModuleCoroutine runCoroutine();
     void notifyModuleConditionVariable();
 
     void kill();
@@ -37,16 +73,90 @@ public:
 
     std::condition_variable &getModuleConditionVariable();
 
-    void setPipelineType(PipelineType current_type);
+    virtual void setPipelineType(PipelineType current_type);
     PipelineType getPipelineType();
 
+    [[nodiscard]] unsigned long getEvaluationCount() const;
+    [[nodiscard]] unsigned long getSkippedEvaluationCount() const;
+
 protected:
-    Logger *logger;
+    SimulationContext *context;
+    std::atomic<Logger *> logger;
+    ExecutionEngine *execution_engine;
+
+    /**
+     * Modules tracking their inputs in the readiness mask wait on it instead of the condition variable in the threaded
+     * mode, their setters store the value and set its bit without taking the module mutex.
+     */
+    ReadinessMask readiness;
 
     virtual void initDependencies() = 0;
-    virtual void log(const std::string &message);
+
+    /**
+     * A module executes once per wake-up, with the module mutex held, when isReadyToExecute() holds. Both are
+     * driven either by run() on the module's own thread or by the ExecutionEngine in the cycle-driven mode.
+     */
+    virtual bool isReadyToExecute() = 0;
+    virtual void execute() = 0;
+
+    /**
+     * Event-driven mode only. A module whose every output reaches a connected input reports whether its inputs are
+     * unchanged since it last evaluated them. The ExecutionEngine then skips the evaluation, marks the inputs
+     * evaluated and holds the connected inputs instead, so downstream modules see their previous values set again.
+     */
+    virtual bool isEvaluationSkippable();
+    virtual void markInputsEvaluated();
+
+    template<typename... Values>
+    static bool areInputsUnchanged(const Signal<Values> &... inputs);
+
+    // Called from initDependencies of the module owning the input
+    void connectInput(SignalBase &input, Module *driver);
+
+    // Clocked modules defer it to the clock edge, like the setter of the held input
+    virtual void holdInput(SignalBase &input);
+
+    template<typename Function, typename... Arguments>
+    void dispatch(Function &&function, Arguments &&... arguments);
+    void dispatchAndWait(std::initializer_list<std::function<void()>> signals);
+
+    void setReadiness(uint32_t bits);
+    void clearReadiness(uint32_t bits);
+    void requireReadiness(uint32_t bits);
+    void wakeUp();
+
+    /**
+     * Messages below COMPILED_LOG_LEVEL are discarded at compile time, the call and its argument compile to nothing
+     * as long as the message is a literal. Each "{}" in the message is rendered as the next payload.
+     */
+    template<LogLevel level = LogLevel::Trace>
+    void log(std::string_view message, uint32_t payload_1 = 0, uint32_t payload_2 = 0);
+    void writeLog(std::string_view message, uint32_t payload_1, uint32_t payload_2);
+
+    // Handed to the Logger's console writer, the text appears in submission order after the cycle line
+    void printToConsole(std::string text);
+
     virtual std::string getModuleTag() = 0;
     virtual Stage getModuleStage() = 0;
 };
 
+template<typename... Values>
+bool Module::areInputsUnchanged(const Signal<Values> &... inputs) {
+    return (!inputs.isChanged() && ...);
+}
+
+template<typename Function, typename... Arguments>
+void Module::dispatch(Function &&function, Arguments &&... arguments) {
+    this->execution_engine->dispatch(
+            std::bind(std::forward<Function>(function), std::forward<Arguments>(arguments)...)
+    );
+}
+
+template<LogLevel level>
+void Module::log(std::string_view message, uint32_t payload_1, uint32_t payload_2) {
+    if constexpr (level >= COMPILED_LOG_LEVEL && level != LogLevel::Off) {
+        this->writeLog(message, payload_1, payload_2);
+    }
+}
+
 #endif //RISC_V_SIMULATOR_MODULE_H
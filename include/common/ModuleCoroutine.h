@@ -0,0 +1,44 @@
+#ifndef RISC_V_SIMULATOR_MODULECOROUTINE_H
+#define RISC_V_SIMULATOR_MODULECOROUTINE_H
+
+#include <coroutine>
+#include <exception>
+
+/**
+ * Owning handle of the coroutine a module runs in the coroutine mode. The coroutine runs up to its first co_await when
+ * it is created, every resume() runs it up to its next one, and an exception escaping the coroutine is rethrown from
+ * the resume() that raised it.
+ */
+class ModuleCoroutine {
+public:
+    struct promise_type {
+        std::exception_ptr exception;
+
+        ModuleCoroutine get_return_object();
+        std::suspend_never initial_suspend() noexcept;
+        std::suspend_always final_suspend() noexcept;
+        void return_void();
+        void unhandled_exception();
+    };
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    explicit ModuleCoroutine(std::coroutine_handle<promise_type> handle);
+
+public:
+    ModuleCoroutine();
+    ~ModuleCoroutine();
+
+    ModuleCoroutine(ModuleCoroutine &&other) noexcept;
+    ModuleCoroutine &operator=(ModuleCoroutine &&other) noexcept;
+
+    ModuleCoroutine(const ModuleCoroutine &) = delete;
+    ModuleCoroutine &operator=(const ModuleCoroutine &) = delete;
+
+    [[nodiscard]] bool isDone() const;
+
+    void resume();
+};
+
+#endif //RISC_V_SIMULATOR_MODULECOROUTINE_H
@@ -0,0 +1,61 @@
+#ifndef RISC_V_SIMULATOR_PAGEDMEMORY_H
+#define RISC_V_SIMULATOR_PAGEDMEMORY_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+/**
+ * Sparse, big endian byte memory covering the full 32-bit address space. Pages are allocated on their first store
+ * through a two level page table, loads from untouched pages read zero without allocating anything.
+ */
+class PagedMemory {
+public:
+    static constexpr int PAGE_OFFSET_BIT_COUNT = 12;
+    static constexpr int PAGE_TABLE_INDEX_BIT_COUNT = 10;
+    static constexpr int PAGE_DIRECTORY_INDEX_BIT_COUNT = 10;
+
+    static constexpr unsigned long PAGE_SIZE = 1UL << PAGE_OFFSET_BIT_COUNT;
+    static constexpr unsigned long ADDRESS_SPACE_SIZE =
+            1UL << (PAGE_OFFSET_BIT_COUNT + PAGE_TABLE_INDEX_BIT_COUNT + PAGE_DIRECTORY_INDEX_BIT_COUNT);
+
+    struct Page {
+        std::array<uint8_t, PAGE_SIZE> bytes {};
+        bool is_dirty = false;  // Written by a store since the page was loaded
+    };
+
+private:
+    static constexpr unsigned long PAGE_TABLE_SIZE = 1UL << PAGE_TABLE_INDEX_BIT_COUNT;
+    static constexpr unsigned long PAGE_DIRECTORY_SIZE = 1UL << PAGE_DIRECTORY_INDEX_BIT_COUNT;
+    static constexpr int WORD_BYTE_COUNT = 4;
+
+    using PageTable = std::array<std::unique_ptr<Page>, PAGE_TABLE_SIZE>;
+
+    std::array<std::unique_ptr<PageTable>, PAGE_DIRECTORY_SIZE> page_directory;
+    unsigned long resident_page_count;
+
+public:
+    PagedMemory();
+
+    [[nodiscard]] uint8_t loadByte(unsigned long address) const;
+    void storeByte(unsigned long address, uint8_t byte);
+    void storeBytes(unsigned long address, std::span<const uint8_t> bytes);  // Loads an image, pages stay clean
+
+    // Words are big endian and may straddle pages, the caller keeps them inside ADDRESS_SPACE_SIZE
+    [[nodiscard]] uint32_t loadWord(unsigned long address) const;
+    void storeWord(unsigned long address, uint32_t word);
+
+    void clear();
+    void copyFrom(const PagedMemory &source);  // Reuses the pages both memories have, dirty flags included
+
+    [[nodiscard]] unsigned long getResidentPageCount() const;
+    [[nodiscard]] std::vector<unsigned long> getDirtyPageAddresses() const;
+    [[nodiscard]] const Page *findPage(unsigned long address) const;
+
+private:
+    Page &touchPage(unsigned long address);
+};
+
+#endif //RISC_V_SIMULATOR_PAGEDMEMORY_H
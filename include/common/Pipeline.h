@@ -0,0 +1,101 @@
+#ifndef RISC_V_SIMULATOR_PIPELINE_H
+#define RISC_V_SIMULATOR_PIPELINE_H
+
+#include <string>
+#include <thread>
+
+#include "Config.h"
+#include "SimulationContext.h"
+
+class EXAdder;
+class IFAdder;
+class ALUInput1ForwardingMux;
+class ALUInput2ForwardingMux;
+class EXMuxALUInput1;
+class EXMuxALUInput2;
+class IFMux;
+class WBMux;
+class ALU;
+class ForwardingUnit;
+class ImmediateGenerator;
+class StageSynchronizer;
+class EXMEMStageRegisters;
+class IDEXStageRegisters;
+class IFIDStageRegisters;
+class MEMWBStageRegisters;
+class DataMemory;
+class Driver;
+class InstructionMemory;
+class RegisterFile;
+class HazardDetectionUnit;
+class ExecutionEngine;
+class Logger;
+class SimulationContext;
+
+/**
+ * The modules of one SimulationContext, with the operations the simulator and the batch runner drive them through.
+ */
+struct Pipeline {
+    EXAdder *ex_adder = nullptr;
+    IFAdder *if_adder = nullptr;
+    ALUInput1ForwardingMux *alu_input_1_forwarding_mux = nullptr;
+    ALUInput2ForwardingMux *alu_input_2_forwarding_mux = nullptr;
+    EXMuxALUInput1 *ex_mux_alu_input_1 = nullptr;
+    EXMuxALUInput2 *ex_mux_alu_input_2 = nullptr;
+    IFMux *if_mux = nullptr;
+    WBMux *wb_mux = nullptr;
+    ALU *alu = nullptr;
+    Logger *logger = nullptr;
+    ForwardingUnit *forwarding_unit = nullptr;
+    ImmediateGenerator *immediate_generator = nullptr;
+    StageSynchronizer *stage_synchronizer = nullptr;
+    EXMEMStageRegisters *ex_mem_stage_registers = nullptr;
+    IDEXStageRegisters *id_ex_stage_registers = nullptr;
+    IFIDStageRegisters *if_id_stage_registers = nullptr;
+    MEMWBStageRegisters *mem_wb_stage_registers = nullptr;
+    DataMemory *data_memory = nullptr;
+    Driver *driver = nullptr;
+    InstructionMemory *instruction_memory = nullptr;
+    RegisterFile *register_file = nullptr;
+    HazardDetectionUnit *hazard_detection_unit = nullptr;
+    ExecutionEngine *execution_engine = nullptr;
+};
+
+struct ActiveThreads {
+    std::thread ex_adder_thread;
+    std::thread if_adder_thread;
+    std::thread alu_input_1_forwarding_mux_thread;
+    std::thread alu_input_2_forwarding_mux_thread;
+    std::thread ex_mux_alu_input_1_thread;
+    std::thread ex_mux_alu_input_2_thread;
+    std::thread if_mux_thread;
+    std::thread wb_mux_thread;
+    std::thread alu_thread;
+    std::thread forwarding_unit_thread;
+    std::thread immediate_generator_thread;
+    std::thread ex_mem_stage_registers_thread;
+    std::thread id_ex_stage_registers_thread;
+    std::thread if_id_stage_registers_thread;
+    std::thread mem_wb_stage_registers_thread;
+    std::thread data_memory_thread;
+    std::thread logger_thread;
+    std::thread driver_thread;
+    std::thread instruction_memory_thread;
+    std::thread register_file_thread;
+    std::thread hazard_detection_unit_thread;
+};
+
+void resetPipeline(Pipeline &pipeline);
+void pausePipeline(Pipeline &pipeline);
+void resumePipeline(Pipeline &pipeline);
+void changePipelineType(Pipeline &pipeline, const PipelineType &type);
+void killPipeline(Pipeline &pipeline);
+Pipeline initializePipeline(SimulationContext *context);
+void registerPipeline(const Pipeline &pipeline);
+ActiveThreads runPipeline(const Pipeline &pipeline);
+void printStagesState(Pipeline &pipeline);
+void changeInstructionMemoryFile(Pipeline &pipeline, const std::string &new_file_path);
+void changeDataMemoryFile(Pipeline &pipeline, const std::string &new_file_path);
+void clearOutputFiles(Pipeline &pipeline);
+
+#endif //RISC_V_SIMULATOR_PIPELINE_H
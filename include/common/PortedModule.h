@@ -0,0 +1,121 @@
+#ifndef RISC_V_SIMULATOR_PORTEDMODULE_H
+#define RISC_V_SIMULATOR_PORTEDMODULE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Module.h"
+#include "InputPort.h"
+
+/**
+ * Base of the modules whose inputs are InputPorts, Derived lists them in getInputPorts() as a std::tie of its ports.
+ * setInput<input>(value) picks the port named by input when it is compiled, so writing to an input the module does not
+ * have, or a value the port cannot hold, fails to compile instead of throwing every cycle.
+ *
+ * Each port has the readiness bit of its position in getInputPorts(), the bits from PORT_BIT_COUNT up are left to
+ * Derived for its other inputs and flags.
+ */
+template<typename Derived>
+class PortedModule: public Module {
+public:
+    using Module::Module;
+
+    template<auto input, typename T>
+    void setInput(T &&value);
+
+protected:
+    static constexpr int PORT_BIT_COUNT = 8;
+
+    template<auto input>
+    [[nodiscard]] uint32_t getInputPortBit();
+    [[nodiscard]] uint32_t getInputPortBits();
+
+    void holdInput(SignalBase &input) override;
+
+private:
+    template<auto input, typename Port>
+    static constexpr bool isInputPort();
+
+    template<auto input, typename... Ports>
+    static constexpr std::size_t getInputPortIndex(std::type_identity<std::tuple<Ports &...>>);
+};
+
+template<typename Derived>
+template<auto input, typename T>
+void PortedModule<Derived>::setInput(T &&value) {
+    auto input_ports = static_cast<Derived *>(this)->getInputPorts();
+
+    constexpr std::size_t index = getInputPortIndex<input>(std::type_identity<decltype(input_ports)>());
+    static_assert(index < std::tuple_size_v<decltype(input_ports)>, "the module has no port for this input");
+
+    std::get<index>(input_ports).set(std::forward<T>(value));
+
+    this->log("setInput value updated.");
+    this->setReadiness(this->template getInputPortBit<input>());
+}
+
+template<typename Derived>
+template<auto input>
+uint32_t PortedModule<Derived>::getInputPortBit() {
+    using InputPorts = decltype(static_cast<Derived *>(this)->getInputPorts());
+
+    constexpr std::size_t index = getInputPortIndex<input>(std::type_identity<InputPorts>());
+    static_assert(index < std::tuple_size_v<InputPorts>, "the module has no port for this input");
+
+    return 1U << index;
+}
+
+template<typename Derived>
+uint32_t PortedModule<Derived>::getInputPortBits() {
+    constexpr std::size_t port_count = std::tuple_size_v<decltype(static_cast<Derived *>(this)->getInputPorts())>;
+    static_assert(port_count <= PORT_BIT_COUNT, "the module has more ports than readiness bits reserved for them");
+
+    return (1U << port_count) - 1U;
+}
+
+template<typename Derived>
+void PortedModule<Derived>::holdInput(SignalBase &input) {
+    uint32_t held_bits = 0U;
+
+    std::apply([&input, &held_bits](auto &... ports) {
+        uint32_t port_bit = 1U;
+        ((held_bits |= &ports == &input ? port_bit : 0U, port_bit <<= 1), ...);
+    }, static_cast<Derived *>(this)->getInputPorts());
+
+    if (held_bits == 0U) {
+        throw std::runtime_error("PortedModule::holdInput: the held input is not a port of the module.");
+    }
+
+    input.hold();
+    this->setReadiness(held_bits);
+}
+
+template<typename Derived>
+template<auto input, typename Port>
+constexpr bool PortedModule<Derived>::isInputPort() {
+    if constexpr (std::is_same_v<decltype(input), std::remove_cv_t<decltype(Port::input)>>) {
+        return input == Port::input;
+    } else {
+        return false;
+    }
+}
+
+template<typename Derived>
+template<auto input, typename... Ports>
+constexpr std::size_t PortedModule<Derived>::getInputPortIndex(std::type_identity<std::tuple<Ports &...>>) {
+    constexpr bool is_input_port[] = {isInputPort<input, Ports>()...};
+
+    for (std::size_t i = 0; i < sizeof...(Ports); ++i) {
+        if (is_input_port[i]) {
+            return i;
+        }
+    }
+
+    return sizeof...(Ports);
+}
+
+#endif //RISC_V_SIMULATOR_PORTEDMODULE_H
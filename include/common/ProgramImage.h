@@ -0,0 +1,92 @@
+#ifndef RISC_V_SIMULATOR_PROGRAMIMAGE_H
+#define RISC_V_SIMULATOR_PROGRAMIMAGE_H
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class ProgramImageFormat {
+    Text = 0,  // One "01010101" line per byte, the format under input/
+    Raw,  // *.bin without a header, bytes loaded at address 0
+    Binary,  // ProgramImageHeader followed by the bytes
+    Elf  // Statically linked little endian ELF32 RISC-V executable
+};
+
+struct ProgramImageHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t base_address;  // Address the first byte is loaded at
+    uint32_t entry_program_counter;  // Only meaningful for instruction images
+    uint32_t reserved;
+};
+
+static_assert(sizeof(ProgramImageHeader) == 24, "ProgramImageHeader layout is part of the file format");
+
+struct ProgramImageSegment {
+    uint32_t address;
+    std::span<const uint8_t> bytes;
+    bool is_executable;
+};
+
+/**
+ * Read-only view of an instruction or data memory image. Binary images are mmap-ed and their bytes handed out without
+ * copying, text images are decoded once from the mapping. The mapping lives as long as the ProgramImage.
+ *
+ * Text, raw and binary images hold a single segment that serves as both instruction and data memory image. ELF images
+ * hold one segment per PT_LOAD program header, InstructionMemory loads the executable ones and DataMemory the rest.
+ * Executable segments may also carry read-only data, getCodeRanges() narrows them to the SHF_EXECINSTR sections.
+ */
+class ProgramImage {
+public:
+    static constexpr char MAGIC[8] = {'R', 'V', 'S', 'I', 'M', 'I', 'M', 'G'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr const char *RAW_IMAGE_EXTENSION = ".bin";
+
+private:
+    static constexpr int BYTE_BIT_COUNT = 8;
+    static constexpr int WORD_BYTE_COUNT = 4;
+
+    std::string file_path;
+    ProgramImageFormat format;
+
+    void *mapping;
+    unsigned long mapping_size;
+
+    std::vector<ProgramImageSegment> segments;
+    std::deque<std::vector<uint8_t>> decoded_segment_bytes;  // Backs segments that are not views of the mapping
+
+    uint32_t entry_program_counter;
+
+    std::vector<std::pair<std::string_view, uint32_t>> symbols;
+    std::vector<std::pair<uint32_t, uint32_t>> code_ranges;  // Address and size of each executable ELF section
+
+public:
+    explicit ProgramImage(const std::string &file_path);
+    ~ProgramImage();
+
+    ProgramImage(const ProgramImage &) = delete;
+    ProgramImage &operator=(const ProgramImage &) = delete;
+
+    [[nodiscard]] ProgramImageFormat getFormat() const;
+    [[nodiscard]] std::vector<ProgramImageSegment> getInstructionSegments() const;
+    [[nodiscard]] std::vector<ProgramImageSegment> getDataSegments() const;
+    [[nodiscard]] uint32_t getEntryProgramCounter() const;
+    [[nodiscard]] std::optional<uint32_t> findSymbol(std::string_view name) const;
+    [[nodiscard]] std::vector<std::pair<uint32_t, uint32_t>> getCodeRanges() const;
+
+    static ProgramImageHeader makeHeader(uint32_t base_address, uint32_t entry_program_counter);
+
+private:
+    void map();
+    void decodeText(std::span<const uint8_t> text);
+    void decodeElf(std::span<const uint8_t> file_bytes);
+    void readElfSections(std::span<const uint8_t> file_bytes, uint32_t section_header_offset,
+                         uint16_t section_header_count, uint16_t section_header_size);
+};
+
+#endif //RISC_V_SIMULATOR_PROGRAMIMAGE_H
@@ -0,0 +1,47 @@
+#ifndef RISC_V_SIMULATOR_READINESSMASK_H
+#define RISC_V_SIMULATOR_READINESSMASK_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Input bits of a module in a single atomic word. Producers set their bit after storing the value it guards, the
+ * module is ready once every required bit and no blocking bit is set, or once any forcing bit is set. set() and clear()
+ * report whether they made the module ready, so only the producer completing the inputs of a cycle wakes it.
+ *
+ * The word has a cache line of its own, producers on other threads hammer it while the module reads its values.
+ */
+class ReadinessMask {
+    alignas(64) std::atomic<uint32_t> bits;
+
+    std::atomic<uint32_t> required_bits;  // Replaced by require() between pipelines, read by every producer
+    uint32_t blocking_bits;
+    uint32_t forcing_bits;
+
+    [[nodiscard]] bool isReady(uint32_t current_bits) const;
+
+public:
+    static constexpr uint32_t KILLED = 1U << 31;
+
+    ReadinessMask();
+
+    ReadinessMask(const ReadinessMask &) = delete;
+    ReadinessMask &operator=(const ReadinessMask &) = delete;
+
+    void track(uint32_t required, uint32_t blocking, uint32_t forcing);
+    bool require(uint32_t required);
+    [[nodiscard]] bool isTracked() const;
+
+    bool set(uint32_t set_bits);
+    bool clear(uint32_t cleared_bits);
+    void keepOnly(uint32_t kept_bits);
+
+    [[nodiscard]] bool isSet(uint32_t bit) const;
+    [[nodiscard]] bool isReady() const;
+
+    void waitUntilReady() const;
+    void waitUntilSet(uint32_t bit) const;
+    void notify();
+};
+
+#endif //RISC_V_SIMULATOR_READINESSMASK_H
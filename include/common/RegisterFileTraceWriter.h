@@ -0,0 +1,60 @@
+#ifndef RISC_V_SIMULATOR_REGISTERFILETRACEWRITER_H
+#define RISC_V_SIMULATOR_REGISTERFILETRACEWRITER_H
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Config.h"
+
+/**
+ * Keeps a register file trace open across cycles and writes it through a large stream buffer.
+ *
+ * Full traces are the "State of RF after executing cycle" dumps compared against output/ExpectedResults. Delta traces
+ * only list the registers that changed since the previous record, the first record after opening lists all of them.
+ * RISC_V_RegisterFileTraceConverter expands a delta trace back into a full one.
+ */
+class RegisterFileTraceWriter {
+public:
+    static constexpr int REGISTERS_COUNT = 32;
+
+    using RegisterValues = std::array<uint32_t, REGISTERS_COUNT>;
+
+    static constexpr const char *FULL_TRACE_CYCLE_HEADER = "State of RF after executing cycle:\t";
+    static constexpr const char *DELTA_TRACE_FILE_HEADER = "RegisterFile delta trace v1";
+    static constexpr const char *DELTA_TRACE_CYCLE_HEADER = "cycle";
+
+private:
+    static constexpr unsigned long TRACE_FILE_BUFFER_SIZE = 1UL << 16;
+
+    RegisterFileTraceMode trace_mode;
+
+    std::unique_ptr<char[]> trace_file_buffer;
+    std::ofstream trace_file;
+
+    RegisterValues previous_registers;
+    bool is_previous_registers_set;
+
+public:
+    RegisterFileTraceWriter();
+    ~RegisterFileTraceWriter();
+
+    void open(const std::string &file_path, RegisterFileTraceMode mode, bool is_truncated);
+    void close();
+    void flush();
+
+    void writeCycle(unsigned long cycle, const std::vector<std::bitset<WORD_BIT_COUNT>> &registers);
+
+    static void writeFullRecord(std::ostream &output, unsigned long cycle, const RegisterValues &registers);
+
+private:
+    void writeDeltaRecord(unsigned long cycle, const RegisterValues &registers);
+};
+
+#endif //RISC_V_SIMULATOR_REGISTERFILETRACEWRITER_H
@@ -0,0 +1,97 @@
+#ifndef RISC_V_SIMULATOR_SIGNAL_H
+#define RISC_V_SIMULATOR_SIGNAL_H
+
+#include <utility>
+
+class Module;
+
+/**
+ * Type independent part of a Signal, which is all the ExecutionEngine needs to hold the inputs driven by a module it
+ * skipped in the event-driven mode.
+ */
+class SignalBase {
+protected:
+    bool is_set;
+    bool is_evaluated;
+    bool is_holdable;  // The value is the one its driver last sent, cleared by reset() and discard()
+
+    Module *owner;  // Module the signal is an input of, set once connected to a driver
+
+public:
+    SignalBase();
+
+    [[nodiscard]] bool isSet() const;
+    [[nodiscard]] bool isHoldable() const;
+
+    [[nodiscard]] Module *getOwner() const;
+    void setOwner(Module *new_owner);
+
+    // Marks the signal set again without a new value, its driver was skipped and would have sent the same one
+    void hold();
+
+    // Marks the signal set but keeps the current value, the owner dropped the value sent (a stage register under NOP)
+    void discard();
+};
+
+/**
+ * Input of a module that remembers the value the module last evaluated. set() marks the signal like the is_*_set flags
+ * do, isChanged() tells whether an evaluation would see a value different from the previous one. Guarded by the mutex
+ * of the module owning it, or ordered by the input's bit for modules tracking their readiness.
+ */
+template<typename T>
+class Signal: public SignalBase {
+    T value;
+    T evaluated_value;
+
+public:
+    explicit Signal(T initial_value = T());
+
+    void set(T new_value);
+    [[nodiscard]] const T &get() const;
+
+    [[nodiscard]] bool isChanged() const;
+
+    // Records the current value as evaluated and waits for the next set()
+    void markEvaluated();
+
+    // Also forgets the evaluated value, so the next evaluation is never skipped
+    void reset(T initial_value = T());
+};
+
+template<typename T>
+Signal<T>::Signal(T initial_value) : value(initial_value), evaluated_value(std::move(initial_value)) {}
+
+template<typename T>
+void Signal<T>::set(T new_value) {
+    this->value = std::move(new_value);
+    this->is_set = true;
+    this->is_holdable = true;
+}
+
+template<typename T>
+const T &Signal<T>::get() const {
+    return this->value;
+}
+
+template<typename T>
+bool Signal<T>::isChanged() const {
+    return !this->is_evaluated || !(this->value == this->evaluated_value);
+}
+
+template<typename T>
+void Signal<T>::markEvaluated() {
+    this->evaluated_value = this->value;
+    this->is_evaluated = true;
+    this->is_set = false;
+}
+
+template<typename T>
+void Signal<T>::reset(T initial_value) {
+    this->value = initial_value;
+    this->evaluated_value = std::move(initial_value);
+    this->is_set = false;
+    this->is_evaluated = false;
+    this->is_holdable = false;
+}
+
+#endif //RISC_V_SIMULATOR_SIGNAL_H
@@ -0,0 +1,100 @@
+#ifndef RISC_V_SIMULATOR_SIMULATIONCONTEXT_H
+#define RISC_V_SIMULATOR_SIMULATIONCONTEXT_H
+
+#include <string>
+#include <tuple>
+
+class ExecutionEngine;
+class Logger;
+class EXAdder;
+class IFAdder;
+class ALUInput1ForwardingMux;
+class ALUInput2ForwardingMux;
+class EXMuxALUInput1;
+class EXMuxALUInput2;
+class IFMux;
+class WBMux;
+class ALU;
+class ForwardingUnit;
+class ImmediateGenerator;
+class HazardDetectionUnit;
+class EXMEMStageRegisters;
+class IDEXStageRegisters;
+class IFIDStageRegisters;
+class MEMWBStageRegisters;
+class DataMemory;
+class Driver;
+class InstructionMemory;
+class RegisterFile;
+class StageSynchronizer;
+class FunctionalSimulator;
+
+/**
+ * Owns one instance of every module of a simulated core. Modules are created with the context and look their peers up
+ * through get<T>(), so any number of contexts can run independent simulations in one process.
+ *
+ * Instances are created in the order of the tuple. Constructors may only look up instances created before them
+ * (every Module takes the ExecutionEngine), the remaining peers are looked up in initDependencies(). A context can only
+ * be destroyed once no thread runs its modules anymore, which the detached module threads of the threaded mode never
+ * guarantee, so only contexts that ran cycle-driven are deleted.
+ */
+class SimulationContext {
+public:
+    static constexpr const char *DEFAULT_OUTPUT_DIRECTORY_PATH = "../output/";
+    static constexpr const char *DEFAULT_LOG_DIRECTORY_PATH = "../logs/";
+
+private:
+    std::string name;
+    std::string output_directory_path;  // RegisterFile and DataMemory output files
+    std::string log_directory_path;  // Logger stage logs
+
+    std::tuple<
+            ExecutionEngine *,
+            Logger *,
+            EXAdder *,
+            IFAdder *,
+            ALUInput1ForwardingMux *,
+            ALUInput2ForwardingMux *,
+            EXMuxALUInput1 *,
+            EXMuxALUInput2 *,
+            IFMux *,
+            WBMux *,
+            ALU *,
+            ForwardingUnit *,
+            ImmediateGenerator *,
+            HazardDetectionUnit *,
+            EXMEMStageRegisters *,
+            IDEXStageRegisters *,
+            IFIDStageRegisters *,
+            MEMWBStageRegisters *,
+            DataMemory *,
+            Driver *,
+            InstructionMemory *,
+            RegisterFile *,
+            StageSynchronizer *,
+            FunctionalSimulator *
+    > instances;
+
+public:
+    explicit SimulationContext(std::string name);
+    SimulationContext(std::string name, std::string output_directory_path, std::string log_directory_path);
+    ~SimulationContext();
+
+    SimulationContext(const SimulationContext &) = delete;
+    SimulationContext &operator=(const SimulationContext &) = delete;
+
+    // Empty for the default context, other contexts tag their log files and cycle lines with it
+    [[nodiscard]] const std::string &getName() const;
+    [[nodiscard]] const std::string &getOutputDirectoryPath() const;
+    [[nodiscard]] const std::string &getLogDirectoryPath() const;
+
+    template<typename T>
+    [[nodiscard]] T *get() const;
+};
+
+template<typename T>
+T *SimulationContext::get() const {
+    return std::get<T *>(this->instances);
+}
+
+#endif //RISC_V_SIMULATOR_SIMULATIONCONTEXT_H
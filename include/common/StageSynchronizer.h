@@ -1,17 +1,23 @@
 #ifndef RISC_V_SIMULATOR_STAGESYNCHRONIZER_H
 #define RISC_V_SIMULATOR_STAGESYNCHRONIZER_H
 
-#include <barrier>
 #include <functional>
+#include <string>
 
 #include "Config.h"
+#include "CycleBarrier.h"
 #include "../state/stage-registers/IFIDStageRegisters.h"
 #include "../state/stage-registers/IDEXStageRegisters.h"
 #include "../state/stage-registers/EXMEMStageRegisters.h"
 #include "../state/stage-registers/MEMWBStageRegisters.h"
 #include "../state/Driver.h"
+#include "../state/DataMemory.h"
 #include "../combinational/HazardDetectionUnit.h"
+#include "ExecutionEngine.h"
+#include "Logger.h"
+#include "SimulationContext.h"
 
+class Module;
 class Driver;
 class IFIDStageRegisters;
 class IDEXStageRegisters;
@@ -20,20 +26,17 @@ class MEMWBStageRegisters;
 class RegisterFile;
 class DataMemory;
 class HazardDetectionUnit;
+class ExecutionEngine;
+class Logger;
 
 class StageSynchronizer {
-    std::barrier<std::function<void()>> *single_stage_barrier;
-    std::barrier<std::function<void()>> *five_stage_barrier;
-    std::barrier<std::function<void()>> *reset_barrier;
+    CycleBarrier single_stage_barrier;
+    CycleBarrier five_stage_barrier;
+    CycleBarrier reset_barrier;
 
     PipelineType current_pipeline_type;
 
-    static constexpr int SINGLE_STAGE_THREAD_COUNT = 6;
-    static constexpr int FIVE_STAGE_THREAD_COUNT = 34;
-    static constexpr int RESET_THREAD_COUNT = 10;
-
-    static StageSynchronizer *current_instance;
-    static std::mutex initialization_mutex;
+    SimulationContext *context;
 
     Driver *driver;
     IFIDStageRegisters *if_id_stage_registers;
@@ -43,8 +46,11 @@ class StageSynchronizer {
     HazardDetectionUnit *hazard_detection_unit;
     RegisterFile *register_file;
     DataMemory *data_memory;
+    ExecutionEngine *execution_engine;
+    Logger *logger;
 
     int current_cycle;
+    std::string cycle_prefix;  // Tags the cycle lines of named contexts
     bool halt_detected;
     bool is_paused;
 
@@ -53,26 +59,55 @@ class StageSynchronizer {
     bool is_print_id_ex_state_asserted;
     bool is_print_ex_mem_state_asserted;
     bool is_print_mem_wb_state_asserted;
+    bool is_print_cycle_asserted;
 
     std::mutex module_mutex;
     std::mutex print_mutex;
 
-public:
-    StageSynchronizer();
-
-    static StageSynchronizer *init();
+    static thread_local bool is_single_stage_arrival_pending;
 
+public:
+    explicit StageSynchronizer(SimulationContext *context);
+
+    /**
+     * Modules register with the barriers of the threaded mode from their initDependencies, before the first module
+     * thread starts. A participant arrives once per reset and, when is_single_stage_participant holds, once per single
+     * stage cycle.
+     */
+    void registerParticipant(bool is_single_stage_participant);
+
+    // Every call of a five stage setter arrives at the five stage barrier, once per cycle and driver calling it
+    void connectFiveStageInput(Module *driver);
+
+    /**
+     * Called at the end of a single stage execute(). The threaded mode only records the arrival there, the module
+     * thread waits at the barrier in waitForSingleStageArrival() once it released its module mutex.
+     */
     void conditionalArriveSingleStage();
-    void conditionalArriveFiveStage();
+    void waitForSingleStageArrival();
     void arriveReset();
 
+    /**
+     * Five stage setters hand their update over instead of applying it, nop updates separately since they are applied
+     * first. In the threaded mode the setter arrives at the five stage barrier without waiting, and the last arrival
+     * hands the clock edge to the worker pool.
+     */
+    bool deferUntilClockEdge(std::function<void()> update);
+    bool deferNopUntilClockEdge(std::function<void()> update);
+    void completeCycle();
+
     void setPipelineType(PipelineType new_pipeline_type);
     PipelineType getPipelineType();
 
+    void assertPrintCycleFlag(bool is_asserted);
+    [[nodiscard]] int getCurrentCycle() const;
+
     [[nodiscard]] bool isPaused();
     void reset();
 
 private:
+    bool deferFiveStageUpdate(std::function<void()> update, bool is_nop_update);
+    void printCycle(const std::string &execution_title);
     void onCompletionSingleStage();
     void onCompletionFiveStage();
     static void onCompletionReset();
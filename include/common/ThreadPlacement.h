@@ -0,0 +1,73 @@
+#ifndef RISC_V_SIMULATOR_THREADPLACEMENT_H
+#define RISC_V_SIMULATOR_THREADPLACEMENT_H
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Config.h"
+
+/**
+ * Process wide placement of the module, worker pool and Logger writer threads. Under ThreadPlacementPolicy::Stage the
+ * CPUs the process may run on are ordered by package and core, the last ones are kept for the Logger writers and the
+ * others are split into one contiguous cluster per pipeline stage. Neighbouring stages end up on the same package as
+ * long as it has cores left, hyperthread siblings in the same cluster. Worker pool threads run signals of every stage
+ * and may use all module CPUs. Threads place themselves when they start and are dropped from the report when they exit.
+ */
+class ThreadPlacement {
+    static constexpr int STAGE_COUNT = static_cast<int>(Stage::WB) + 1;
+
+    enum class ThreadRole {
+        Module,
+        PoolWorker,
+        LoggerWriter
+    };
+
+    struct Placement {
+        std::string thread_name;
+        ThreadRole role;
+        Stage stage;  // Not used for pool workers
+        std::thread::id thread_id;
+        std::vector<int> cpus;
+        std::string error;
+    };
+
+    struct Cpu {
+        int package_id;
+        int core_id;
+        int cpu_id;
+    };
+
+    static ThreadPlacementPolicy policy;
+    static std::mutex placement_mutex;
+    static bool is_planned;
+
+    static std::array<std::vector<int>, STAGE_COUNT> stage_cpus;
+    static std::vector<int> pool_worker_cpus;
+    static std::vector<int> logger_writer_cpus;
+    // Never destroyed, detached module threads may still drop their placement while the process exits
+    static std::vector<Placement> &placements;
+
+public:
+    static void setPolicy(ThreadPlacementPolicy new_policy);
+    static ThreadPlacementPolicy getPolicy();
+
+    // Called on the thread being placed
+    static void placeModuleThread(Stage stage, const std::string &thread_name);
+    static void placePoolWorkerThread(const std::string &thread_name);
+    static void placeLoggerWriterThread(Stage stage, const std::string &thread_name);
+    static void removeCurrentThread();
+
+    static void printPlacements();
+
+private:
+    static void planPlacement();
+    static std::vector<Cpu> getAvailableCpus();
+    static int readTopologyId(int cpu_id, const std::string &name);
+
+    static void place(Placement placement);
+};
+
+#endif //RISC_V_SIMULATOR_THREADPLACEMENT_H
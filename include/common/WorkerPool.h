@@ -0,0 +1,51 @@
+#ifndef RISC_V_SIMULATOR_WORKERPOOL_H
+#define RISC_V_SIMULATOR_WORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed set of long-lived threads that run submitted tasks in FIFO order.
+ *
+ * Tasks must not wait for other tasks. A setter only waits for the mutex of the module it drives, which the module
+ * thread holds for one execute() and never while it waits at a barrier or for pool work. Any worker count makes
+ * progress, the count only bounds how many signals are delivered in parallel.
+ *
+ * Workers place themselves through ThreadPlacement when they start and drop their placement when they exit.
+ */
+class WorkerPool {
+    std::vector<std::thread> workers;
+    std::string thread_name;
+
+    std::queue<std::function<void()>> tasks;
+    std::mutex tasks_mutex;
+    std::condition_variable tasks_condition_variable;
+
+    bool is_stopped;
+
+    std::atomic<unsigned long> executed_tasks_count;
+
+public:
+    WorkerPool(int worker_count, std::string thread_name);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    void submit(std::function<void()> task);
+
+    [[nodiscard]] unsigned long getExecutedTasksCount() const;
+    [[nodiscard]] unsigned long getQueueDepth();
+    [[nodiscard]] int getWorkerCount() const;
+
+private:
+    void work(int worker_index);
+};
+
+#endif //RISC_V_SIMULATOR_WORKERPOOL_H
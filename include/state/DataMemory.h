@@ -1,13 +1,19 @@
 #ifndef RISC_V_SIMULATOR_DATAMEMORY_H
 #define RISC_V_SIMULATOR_DATAMEMORY_H
 
+#include <algorithm>
 #include <bitset>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <memory>
 
 #include "../common/Module.h"
+#include "../common/Signal.h"
+#include "../common/PagedMemory.h"
+#include "../common/ProgramImage.h"
 #include "../common/Logger.h"
 #include "../common/StageSynchronizer.h"
 #include "../state/stage-registers/MEMWBStageRegisters.h"
@@ -15,45 +21,66 @@
 class MEMWBStageRegisters;
 class StageSynchronizer;
 class Logger;
+class FunctionalSimulator;
 
 class DataMemory: public Module {
+public:
+    static constexpr unsigned long DEFAULT_DATA_MEMORY_SIZE = 1000;  // Bytes, grown to fit the input file
+
+private:
     static constexpr int WORD_BIT_COUNT = 32;
+    static constexpr int WORD_BYTE_COUNT = 4;
+    static constexpr int BYTE_BIT_COUNT = 8;
+
+    // Big endian as in the input file: the byte at a word's address holds its most significant bits
+    std::vector<uint8_t> data_memory;
+    unsigned long data_memory_size;
+
+    DataMemoryModel data_memory_model;
+    PagedMemory paged_data_memory;
+
+    // Stays mapped after the input file was read, every reset loads the memory from it instead of reading the file
+    std::unique_ptr<ProgramImage> data_memory_image;
 
-    std::vector<std::string> data_memory;
+    // Contents handed over by a fast-forward, loaded on resets in place of the image
+    std::vector<uint8_t> kept_data_memory;
+    PagedMemory kept_paged_data_memory;
+    bool is_data_memory_kept;
+
+    unsigned long out_of_bounds_access_count;
 
     std::string data_memory_file_path;
 
-    unsigned long address;
+    Signal<unsigned long> address;
 
-    std::bitset<WORD_BIT_COUNT> write_data;
+    Signal<std::bitset<WORD_BIT_COUNT>> write_data;
     std::bitset<WORD_BIT_COUNT> read_data;
 
-    bool is_mem_write_asserted;
-    bool is_mem_read_asserted;
+    Signal<bool> mem_write_signal;
+    Signal<bool> mem_read_signal;
 
-    bool is_address_set;
-    bool is_write_data_set;
-    bool is_mem_write_flag_set;
-    bool is_mem_read_flag_set;
-    bool is_input_file_read;
-    bool is_reset_flag_set;
+    static constexpr uint32_t ADDRESS_SET = 1U << 0;
+    static constexpr uint32_t WRITE_DATA_SET = 1U << 1;
+    static constexpr uint32_t MEM_WRITE_SIGNAL_SET = 1U << 2;
+    static constexpr uint32_t MEM_READ_SIGNAL_SET = 1U << 3;
+    static constexpr uint32_t INPUT_FILE_READ = 1U << 4;  // Set once the file was read or the memory reset
+    static constexpr uint32_t RESET_FLAG_SET = 1U << 5;
 
-    static DataMemory *current_instance;
-    static std::mutex initialization_mutex;
+    static constexpr uint32_t INPUT_BITS = ADDRESS_SET | WRITE_DATA_SET | MEM_WRITE_SIGNAL_SET | MEM_READ_SIGNAL_SET;
 
     MEMWBStageRegisters *mem_wb_stage_registers;
     StageSynchronizer *stage_synchronizer;
 
     std::string output_file_path;
 
-public:
-    DataMemory();
-
-    static DataMemory *init();
+    friend FunctionalSimulator;
 
-    void run() override;
+public:
+    explicit DataMemory(SimulationContext *context);
 
     void setDataMemoryInputFilePath(const std::string &file_path);
+    void setDataMemorySize(unsigned long size);
+    void setDataMemoryModel(DataMemoryModel model);
 
     void setAddress(unsigned long value);
     void setWriteData(std::bitset<WORD_BIT_COUNT> value);
@@ -64,13 +91,27 @@ public:
     void writeDataMemoryContentsToOutput();
     void clearDataMemoryOutputFile();
 
+    [[nodiscard]] unsigned long getOutOfBoundsAccessCount();
+    [[nodiscard]] DataMemoryModel getDataMemoryModel();
+    [[nodiscard]] unsigned long getResidentPageCount();
+
 private:
     void readDataMemoryFile();
+    void restoreInitialDataMemory();
+    void loadDataMemoryImage();
+    void keepDataMemoryContentsAcrossResets();
+    void writeFlatDataMemoryContents(std::ofstream &output_file);
+    void writePagedDataMemoryContents(std::ofstream &output_file);
     void writeData();
     void readData();
+    std::bitset<WORD_BIT_COUNT> loadWord(unsigned long word_address);
+    void storeWord(unsigned long word_address, std::bitset<WORD_BIT_COUNT> word);
+    void recordOutOfBoundsAccess();
     void passReadData(std::bitset<WORD_BIT_COUNT> data);
     void resetState();
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
 
     std::string getModuleTag() override;
     Stage getModuleStage() override;
@@ -1,10 +1,14 @@
 #ifndef RISC_V_SIMULATOR_DRIVER_H
 #define RISC_V_SIMULATOR_DRIVER_H
 
+#include <atomic>
+#include <cstdint>
+
 #include "InstructionMemory.h"
 #include "stage-registers/IFIDStageRegisters.h"
 #include "../combinational/adder/IFAdder.h"
 #include "../common/Module.h"
+#include "../common/Signal.h"
 #include "../common/Logger.h"
 #include "../common/StageSynchronizer.h"
 
@@ -14,13 +18,14 @@ class IFAdder;
 class StageSynchronizer;
 
 class Driver: public Module {
-    unsigned long program_counter;
-    bool is_new_program_counter_set;
+    Signal<unsigned long> program_counter;
+    unsigned long entry_program_counter;
 
-    bool is_nop_asserted;
-    bool is_reset_flag_set;
-    bool is_pause_flag_set;
-    bool is_nop_flag_set;
+    static constexpr uint32_t PROGRAM_COUNTER_SET = 1U << 0;
+    static constexpr uint32_t NOP_FLAG_SET = 1U << 1;
+    static constexpr uint32_t NOP_ASSERTED = 1U << 2;
+    static constexpr uint32_t PAUSE_FLAG_SET = 1U << 3;
+    static constexpr uint32_t RESET_FLAG_SET = 1U << 4;
 
     bool is_verbose_execution_flag_asserted;
 
@@ -29,19 +34,14 @@ class Driver: public Module {
     IFAdder *if_adder;
     StageSynchronizer *stage_synchronizer;
 
-    static Driver *current_instance;
-    static std::mutex initialization_mutex;
-
     static constexpr int REQUIRED_NOP_FLAG_SET_OPERATIONS = 2;
-    int current_nop_set_operations;
+    std::atomic<int> current_nop_set_operations;
 
 public:
-    Driver();
+    explicit Driver(SimulationContext *context);
     void setProgramCounter(unsigned long value);
+    void setEntryProgramCounter(unsigned long value);
 
-    static Driver *init();
-
-    void run() override;
     void setNop(bool is_asserted);
     void assertSystemEnabledNop();
     void reset();
@@ -59,13 +59,18 @@ private:
 
     void resetStage();
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
+
+    void markInputsEvaluated() override;
+    void holdInput(SignalBase &input) override;
 
     void delayUpdateUntilNopFlagSet();
 
     std::string getModuleTag() override;
     Stage getModuleStage() override;
 
-    void printState() const;
+    void printState();
 };
 
 #endif //RISC_V_SIMULATOR_DRIVER_H
@@ -1,56 +1,106 @@
 #ifndef RISC_V_SIMULATOR_INSTRUCTIONMEMORY_H
 #define RISC_V_SIMULATOR_INSTRUCTIONMEMORY_H
 
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <optional>
+#include <span>
 #include <vector>
 #include <string>
 #include <stdexcept>
 #include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
 
 #include "stage-registers/IFIDStageRegisters.h"
 #include "../common/Module.h"
+#include "../common/Signal.h"
 #include "../common/Logger.h"
 #include "../state/Driver.h"
+#include "../common/Instruction.h"
+#include "../common/Control.h"
+#include "../common/ProgramImage.h"
 
 class IFIDStageRegisters;
 class Logger;
 class IFIDStageRegisters;
 class Driver;
+class Instruction;
+class Control;
+class FunctionalSimulator;
 
 class InstructionMemory: public Module {
+public:
+    static constexpr uint32_t HALT_INSTRUCTION = 0xFFFFFFFF;
+
+private:
     std::string instruction_memory_file_path;
-    bool is_instruction_file_read;
 
-    std::vector<std::string> data;
+    static constexpr uint32_t PROGRAM_COUNTER_SET = 1U << 0;
+    static constexpr uint32_t INSTRUCTION_FILE_READ = 1U << 1;
+
+    // Points into the mapped image, or into writable_data once the segments had to be joined or a word patched
+    std::unique_ptr<ProgramImage> instruction_memory_image;
+    std::span<const uint8_t> data;
+    std::vector<uint8_t> writable_data;
+    unsigned long base_address;  // Address of data[0]
+    unsigned long entry_program_counter;
+
+    // Rewritten to HALT_INSTRUCTION on load, for programs that were not assembled for the simulator
+    std::string halt_symbol;
+    std::optional<uint32_t> halt_instruction;
 
-    unsigned long program_counter;
-    bool is_new_program_counter_set;
+    Signal<unsigned long> program_counter;
 
-    std::string instruction;
+    DecodedInstruction decoded_instruction;
+
+    // Program counter to decoded instruction, filled on first fetch and dropped whenever the program changes
+    std::unordered_map<unsigned long, DecodedInstruction> decoded_instruction_cache;
+    PipelineType decoded_instruction_cache_pipeline_type;
+    unsigned long decoded_instruction_cache_hit_count;
+    unsigned long decoded_instruction_cache_miss_count;
+
+    // Owners of the cached objects. The cache is only invalidated on a program or pipeline type change, after the
+    // stage registers were reset to the zero instruction, so nothing points at the freed objects
+    std::vector<std::unique_ptr<const Instruction>> decoded_instructions;
+    std::vector<std::unique_ptr<const Control>> decoded_controls;
 
     IFIDStageRegisters *if_id_stage_registers;
     Driver *driver;
 
-    static InstructionMemory *current_instance;
-    static std::mutex initialization_mutex;
+    friend FunctionalSimulator;
 
 public:
-    InstructionMemory();
-
-    static InstructionMemory *init();
-
-    void run() override;
+    explicit InstructionMemory(SimulationContext *context);
 
     void setInstructionMemoryInputFilePath(const std::string &file_path);
     void setProgramCounter(unsigned long value);
+    void setHaltSymbol(const std::string &symbol);
+    void setHaltInstruction(uint32_t instruction);
+
+    [[nodiscard]] unsigned long getEntryProgramCounter();
+    [[nodiscard]] unsigned long getDecodedInstructionCacheHitCount();
+    [[nodiscard]] unsigned long getDecodedInstructionCacheMissCount();
 
 private:
     void fetchInstructionFromMemory();
     void readInstructionMemoryFile();
+    void patchHaltInstructions(const ProgramImage &image);
+    void rejectUnsupportedInstructions(const ProgramImage &image) const;
+    [[nodiscard]] uint32_t readWord(unsigned long byte_index) const;
+    void writeWord(unsigned long byte_index, uint32_t word);
+    void makeDataWritable();
+    void invalidateDecodedInstructionCache();
 
     void passInstructionIntoIFIDStageRegisters();
     void passNopToDriver(bool is_asserted);
 
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
 
     std::string getModuleTag() override;
     Stage getModuleStage() override;
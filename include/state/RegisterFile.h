@@ -1,12 +1,16 @@
 #ifndef RISC_V_SIMULATOR_REGISTERFILE_H
 #define RISC_V_SIMULATOR_REGISTERFILE_H
 
+#include <cstdint>
 #include <vector>
 #include <bitset>
 #include <string>
 #include <iostream>
+#include <optional>
 
 #include "../common/Module.h"
+#include "../common/Signal.h"
+#include "../common/RegisterFileTraceWriter.h"
 #include "../common/Logger.h"
 #include "../common/StageSynchronizer.h"
 #include "../state/stage-registers/IDEXStageRegisters.h"
@@ -14,30 +18,32 @@
 class IDEXStageRegisters;
 class Logger;
 class StageSynchronizer;
+class FunctionalSimulator;
 
 class RegisterFile: public Module {
     static constexpr int REGISTERS_COUNT = 32;
 
-    static RegisterFile *current_instance;
-    static std::mutex initialization_mutex;
-
     std::vector<std::bitset<WORD_BIT_COUNT>> registers;
+    std::vector<std::bitset<WORD_BIT_COUNT>> initial_registers;  // Restored on every reset, all zero unless fast-forwarded
+
+    Signal<unsigned long> register_source1;  // corresponds to the RISC-V rs1 register
+    Signal<std::optional<unsigned long>> register_source2;  // rs2, empty for instructions reading a single register
+
+    Signal<unsigned long> register_destination;  // corresponds to the RISC-V rd register
+    Signal<std::bitset<WORD_BIT_COUNT>> write_data;  // data to be written to rd
 
-    unsigned long register_source2;  // corresponds to the RISC-V rs2 register
-    unsigned long register_source1;  // corresponds to the RISC-V rs1 register
+    Signal<bool> reg_write_signal;
 
-    unsigned long register_destination;  // corresponds to the RISC-V rd register
-    std::bitset<WORD_BIT_COUNT> write_data;  // data to be written to rd
+    bool is_awaiting_write_items;  // Single stage: read data passed on, write back still pending for this cycle
 
-    bool is_reg_write_signal_asserted;
+    static constexpr uint32_t REGISTER_SOURCE_SET = 1U << 0;
+    static constexpr uint32_t REGISTER_DESTINATION_SET = 1U << 1;
+    static constexpr uint32_t WRITE_DATA_SET = 1U << 2;
+    static constexpr uint32_t REG_WRITE_SIGNAL_SET = 1U << 3;
+    static constexpr uint32_t PAUSE_FLAG_SET = 1U << 4;
+    static constexpr uint32_t RESET_FLAG_SET = 1U << 5;
 
-    bool is_single_read_register_set;
-    bool is_double_read_register_set;
-    bool is_write_register_set;
-    bool is_reg_write_signal_set;
-    bool is_write_data_set;
-    bool is_reset_flag_set;
-    bool is_pause_flag_set;
+    static constexpr uint32_t WRITE_ITEM_BITS = REGISTER_DESTINATION_SET | WRITE_DATA_SET | REG_WRITE_SIGNAL_SET;
 
     int cycle_count;
 
@@ -46,12 +52,14 @@ class RegisterFile: public Module {
 
     std::string output_file_path;
 
-public:
-    RegisterFile();
+    RegisterFileTraceMode trace_mode;
+    RegisterFileTraceWriter trace_writer;
+    PipelineType trace_pipeline_type;  // Pipeline type of the file trace_writer currently appends to
 
-    static RegisterFile *init();
+    friend FunctionalSimulator;
 
-    void run() override;
+public:
+    explicit RegisterFile(SimulationContext *context);
 
     void setReadRegister(unsigned long rs1);
     void setReadRegisters(unsigned long rs1, unsigned long rs2);
@@ -61,21 +69,35 @@ public:
 
     void setRegWriteSignal(bool is_asserted);
 
+    void setPipelineType(PipelineType current_type) override;
+
     void reset();
     void pause();
     void resume();
 
     void writeRegisterFileContentsToOutputFile();
     void clearRegisterFileOutputFile();
+    void flushRegisterFileOutputFile();
+
+    void setTraceMode(RegisterFileTraceMode mode);
 
 private:
+    void openRegisterFileOutputFile(PipelineType pipeline_type, bool is_truncated);
+
     void passReadRegisterDataToIDEXStageRegister();
     void writeDataToRegisterFile();
     void resetRegisterFileContents();
+    void keepRegisterFileContentsAcrossResets();
+
+    uint32_t getRequiredBits();
 
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
     void resetState();
 
+    void holdInput(SignalBase &input) override;
+
     std::string getModuleTag() override;
     Stage getModuleStage() override;
 };
@@ -1,7 +1,11 @@
 #ifndef RISC_V_SIMULATOR_EXMEMSTAGEREGISTERS_H
 #define RISC_V_SIMULATOR_EXMEMSTAGEREGISTERS_H
 
+#include <atomic>
+#include <cstdint>
+
 #include "../../common/Module.h"
+#include "../../common/Signal.h"
 #include "../../common/Control.h"
 #include "../../common/Logger.h"
 #include "../../combinational/mux/IFMux.h"
@@ -23,30 +27,35 @@ class ALUInput2ForwardingMux;
 class ForwardingUnit;
 
 class EXMEMStageRegisters: public Module {
-    unsigned long branch_program_counter;
-    unsigned long register_destination;
-
-    std::bitset<WORD_BIT_COUNT> alu_result;
-    std::bitset<WORD_BIT_COUNT> read_data_2;
-
-    bool is_alu_result_zero;
-
-    bool is_branch_program_counter_set;
-    bool is_alu_result_set;
-    bool is_read_data_2_set;
-    bool is_register_destination_set;
-    bool is_alu_result_zero_flag_set;
-    bool is_control_set;
-    bool is_nop_asserted;
-    bool is_nop_passed_flag_asserted;
-    bool is_reset_flag_set;
-    bool is_pause_flag_set;
-    bool is_nop_passed_flag_set;
-    bool is_nop_flag_set;
+    Signal<unsigned long> branch_program_counter;
+    Signal<unsigned long> register_destination;
+
+    Signal<std::bitset<WORD_BIT_COUNT>> alu_result;
+    Signal<std::bitset<WORD_BIT_COUNT>> read_data_2;
+
+    Signal<bool> alu_result_zero_flag;
+    Signal<Control> control;
+    Signal<bool> nop_passed_flag;
+
+    static constexpr uint32_t BRANCH_PROGRAM_COUNTER_SET = 1U << 0;
+    static constexpr uint32_t ALU_RESULT_SET = 1U << 1;
+    static constexpr uint32_t ALU_RESULT_ZERO_FLAG_SET = 1U << 2;
+    static constexpr uint32_t READ_DATA_2_SET = 1U << 3;
+    static constexpr uint32_t REGISTER_DESTINATION_SET = 1U << 4;
+    static constexpr uint32_t CONTROL_SET = 1U << 5;
+    static constexpr uint32_t NOP_PASSED_FLAG_SET = 1U << 6;
+    static constexpr uint32_t NOP_FLAG_SET = 1U << 7;
+    static constexpr uint32_t NOP_ASSERTED = 1U << 8;
+    static constexpr uint32_t PAUSE_FLAG_SET = 1U << 9;
+    static constexpr uint32_t RESET_FLAG_SET = 1U << 10;
+
+    static constexpr uint32_t INPUT_BITS = BRANCH_PROGRAM_COUNTER_SET | ALU_RESULT_SET | ALU_RESULT_ZERO_FLAG_SET |
+                                           READ_DATA_2_SET | REGISTER_DESTINATION_SET | CONTROL_SET |
+                                           NOP_PASSED_FLAG_SET;
+    static constexpr uint32_t REQUIRED_BITS = INPUT_BITS | NOP_FLAG_SET;
 
     bool is_verbose_execution_flag_asserted;
 
-    Control *control;
     DataMemory *data_memory;
     MEMWBStageRegisters *mem_wb_stage_registers;
     IFMux *if_mux;
@@ -55,25 +64,20 @@ class EXMEMStageRegisters: public Module {
     ALUInput2ForwardingMux *alu_input_2_forwarding_mux;
     ForwardingUnit *forwarding_unit;
 
-    static EXMEMStageRegisters *current_instance;
-    static std::mutex initialization_mutex;
-
     static constexpr int REQUIRED_NOP_FLAG_SET_OPERATIONS = 2;
-    int current_nop_set_operations;
+    std::atomic<int> current_nop_set_operations;
 
 public:
-    EXMEMStageRegisters();
+    explicit EXMEMStageRegisters(SimulationContext *context);
 
-    static EXMEMStageRegisters *init();
 
-    void run() override;
 
     void setBranchedProgramCounter(unsigned long value);
     void setALUResult(std::bitset<WORD_BIT_COUNT> value);
     void setIsResultZeroFlag(bool asserted);
     void setReadData2(std::bitset<WORD_BIT_COUNT> value);
     void setRegisterDestination(unsigned long value);
-    void setControl(Control *new_control);
+    void setControl(const Control &new_control);
 
     void assertSystemEnabledNop();  // Nop set by system
     void reset();
@@ -95,17 +99,22 @@ private:
     void passRegisterDestinationToForwardingUnit(unsigned long rd);
     void passRegWriteToForwardingUnit(bool is_signal_asserted);
     void passBranchedAddressToIFMux(unsigned long branched_address);
-    void passControlToMEMWBStageRegisters(Control *control);
+    void passControlToMEMWBStageRegisters(const Control &control);
     void passNopToMEMWBStageRegisters(bool is_signal_asserted);
     void delayUpdateUntilNopFlagSet();
 
     void resetStage();
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
+
+    void markInputsEvaluated() override;
+    void holdInput(SignalBase &input) override;
 
     std::string getModuleTag() override;
     Stage getModuleStage() override;
 
-    void printState();
+    void printState(Control &current_control);
 };
 
 #endif //RISC_V_SIMULATOR_EXMEMSTAGEREGISTERS_H
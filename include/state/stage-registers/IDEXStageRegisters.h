@@ -2,6 +2,7 @@
 #define RISC_V_SIMULATOR_IDEXSTAGEREGISTERS_H
 
 #include "../../common/Module.h"
+#include "../../common/Signal.h"
 #include "../../common/Instruction.h"
 #include "../../common/Control.h"
 #include "../../combinational/adder/EXAdder.h"
@@ -14,7 +15,9 @@
 #include "../../combinational/ForwardingUnit.h"
 #include "../../combinational/HazardDetectionUnit.h"
 
+#include <atomic>
 #include <bitset>
+#include <cstdint>
 
 class Control;
 class Instruction;
@@ -28,36 +31,42 @@ class Logger;
 class HazardDetectionUnit;
 
 class IDEXStageRegisters: public Module {
-    Control *control;
-    Instruction *instruction;
-
-    std::bitset<WORD_BIT_COUNT> read_data_1;
-    std::bitset<WORD_BIT_COUNT> read_data_2;
-    std::bitset<WORD_BIT_COUNT> immediate;
-
-    unsigned long register_source1;
-    unsigned long register_source2;
-    unsigned long register_destination;
-    unsigned long program_counter;
-
-    static IDEXStageRegisters *current_instance;
-    static std::mutex initialization_mutex;
-
-    bool is_single_read_register_data_set;
-    bool is_double_read_register_data_set;
-    bool is_immediate_set;
-    bool is_register_destination_set;
-    bool is_register_source1_set;
-    bool is_register_source2_set;
-    bool is_program_counter_set;
-    bool is_control_set;
-    bool is_instruction_set;
-    bool is_nop_passed_flag_set;
-    bool is_nop_asserted;
-    bool is_reset_flag_set;
-    bool is_pause_flag_set;
-    bool is_nop_flag_set;
-    bool is_nop_passed_flag_asserted;
+    // Values are grouped by the module setting them, each group on a cache line of its own
+    alignas(64) Signal<Control> control;
+
+    alignas(64) Signal<std::bitset<WORD_BIT_COUNT>> read_data_1;
+    Signal<std::bitset<WORD_BIT_COUNT>> read_data_2;
+
+    alignas(64) Signal<std::bitset<WORD_BIT_COUNT>> immediate;
+
+    alignas(64) Signal<const Instruction *> instruction;
+    Signal<unsigned long> register_source1;
+    Signal<unsigned long> register_source2;
+    Signal<unsigned long> register_destination;
+    Signal<unsigned long> program_counter;
+
+    // Bits of the readiness mask, the setters store their value before they set its bit. The mask decides readiness,
+    // the is_set flag of the values is not read.
+    static constexpr uint32_t REGISTER_DATA_SET = 1U << 0;
+    static constexpr uint32_t SINGLE_READ_REGISTER_DATA = 1U << 1;
+    static constexpr uint32_t IMMEDIATE_SET = 1U << 2;
+    static constexpr uint32_t REGISTER_DESTINATION_SET = 1U << 3;
+    static constexpr uint32_t REGISTER_SOURCE1_SET = 1U << 4;
+    static constexpr uint32_t REGISTER_SOURCE2_SET = 1U << 5;
+    static constexpr uint32_t PROGRAM_COUNTER_SET = 1U << 6;
+    static constexpr uint32_t CONTROL_SET = 1U << 7;
+    static constexpr uint32_t INSTRUCTION_SET = 1U << 8;
+    static constexpr uint32_t NOP_PASSED_FLAG_SET = 1U << 9;
+    static constexpr uint32_t NOP_FLAG_SET = 1U << 10;
+    static constexpr uint32_t NOP_ASSERTED = 1U << 11;
+    static constexpr uint32_t NOP_PASSED_FLAG_ASSERTED = 1U << 12;
+    static constexpr uint32_t PAUSE_FLAG_SET = 1U << 13;
+    static constexpr uint32_t RESET_FLAG_SET = 1U << 14;
+
+    static constexpr uint32_t INPUT_BITS = REGISTER_DATA_SET | SINGLE_READ_REGISTER_DATA | IMMEDIATE_SET |
+                                           REGISTER_DESTINATION_SET | REGISTER_SOURCE1_SET | REGISTER_SOURCE2_SET |
+                                           PROGRAM_COUNTER_SET | CONTROL_SET | INSTRUCTION_SET | NOP_PASSED_FLAG_SET;
+    static constexpr uint32_t REQUIRED_BITS = (INPUT_BITS & ~SINGLE_READ_REGISTER_DATA) | NOP_FLAG_SET;
 
     bool is_verbose_execution_flag_asserted;
 
@@ -70,24 +79,22 @@ class IDEXStageRegisters: public Module {
     HazardDetectionUnit *hazard_detection_unit;
 
     static constexpr int REQUIRED_NOP_FLAG_SET_OPERATIONS = 3;
-    int current_nop_set_operations;
+    alignas(64) std::atomic<int> current_nop_set_operations;
 
 public:
-    IDEXStageRegisters();
+    explicit IDEXStageRegisters(SimulationContext *context);
 
-    static IDEXStageRegisters *init();
 
-    void run() override;
 
     void setRegisterData(std::bitset<WORD_BIT_COUNT> reg_data);
     void setRegisterData(std::bitset<WORD_BIT_COUNT> reg_data1, std::bitset<WORD_BIT_COUNT> reg_data2);
     void setImmediate(std::bitset<WORD_BIT_COUNT> imm);
     void setRegisterDestination(unsigned long rd);
     void setProgramCounter(unsigned long pc);
-    void setControlModule(Control *new_control);
+    void setControlModule(const Control &new_control);
     void setRegisterSource1(unsigned long rs1);
     void setRegisterSource2(unsigned long rs2);
-    void setInstruction(Instruction *current_instruction);
+    void setInstruction(const Instruction *current_instruction);
     void setPassedNop(bool is_asserted);  // Pass Nop by previous stages
     void setNop(bool is_asserted);  // Nop set by operations
     void assertSystemEnabledNop(); // assert Nop by system
@@ -108,7 +115,7 @@ private:
     void passImmediateToEXAdder(std::bitset<WORD_BIT_COUNT> imm);
     void passRegisterDestinationToEXMEMStageRegisters(unsigned long rd);
     void passReadData2ToEXMEMStageRegisters(std::bitset<WORD_BIT_COUNT> data);
-    void passControlToEXMEMStageRegisters(Control *current_control);
+    void passControlToEXMEMStageRegisters(const Control &current_control);
     void passRegisterSourceToForwardingUnit(bool single_register_used, unsigned long rs1, unsigned long rs2);
     void passNopToEXMEMStageRegisters(bool is_signal_asserted);
     void passMemReadToHazardDetectionUnit(bool is_signal_asserted);
@@ -116,13 +123,18 @@ private:
 
     void resetStage();
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
+
+    void markInputsEvaluated() override;
+    void holdInput(SignalBase &input) override;
 
     void delayUpdateUntilNopFlagSet();
 
     std::string getModuleTag() override;
     Stage getModuleStage() override;
 
-    void printState();
+    void printState(Control &current_control);
 };
 
 #endif //RISC_V_SIMULATOR_IDEXSTAGEREGISTERS_H
@@ -1,8 +1,13 @@
 #ifndef RISC_V_SIMULATOR_IFIDSTAGEREGISTERS_H
 #define RISC_V_SIMULATOR_IFIDSTAGEREGISTERS_H
 
+#include <atomic>
+#include <cstdint>
+#include <variant>
+
 #include "../../common/Config.h"
 #include "../../common/Module.h"
+#include "../../common/Signal.h"
 #include "../../common/Logger.h"
 #include "../../state/stage-registers/IDEXStageRegisters.h"
 #include "../../common/Instruction.h"
@@ -27,12 +32,13 @@ class HazardDetectionUnit;
 class IFIDStageRegisters: public Module {
     static constexpr int WORD_BIT_COUNT = 32;
 
-    unsigned long program_counter;
-
-    std::string instruction_bits;
+    Signal<unsigned long> program_counter;
+    Signal<DecodedInstruction> fetched_instruction;
+    Signal<bool> nop_passed_flag;
 
-    Instruction *instruction;
-    Control *control;
+    const Instruction *instruction;
+    Control control;
+    Control reset_control;  // Decoded control of the zero instruction, fetched until the first instruction arrives
 
     IDEXStageRegisters *id_ex_stage_registers;
     RegisterFile *register_file;
@@ -40,33 +46,26 @@ class IFIDStageRegisters: public Module {
     StageSynchronizer *stage_synchronizer;
     HazardDetectionUnit *hazard_detection_unit;
 
-    bool is_program_counter_set;
-    bool is_instruction_set;
-    bool is_nop_flag_set;
+    static constexpr uint32_t PROGRAM_COUNTER_SET = 1U << 0;
+    static constexpr uint32_t INSTRUCTION_SET = 1U << 1;
+    static constexpr uint32_t NOP_PASSED_FLAG_SET = 1U << 2;
+    static constexpr uint32_t NOP_FLAG_SET = 1U << 3;
+    static constexpr uint32_t NOP_ASSERTED = 1U << 4;
+    static constexpr uint32_t PAUSE_FLAG_SET = 1U << 5;
+    static constexpr uint32_t RESET_FLAG_SET = 1U << 6;
 
-    bool is_nop_passed_flag_asserted;
-    bool is_nop_passed_flag_set;
-
-    bool is_nop_asserted;
-    bool is_reset_flag_set;
-    bool is_pause_flag_set;
+    static constexpr uint32_t INPUT_BITS = PROGRAM_COUNTER_SET | INSTRUCTION_SET | NOP_PASSED_FLAG_SET;
+    static constexpr uint32_t REQUIRED_BITS = INPUT_BITS | NOP_FLAG_SET;
 
     bool is_verbose_execution_flag_asserted;
 
-    static IFIDStageRegisters *current_instance;
-    static std::mutex initialization_mutex;
-
     static constexpr int REQUIRED_NOP_FLAG_SET_OPERATIONS = 2;
-    int current_nop_set_operations;
+    std::atomic<int> current_nop_set_operations;
 
 public:
-    IFIDStageRegisters();
+    explicit IFIDStageRegisters(SimulationContext *context);
 
-    static IFIDStageRegisters *init();
-
-    void run() override;
-
-    void setInput(std::variant<unsigned long, std::string> input);
+    void setInput(std::variant<unsigned long, DecodedInstruction> input);
     void assertSystemEnabledNop();  // System asserted NOP
     void setNop(bool is_asserted);
     void setPassedNop(bool is_asserted);  // NOP passed from previous stage
@@ -80,18 +79,22 @@ public:
 
 private:
     void passProgramCounterToIDEXStageRegisters(unsigned long pc);
-    void passControlToIDEXStageRegisters(Control *new_control);
-    void passReadRegistersToRegisterFile(Instruction *current_instruction);
-    void passInstructionToImmediateGenerator(Instruction *current_instruction);
-    void passRegisterDestinationToIDEXStageRegisters(Instruction *instruction);
-    void passRegisterSource1ToIDEXStageRegisters(Instruction *instruction);
-    void passRegisterSource2ToIDEXStageRegisters(Instruction *instruction);
-    void passInstructionToIDEXStageRegisters(Instruction *instruction);
+    void passControlToIDEXStageRegisters(const Control &new_control);
+    void passReadRegistersToRegisterFile(const Instruction *current_instruction);
+    void passInstructionToImmediateGenerator(const Instruction *current_instruction);
+    void passRegisterDestinationToIDEXStageRegisters(const Instruction *instruction);
+    void passRegisterSource1ToIDEXStageRegisters(const Instruction *instruction);
+    void passRegisterSource2ToIDEXStageRegisters(const Instruction *instruction);
+    void passInstructionToIDEXStageRegisters(const Instruction *instruction);
     void passNopToIDEXStageRegisters(bool is_asserted);
-    void passInstructionToHazardDetectionUnit(Instruction *next_instruction);
+    void passInstructionToHazardDetectionUnit(const Instruction *next_instruction);
 
     void resetStage();
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
+
+    void markInputsEvaluated() override;
 
     void delayUpdateUntilNopFlagSet();
 
@@ -1,7 +1,10 @@
 #ifndef RISC_V_SIMULATOR_MEMWBSTAGEREGISTERS_H
 #define RISC_V_SIMULATOR_MEMWBSTAGEREGISTERS_H
 
+#include <cstdint>
+
 #include "../../common/Module.h"
+#include "../../common/Signal.h"
 #include "../../common/Control.h"
 #include "../../common/Logger.h"
 #include "../../state/RegisterFile.h"
@@ -17,26 +20,26 @@ class ForwardingUnit;
 class Logger;
 
 class MEMWBStageRegisters: public Module {
-    std::bitset<WORD_BIT_COUNT> read_data;
-    std::bitset<WORD_BIT_COUNT> alu_result;
-    unsigned long register_destination;
-
-    bool is_read_data_set;
-    bool is_alu_result_set;
-    bool is_register_destination_set;
-    bool is_control_set;
-    bool is_reset_flag_set;
-    bool is_pause_flag_set;
-    bool is_nop_asserted;
-    bool is_nop_passed_flag_set;
-    bool is_nop_passed_flag_asserted;
+    Signal<std::bitset<WORD_BIT_COUNT>> read_data;
+    Signal<std::bitset<WORD_BIT_COUNT>> alu_result;
+    Signal<unsigned long> register_destination;
 
-    bool is_verbose_execution_flag_asserted;
+    Signal<Control> control;
+    Signal<bool> nop_passed_flag;
 
-    static MEMWBStageRegisters *current_instance;
-    static std::mutex initialization_mutex;
+    static constexpr uint32_t READ_DATA_SET = 1U << 0;
+    static constexpr uint32_t ALU_RESULT_SET = 1U << 1;
+    static constexpr uint32_t REGISTER_DESTINATION_SET = 1U << 2;
+    static constexpr uint32_t CONTROL_SET = 1U << 3;
+    static constexpr uint32_t NOP_PASSED_FLAG_SET = 1U << 4;
+    static constexpr uint32_t NOP_ASSERTED = 1U << 5;  // Read by the StageSynchronizer in the barrier completion
+    static constexpr uint32_t PAUSE_FLAG_SET = 1U << 6;
+    static constexpr uint32_t RESET_FLAG_SET = 1U << 7;
 
-    Control *control;
+    static constexpr uint32_t INPUT_BITS = READ_DATA_SET | ALU_RESULT_SET | REGISTER_DESTINATION_SET | CONTROL_SET |
+                                           NOP_PASSED_FLAG_SET;
+
+    bool is_verbose_execution_flag_asserted;
 
     RegisterFile *register_file;
     WBMux *wb_mux;
@@ -46,18 +49,17 @@ class MEMWBStageRegisters: public Module {
     friend StageSynchronizer;
 
 public:
-    MEMWBStageRegisters();
+    explicit MEMWBStageRegisters(SimulationContext *context);
 
-    static MEMWBStageRegisters *init();
 
-    void run() override;
 
     void setReadData(std::bitset<WORD_BIT_COUNT> value);
     void setALUResult(std::bitset<WORD_BIT_COUNT> value);
     void setRegisterDestination(unsigned long value);
-    void setControl(Control *new_control);
+    void setControl(const Control &new_control);
     void setPassedNop(bool is_asserted);
     bool isExecutingHaltInstruction();
+    bool isNopAsserted();
     void assertNop();
 
     void reset();
@@ -67,19 +69,23 @@ public:
     void assertVerboseExecutionFlag();
 
 private:
-    void passReadDataToWBMux();
-    void passALUResultToWBMux();
+    void passReadDataToWBMux(std::bitset<WORD_BIT_COUNT> data);
+    void passALUResultToWBMux(std::bitset<WORD_BIT_COUNT> data);
     void passRegisterDestinationToRegisterFile(unsigned long rd);
     void passRegisterDestinationToForwardingUnit(unsigned long rd);
     void passRegWriteToForwardingUnit(bool is_asserted);
 
     void resetStage();
     void initDependencies() override;
+    bool isReadyToExecute() override;
+    void execute() override;
+
+    void markInputsEvaluated() override;
 
     std::string getModuleTag() override;
     Stage getModuleStage() override;
 
-    void printState();
+    void printState(Control &current_control);
 };
 
 #endif //RISC_V_SIMULATOR_MEMWBSTAGEREGISTERS_H
@@ -1,20 +1,12 @@
 #include "../../include/combinational/ALU.h"
+#include "../../include/combinational/mux/forwarding/ALUInput1ForwardingMux.h"
+#include "../../include/combinational/mux/forwarding/ALUInput2ForwardingMux.h"
 
-ALU *ALU::current_instance = nullptr;
-std::mutex ALU::initialization_mutex;
-
-ALU::ALU() {
-    this->input1 = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->input2 = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->result = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-
+ALU::ALU(SimulationContext *context) : Module(context) {
+    this->result = 0U;
     this->is_result_zero = false;
 
-    this->is_input1_set = false;
-    this->is_input2_set = false;
-    this->is_alu_op_set = false;
-
-    this->is_reset_flag_set = false;
+    this->readiness.track(INPUT_BITS, 0U, RESET_FLAG_SET);
 
     this->ex_mem_stage_registers = nullptr;
     this->logger = nullptr;
@@ -22,130 +14,94 @@ ALU::ALU() {
 }
 
 void ALU::reset() {
-    std::lock_guard<std::mutex> alu_lock (this->getModuleMutex());
-
-    this->is_reset_flag_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(RESET_FLAG_SET);
 }
 
 void ALU::resetState() {
-    this->input1 = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->input2 = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->result = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->alu_op = std::bitset<ALU_OP_BIT_COUNT>(std::string(ALU_OP_BIT_COUNT, '0'));
+    this->input1.reset(0U);
+    this->input2.reset(0U);
+    this->alu_op.reset(std::bitset<ALU_OP_BIT_COUNT>(std::string(ALU_OP_BIT_COUNT, '0')));
 
+    this->result = 0U;
     this->is_result_zero = false;
-    this->is_input1_set = false;
-    this->is_input2_set = false;
-    this->is_alu_op_set = false;
+
+    this->readiness.clear(INPUT_BITS);
 }
 
 void ALU::setInput1(std::bitset<WORD_BIT_COUNT> value) {
-    this->log("setInput1 waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> alu_lock (this->getModuleMutex());
-
-    this->log("setInput1 acquired lock. Updating value.");
-
-    this->input1 = value;
-    this->is_input1_set = true;
+    this->input1.set(value.to_ulong());
 
     this->log("setInput1 updated value.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(INPUT1_SET);
 }
 
 void ALU::setInput2(std::bitset<WORD_BIT_COUNT> value) {
-    this->log("setInput2 waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> alu_lock (this->getModuleMutex());
-
-    this->log("setInput2 acquired lock. Updating value.");
-
-    this->input2 = value;
-    this->is_input2_set = true;
+    this->input2.set(value.to_ulong());
 
     this->log("setInput2 updated value.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(INPUT2_SET);
 }
 
 void ALU::setALUOp(std::bitset<ALU_OP_BIT_COUNT> value) {
-    std::lock_guard<std::mutex> alu_lock (this->getModuleMutex());
-
-    this->log("setALUOp acquired lock. Updating value.");
-
-    this->alu_op = value;
-    this->is_alu_op_set = true;
+    this->alu_op.set(value);
 
     this->log("setALUOp updated value.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(ALU_OP_SET);
 }
 
-void ALU::run() {
-    this->initDependencies();
-
-    while (this->isAlive()) {
-        this->log("Waiting to be woken up and acquire lock.");
-
-        std::unique_lock<std::mutex> alu_lock (this->getModuleMutex());
-        this->getModuleConditionVariable().wait(
-                alu_lock,
-                [this] {
-                    return (this->is_input1_set && this->is_input2_set && this->is_alu_op_set) ||
-                        this->is_reset_flag_set || this->isKilled();
-                }
-        );
-
-        if (this->is_reset_flag_set) {
-            this->log("Resetting stage.");
+void ALU::holdInput(SignalBase &input) {
+    if (&input == &this->input1) {
+        input.hold();
+        this->setReadiness(INPUT1_SET);
+    } else if (&input == &this->input2) {
+        input.hold();
+        this->setReadiness(INPUT2_SET);
+    } else {
+        Module::holdInput(input);
+    }
+}
 
-            this->resetState();
-            this->is_reset_flag_set = false;
+bool ALU::isReadyToExecute() {
+    return this->readiness.isReady();
+}
 
-            this->stage_synchronizer->arriveReset();
+void ALU::execute() {
+    if (this->readiness.isSet(RESET_FLAG_SET)) {
+        this->log<LogLevel::Info>("Resetting stage.");
 
-            this->log("Reset.");
-            continue;
-        }
+        this->resetState();
+        this->readiness.clear(RESET_FLAG_SET);
 
-        if (this->isKilled()) {
-            this->log("Killed.");
-            break;
-        }
+        this->stage_synchronizer->arriveReset();
 
-        this->log("Woken up and acquired lock.");
+        this->log<LogLevel::Info>("Reset.");
+        return;
+    }
 
-        this->computeResult();
+    this->log("Woken up and acquired lock.");
 
-        std::thread pass_result_thread(
-                &ALU::passResultToEXMEMStageRegisters,
-                this,
-                this->result
-        );
+    this->computeResult();
 
-        std::thread pass_zero_flag_thread (
-                &ALU::passZeroFlagToEXMEMStageRegisters,
-                this,
-                this->is_result_zero
-        );
+    std::bitset<WORD_BIT_COUNT> current_result = this->result;
+    bool is_current_result_zero = this->is_result_zero;
 
-        pass_result_thread.detach();
-        pass_zero_flag_thread.detach();
+    this->markInputsEvaluated();
 
-        this->is_alu_op_set = false;
-        this->is_input1_set = false;
-        this->is_input2_set = false;
-        this->is_result_zero = false;
-    }
+    this->dispatch(&ALU::passResultToEXMEMStageRegisters, this, current_result);
+    this->dispatch(&ALU::passZeroFlagToEXMEMStageRegisters, this, is_current_result_zero);
 }
 
-ALU *ALU::init() {
-    std::lock_guard<std::mutex> alu_lock (ALU::initialization_mutex);
+bool ALU::isEvaluationSkippable() {
+    return !this->readiness.isSet(RESET_FLAG_SET) &&
+           Module::areInputsUnchanged(this->input1, this->input2, this->alu_op);
+}
 
-    if (ALU::current_instance == nullptr) {
-        ALU::current_instance = new ALU();
-    }
+void ALU::markInputsEvaluated() {
+    this->alu_op.markEvaluated();
+    this->input1.markEvaluated();
+    this->input2.markEvaluated();
 
-    return ALU::current_instance;
+    this->readiness.clear(INPUT_BITS);
 }
 
 void ALU::initDependencies() {
@@ -155,30 +111,48 @@ void ALU::initDependencies() {
         return;
     }
 
-    this->ex_mem_stage_registers = EXMEMStageRegisters::init();
-    this->logger = Logger::init();
-    this->stage_synchronizer = StageSynchronizer::init();
+    this->ex_mem_stage_registers = this->context->get<EXMEMStageRegisters>();
+    this->logger = this->context->get<Logger>();
+    this->stage_synchronizer = this->context->get<StageSynchronizer>();
+
+    this->connectInput(this->input1, this->context->get<ALUInput1ForwardingMux>());
+    this->connectInput(this->input2, this->context->get<ALUInput2ForwardingMux>());
+
+    this->stage_synchronizer->registerParticipant(false);
 }
 
 void ALU::computeResult() {
     this->log("Computing result.");
 
-    if (this->alu_op == std::bitset<ALU_OP_BIT_COUNT>("0000")) {  // Add
-        this->result = BitwiseOperations::addInputs(this->input1, this->input2);
-    } else if (this->alu_op == std::bitset<ALU_OP_BIT_COUNT>("0001")) {  // subtract
-        this->result = BitwiseOperations::subtractInputs(this->input1, this->input2);
-    } else if (this->alu_op == std::bitset<ALU_OP_BIT_COUNT>("0010")) {  // Xor
-        this->result = BitwiseOperations::bitwiseXorInputs(this->input1, this->input2);
-    } else if (this->alu_op == std::bitset<ALU_OP_BIT_COUNT>("0011")) {  // Or
-        this->result = BitwiseOperations::bitwiseOrInputs(this->input1, this->input2);
-    } else if (this->alu_op == std::bitset<ALU_OP_BIT_COUNT>("0100")) {  // And
-        this->result = BitwiseOperations::bitwiseAndInputs(this->input1, this->input2);
-    }
+    this->result = ALU::evaluate(this->alu_op.get(), this->input1.get(), this->input2.get());
 
-    this->is_result_zero = this->result.to_ulong() == 0;
+    this->is_result_zero = this->result == 0U;
     this->log("Result computed.");
 }
 
+uint32_t ALU::evaluate(std::bitset<ALU_OP_BIT_COUNT> alu_op, uint32_t value1, uint32_t value2) {
+    switch (alu_op.to_ulong()) {
+        case 0b0000:  // Add
+            return BitwiseOperations::addWords(value1, value2);
+        case 0b0001:  // subtract
+            return BitwiseOperations::subtractWords(value1, value2);
+        case 0b0010:  // Xor
+            return value1 ^ value2;
+        case 0b0011:  // Or
+            return value1 | value2;
+        case 0b0100:  // And
+            return value1 & value2;
+        default:
+            throw std::runtime_error("ALU::evaluate: unsupported ALU operation " + alu_op.to_string());
+    }
+}
+
+std::bitset<WORD_BIT_COUNT> ALU::evaluate(std::bitset<ALU_OP_BIT_COUNT> alu_op,
+                                          std::bitset<WORD_BIT_COUNT> value1,
+                                          std::bitset<WORD_BIT_COUNT> value2) {
+    return {ALU::evaluate(alu_op, static_cast<uint32_t>(value1.to_ulong()), static_cast<uint32_t>(value2.to_ulong()))};
+}
+
 void ALU::passZeroFlagToEXMEMStageRegisters(bool is_flag_asserted) {
     this->log("Passing zero flag to EXMEMStageRegisters.");
     this->ex_mem_stage_registers->setIsResultZeroFlag(is_flag_asserted);
@@ -1,26 +1,7 @@
 #include "../../include/combinational/ForwardingUnit.h"
 
-ForwardingUnit *ForwardingUnit::current_instance = nullptr;
-std::mutex ForwardingUnit::initialization_mutex;
-
-ForwardingUnit::ForwardingUnit() {
-    this->register_source1 = 0UL;
-    this->register_source2 = 0UL;
-    this->ex_mem_stage_register_destination = 0UL;
-    this->mem_wb_stage_register_destination = 0UL;
-
-    this->is_single_register_source_set = false;
-    this->is_double_register_source_set = false;
-    this->is_ex_mem_stage_register_destination_set = false;
-    this->is_mem_wb_stage_register_destination_set = false;
-
-    this->is_ex_mem_reg_write_asserted = false;
-    this->is_mem_wb_reg_write_asserted = false;
-
-    this->is_ex_mem_reg_write_set = false;
-    this->is_mem_wb_reg_write_set = false;
-
-    this->is_reset_flag_set = false;
+ForwardingUnit::ForwardingUnit(SimulationContext *context) : Module(context) {
+    this->readiness.track(ForwardingUnit::getRequiredBits(this->getPipelineType()), 0U, RESET_FLAG_SET);
 
     this->alu_input_1_mux_control_signal = ALUInputMuxControlSignals::IDEXStageRegisters;
     this->alu_input_2_mux_control_signal = ALUInputMuxControlSignals::IDEXStageRegisters;
@@ -31,16 +12,6 @@ ForwardingUnit::ForwardingUnit() {
     this->stage_synchronizer = nullptr;
 }
 
-ForwardingUnit *ForwardingUnit::init() {
-    std::lock_guard<std::mutex> forwarding_unit_lock (ForwardingUnit::initialization_mutex);
-
-    if (ForwardingUnit::current_instance == nullptr) {
-        ForwardingUnit::current_instance = new ForwardingUnit();
-    }
-
-    return ForwardingUnit::current_instance;
-}
-
 void ForwardingUnit::initDependencies() {
     std::unique_lock<std::mutex> forwarding_unit_lock (this->getModuleDependencyMutex());
 
@@ -48,184 +19,130 @@ void ForwardingUnit::initDependencies() {
         return;
     }
 
-    this->alu_input_1_mux = ALUInput1ForwardingMux::init();
-    this->alu_input_2_mux = ALUInput2ForwardingMux::init();
-    this->logger = Logger::init();
-    this->stage_synchronizer = StageSynchronizer::init();
-}
+    this->alu_input_1_mux = this->context->get<ALUInput1ForwardingMux>();
+    this->alu_input_2_mux = this->context->get<ALUInput2ForwardingMux>();
+    this->logger = this->context->get<Logger>();
+    this->stage_synchronizer = this->context->get<StageSynchronizer>();
 
-void ForwardingUnit::run() {
-    this->initDependencies();
-
-    while (this->isAlive()) {
-        this->log("Waiting to be woken up and acquire lock.");
-
-        std::unique_lock<std::mutex> forwarding_unit_lock (this->getModuleMutex());
-        this->getModuleConditionVariable().wait(
-                forwarding_unit_lock,
-                [this] {
-                    return ((this->is_single_register_source_set || this->is_double_register_source_set) &&
-                        (this->getPipelineType() == PipelineType::Single ||
-                        (this->is_ex_mem_stage_register_destination_set && this->is_ex_mem_reg_write_set &&
-                        this->is_mem_wb_stage_register_destination_set && this->is_mem_wb_reg_write_set))) ||
-                        this->is_reset_flag_set || this->isKilled();
-                }
-        );
-
-        if (this->isKilled()) {
-            this->log("Killed.");
-            break;
-        }
-
-        if (this->is_reset_flag_set) {
-            this->log("Resetting.");
+    this->stage_synchronizer->registerParticipant(false);
+}
 
-            this->resetState();
-            this->is_reset_flag_set = false;
+// Nothing is forwarded in the single stage pipeline, it does not wait for the later stages' inputs
+uint32_t ForwardingUnit::getRequiredBits(PipelineType current_type) {
+    return current_type == PipelineType::Single ? REGISTER_SOURCE_SET : INPUT_BITS;
+}
 
-            this->stage_synchronizer->arriveReset();
+bool ForwardingUnit::isReadyToExecute() {
+    return this->readiness.isReady();
+}
 
-            this->log("Reset.");
-            continue;
-        }
+void ForwardingUnit::execute() {
+    if (this->readiness.isSet(RESET_FLAG_SET)) {
+        this->log<LogLevel::Info>("Resetting.");
 
-        this->log("Woken up and acquired lock.");
+        this->resetState();
+        this->readiness.clear(RESET_FLAG_SET);
 
-        this->computeControlSignals();
+        this->stage_synchronizer->arriveReset();
 
-        std::thread pass_control_signal_to_alu_input_1_forwarding_mux (
-                &ForwardingUnit::passControlSignalToALUInput1ForwardingMux,
-                this
-        );
+        this->log<LogLevel::Info>("Reset.");
+        return;
+    }
 
-        std::thread pass_control_signal_to_alu_input_2_forwarding_mux (
-                &ForwardingUnit::passControlSignalToALUInput2ForwardingMux,
-                this
-        );
+    this->log("Woken up and acquired lock.");
 
-        pass_control_signal_to_alu_input_1_forwarding_mux.join();
-        pass_control_signal_to_alu_input_2_forwarding_mux.join();
+    this->computeControlSignals();
+    this->markInputsEvaluated();
 
-        this->is_single_register_source_set = false;
-        this->is_double_register_source_set = false;
-        this->is_ex_mem_stage_register_destination_set = false;
-        this->is_mem_wb_stage_register_destination_set = false;
-        this->is_ex_mem_reg_write_set = false;
-        this->is_mem_wb_reg_write_set = false;
-        this->is_ex_mem_reg_write_asserted = false;
-        this->is_mem_wb_reg_write_asserted = false;
-    }
+    this->dispatchAndWait({
+            [this] { this->passControlSignalToALUInput1ForwardingMux(); },
+            [this] { this->passControlSignalToALUInput2ForwardingMux(); }
+    });
 }
 
-void ForwardingUnit::setSingleRegisterSource(unsigned long rs1) {
-    this->log("setSingleRegisterSource waiting to acquire lock.");
+bool ForwardingUnit::isEvaluationSkippable() {
+    return !this->readiness.isSet(RESET_FLAG_SET) &&
+           Module::areInputsUnchanged(this->register_source1, this->register_source2,
+                                      this->ex_mem_stage_register_destination,
+                                      this->mem_wb_stage_register_destination,
+                                      this->ex_mem_reg_write, this->mem_wb_reg_write);
+}
 
-    std::lock_guard<std::mutex> forwarding_unit_lock (this->getModuleMutex());
+void ForwardingUnit::markInputsEvaluated() {
+    this->register_source1.markEvaluated();
+    this->register_source2.markEvaluated();
+    this->ex_mem_stage_register_destination.markEvaluated();
+    this->mem_wb_stage_register_destination.markEvaluated();
+    this->ex_mem_reg_write.markEvaluated();
+    this->mem_wb_reg_write.markEvaluated();
 
-    this->log("setSingleRegisterSource acquired lock. Updating value.");
+    this->readiness.clear(INPUT_BITS);
+}
 
-    this->register_source1 = rs1;
-    this->is_single_register_source_set = true;
+void ForwardingUnit::setSingleRegisterSource(unsigned long rs1) {
+    this->register_source1.set(rs1);
+    this->register_source2.set(std::nullopt);
 
     this->log("setSingleRegisterSource value updated.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(REGISTER_SOURCE_SET);
 }
 
 void ForwardingUnit::setDoubleRegisterSource(unsigned long rs1, unsigned long rs2) {
-    this->log("setDoubleRegisterSource waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> forwarding_unit_lock (this->getModuleMutex());
-
-    this->log("setDoubleRegisterSource acquired lock. Updating values.");
-
-    this->register_source1 = rs1;
-    this->register_source2 = rs2;
-    this->is_double_register_source_set = true;
+    this->register_source1.set(rs1);
+    this->register_source2.set(rs2);
 
     this->log("setDoubleRegisterSource values updated.");
-    this->notifyModuleConditionVariable();
-
+    this->setReadiness(REGISTER_SOURCE_SET);
 }
 
 void ForwardingUnit::setEXMEMStageRegisterDestination(unsigned long rd) {
-    this->log("setEXMEMStageRegisterDestination waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> forwarding_unit_lock (this->getModuleMutex());
-
-    this->log("setEXMEMStageRegisterDestination acquired lock. Updating value.");
-
-    this->ex_mem_stage_register_destination = rd;
-    this->is_ex_mem_stage_register_destination_set = true;
+    this->ex_mem_stage_register_destination.set(rd);
 
     this->log("setEXMEMStageRegisterDestination value updated.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(EX_MEM_REGISTER_DESTINATION_SET);
 }
 
 void ForwardingUnit::setMEMWBStageRegisterDestination(unsigned long rd) {
-    this->log("setMEMWBStageRegisterDestination waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> forwarding_unit_lock (this->getModuleMutex());
-
-    this->log("setMEMWBStageRegisterDestination acquired lock. Updating value.");
-
-    this->mem_wb_stage_register_destination = rd;
-    this->is_mem_wb_stage_register_destination_set = true;
+    this->mem_wb_stage_register_destination.set(rd);
 
     this->log("setMEMWBStageRegisterDestination values updated.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(MEM_WB_REGISTER_DESTINATION_SET);
 }
 
 void ForwardingUnit::setEXMEMStageRegisterRegWrite(bool is_asserted) {
-    this->log("setEXMEMStageRegisterRegWrite waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> forwarding_unit_lock (this->getModuleMutex());
-
-    this->log("setEXMEMStageRegisterRegWrite acquired lock. Updating value.");
-
-    this->is_ex_mem_reg_write_asserted = is_asserted;
-    this->is_ex_mem_reg_write_set = true;
+    this->ex_mem_reg_write.set(is_asserted);
 
     this->log("setEXMEMStageRegisterRegWrite values updated.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(EX_MEM_REG_WRITE_SET);
 }
 
 void ForwardingUnit::setMEMWBStageRegisterRegWrite(bool is_asserted) {
-    this->log("setEXMEMStageRegisterRegWrite waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> forwarding_unit_lock (this->getModuleMutex());
+    this->mem_wb_reg_write.set(is_asserted);
 
-    this->log("setEXMEMStageRegisterRegWrite acquired lock. Updating value.");
-
-    this->is_mem_wb_reg_write_asserted = is_asserted;
-    this->is_mem_wb_reg_write_set = true;
+    this->log("setMEMWBStageRegisterRegWrite values updated.");
+    this->setReadiness(MEM_WB_REG_WRITE_SET);
+}
 
-    this->log("setEXMEMStageRegisterRegWrite values updated.");
-    this->notifyModuleConditionVariable();
+void ForwardingUnit::setPipelineType(PipelineType current_type) {
+    Module::setPipelineType(current_type);
+    this->requireReadiness(ForwardingUnit::getRequiredBits(current_type));
 }
 
 void ForwardingUnit::reset() {
-    std::lock_guard<std::mutex> forwarding_unit_lock (this->getModuleMutex());
-
     this->log("reset flag set.");
-    this->is_reset_flag_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(RESET_FLAG_SET);
 }
 
 void ForwardingUnit::resetState() {
-    this->is_single_register_source_set = false;
-    this->is_double_register_source_set = false;
-    this->is_ex_mem_stage_register_destination_set = false;
-    this->is_mem_wb_stage_register_destination_set = false;
-    this->is_ex_mem_reg_write_set = false;
-    this->is_mem_wb_reg_write_set = false;
-
-    this->is_ex_mem_reg_write_asserted = false;
-    this->is_mem_wb_reg_write_asserted = false;
-
-    this->register_source1 = 0UL;
-    this->register_source2 = 0UL;
-    this->ex_mem_stage_register_destination = 0UL;
-    this->mem_wb_stage_register_destination = 0UL;
+    this->register_source1.reset(0UL);
+    this->register_source2.reset(std::nullopt);
+    this->ex_mem_stage_register_destination.reset(0UL);
+    this->mem_wb_stage_register_destination.reset(0UL);
+
+    this->ex_mem_reg_write.reset(false);
+    this->mem_wb_reg_write.reset(false);
+
+    this->readiness.clear(INPUT_BITS);
 }
 
 void ForwardingUnit::computeControlSignals() {
@@ -238,16 +155,22 @@ void ForwardingUnit::computeControlSignals() {
         this->alu_input_1_mux_control_signal = ALUInputMuxControlSignals::IDEXStageRegisters;
         this->alu_input_2_mux_control_signal = ALUInputMuxControlSignals::IDEXStageRegisters;
 
-        if (this->register_source1 == this->ex_mem_stage_register_destination && this->is_ex_mem_reg_write_asserted) {
+        unsigned long rs1 = this->register_source1.get();
+        unsigned long ex_mem_rd = this->ex_mem_stage_register_destination.get();
+        unsigned long mem_wb_rd = this->mem_wb_stage_register_destination.get();
+
+        if (rs1 == ex_mem_rd && this->ex_mem_reg_write.get()) {
             this->alu_input_1_mux_control_signal = ALUInputMuxControlSignals::EXMEMStageRegisters;
-        } else if (this->register_source1 == this->mem_wb_stage_register_destination && this->is_mem_wb_reg_write_set) {
+        } else if (rs1 == mem_wb_rd && this->mem_wb_reg_write.isSet()) {
             this->alu_input_1_mux_control_signal = ALUInputMuxControlSignals::MEMWBStageRegisters;
         }
 
-        if (this->is_double_register_source_set) {
-            if (this->register_source2 == this->ex_mem_stage_register_destination && this->is_ex_mem_reg_write_asserted) {
+        if (this->register_source2.get()) {
+            unsigned long rs2 = *this->register_source2.get();
+
+            if (rs2 == ex_mem_rd && this->ex_mem_reg_write.get()) {
                 this->alu_input_2_mux_control_signal = ALUInputMuxControlSignals::EXMEMStageRegisters;
-            } else if (this->register_source2 == this->mem_wb_stage_register_destination && this->is_mem_wb_reg_write_asserted) {
+            } else if (rs2 == mem_wb_rd && this->mem_wb_reg_write.get()) {
                 this->alu_input_2_mux_control_signal = ALUInputMuxControlSignals::MEMWBStageRegisters;
             }
         }
@@ -1,20 +1,11 @@
 #include "../../include/combinational/HazardDetectionUnit.h"
 
-HazardDetectionUnit *HazardDetectionUnit::current_instance = nullptr;
-std::mutex HazardDetectionUnit::initialization_mutex;
+HazardDetectionUnit::HazardDetectionUnit(SimulationContext *context)
+        : Module(context), id_ex_register_destination(0UL), instruction(nullptr), id_ex_mem_read_signal(false) {
+    this->readiness.track(INPUT_BITS, PAUSE_FLAG_SET, RESET_FLAG_SET);
 
-HazardDetectionUnit::HazardDetectionUnit() {
-    this->id_ex_register_destination = 0UL;
-    this->instruction = nullptr;
-    this->is_id_ex_mem_read_asserted = false;
     this->is_hazard_detected_flag_asserted = false;
 
-    this->is_id_ex_register_destination_set = false;
-    this->is_id_ex_mem_read_set = false;
-    this->is_instruction_set = false;
-    this->is_pause_flag_set = false;
-    this->is_reset_flag_set = false;
-
     this->logger = nullptr;
     this->driver = nullptr;
     this->stage_synchronizer = nullptr;
@@ -23,14 +14,13 @@ HazardDetectionUnit::HazardDetectionUnit() {
 }
 
 void HazardDetectionUnit::pause() {
-    this->log("Paused.");
-    this->is_pause_flag_set = true;
+    this->log<LogLevel::Info>("Paused.");
+    this->readiness.set(PAUSE_FLAG_SET);
 }
 
 void HazardDetectionUnit::resume() {
-    this->log("Resumed.");
-    this->is_pause_flag_set = false;
-    this->notifyModuleConditionVariable();
+    this->log<LogLevel::Info>("Resumed.");
+    this->clearReadiness(PAUSE_FLAG_SET);
 }
 
 
@@ -41,120 +31,78 @@ void HazardDetectionUnit::initDependencies() {
         return;
     }
 
-    this->logger = Logger::init();
-    this->driver = Driver::init();
-    this->if_id_stage_registers = IFIDStageRegisters::init();
-    this->id_ex_stage_registers = IDEXStageRegisters::init();
-    this->stage_synchronizer = StageSynchronizer::init();
-}
-
-HazardDetectionUnit *HazardDetectionUnit::init() {
-    std::lock_guard<std::mutex> hazard_detection_lock (HazardDetectionUnit::initialization_mutex);
+    this->logger = this->context->get<Logger>();
+    this->driver = this->context->get<Driver>();
+    this->if_id_stage_registers = this->context->get<IFIDStageRegisters>();
+    this->id_ex_stage_registers = this->context->get<IDEXStageRegisters>();
+    this->stage_synchronizer = this->context->get<StageSynchronizer>();
 
-    if (HazardDetectionUnit::current_instance == nullptr) {
-        HazardDetectionUnit::current_instance = new HazardDetectionUnit();
-    }
-
-    return HazardDetectionUnit::current_instance;
+    this->stage_synchronizer->registerParticipant(false);
 }
 
-void HazardDetectionUnit::run() {
-    this->initDependencies();
-
-    while (this->isAlive()) {
-        this->log("Waiting to be woken up and acquire lock.");
-
-        std::unique_lock<std::mutex> hazard_detection_unit_lock (this->getModuleMutex());
-        this->getModuleConditionVariable().wait(
-                hazard_detection_unit_lock,
-                [this] {
-                    return ((this->is_instruction_set  &&
-                        this->is_id_ex_mem_read_set && this->is_id_ex_register_destination_set) &&
-                        !this->is_pause_flag_set) || this->is_reset_flag_set || this->isKilled();
-                }
-        );
+bool HazardDetectionUnit::isReadyToExecute() {
+    return this->readiness.isReady();
+}
 
-        if (this->isKilled()) {
-            this->log("Killed.");
-            break;
-        }
+void HazardDetectionUnit::execute() {
+    if (this->readiness.isSet(RESET_FLAG_SET)) {
+        this->log("Resetting state.");
 
-        if (this->is_reset_flag_set) {
-            this->log("Resetting state.");
+        this->resetState();
+        this->readiness.clear(RESET_FLAG_SET);
 
-            this->resetState();
-            this->is_reset_flag_set = false;
+        this->stage_synchronizer->arriveReset();
 
-            this->stage_synchronizer->arriveReset();
+        this->log<LogLevel::Info>("Reset.");
+        return;
+    }
 
-            this->log("Reset.");
-            continue;
-        }
+    this->log("Woken up and acquired lock.");
 
-        this->log("Woken up and acquired lock.");
+    const Instruction *current_instruction = this->instruction.get();
+    unsigned long current_id_ex_register_destination = this->id_ex_register_destination.get();
 
-        if (this->getPipelineType() == PipelineType::Five && this->is_id_ex_mem_read_asserted &&
-            (this->instruction->getRs1().to_ulong() == this->id_ex_register_destination ||
-            this->instruction->getRs2().to_ulong() == this->id_ex_register_destination) && !this->is_hazard_detected_flag_asserted) {
-            this->is_hazard_detected_flag_asserted = true;
-        } else {
-            this->is_hazard_detected_flag_asserted = false;
-        }
+    if (this->getPipelineType() == PipelineType::Five && this->id_ex_mem_read_signal.get() &&
+        (current_instruction->getRs1().to_ulong() == current_id_ex_register_destination ||
+        current_instruction->getRs2().to_ulong() == current_id_ex_register_destination) &&
+        !this->is_hazard_detected_flag_asserted) {
+        this->is_hazard_detected_flag_asserted = true;
+    } else {
+        this->is_hazard_detected_flag_asserted = false;
+    }
 
-        std::thread pass_hazard_detected_driver_thread (&HazardDetectionUnit::passHazardDetectedFlagToDriver, this);
-        std::thread pass_hazard_detected_if_id_thread (&HazardDetectionUnit::passHazardDetectedFlagToIFIDStageRegisters, this);
-        std::thread pass_hazard_detected_id_ex_thread (&HazardDetectionUnit::passHazardDetectedFlagToIDEXStageRegisters, this);
+    this->id_ex_register_destination.markEvaluated();
+    this->id_ex_mem_read_signal.markEvaluated();
+    this->instruction.markEvaluated();
 
-        pass_hazard_detected_driver_thread.join();
-        pass_hazard_detected_id_ex_thread.join();
-        pass_hazard_detected_if_id_thread.join();
+    this->readiness.clear(INPUT_BITS);
 
-        this->is_id_ex_register_destination_set = false;
-        this->is_id_ex_mem_read_set = false;
-        this->is_instruction_set = false;
-    }
+    this->dispatchAndWait({
+            [this] { this->passHazardDetectedFlagToDriver(); },
+            [this] { this->passHazardDetectedFlagToIFIDStageRegisters(); },
+            [this] { this->passHazardDetectedFlagToIDEXStageRegisters(); }
+    });
 }
 
 void HazardDetectionUnit::setIDEXRegisterDestination(unsigned long rd) {
-    this->log("setIDEXRegisterDestination waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> hazard_detection_unit_lock (this->getModuleMutex());
-
-    this->log("setIDEXRegisterDestination acquired lock. Updating value.");
-
-    this->id_ex_register_destination = rd;
-    this->is_id_ex_register_destination_set = true;
+    this->id_ex_register_destination.set(rd);
 
     this->log("setIDEXRegisterDestination value updated.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(ID_EX_REGISTER_DESTINATION_SET);
 }
 
-void HazardDetectionUnit::setInstruction(Instruction *new_instruction) {
-    this->log("setInstruction waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> hazard_detection_unit_lock (this->getModuleMutex());
-
-    this->log("setInstruction acquired lock. Updating value.");
-
-    this->instruction = new_instruction;
-    this->is_instruction_set = true;
+void HazardDetectionUnit::setInstruction(const Instruction *new_instruction) {
+    this->instruction.set(new_instruction);
 
     this->log("setInstruction value updated.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(INSTRUCTION_SET);
 }
 
 void HazardDetectionUnit::setIDEXMemRead(bool is_asserted) {
-    this->log("setIDEXMemRead waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> hazard_detection_unit_lock (this->getModuleMutex());
-
-    this->log("setIDEXMemRead acquired lock. Updating value.");
-
-    this->is_id_ex_mem_read_asserted = is_asserted;
-    this->is_id_ex_mem_read_set = true;
+    this->id_ex_mem_read_signal.set(is_asserted);
 
     this->log("setIDEXMemRead value updated.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(ID_EX_MEM_READ_SET);
 }
 
 void HazardDetectionUnit::passHazardDetectedFlagToDriver() {
@@ -176,20 +124,15 @@ void HazardDetectionUnit::passHazardDetectedFlagToIDEXStageRegisters() {
 }
 
 void HazardDetectionUnit::reset() {
-    std::lock_guard<std::mutex> hazard_detection_lock (this->getModuleMutex());
-
-    this->is_reset_flag_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(RESET_FLAG_SET);
 }
 
 void HazardDetectionUnit::resetState() {
-    this->is_id_ex_register_destination_set = false;
-    this->is_id_ex_mem_read_set = false;
-    this->is_instruction_set = false;
+    this->id_ex_mem_read_signal.reset(false);
+    this->instruction.reset(Instruction::getZeroInstruction());
+    this->id_ex_register_destination.reset(0UL);
 
-    this->is_id_ex_mem_read_asserted = false;
-    this->instruction = new Instruction(std::string(32, '0'));
-    this->id_ex_register_destination = 0UL;
+    this->readiness.clear(INPUT_BITS);
 }
 
 std::string HazardDetectionUnit::getModuleTag() {
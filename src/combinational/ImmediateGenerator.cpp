@@ -1,26 +1,13 @@
 #include "../../include/combinational/ImmediateGenerator.h"
 
-ImmediateGenerator *ImmediateGenerator::current_instance = nullptr;
-std::mutex ImmediateGenerator::initialization_mutex;
-
-ImmediateGenerator::ImmediateGenerator() {
-    this->is_instruction_set = false;
-    this->instruction = new Instruction(std::string(32, '0'));
+ImmediateGenerator::ImmediateGenerator(SimulationContext *context) : Module(context) {
+    this->instruction = Instruction::getZeroInstruction();
+    this->readiness.track(INSTRUCTION_SET, 0U, 0U);
 
     this->id_ex_stage_registers = nullptr;
     this->logger = nullptr;
 }
 
-ImmediateGenerator *ImmediateGenerator::init() {
-    std::lock_guard<std::mutex> immediate_generator_lock (ImmediateGenerator::initialization_mutex);
-
-    if (ImmediateGenerator::current_instance == nullptr) {
-        ImmediateGenerator::current_instance = new ImmediateGenerator();
-    }
-
-    return ImmediateGenerator::current_instance;
-}
-
 void ImmediateGenerator::initDependencies() {
     std::unique_lock<std::mutex> immediate_generator_lock (this->getModuleDependencyMutex());
 
@@ -28,102 +15,50 @@ void ImmediateGenerator::initDependencies() {
         return;
     }
 
-    this->id_ex_stage_registers = IDEXStageRegisters::init();
-    this->logger = Logger::init();
+    this->id_ex_stage_registers = this->context->get<IDEXStageRegisters>();
+    this->logger = this->context->get<Logger>();
 }
 
-void ImmediateGenerator::run() {
-    this->initDependencies();
-
-    while (this->isAlive()) {
-        this->log("Waiting to be woken up and acquire lock.");
+bool ImmediateGenerator::isReadyToExecute() {
+    return this->readiness.isReady();
+}
 
-        std::unique_lock<std::mutex> immediate_generator_lock (this->getModuleMutex());
-        this->getModuleConditionVariable().wait(
-                immediate_generator_lock,
-                [this] { return this->is_instruction_set || this->isKilled(); }
-        );
+void ImmediateGenerator::execute() {
+    this->log("Woken up and acquired lock.");
 
-        if (this->isKilled()) {
-            this->log("Killed.");
-            break;
-        }
+    this->immediate = this->instruction->getSignExtendedImmediate();
+    std::bitset<WORD_BIT_COUNT> current_immediate = this->immediate;
 
-        this->log("Woken up and acquired lock.");
+    this->markInputsEvaluated();
+    this->loadImmediateToIDEXStageRegisters(current_immediate);
+}
 
-        this->loadImmediateToIDEXStageRegisters();
+bool ImmediateGenerator::isEvaluationSkippable() {
+    return Module::areInputsUnchanged(this->instruction_bits);
+}
 
-        this->is_instruction_set = false;
-    }
+void ImmediateGenerator::markInputsEvaluated() {
+    this->instruction_bits.markEvaluated();
+    this->readiness.clear(INSTRUCTION_SET);
 }
 
 void ImmediateGenerator::setInstruction(const Instruction *current_instruction) {
-    this->log("setInstruction waiting to acquire lock.");
-
-    std::lock_guard immediate_generator_lock (this->getModuleMutex());
-
-    this->log("setInstruction acquired lock. Updating value.");
-
     this->instruction = current_instruction;
-    this->is_instruction_set = true;
+    this->instruction_bits.set(current_instruction->getBits());
 
     this->log("setInstruction value updated.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(INSTRUCTION_SET);
 }
 
-void ImmediateGenerator::loadImmediateToIDEXStageRegisters() {
+void ImmediateGenerator::loadImmediateToIDEXStageRegisters(std::bitset<WORD_BIT_COUNT> current_immediate) {
     this->log("Passing immediate to IDEXStageRegisters.");
 
-    InstructionType type = this->instruction->getType();
-
-    std::bitset<WORD_BIT_COUNT> result;
-
-    if (type == InstructionType::S || type == InstructionType::I) {
-        std::bitset<Instruction::GENERAL_IMMEDIATE_BIT_COUNT> current_immediate = this->instruction->getImmediate();
-
-        bool is_negative_number = current_immediate[Instruction::GENERAL_IMMEDIATE_BIT_COUNT - 1];
-
-        if (is_negative_number) {
-            for (int i = Instruction::GENERAL_IMMEDIATE_BIT_COUNT; i < result.size(); ++i) {
-                result[i] = true;
-            }
-        }
-
-        for (int i = 0; i < Instruction::GENERAL_IMMEDIATE_BIT_COUNT; ++i) {
-            result[i] = current_immediate[i] == 1;
-        }
-    } else if (type == InstructionType::J) {
-        std::bitset<Instruction::J_TYPE_IMMEDIATE_BIT_COUNT> current_immediate = this->instruction->getImmediateJ();
-
-        for (int i = 0; i < Instruction::J_TYPE_IMMEDIATE_BIT_COUNT; ++i) {
-            result[i + 1] = current_immediate[i];
-        }
-
-        if (current_immediate[Instruction::J_TYPE_IMMEDIATE_BIT_COUNT - 1]) {
-            for (int i = Instruction::J_TYPE_IMMEDIATE_BIT_COUNT + 1; i < result.size(); ++i) {
-                result[i] = true;
-            }
-        }
-    } else if (type == InstructionType::B) {
-        std::bitset<Instruction::GENERAL_IMMEDIATE_BIT_COUNT> current_immediate = this->instruction->getImmediate();
-
-        for (int i = 0; i < Instruction::GENERAL_IMMEDIATE_BIT_COUNT; ++i) {
-            result[i + 1] = current_immediate[i] == 1;
-        }
-
-        if (current_immediate[Instruction::GENERAL_IMMEDIATE_BIT_COUNT - 1]) {
-            for (int i = Instruction::GENERAL_IMMEDIATE_BIT_COUNT + 1; i < result.size(); ++i) {
-                result[i] = true;
-            }
-        }
-    }
-
-    this->id_ex_stage_registers->setImmediate(result);
+    this->id_ex_stage_registers->setImmediate(current_immediate);
     this->log("Passed immediate to IDEXStageRegisters.");
 }
 
 std::string ImmediateGenerator::getModuleTag() {
-    return "IFAdder";
+    return "ImmediateGenerator";
 }
 
 Stage ImmediateGenerator::getModuleStage() {
@@ -1,28 +1,12 @@
 #include "../../../include/combinational/adder/EXAdder.h"
 
-EXAdder *EXAdder::current_instance = nullptr;
-std::mutex EXAdder::initialization_mutex;
+EXAdder::EXAdder(SimulationContext *context) : AdderBase(context) {
+    this->readiness.track(this->getInputPortBits(), 0U, 0U);
 
-EXAdder::EXAdder() {
-    this->program_counter = 0UL;
-    this->immediate = 0UL;
     this->result = 0UL;
 
     this->ex_mem_stage_registers = nullptr;
     this->logger = nullptr;
-
-    this->is_program_counter_set = false;
-    this->is_immediate_set = false;
-}
-
-EXAdder *EXAdder::init() {
-    std::lock_guard<std::mutex> ex_adder_lock (EXAdder::initialization_mutex);
-
-    if (EXAdder::current_instance == nullptr) {
-        EXAdder::current_instance = new EXAdder();
-    }
-
-    return EXAdder::current_instance;
 }
 
 void EXAdder::initDependencies() {
@@ -32,67 +16,35 @@ void EXAdder::initDependencies() {
         return;
     }
 
-    this->ex_mem_stage_registers = EXMEMStageRegisters::init();
-    this->logger = Logger::init();
+    this->ex_mem_stage_registers = this->context->get<EXMEMStageRegisters>();
+    this->logger = this->context->get<Logger>();
 }
 
-void EXAdder::run() {
-    this->initDependencies();
-
-    while (this->isAlive()) {
-        this->log("Waiting to be woken up and acquire lock.");
-
-        std::unique_lock<std::mutex> ex_adder_lock (this->getModuleMutex());
-        this->getModuleConditionVariable().wait(
-                ex_adder_lock,
-                [this] {
-                    return (this->is_program_counter_set && this->is_immediate_set) || this->isKilled();
-                }
-        );
-
-        if (this->isKilled()) {
-            this->log("Killed.");
-            break;
-        }
-
-        this->log("Woken up and acquired lock. Computing result.");
-
-        this->computeResult();
-        this->passBranchAddressToEXMEMStageRegisters();
-
-        this->is_immediate_set = false;
-        this->is_program_counter_set = false;
-    }
+bool EXAdder::isReadyToExecute() {
+    return this->readiness.isReady();
 }
 
-void EXAdder::setInput(const AdderInputType &type, const AdderInputDataType &value) {
-    if (!std::holds_alternative<EXAdderInputType>(type)) {
-        throw std::runtime_error("EXAdder::setInput: incompatible data types passed");
-    }
+void EXAdder::execute() {
+    this->log("Woken up and acquired lock. Computing result.");
 
-    this->log("setInput waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> ex_adder_lock (this->getModuleMutex());
+    this->computeResult();
+    this->markInputsEvaluated();
+    this->passBranchAddressToEXMEMStageRegisters();
+}
 
-    this->log("setInput acquired lock and updating value.");
+bool EXAdder::isEvaluationSkippable() {
+    return Module::areInputsUnchanged(this->program_counter, this->immediate);
+}
 
-    if (std::get<EXAdderInputType>(type) == EXAdderInputType::PCValue) {
-        this->program_counter = std::get<unsigned long>(value);
-        this->is_program_counter_set = true;
-    } else if (std::get<EXAdderInputType>(type) == EXAdderInputType::ImmediateValue) {
-        this->immediate = std::get<std::bitset<WORD_BIT_COUNT>>(value);
-        this->is_immediate_set = true;
-    }
+void EXAdder::markInputsEvaluated() {
+    this->immediate.markEvaluated();
+    this->program_counter.markEvaluated();
 
-    this->log("setInput value updated.");
-    this->notifyModuleConditionVariable();
+    this->readiness.clear(this->getInputPortBits());
 }
 
 void EXAdder::computeResult() {
-    this->result = BitwiseOperations::addInputs(
-            std::bitset<WORD_BIT_COUNT>(this->program_counter),
-            this->immediate
-    ).to_ulong();
+    this->result = BitwiseOperations::addWords(this->program_counter.get(), this->immediate.get().to_ulong());
 
     this->log("Computed adder result.");
 }
@@ -1,25 +1,11 @@
 #include "../../../include/combinational/adder/IFAdder.h"
 
-IFAdder *IFAdder::current_instance = nullptr;
-std::mutex IFAdder::initialization_mutex;
-
-IFAdder::IFAdder() {
-    this->program_counter = 0;
-    this->is_program_counter_set = false;
+IFAdder::IFAdder(SimulationContext *context) : AdderBase(context) {
+    this->readiness.track(this->getInputPortBits(), 0U, 0U);
 
     this->if_mux = nullptr;
 }
 
-IFAdder *IFAdder::init() {
-    std::lock_guard<std::mutex> if_adder_lock (IFAdder::initialization_mutex);
-
-    if (IFAdder::current_instance == nullptr) {
-        IFAdder::current_instance = new IFAdder();
-    }
-
-    return IFAdder::current_instance;
-}
-
 void IFAdder::initDependencies() {
     std::lock_guard<std::mutex> if_adder_lock (this->getModuleDependencyMutex());
 
@@ -27,60 +13,36 @@ void IFAdder::initDependencies() {
         return;
     }
 
-    this->if_mux = IFMux::init();
-    this->logger = Logger::init();
+    this->if_mux = this->context->get<IFMux>();
+    this->logger = this->context->get<Logger>();
 }
 
-void IFAdder::run() {
-    this->initDependencies();
-
-    while (this->isAlive()) {
-        this->log("Waiting to acquire lock and wake up.");
-
-        std::unique_lock<std::mutex> adder_lock(this->getModuleMutex());
-        this->getModuleConditionVariable().wait(
-                adder_lock,
-                [this] { return this->is_program_counter_set; }
-        );
-
-        if (this->isKilled()) {
-            this->log("Killed.");
-            break;
-        }
-
-        this->log("Woken up and acquired lock.");
-
-        this->passProgramCounterToIFMux();
-
-        this->is_program_counter_set = false;
-    }
+bool IFAdder::isReadyToExecute() {
+    return this->readiness.isReady();
 }
 
-void IFAdder::setInput(const AdderInputType &type, const AdderInputDataType &value) {
-    if (!std::holds_alternative<IFAdderInputType>(type) ||
-            !std::holds_alternative<unsigned long>(value)) {
-        throw std::runtime_error("IFAdder::setInput: incompatible type passed.");
-    }
+void IFAdder::execute() {
+    this->log("Woken up and acquired lock.");
 
-    this->log("setInput waiting to acquire lock and update values.");
+    unsigned long incremented_program_counter = BitwiseOperations::addWords(this->program_counter.get(), 4U);
 
-    std::unique_lock<std::mutex> adder_lock(this->getModuleMutex());
+    this->markInputsEvaluated();
+    this->passProgramCounterToIFMux(incremented_program_counter);
+}
 
-    if (std::get<IFAdderInputType>(type) == IFAdderInputType::PCValue) {
-        this->program_counter = std::get<unsigned long>(value);
-        this->is_program_counter_set = true;
+bool IFAdder::isEvaluationSkippable() {
+    return Module::areInputsUnchanged(this->program_counter);
+}
 
-        this->log("setInput program counter set.");
-    } else {
-        this->log("setInput program counter update failed.");
-    }
+void IFAdder::markInputsEvaluated() {
+    this->program_counter.markEvaluated();
 
-    this->notifyModuleConditionVariable();
+    this->readiness.clear(this->getInputPortBits());
 }
 
-void IFAdder::passProgramCounterToIFMux() {
+void IFAdder::passProgramCounterToIFMux(unsigned long incremented_program_counter) {
     this->log("Waiting to pass PCValue to IFMux.");
-    this->if_mux->setInput(IFStageMuxInputType::IncrementedPc, this->program_counter + 4);
+    this->if_mux->setInput<IFStageMuxInputType::IncrementedPc>(incremented_program_counter);
     this->log("PCValue passed to IFMux.");
 }
 
@@ -1,32 +1,13 @@
 #include "../../../include/combinational/mux/IFMux.h"
+#include "../../../include/combinational/adder/IFAdder.h"
 
-IFMux *IFMux::current_instance = nullptr;
-std::mutex IFMux::initialization_mutex;
-
-IFMux::IFMux() {
-    this->is_pc_src_signal_asserted = false;
-    this->is_incremented_pc_set = false;
-    this->is_branched_pc_set = false;
-
-    this->incremented_pc = 0UL;
-    this->branched_pc = 0UL;
-
-    this->is_control_signal_set = false;
+IFMux::IFMux(SimulationContext *context) : MuxBase(context) {
+    this->readiness.track(this->getInputPortBits() | CONTROL_SIGNAL_SET, 0U, 0U);
 
     this->driver = nullptr;
     this->logger = nullptr;
 }
 
-IFMux *IFMux::init() {
-    std::lock_guard<std::mutex> if_mux_lock (IFMux::initialization_mutex);
-
-    if (IFMux::current_instance == nullptr) {
-        IFMux::current_instance = new IFMux();
-    }
-
-    return IFMux::current_instance;
-}
-
 void IFMux::initDependencies() {
     std::unique_lock<std::mutex> mux_lock (this->getModuleDependencyMutex());
 
@@ -34,92 +15,59 @@ void IFMux::initDependencies() {
         return;
     }
 
-    this->driver = Driver::init();
-    this->logger = Logger::init();
-}
-
-void IFMux::run() {
-    this->initDependencies();
+    this->driver = this->context->get<Driver>();
+    this->logger = this->context->get<Logger>();
 
-    while (this->isAlive()) {
-        this->log("Waiting to be woken up and acquire lock.");
-
-        std::unique_lock<std::mutex> mux_lock (this->getModuleMutex());
-        this->getModuleConditionVariable().wait(
-                mux_lock,
-                [this] {
-                    return (this->is_branched_pc_set && this->is_incremented_pc_set && this->is_control_signal_set) ||
-                    this->isKilled();
-                }
-        );
+    this->connectInput(this->incremented_pc, this->context->get<IFAdder>());
+}
 
-        if (this->isKilled()) {
-            this->log("Killed.");
-            break;
-        }
+bool IFMux::isReadyToExecute() {
+    return this->readiness.isReady();
+}
 
-        this->log("Woken up and acquired lock.");
+void IFMux::execute() {
+    this->log("Woken up and acquired lock.");
 
-        this->passOutput();
+    // The next cycle's inputs can arrive once the Driver has its program counter, they are consumed before
+    bool is_branch_taken = this->control_signal.get();
+    unsigned long program_counter = is_branch_taken ? this->branched_pc.get() : this->incremented_pc.get();
 
-        this->is_pc_src_signal_asserted = false;
-        this->is_branched_pc_set = false;
-        this->is_incremented_pc_set = false;
-        this->is_control_signal_set = false;
-    }
+    this->markInputsEvaluated();
+    this->passOutput(is_branch_taken, program_counter);
 }
 
-void IFMux::setInput(MuxInputType type, MuxInputDataType value) {
-    if (!std::holds_alternative<IFStageMuxInputType>(type)) {
-        throw std::runtime_error("IFMux::setInput: incompatible data types passed.");
+bool IFMux::isEvaluationSkippable() {
+    if (this->control_signal.isChanged()) {
+        return false;
     }
 
-    this->log("setInput waiting to acquire lock");
-
-    std::unique_lock<std::mutex> mux_lock (this->getModuleMutex());
-
-    this->log("setInput acquired lock. Updating values.");
-
-    if (std::get<IFStageMuxInputType>(type) == IFStageMuxInputType::IncrementedPc) {
-        this->incremented_pc = std::get<unsigned long>(value);
-        this->is_incremented_pc_set = true;
-
-        this->log("incremented PC value set");
-    } else if (std::get<IFStageMuxInputType>(type) == IFStageMuxInputType::BranchedPc) {
-        this->branched_pc = std::get<unsigned long>(value);
-        this->is_branched_pc_set = true;
+    return this->control_signal.get() ? !this->branched_pc.isChanged() : !this->incremented_pc.isChanged();
+}
 
-        this->log("branched PC value set");
-    } else {
-        throw std::runtime_error("IFMux::setInput did not match any input type.");
-    }
+void IFMux::markInputsEvaluated() {
+    this->branched_pc.markEvaluated();
+    this->incremented_pc.markEvaluated();
+    this->control_signal.markEvaluated();
 
-    this->notifyModuleConditionVariable();
+    this->readiness.clear(this->getInputPortBits() | CONTROL_SIGNAL_SET);
 }
 
 void IFMux::assertControlSignal(bool is_asserted) {
-    this->log("assertControlSignal waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> if_mux_lock (this->getModuleMutex());
-
-    this->is_pc_src_signal_asserted = is_asserted;
-    this->is_control_signal_set = true;
-
-    this->log("PCSrc asserted: " + std::to_string(this->is_pc_src_signal_asserted) + ".");
-    this->notifyModuleConditionVariable();
+    this->log("PCSrc asserted: {}.", is_asserted);
+    this->setControlSignal(is_asserted);
 }
 
 /**
  * Loading output to the Driver.
  */
-void IFMux::passOutput() {
+void IFMux::passOutput(bool is_branch_taken, unsigned long program_counter) {
     this->log("Passing output to Driver.");
 
-    if (!this->is_pc_src_signal_asserted) {
-        this->driver->setProgramCounter(this->incremented_pc);
+    this->driver->setProgramCounter(program_counter);
+
+    if (!is_branch_taken) {
         this->log("Passed PC to Driver.");
     } else {
-        this->driver->setProgramCounter(this->branched_pc);
         this->log("Passed Branch Address to Driver.");
     }
 }
@@ -1,16 +1,7 @@
 #include "../../../include/combinational/mux/WBMux.h"
 
-WBMux *WBMux::current_instance = nullptr;
-std::mutex WBMux::initialization_mutex;
-
-WBMux::WBMux() {
-    this->read_data = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->alu_result = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-
-    this->is_mem_to_reg_asserted = false;
-
-    this->is_read_data_set = false;
-    this->is_alu_result_set = false;
+WBMux::WBMux(SimulationContext *context) : MuxBase(context) {
+    this->readiness.track(this->getInputPortBits() | CONTROL_SIGNAL_SET, 0U, 0U);
 
     this->register_file = nullptr;
     this->alu_input_1_forwarding_mux = nullptr;
@@ -18,16 +9,6 @@ WBMux::WBMux() {
     this->logger = nullptr;
 }
 
-WBMux *WBMux::init() {
-    std::lock_guard<std::mutex> wb_mux_lock (WBMux::initialization_mutex);
-
-    if (WBMux::current_instance == nullptr) {
-        WBMux::current_instance = new WBMux();
-    }
-
-    return WBMux::current_instance;
-}
-
 void WBMux::initDependencies() {
     std::unique_lock<std::mutex> wb_mux_lock (this->getModuleDependencyMutex());
 
@@ -35,100 +16,63 @@ void WBMux::initDependencies() {
         return;
     }
 
-    this->register_file = RegisterFile::init();
-    this->alu_input_1_forwarding_mux = ALUInput1ForwardingMux::init();
-    this->alu_input_2_forwarding_mux = ALUInput2ForwardingMux::init();
-    this->logger = Logger::init();
+    this->register_file = this->context->get<RegisterFile>();
+    this->alu_input_1_forwarding_mux = this->context->get<ALUInput1ForwardingMux>();
+    this->alu_input_2_forwarding_mux = this->context->get<ALUInput2ForwardingMux>();
+    this->logger = this->context->get<Logger>();
 }
 
-void WBMux::run() {
-    this->initDependencies();
-
-    while (this->isAlive()) {
-        this->log("Waiting to be woken up and acquire lock.");
-
-        std::unique_lock<std::mutex> wb_mux_lock (this->getModuleMutex());
-        this->getModuleConditionVariable().wait(
-                wb_mux_lock,
-                [this] {
-                    return (this->is_read_data_set && this->is_alu_result_set && this->is_control_signal_set) ||
-                        this->isKilled();
-                }
-        );
-
-        if (this->isKilled()) {
-            this->log("Killed.");
-            break;
-        }
+bool WBMux::isReadyToExecute() {
+    return this->readiness.isReady();
+}
 
-        this->log("Woken up and acquired lock.");
+void WBMux::execute() {
+    this->log("Woken up and acquired lock.");
 
-        std::thread pass_output_to_forwarding_unit (&WBMux::passOutputToForwardingMuxes, this);
-        this->passOutput();
+    std::bitset<WORD_BIT_COUNT> write_data = this->control_signal.get() ? this->read_data.get() : this->alu_result.get();
 
-        pass_output_to_forwarding_unit.join();
+    this->markInputsEvaluated();
 
-        this->is_read_data_set = false;
-        this->is_alu_result_set = false;
-        this->is_control_signal_set = false;
-    }
+    this->dispatchAndWait({
+            [this, write_data] { this->passOutputToForwardingMuxes(write_data); },
+            [this, write_data] { this->passOutput(write_data); }
+    });
 }
 
-void WBMux::setInput(MuxInputType type, MuxInputDataType value) {
-    if (!std::holds_alternative<WBStageMuxInputType>(type)) {
-        throw std::runtime_error("Incorrect MuxInputType passed to EXMuxALUInput2");
+bool WBMux::isEvaluationSkippable() {
+    if (this->control_signal.isChanged()) {
+        return false;
     }
 
-    this->log("setInput waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> ex_mux_lock (this->getModuleMutex());
+    return this->control_signal.get() ? !this->read_data.isChanged() : !this->alu_result.isChanged();
+}
 
-    if (std::get<WBStageMuxInputType>(type) == WBStageMuxInputType::ALUResult) {
-        this->alu_result = std::bitset<WORD_BIT_COUNT>(std::get<std::bitset<WORD_BIT_COUNT>>(value));
-        this->is_alu_result_set = true;
-    } else if (std::get<WBStageMuxInputType>(type) == WBStageMuxInputType::ReadData) {
-        this->read_data = std::bitset<WORD_BIT_COUNT>(std::get<std::bitset<WORD_BIT_COUNT>>(value));
-        this->is_read_data_set = true;
-    }
+void WBMux::markInputsEvaluated() {
+    this->read_data.markEvaluated();
+    this->alu_result.markEvaluated();
+    this->control_signal.markEvaluated();
 
-    this->log("setInput value updated.");
-    this->notifyModuleConditionVariable();
+    this->readiness.clear(this->getInputPortBits() | CONTROL_SIGNAL_SET);
 }
 
 void WBMux::assertControlSignal(bool is_asserted) {
-    this->log("assertControlSignal waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> wb_mux_lock (this->getModuleMutex());
-
-    this->is_mem_to_reg_asserted = is_asserted;
-    this->is_control_signal_set = true;
-
     this->log("assertControlSignal updated control.");
-    this->notifyModuleConditionVariable();
+    this->setControlSignal(is_asserted);
 }
 
-void WBMux::passOutput() {
+void WBMux::passOutput(std::bitset<WORD_BIT_COUNT> write_data) {
     this->log("Passing output to register file.");
 
-    if (this->is_mem_to_reg_asserted) {
-        this->register_file->setWriteData(this->read_data);
-    } else {
-        this->register_file->setWriteData(this->alu_result);
-    }
+    this->register_file->setWriteData(write_data);
 
     this->log("Passed output to register file.");
 }
 
-void WBMux::passOutputToForwardingMuxes() {
+void WBMux::passOutputToForwardingMuxes(std::bitset<WORD_BIT_COUNT> write_data) {
     this->log("Passing values to forwarding muxes.");
 
-    if (this->is_mem_to_reg_asserted) {
-        this->alu_input_1_forwarding_mux->setInput(ALUInputMuxInputTypes::MEMWBStageRegisters, this->read_data);
-        this->alu_input_2_forwarding_mux->setInput(ALUInputMuxInputTypes::MEMWBStageRegisters, this->read_data);
-    } else {
-        this->alu_input_1_forwarding_mux->setInput(ALUInputMuxInputTypes::MEMWBStageRegisters, this->alu_result);
-        this->alu_input_2_forwarding_mux->setInput(ALUInputMuxInputTypes::MEMWBStageRegisters, this->alu_result);
-    }
+    this->alu_input_1_forwarding_mux->setInput<ALUInputMuxInputTypes::MEMWBStageRegisters>(write_data);
+    this->alu_input_2_forwarding_mux->setInput<ALUInputMuxInputTypes::MEMWBStageRegisters>(write_data);
 
     this->log("Passed values to forwarding muxes.");
 }
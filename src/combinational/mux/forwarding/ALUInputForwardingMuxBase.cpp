@@ -1,131 +1,149 @@
 #include "../../../../include/combinational/ALU.h"
+#include "../../../../include/combinational/mux/forwarding/ALUInput1ForwardingMux.h"
+#include "../../../../include/combinational/mux/forwarding/ALUInput2ForwardingMux.h"
+#include "../../../../include/combinational/mux/WBMux.h"
+#include "../../../../include/combinational/ForwardingUnit.h"
 
-ALUInputForwardingMuxBase::ALUInputForwardingMuxBase() {
-    this->id_ex_stage_registers_value = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->ex_mem_stage_registers_value = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->mem_wb_stage_registers_value = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
+template<typename Derived>
+ALUInputForwardingMuxBase<Derived>::ALUInputForwardingMuxBase(SimulationContext *context)
+        : MuxBase<Derived, ALUInputMuxControlSignals>(context) {
+    this->control_signal.reset(ALUInputMuxControlSignals::IDEXStageRegisters);
 
-    this->control_signal = ALUInputMuxControlSignals::IDEXStageRegisters;
-
-    this->is_reset_flag_set = false;
+    this->readiness.track(this->getRequiredBits(this->getPipelineType()), 0U, this->RESET_FLAG_SET);
 
     this->alu = nullptr;
     this->logger = nullptr;
-
-    this->is_id_ex_stage_registers_value_set = false;
-    this->is_ex_mem_stage_registers_value_set = false;
-    this->is_mem_wb_stage_registers_value_set = false;
 }
 
-void ALUInputForwardingMuxBase::initDependencies() {
+template<typename Derived>
+void ALUInputForwardingMuxBase<Derived>::initDependencies() {
     std::lock_guard<std::mutex> mux_lock (this->getModuleDependencyMutex());
 
     if (this->alu && this->logger) {
         return;
     }
 
-    this->alu = ALU::init();
-    this->logger = Logger::init();
-}
+    this->alu = this->context->template get<ALU>();
+    this->logger = this->context->template get<Logger>();
 
-void ALUInputForwardingMuxBase::setInput(MuxInputType type, MuxInputDataType value) {
-    if (!std::holds_alternative<ALUInputMuxInputTypes>(type) ||
-            !std::holds_alternative<std::bitset<WORD_BIT_COUNT>>(value)) {
-        throw std::runtime_error("ALUInputForwardingMuxBase::setInput: incompatible data types passed.");
-    }
+    this->connectInput(this->control_signal, this->context->template get<ForwardingUnit>());
+    this->connectInput(this->mem_wb_stage_registers_value, this->context->template get<WBMux>());
+}
 
-    this->log("setInput waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> mux_lock (this->getModuleMutex());
-
-    if (std::get<ALUInputMuxInputTypes>(type) == ALUInputMuxInputTypes::IDEXStageRegisters) {
-        this->id_ex_stage_registers_value = std::bitset<WORD_BIT_COUNT>(std::get<std::bitset<WORD_BIT_COUNT>>(value));
-        this->is_id_ex_stage_registers_value_set = true;
-    } else if (std::get<ALUInputMuxInputTypes>(type) == ALUInputMuxInputTypes::EXMEMStageRegisters) {
-        this->ex_mem_stage_registers_value = std::bitset<WORD_BIT_COUNT>(std::get<std::bitset<WORD_BIT_COUNT>>(value));
-        this->is_ex_mem_stage_registers_value_set = true;
-    } else if (std::get<ALUInputMuxInputTypes>(type) == ALUInputMuxInputTypes::MEMWBStageRegisters) {
-        this->mem_wb_stage_registers_value = std::bitset<WORD_BIT_COUNT>(std::get<std::bitset<WORD_BIT_COUNT>>(value));
-        this->is_mem_wb_stage_registers_value_set = true;
-    } else {
-        throw std::runtime_error("ALUInputForwardingMuxBase::setInput parameters did not match any input type.");
-    }
+template<typename Derived>
+void ALUInputForwardingMuxBase<Derived>::setMuxControlSignal(ALUInputMuxControlSignals new_signal) {
+    this->log("setControlSignal control set.");
+    this->setControlSignal(new_signal);
+}
 
-    this->log("setInput updated value.");
-    this->notifyModuleConditionVariable();
+template<typename Derived>
+void ALUInputForwardingMuxBase<Derived>::setPipelineType(PipelineType current_type) {
+    Module::setPipelineType(current_type);
+    this->requireReadiness(this->getRequiredBits(current_type));
 }
 
-void ALUInputForwardingMuxBase::setMuxControlSignal(ALUInputMuxControlSignals new_signal) {
-    this->log("setControlSignal waiting to be woken up and acquire lock.");
+/**
+ * The single stage pipeline has nothing to forward, the values of the later stages are only waited for in the five
+ * stage pipeline.
+ */
+template<typename Derived>
+uint32_t ALUInputForwardingMuxBase<Derived>::getRequiredBits(PipelineType current_type) {
+    uint32_t required_bits = this->getInputPortBits() | this->CONTROL_SIGNAL_SET;
+
+    if (current_type == PipelineType::Single) {
+        required_bits &= ~(this->template getInputPortBit<ALUInputMuxInputTypes::EXMEMStageRegisters>() |
+                this->template getInputPortBit<ALUInputMuxInputTypes::MEMWBStageRegisters>());
+    }
 
-    std::lock_guard<std::mutex> mux_lock (this->getModuleMutex());
+    return required_bits;
+}
 
-    this->control_signal = new_signal;
-    this->is_control_signal_set = true;
+template<typename Derived>
+void ALUInputForwardingMuxBase<Derived>::resetState() {
+    this->id_ex_stage_registers_value.reset();
+    this->ex_mem_stage_registers_value.reset();
+    this->mem_wb_stage_registers_value.reset();
+    this->control_signal.reset(ALUInputMuxControlSignals::IDEXStageRegisters);
 
-    this->log("setControlSignal control set.");
-    this->notifyModuleConditionVariable();
+    this->readiness.clear(this->getInputPortBits() | this->CONTROL_SIGNAL_SET);
 }
 
-void ALUInputForwardingMuxBase::resetState() {
-    this->is_id_ex_stage_registers_value_set = false;
-    this->is_ex_mem_stage_registers_value_set = false;
-    this->is_mem_wb_stage_registers_value_set = false;
+template<typename Derived>
+void ALUInputForwardingMuxBase<Derived>::reset() {
+    this->setReadiness(this->RESET_FLAG_SET);
+}
 
-    this->id_ex_stage_registers_value = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->ex_mem_stage_registers_value = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->mem_wb_stage_registers_value = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
+template<typename Derived>
+bool ALUInputForwardingMuxBase<Derived>::isReadyToExecute() {
+    return this->readiness.isReady();
 }
 
-void ALUInputForwardingMuxBase::reset() {
-    std::lock_guard<std::mutex> alu_input_forwarding_mux_lock (this->getModuleMutex());
+template<typename Derived>
+void ALUInputForwardingMuxBase<Derived>::execute() {
+    if (this->readiness.isSet(this->RESET_FLAG_SET)) {
+        this->template log<LogLevel::Info>("Resetting stage.");
 
-    this->is_reset_flag_set = true;
-    this->notifyModuleConditionVariable();
-}
+        this->resetState();
+        this->readiness.clear(this->RESET_FLAG_SET);
 
-void ALUInputForwardingMuxBase::run() {
-    this->initDependencies();
+        this->template log<LogLevel::Info>("Reset.");
+        return;
+    }
 
-    while (this->isAlive()) {
-        this->log("Waiting to be woken up and acquire lock.");
+    this->log("Woken up and acquired lock.");
 
-        std::unique_lock<std::mutex> mux_lock (this->getModuleMutex());
-        this->getModuleConditionVariable().wait(
-                mux_lock,
-                [this] {
-                    return this->is_id_ex_stage_registers_value_set && (this->getPipelineType() == PipelineType::Single ||
-                            (this->is_ex_mem_stage_registers_value_set && this->is_mem_wb_stage_registers_value_set))
-                            && this->is_control_signal_set || this->isKilled() || this->is_reset_flag_set;
-                }
-        );
+    std::bitset<WORD_BIT_COUNT> output;
 
-        if (this->isKilled()) {
-            this->log("Killed.");
+    switch (this->control_signal.get()) {
+        case ALUInputMuxControlSignals::IDEXStageRegisters:
+            output = this->id_ex_stage_registers_value.get();
             break;
-        }
-
-        if (this->is_reset_flag_set) {
-            this->log("Resetting stage.");
+        case ALUInputMuxControlSignals::EXMEMStageRegisters:
+            output = this->ex_mem_stage_registers_value.get();
+            break;
+        case ALUInputMuxControlSignals::MEMWBStageRegisters:
+            output = this->mem_wb_stage_registers_value.get();
+            break;
+        default:
+            throw std::runtime_error(
+                    "ALUInputForwardingMuxBase::execute: control signal type did not match any existing type."
+            );
+    }
 
-            this->resetState();
-            this->is_reset_flag_set = false;
+    this->markInputsEvaluated();
+    static_cast<Derived *>(this)->passOutput(output);
+}
 
-            this->log("Reset.");
-            continue;
-        }
+template<typename Derived>
+bool ALUInputForwardingMuxBase<Derived>::isEvaluationSkippable() {
+    if (this->readiness.isSet(this->RESET_FLAG_SET) || this->control_signal.isChanged()) {
+        return false;
+    }
 
-        this->log("Woken up and acquired lock.");
+    switch (this->control_signal.get()) {
+        case ALUInputMuxControlSignals::EXMEMStageRegisters:
+            return !this->ex_mem_stage_registers_value.isChanged();
+        case ALUInputMuxControlSignals::MEMWBStageRegisters:
+            return !this->mem_wb_stage_registers_value.isChanged();
+        default:
+            return !this->id_ex_stage_registers_value.isChanged();
+    }
+}
 
-        this->passOutput();
+template<typename Derived>
+void ALUInputForwardingMuxBase<Derived>::markInputsEvaluated() {
+    this->id_ex_stage_registers_value.markEvaluated();
+    this->ex_mem_stage_registers_value.markEvaluated();
+    this->mem_wb_stage_registers_value.markEvaluated();
+    this->control_signal.markEvaluated();
 
-        this->is_id_ex_stage_registers_value_set = false;
-        this->is_ex_mem_stage_registers_value_set = false;
-        this->is_mem_wb_stage_registers_value_set = false;
-        this->is_control_signal_set = false;
-    }
+    this->readiness.clear(this->getInputPortBits() | this->CONTROL_SIGNAL_SET);
 }
 
-Stage ALUInputForwardingMuxBase::getModuleStage() {
+template<typename Derived>
+Stage ALUInputForwardingMuxBase<Derived>::getModuleStage() {
     return Stage::EX;
 }
+
+template class ALUInputForwardingMuxBase<ALUInput1ForwardingMux>;
+template class ALUInputForwardingMuxBase<ALUInput2ForwardingMux>;
@@ -2,28 +2,12 @@
 
 std::bitset<WORD_BIT_COUNT> BitwiseOperations::addInputs(std::bitset<WORD_BIT_COUNT> value1,
                                                          std::bitset<WORD_BIT_COUNT> value2) {
-    bool carry = false;
-    std::bitset<WORD_BIT_COUNT> result;
-
-    for (int i = 0; i < WORD_BIT_COUNT; ++i) {
-        bool input_1_bit = value1.test(i);
-        bool input_2_bit = value2.test(i);
-
-        result[i] = input_1_bit ^ input_2_bit ^ carry;
-        carry = (input_1_bit && input_2_bit) || (carry && (input_1_bit ^ input_2_bit));
-    }
-
-    return result;
+    return {BitwiseOperations::addWords(value1.to_ulong(), value2.to_ulong())};
 }
 
 std::bitset<WORD_BIT_COUNT> BitwiseOperations::subtractInputs(std::bitset<WORD_BIT_COUNT> value1,
                                                               std::bitset<WORD_BIT_COUNT> value2) {
-    std::bitset<WORD_BIT_COUNT> inverted_input_2 = ~value2;
-    std::bitset<WORD_BIT_COUNT> one;
-    one.set(0);
-
-    std::bitset<WORD_BIT_COUNT> complement_input_2 = BitwiseOperations::addInputs(inverted_input_2, one);
-    return addInputs(value1, complement_input_2);
+    return {BitwiseOperations::subtractWords(value1.to_ulong(), value2.to_ulong())};
 }
 
 std::bitset<WORD_BIT_COUNT> BitwiseOperations::bitwiseXorInputs(std::bitset<WORD_BIT_COUNT> value1,
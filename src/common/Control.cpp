@@ -1,8 +1,19 @@
 #include "../../include/common/Control.h"
-
-Control::Control(Instruction *current_instruction, PipelineType current_pipeline_type) {
+#include "../../include/state/RegisterFile.h"
+#include "../../include/combinational/mux/IFMux.h"
+#include "../../include/combinational/mux/WBMux.h"
+#include "../../include/combinational/mux/EXMuxALUInput2.h"
+#include "../../include/combinational/mux/EXMuxALUInput1.h"
+#include "../../include/combinational/ALU.h"
+#include "../../include/state/DataMemory.h"
+#include "../../include/state/stage-registers/IFIDStageRegisters.h"
+#include "../../include/state/stage-registers/IDEXStageRegisters.h"
+#include "../../include/state/stage-registers/EXMEMStageRegisters.h"
+
+Control::Control(const Instruction *current_instruction, PipelineType current_pipeline_type, SimulationContext *context) {
     this->pipeline_type = current_pipeline_type;
     this->instruction = current_instruction;
+    this->context = context;
 
     this->is_reg_write_asserted = false;
     this->is_pc_src_asserted = false;
@@ -29,6 +40,8 @@ Control::Control(Instruction *current_instruction, PipelineType current_pipeline
     this->id_ex_stage_registers = nullptr;
     this->ex_mem_stage_registers = nullptr;
 
+    this->execution_engine = this->context->get<ExecutionEngine>();
+
     this->generateSignals();
     this->generateALUOpCode();
 }
@@ -125,38 +138,32 @@ void Control::toggleMEMStageControlSignals() {
         this->initDependencies();
     }
 
-    this->is_pc_src_asserted = this->is_pc_src_asserted &&
-            (this->is_alu_result_zero ^ this->is_not_equal_branch_comparison_instruction_flag) &&
-            this->is_branch_instruction && !this->is_nop_asserted_flag;
+    this->is_pc_src_asserted = this->isBranchTaken();
 
     this->if_mux->assertControlSignal(this->is_pc_src_asserted && !this->is_nop_asserted_flag);
     this->data_memory->setMemWrite(this->is_mem_write_asserted && !this->is_nop_asserted_flag);
     this->data_memory->setMemRead(this->is_mem_read_asserted && !this->is_nop_asserted_flag);
 
-    std::thread pass_nop_if_id_registers_thread (
-            &Control::passNopToIFIDStageRegisters,
-            this,
+    this->execution_engine->dispatch(std::bind(
+            &IFIDStageRegisters::setNop,
+            this->if_id_stage_registers,
             (this->is_pc_src_asserted || this->is_jal_instruction) && this->pipeline_type == PipelineType::Five &&
             !this->is_nop_asserted_flag
-    );
+    ));
 
-    std::thread pass_nop_id_ex_registers_thread (
-            &Control::passNopToIDEXStageRegisters,
-            this,
+    this->execution_engine->dispatch(std::bind(
+            &IDEXStageRegisters::setNop,
+            this->id_ex_stage_registers,
             (this->is_pc_src_asserted || this->is_jal_instruction) && this->pipeline_type == PipelineType::Five &&
             !this->is_nop_asserted_flag
-    );
+    ));
 
-    std::thread pass_nop_ex_mem_registers_thread (
-            &Control::passNopToEXMEMStageRegisters,
-            this,
+    this->execution_engine->dispatch(std::bind(
+            &EXMEMStageRegisters::setNop,
+            this->ex_mem_stage_registers,
             (this->is_pc_src_asserted || this->is_jal_instruction) && this->pipeline_type == PipelineType::Five &&
             !this->is_nop_asserted_flag
-    );
-
-    pass_nop_if_id_registers_thread.detach();
-    pass_nop_id_ex_registers_thread.detach();
-    pass_nop_ex_mem_registers_thread.detach();
+    ));
 }
 
 void Control::toggleWBStageControlSignals() {
@@ -167,53 +174,52 @@ void Control::toggleWBStageControlSignals() {
     this->register_file->setRegWriteSignal(this->is_reg_write_asserted && !this->is_nop_asserted_flag);
     this->wb_mux->assertControlSignal(this->is_mem_to_reg_asserted && !this->is_nop_asserted_flag);
 
-    std::thread pass_nop_id_ex_registers_thread (
-            &Control::passNopToIDEXStageRegisters,
-            this,
+    this->execution_engine->dispatch(std::bind(
+            &IDEXStageRegisters::setNop,
+            this->id_ex_stage_registers,
             (this->is_pc_src_asserted || this->is_jal_instruction) && this->pipeline_type == PipelineType::Five &&
             !this->is_nop_asserted_flag
-    );
+    ));
 
-    std::thread pass_nop_ex_mem_registers_thread (
-            &Control::passNopToEXMEMStageRegisters,
-            this,
+    this->execution_engine->dispatch(std::bind(
+            &EXMEMStageRegisters::setNop,
+            this->ex_mem_stage_registers,
             (this->is_pc_src_asserted || this->is_jal_instruction) && this->pipeline_type == PipelineType::Five &&
             !this->is_nop_asserted_flag
-    );
+    ));
+}
 
-    pass_nop_id_ex_registers_thread.detach();
-    pass_nop_ex_mem_registers_thread.detach();
+bool Control::isBranchTaken() const {
+    return this->is_pc_src_asserted &&
+            (this->is_alu_result_zero ^ this->is_not_equal_branch_comparison_instruction_flag) &&
+            this->is_branch_instruction && !this->is_nop_asserted_flag;
 }
 
 void Control::initDependencies() {
-    this->register_file = RegisterFile::init();
-    this->if_mux = IFMux::init();
-    this->ex_mux_alu_input_1 = EXMuxALUInput1::init();
-    this->ex_mux_alu_input_2 = EXMuxALUInput2::init();
-    this->alu = ALU::init();
-    this->data_memory = DataMemory::init();
-    this->wb_mux = WBMux::init();
-    this->if_id_stage_registers = IFIDStageRegisters::init();
-    this->id_ex_stage_registers = IDEXStageRegisters::init();
-    this->ex_mem_stage_registers = EXMEMStageRegisters::init();
+    this->register_file = this->context->get<RegisterFile>();
+    this->if_mux = this->context->get<IFMux>();
+    this->ex_mux_alu_input_1 = this->context->get<EXMuxALUInput1>();
+    this->ex_mux_alu_input_2 = this->context->get<EXMuxALUInput2>();
+    this->alu = this->context->get<ALU>();
+    this->data_memory = this->context->get<DataMemory>();
+    this->wb_mux = this->context->get<WBMux>();
+    this->if_id_stage_registers = this->context->get<IFIDStageRegisters>();
+    this->id_ex_stage_registers = this->context->get<IDEXStageRegisters>();
+    this->ex_mem_stage_registers = this->context->get<EXMEMStageRegisters>();
 }
 
 void Control::setNop(bool is_asserted) {
     this->is_nop_asserted_flag = is_asserted;
 }
 
-Control *Control::deepCopy(Control *source) {
-    if (!source) {
-        return nullptr;
-    }
+Control Control::getNextStageControl() const {
+    Control next_stage_control (*this);
 
-    auto *deep_copy = new Control(source->instruction, source->pipeline_type);
-    if (source->is_nop_asserted_flag) {
-        deep_copy->is_nop_asserted_flag = true;
-    } else {
-        deep_copy->is_nop_asserted_flag = false;
-    }
-    return deep_copy;
+    // Both are generated from the instruction and only changed by the stage that evaluates them
+    next_stage_control.is_alu_result_zero = false;
+    next_stage_control.is_pc_src_asserted = next_stage_control.is_branch_instruction;
+
+    return next_stage_control;
 }
 
 bool Control::isRegWriteAsserted() const {
@@ -224,29 +230,17 @@ bool Control::isMemReadAsserted() const {
     return this->is_mem_read_asserted && !this->is_nop_asserted_flag;
 }
 
-void Control::passNopToIFIDStageRegisters(bool is_signal_asserted) {
-    this->if_id_stage_registers->setNop(is_signal_asserted);
-}
-
-void Control::passNopToIDEXStageRegisters(bool is_signal_asserted) {
-    this->id_ex_stage_registers->setNop(is_signal_asserted);
-}
-
-void Control::passNopToEXMEMStageRegisters(bool is_signal_asserted) {
-    this->ex_mem_stage_registers->setNop(is_signal_asserted);
-}
-
-void Control::printState() {
-    std::cout << "control::is_reg_write_asserted: " << this->is_reg_write_asserted << std::endl;
-    std::cout << "control::is_pc_src_asserted: " << this->is_pc_src_asserted << std::endl;
-    std::cout << "control::is_alu_src_asserted: " << this->is_alu_src_asserted << std::endl;
-    std::cout << "control::is_mem_read_asserted: " << this->is_mem_read_asserted << std::endl;
-    std::cout << "control::is_mem_write_asserted: " << this->is_mem_write_asserted << std::endl;
-    std::cout << "control::is_mem_to_reg_asserted: " << this->is_mem_to_reg_asserted << std::endl;
-    std::cout << "control::is_branch_instruction: " << this->is_branch_instruction << std::endl;
-    std::cout << "control::is_alu_result_zero: " << this->is_alu_result_zero << std::endl;
-    std::cout << "control::is_jal_instruction: " << this->is_jal_instruction << std::endl;
-    std::cout << "control::is_halt_instruction: " << this->is_halt_instruction << std::endl;
-    std::cout << "control::is_nop_asserted_flag: " << this->is_nop_asserted_flag << std::endl;
-    std::cout << "control::alu_op: " << this->alu_op.to_string() << std::endl;
+void Control::printState(std::ostream &state) const {
+    state << "control::is_reg_write_asserted: " << this->is_reg_write_asserted << '\n';
+    state << "control::is_pc_src_asserted: " << this->is_pc_src_asserted << '\n';
+    state << "control::is_alu_src_asserted: " << this->is_alu_src_asserted << '\n';
+    state << "control::is_mem_read_asserted: " << this->is_mem_read_asserted << '\n';
+    state << "control::is_mem_write_asserted: " << this->is_mem_write_asserted << '\n';
+    state << "control::is_mem_to_reg_asserted: " << this->is_mem_to_reg_asserted << '\n';
+    state << "control::is_branch_instruction: " << this->is_branch_instruction << '\n';
+    state << "control::is_alu_result_zero: " << this->is_alu_result_zero << '\n';
+    state << "control::is_jal_instruction: " << this->is_jal_instruction << '\n';
+    state << "control::is_halt_instruction: " << this->is_halt_instruction << '\n';
+    state << "control::is_nop_asserted_flag: " << this->is_nop_asserted_flag << '\n';
+    state << "control::alu_op: " << this->alu_op.to_string() << '\n';
 }
@@ -0,0 +1,61 @@
+#include "../../include/common/CycleBarrier.h"
+
+#include <stdexcept>
+
+CycleBarrier::CycleBarrier(std::function<void()> on_completion) {
+    this->on_completion = std::move(on_completion);
+    this->participant_count = 0;
+    this->arrived_count = 0;
+    this->phase = 0UL;
+}
+
+void CycleBarrier::registerParticipants(int count) {
+    if (count <= 0) {
+        throw std::runtime_error("CycleBarrier::registerParticipants: participant count has to be positive");
+    }
+
+    this->participant_count += count;
+}
+
+int CycleBarrier::getParticipantCount() const {
+    return this->participant_count;
+}
+
+void CycleBarrier::arrive() {
+    if (this->arrived_count.fetch_add(1, std::memory_order_acq_rel) + 1 == this->participant_count) {
+        this->complete();
+    }
+}
+
+void CycleBarrier::arriveAndWait() {
+    // Read before arriving, the phase cannot advance without this arrival
+    unsigned long arrival_phase = this->phase.load(std::memory_order_acquire);
+
+    if (this->arrived_count.fetch_add(1, std::memory_order_acq_rel) + 1 == this->participant_count) {
+        this->complete();
+        return;
+    }
+
+    for (int i = 0; i < CycleBarrier::SPIN_ITERATION_COUNT; ++i) {
+        if (this->phase.load(std::memory_order_acquire) != arrival_phase) {
+            return;
+        }
+
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    while (this->phase.load(std::memory_order_acquire) == arrival_phase) {
+        this->phase.wait(arrival_phase, std::memory_order_acquire);
+    }
+}
+
+void CycleBarrier::complete() {
+    // Waiting threads wait for the phase to change, the next cycle only starts after the completion
+    this->arrived_count.store(0, std::memory_order_relaxed);
+    this->on_completion();
+
+    this->phase.fetch_add(1UL, std::memory_order_release);
+    this->phase.notify_all();
+}
@@ -0,0 +1,161 @@
+#include "../../include/common/EventLogFormat.h"
+
+#include <algorithm>
+
+EventLogHeader EventLogFormat::makeHeader() {
+    EventLogHeader header {};
+
+    std::copy(std::begin(MAGIC), std::end(MAGIC), header.magic);
+    header.version = VERSION;
+
+    return header;
+}
+
+bool EventLogFormat::isValidHeader(const EventLogHeader &header) {
+    return std::equal(std::begin(MAGIC), std::end(MAGIC), header.magic) && header.version == VERSION;
+}
+
+void EventLogFormat::writeRecord(std::ostream &output, const EventLogRecord &record, uint64_t &previous_cycle) {
+    char buffer[MAX_ENCODED_RECORD_SIZE];
+    char *end = buffer + 1;
+
+    bool is_definition = record.kind == EventLogRecordKind::ModuleDefinition ||
+            record.kind == EventLogRecordKind::EventDefinition;
+
+    // Cycles of one stage only move forward within a pipeline, zigzag keeps the step back to a new pipeline small
+    int64_t cycle_delta = is_definition ? 0 : static_cast<int64_t>(record.cycle - previous_cycle);
+    uint64_t zigzag_cycle_delta = (static_cast<uint64_t>(cycle_delta) << 1) ^ static_cast<uint64_t>(cycle_delta >> 63);
+
+    uint8_t tag = static_cast<uint8_t>(record.kind) & KIND_MASK;
+    tag |= record.payload_1 != 0 ? PAYLOAD_1_FLAG : 0;
+    tag |= record.payload_2 != 0 ? PAYLOAD_2_FLAG : 0;
+
+    if (zigzag_cycle_delta < CYCLE_DELTA_ESCAPE) {
+        tag |= zigzag_cycle_delta << CYCLE_DELTA_SHIFT;
+    } else {
+        tag |= CYCLE_DELTA_ESCAPE << CYCLE_DELTA_SHIFT;
+        end = EventLogFormat::writeVarint(end, zigzag_cycle_delta);
+    }
+
+    buffer[0] = static_cast<char>(tag);
+    end = EventLogFormat::writeVarint(end, (static_cast<uint64_t>(record.event_id) << MODULE_ID_BIT_COUNT) |
+            record.module_id);
+
+    if (record.payload_1 != 0) {
+        end = EventLogFormat::writeVarint(end, record.payload_1);
+    }
+
+    if (record.payload_2 != 0) {
+        end = EventLogFormat::writeVarint(end, record.payload_2);
+    }
+
+    if (!is_definition) {
+        previous_cycle = record.cycle;
+    }
+
+    output.write(buffer, end - buffer);
+}
+
+bool EventLogFormat::readRecord(std::istream &input, EventLogRecord &record, uint64_t &previous_cycle) {
+    int tag = input.get();
+
+    if (tag == std::istream::traits_type::eof()) {
+        return false;
+    }
+
+    record = EventLogRecord {};
+    record.kind = static_cast<EventLogRecordKind>(tag & KIND_MASK);
+
+    uint64_t zigzag_cycle_delta = (tag >> CYCLE_DELTA_SHIFT) & CYCLE_DELTA_ESCAPE;
+    uint64_t identifiers;
+    uint64_t payload;
+
+    if (zigzag_cycle_delta == CYCLE_DELTA_ESCAPE && !EventLogFormat::readVarint(input, zigzag_cycle_delta)) {
+        return false;
+    }
+
+    if (!EventLogFormat::readVarint(input, identifiers)) {
+        return false;
+    }
+
+    record.event_id = identifiers >> MODULE_ID_BIT_COUNT;
+    record.module_id = identifiers & ((1U << MODULE_ID_BIT_COUNT) - 1U);
+
+    if (tag & PAYLOAD_1_FLAG) {
+        if (!EventLogFormat::readVarint(input, payload)) {
+            return false;
+        }
+
+        record.payload_1 = payload;
+    }
+
+    if (tag & PAYLOAD_2_FLAG) {
+        if (!EventLogFormat::readVarint(input, payload)) {
+            return false;
+        }
+
+        record.payload_2 = payload;
+    }
+
+    previous_cycle += static_cast<uint64_t>(static_cast<int64_t>(zigzag_cycle_delta >> 1) ^
+            -static_cast<int64_t>(zigzag_cycle_delta & 1U));
+    record.cycle = previous_cycle;
+
+    return true;
+}
+
+char *EventLogFormat::writeVarint(char *output, uint64_t value) {
+    while (value >= 0x80) {
+        *output++ = static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+
+    *output++ = static_cast<char>(value);
+
+    return output;
+}
+
+bool EventLogFormat::readVarint(std::istream &input, uint64_t &value) {
+    value = 0;
+
+    for (int shift = 0; shift < 64; shift += 7) {
+        int byte = input.get();
+
+        if (byte == std::istream::traits_type::eof()) {
+            return false;
+        }
+
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void EventLogFormat::writeEventText(std::ostream &output, std::string_view module_tag,
+                                    std::string_view message_format, uint32_t payload_1, uint32_t payload_2) {
+    output << '[' << module_tag << "] ";
+
+    uint32_t payloads[] = {payload_1, payload_2};
+    int payload_index = 0;
+
+    while (true) {
+        std::string_view::size_type placeholder_index = message_format.find(PAYLOAD_PLACEHOLDER);
+
+        if (placeholder_index == std::string_view::npos || payload_index == 2) {
+            break;
+        }
+
+        output << message_format.substr(0, placeholder_index) << payloads[payload_index++];
+        message_format.remove_prefix(placeholder_index + PAYLOAD_PLACEHOLDER.size());
+    }
+
+    output << message_format << '\n';
+}
+
+void EventLogFormat::writeDroppedMessagesText(std::ostream &output, unsigned long dropped_messages_count) {
+    output << "[Logger] " << dropped_messages_count << " messages dropped, ring buffer full" << '\n';
+}
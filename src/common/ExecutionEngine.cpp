@@ -0,0 +1,344 @@
+#include "../../include/common/ExecutionEngine.h"
+#include "../../include/common/StageSynchronizer.h"
+
+#include <algorithm>
+
+thread_local bool ExecutionEngine::is_applying_clock_edge = false;
+
+ExecutionEngine::ExecutionEngine(SimulationContext *context) {
+    this->execution_mode = ExecutionMode::Threaded;
+    this->executing_module_index = ExecutionEngine::NO_EXECUTING_MODULE;
+    this->stage_synchronizer = nullptr;
+    this->context = context;
+}
+
+ExecutionEngine::~ExecutionEngine() = default;
+
+void ExecutionEngine::initDependencies() {
+    if (this->stage_synchronizer) {
+        return;
+    }
+
+    this->stage_synchronizer = this->context->get<StageSynchronizer>();
+}
+
+void ExecutionEngine::setExecutionMode(ExecutionMode new_execution_mode) {
+    this->execution_mode = new_execution_mode;
+}
+
+ExecutionMode ExecutionEngine::getExecutionMode() const {
+    return this->execution_mode;
+}
+
+bool ExecutionEngine::isCycleDriven() const {
+    return this->execution_mode == ExecutionMode::CycleDriven || this->execution_mode == ExecutionMode::EventDriven ||
+           this->execution_mode == ExecutionMode::Coroutine;
+}
+
+bool ExecutionEngine::isEventDriven() const {
+    return this->execution_mode == ExecutionMode::EventDriven;
+}
+
+bool ExecutionEngine::isCoroutineDriven() const {
+    return this->execution_mode == ExecutionMode::Coroutine;
+}
+
+void ExecutionEngine::registerModule(Module *module) {
+    module->initDependencies();
+    module->registration_index = static_cast<int>(this->modules.size());
+
+    this->modules.push_back(module);
+    this->is_module_arrived.push_back(false);
+
+    this->is_module_waiting.push_back(false);
+    this->is_module_scheduled.push_back(false);
+    this->module_coroutines.push_back(module->runCoroutine());  // Runs up to its first waitForSignal()
+}
+
+void ExecutionEngine::scheduleModule(Module *module) {
+    if (module->registration_index != Module::NOT_REGISTERED) {
+        this->scheduleModule(module->registration_index);
+    }
+}
+
+void ExecutionEngine::scheduleModule(int module_index) {
+    if (!this->is_module_scheduled.at(module_index)) {
+        this->is_module_scheduled.at(module_index) = true;
+        this->scheduled_module_indices.push_back(module_index);
+    }
+}
+
+ExecutionEngine::SignalAwaiter ExecutionEngine::waitForSignal(Module *module) {
+    if (module->registration_index == Module::NOT_REGISTERED) {
+        throw std::runtime_error("ExecutionEngine::waitForSignal: module " + module->getModuleTag() + " is not registered");
+    }
+
+    return {this, module->registration_index};
+}
+
+ExecutionEngine::SignalAwaiter::SignalAwaiter(ExecutionEngine *execution_engine, int module_index) {
+    this->execution_engine = execution_engine;
+    this->module_index = module_index;
+}
+
+bool ExecutionEngine::SignalAwaiter::await_ready() const noexcept {
+    return false;
+}
+
+/**
+ * Like the predicate of the condition variable wait in run(), readiness is checked once before waiting. It covers
+ * signals that reached the module before it was registered and a ready state left behind by its own execute().
+ */
+void ExecutionEngine::SignalAwaiter::await_suspend(std::coroutine_handle<>) const {
+    this->execution_engine->is_module_waiting.at(this->module_index) = true;
+
+    Module *module = this->execution_engine->modules.at(this->module_index);
+
+    if (this->execution_engine->isCoroutineDriven() && !module->isKilled() && module->isReadyToExecute()) {
+        this->execution_engine->scheduleModule(this->module_index);
+    }
+}
+
+void ExecutionEngine::SignalAwaiter::await_resume() const noexcept {}
+
+void ExecutionEngine::connectInput(SignalBase &input, Module *owner, Module *driver) {
+    std::lock_guard<std::mutex> connection_lock (this->connection_mutex);
+
+    if (input.getOwner()) {
+        return;
+    }
+
+    input.setOwner(owner);
+    driver->driven_inputs.push_back(&input);
+}
+
+void ExecutionEngine::dispatch(std::function<void()> signal) {
+    if (this->isCycleDriven()) {
+        this->pending_signals.push(std::move(signal));
+        return;
+    }
+
+    this->getWorkerPool()->submit(std::move(signal));
+}
+
+void ExecutionEngine::dispatchAndWait(std::initializer_list<std::function<void()>> signals) {
+    for (const std::function<void()> &signal: signals) {
+        signal();
+    }
+}
+
+WorkerPool *ExecutionEngine::getWorkerPool() {
+    std::call_once(this->worker_pool_initialization_flag, [this] {
+        this->initDependencies();
+
+        const std::string &context_name = this->context->getName();
+
+        // No task waits for another one, the workers only bound how many signals are delivered in parallel
+        this->worker_pool = std::make_unique<WorkerPool>(
+                static_cast<int>(std::max(1U, std::thread::hardware_concurrency())),
+                context_name.empty() ? "WorkerPool" : "WorkerPool-" + context_name
+        );
+    });
+
+    return this->worker_pool.get();
+}
+
+std::vector<ModuleEvaluationStatistics> ExecutionEngine::getEvaluationStatistics() const {
+    std::vector<ModuleEvaluationStatistics> statistics;
+    statistics.reserve(this->modules.size());
+
+    for (Module *module: this->modules) {
+        statistics.push_back({module->getModuleTag(), module->evaluation_count, module->skipped_evaluation_count});
+    }
+
+    return statistics;
+}
+
+bool ExecutionEngine::deferUntilClockEdge(std::function<void()> update, bool is_nop_signal) {
+    if (ExecutionEngine::is_applying_clock_edge) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> clock_edge_lock (this->clock_edge_mutex);
+
+    if (is_nop_signal) {
+        this->clock_edge_nop_updates.push_back(std::move(update));
+    } else {
+        this->clock_edge_updates.push_back(std::move(update));
+    }
+
+    return true;
+}
+
+void ExecutionEngine::submitClockEdge() {
+    this->getWorkerPool()->submit([this] { this->applyClockEdge(); });
+}
+
+void ExecutionEngine::arriveSingleStage() {
+    if (this->executing_module_index != ExecutionEngine::NO_EXECUTING_MODULE) {
+        this->is_module_arrived.at(this->executing_module_index) = true;
+    }
+}
+
+void ExecutionEngine::runUntilPaused() {
+    this->initDependencies();
+
+    while (!this->stage_synchronizer->isPaused()) {
+        bool is_any_module_evaluated = this->isCoroutineDriven() ? this->resumeModuleCoroutines()
+                                                                 : this->evaluateModules();
+
+        if (!is_any_module_evaluated && this->clock_edge_updates.empty() && this->clock_edge_nop_updates.empty()) {
+            throw std::runtime_error("ExecutionEngine::runUntilPaused: pipeline stalled, no module is ready to execute");
+        }
+
+        this->stage_synchronizer->completeCycle();
+        this->applyClockEdge();
+    }
+}
+
+bool ExecutionEngine::evaluateModules() {
+    bool is_any_module_evaluated = false;
+    bool is_module_evaluated_in_pass = true;
+
+    while (is_module_evaluated_in_pass) {
+        is_module_evaluated_in_pass = false;
+
+        for (std::size_t i = 0; i < this->modules.size(); ++i) {
+            if (this->is_module_arrived.at(i)) {
+                continue;
+            }
+
+            Module *module = this->modules.at(i);
+            bool is_evaluation_skipped;
+
+            {
+                std::lock_guard<std::mutex> module_lock (module->getModuleMutex());
+
+                if (module->isKilled() || !module->isReadyToExecute()) {
+                    continue;
+                }
+
+                is_evaluation_skipped = this->isEvaluationSkipped(module);
+
+                if (is_evaluation_skipped) {
+                    ++module->skipped_evaluation_count;
+                    module->markInputsEvaluated();
+                } else {
+                    this->executing_module_index = static_cast<int>(i);
+                    ++module->evaluation_count;
+                    module->execute();
+                    this->executing_module_index = ExecutionEngine::NO_EXECUTING_MODULE;
+                }
+            }
+
+            if (is_evaluation_skipped) {
+                for (SignalBase *input: module->driven_inputs) {
+                    input->getOwner()->holdInput(*input);
+                }
+            }
+
+            this->drainPendingSignals();
+            is_module_evaluated_in_pass = true;
+            is_any_module_evaluated = true;
+        }
+    }
+
+    return is_any_module_evaluated;
+}
+
+bool ExecutionEngine::isEvaluationSkipped(Module *module) {
+    if (!this->isEventDriven() || module->driven_inputs.empty()) {
+        return false;
+    }
+
+    for (SignalBase *input: module->driven_inputs) {
+        if (!input->isHoldable()) {
+            return false;  // Reset or discarded since the driver last sent it
+        }
+    }
+
+    return module->isEvaluationSkippable();
+}
+
+bool ExecutionEngine::resumeModuleCoroutines() {
+    bool is_any_module_resumed = false;
+
+    for (int i: this->next_cycle_module_indices) {
+        this->scheduled_module_indices.push_back(i);
+    }
+
+    this->next_cycle_module_indices.clear();
+
+    while (!this->scheduled_module_indices.empty()) {
+        int i = this->scheduled_module_indices.front();
+        this->scheduled_module_indices.pop_front();
+
+        if (this->is_module_arrived.at(i)) {
+            this->next_cycle_module_indices.push_back(i);  // Stays scheduled
+            continue;
+        }
+
+        this->is_module_scheduled.at(i) = false;
+
+        if (!this->is_module_waiting.at(i)) {
+            continue;
+        }
+
+        Module *module = this->modules.at(i);
+
+        {
+            std::lock_guard<std::mutex> module_lock (module->getModuleMutex());
+
+            if (module->isKilled() || !module->isReadyToExecute()) {
+                continue;  // Scheduled again by the signal that makes it ready
+            }
+
+            this->executing_module_index = i;
+            this->is_module_waiting.at(i) = false;
+            ++module->evaluation_count;
+            this->module_coroutines.at(i).resume();
+            this->executing_module_index = ExecutionEngine::NO_EXECUTING_MODULE;
+        }
+
+        this->drainPendingSignals();
+        is_any_module_resumed = true;
+    }
+
+    return is_any_module_resumed;
+}
+
+void ExecutionEngine::drainPendingSignals() {
+    while (!this->pending_signals.empty()) {
+        std::function<void()> signal = std::move(this->pending_signals.front());
+        this->pending_signals.pop();
+
+        signal();
+    }
+}
+
+void ExecutionEngine::applyClockEdge() {
+    std::vector<std::function<void()>> nop_updates;
+    std::vector<std::function<void()>> updates;
+
+    {
+        std::lock_guard<std::mutex> clock_edge_lock (this->clock_edge_mutex);
+
+        nop_updates.swap(this->clock_edge_nop_updates);
+        updates.swap(this->clock_edge_updates);
+    }
+
+    // Nop signals land first so the stage registers know whether to discard the data updates that follow.
+    ExecutionEngine::is_applying_clock_edge = true;
+
+    for (std::function<void()> &update: nop_updates) {
+        update();
+    }
+
+    for (std::function<void()> &update: updates) {
+        update();
+    }
+
+    ExecutionEngine::is_applying_clock_edge = false;
+
+    std::fill(this->is_module_arrived.begin(), this->is_module_arrived.end(), false);
+}
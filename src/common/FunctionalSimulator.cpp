@@ -0,0 +1,147 @@
+#include "../../include/common/FunctionalSimulator.h"
+
+FunctionalSimulator::FunctionalSimulator(SimulationContext *context) {
+    this->context = context;
+
+    this->executed_instruction_count = 0UL;
+    this->is_halted = false;
+
+    this->read_data_2 = std::bitset<WORD_BIT_COUNT>(0UL);
+
+    this->instruction_memory = this->context->get<InstructionMemory>();
+    this->data_memory = this->context->get<DataMemory>();
+    this->register_file = this->context->get<RegisterFile>();
+    this->driver = this->context->get<Driver>();
+
+    this->program_counter = 0UL;  // The entry program counter is known once a program is loaded, see reset()
+}
+
+bool FunctionalSimulator::run(unsigned long max_instruction_count) {
+    for (unsigned long i = 0; i < max_instruction_count && !this->is_halted; ++i) {
+        this->step(true);
+    }
+
+    return this->is_halted;
+}
+
+/**
+ * Executes up to instruction_count instructions from the program entry, then hands the program counter, register file
+ * and data memory over to the pipeline, which has to be loaded and not yet started. Pipeline resets restart from the
+ * handed over state instead of the program entry.
+ */
+bool FunctionalSimulator::fastForward(unsigned long instruction_count) {
+    this->reset();
+
+    for (unsigned long i = 0; i < instruction_count && !this->is_halted; ++i) {
+        this->step(false);
+    }
+
+    this->driver->setEntryProgramCounter(this->program_counter);
+    this->register_file->keepRegisterFileContentsAcrossResets();
+    this->data_memory->keepDataMemoryContentsAcrossResets();
+
+    return this->is_halted;
+}
+
+void FunctionalSimulator::reset() {
+    this->program_counter = this->instruction_memory->entry_program_counter;
+    this->executed_instruction_count = 0UL;
+    this->is_halted = false;
+
+    this->read_data_2 = std::bitset<WORD_BIT_COUNT>(0UL);
+}
+
+void FunctionalSimulator::step(bool is_output_written) {
+    // IF
+    this->instruction_memory->program_counter.reset(this->program_counter);
+    this->instruction_memory->fetchInstructionFromMemory();
+
+    const Instruction *instruction = this->instruction_memory->decoded_instruction.instruction;
+    Control control (*this->instruction_memory->decoded_instruction.control_template);
+
+    InstructionType type = instruction->getType();
+    bool is_nop_asserted = control.is_nop_asserted_flag;
+
+    // ID
+    std::bitset<WORD_BIT_COUNT> read_data_1 = this->register_file->registers.at(instruction->getRs1().to_ulong());
+
+    if (type != InstructionType::I && type != InstructionType::S) {
+        this->read_data_2 = this->register_file->registers.at(instruction->getRs2().to_ulong());
+    }
+
+    std::bitset<WORD_BIT_COUNT> immediate = instruction->getSignExtendedImmediate();
+
+    // EX
+    bool is_jal_asserted = control.is_jal_instruction && !is_nop_asserted;
+
+    std::bitset<WORD_BIT_COUNT> alu_input_1 = is_jal_asserted ?
+            std::bitset<WORD_BIT_COUNT>(this->program_counter) : read_data_1;
+    std::bitset<WORD_BIT_COUNT> alu_input_2;
+
+    if (is_jal_asserted) {
+        alu_input_2 = std::bitset<WORD_BIT_COUNT>(4UL);
+    } else if (control.is_alu_src_asserted && !is_nop_asserted) {
+        alu_input_2 = immediate;
+    } else {
+        alu_input_2 = this->read_data_2;
+    }
+
+    std::bitset<WORD_BIT_COUNT> alu_result = ALU::evaluate(control.alu_op, alu_input_1, alu_input_2);
+    unsigned long branched_program_counter = BitwiseOperations::addInputs(
+            std::bitset<WORD_BIT_COUNT>(this->program_counter),
+            immediate
+    ).to_ulong();
+
+    // MEM
+    control.setIsALUResultZero(alu_result.to_ulong() == 0);
+
+    if (control.is_mem_write_asserted && !is_nop_asserted) {
+        this->data_memory->storeWord(alu_result.to_ulong(), this->read_data_2);
+    }
+
+    std::bitset<WORD_BIT_COUNT> read_data;
+
+    if (control.is_mem_read_asserted && !is_nop_asserted) {
+        read_data = this->data_memory->loadWord(alu_result.to_ulong());
+    }
+
+    bool is_branch_taken = control.isBranchTaken();
+
+    // WB
+    unsigned long register_destination = instruction->getRd().to_ulong();
+
+    if (control.is_reg_write_asserted && !is_nop_asserted && register_destination != 0) {
+        this->register_file->registers.at(register_destination) =
+                control.is_mem_to_reg_asserted ? read_data : alu_result;
+    }
+
+    if (is_output_written) {
+        this->register_file->writeRegisterFileContentsToOutputFile();
+    }
+
+    ++this->executed_instruction_count;
+
+    if (control.is_halt_instruction) {
+        if (is_output_written) {
+            this->register_file->flushRegisterFileOutputFile();
+            this->data_memory->writeDataMemoryContentsToOutput();
+        }
+
+        this->is_halted = true;
+        return;
+    }
+
+    this->program_counter = is_branch_taken ? branched_program_counter : this->program_counter + 4;
+}
+
+unsigned long FunctionalSimulator::getProgramCounter() const {
+    return this->program_counter;
+}
+
+unsigned long FunctionalSimulator::getExecutedInstructionCount() const {
+    return this->executed_instruction_count;
+}
+
+bool FunctionalSimulator::isHalted() const {
+    return this->is_halted;
+}
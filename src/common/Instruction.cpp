@@ -1,93 +1,136 @@
 #include "../../include/common/Instruction.h"
 
-Instruction::Instruction(std::string instruction) {
-    this->instruction = std::move(instruction);
+Instruction::Instruction(uint32_t instruction) {
+    this->instruction = instruction;
+    this->decode();
+}
+
+Instruction::Instruction(const std::string &instruction)
+        : Instruction(static_cast<uint32_t>(std::bitset<WORD_BIT_COUNT>(instruction).to_ulong())) { }
+
+uint32_t Instruction::extractBits(uint32_t bits, int base_bit_index, int bit_count) {
+    return (bits >> base_bit_index) & ((1U << bit_count) - 1U);
+}
+
+InstructionType Instruction::decodeType(uint8_t opcode) {
+    switch (opcode) {
+        case 0b0110011:
+            return InstructionType::R;
+        case 0b0010011:
+        case 0b0000011:
+            return InstructionType::I;
+        case 0b1101111:
+            return InstructionType::J;
+        case 0b1100011:
+            return InstructionType::B;
+        case 0b0100011:
+            return InstructionType::S;
+        case 0b1111111:
+            return InstructionType::HALT;
+        case 0b0000000:
+            return InstructionType::CUSTOM;
+        default:
+            return InstructionType::UNKNOWN;
+    }
+}
 
-    this->opcode_to_type_mapping = std::unordered_map<std::string, InstructionType>{
-            {"0110011", InstructionType::R},
-            {"0010011", InstructionType::I},
-            {"1101111", InstructionType::J},
-            {"1100011", InstructionType::B},
-            {"0000011", InstructionType::I},
-            {"0100011", InstructionType::S},
-            {"1111111", InstructionType::HALT},
-            {"0000000", InstructionType::CUSTOM}
-    };
+bool Instruction::isSupportedOpcode(uint8_t opcode) {
+    return Instruction::decodeType(opcode) != InstructionType::UNKNOWN;
+}
+
+void Instruction::decode() {
+    uint32_t bits = this->instruction;
+
+    this->fields.funct7 = Instruction::extractBits(bits, FUNCT7_BASE_BIT_INDEX, FUNCT7_BIT_COUNT);
+    this->fields.funct3 = Instruction::extractBits(bits, FUNCT3_BASE_BIT_INDEX, FUNCT3_BIT_COUNT);
+    this->fields.rs1 = Instruction::extractBits(bits, RS1_BASE_BIT_INDEX, REGISTER_BIT_COUNT);
+    this->fields.rs2 = Instruction::extractBits(bits, RS2_BASE_BIT_INDEX, REGISTER_BIT_COUNT);
+    this->fields.rd = Instruction::extractBits(bits, RD_BASE_BIT_INDEX, REGISTER_BIT_COUNT);
+    this->fields.opcode = Instruction::extractBits(bits, OPCODE_BASE_BIT_INDEX, OPCODE_BIT_COUNT);
+    this->fields.type = Instruction::decodeType(this->fields.opcode);
+
+    this->fields.immediate = 0;
+    this->fields.immediate_j = 0;
+    this->fields.sign_extended_immediate = 0;
+
+    if (this->fields.type == InstructionType::I) {  // imm[11:0] = bits 31 - 20
+        this->fields.immediate = Instruction::extractBits(bits, 20, GENERAL_IMMEDIATE_BIT_COUNT);
+    } else if (this->fields.type == InstructionType::S || this->fields.type == InstructionType::B) {
+        // imm[11 | 10 | 9:4 | 3:0] = bits 31 | 7 | 30 - 25 | 11 - 8, the B type layout is used for S type as well
+        this->fields.immediate = (Instruction::extractBits(bits, 31, 1) << 11) |
+                (Instruction::extractBits(bits, 7, 1) << 10) |
+                (Instruction::extractBits(bits, 25, 6) << 4) |
+                Instruction::extractBits(bits, 8, 4);
+    } else if (this->fields.type == InstructionType::J) {  // bits 31 - 12 as they are
+        this->fields.immediate_j = Instruction::extractBits(bits, J_TYPE_IMMEDIATE_BASE_BIT_INDEX, J_TYPE_IMMEDIATE_BIT_COUNT);
+    }
+
+    // Sign extension as performed by the immediate generator, B and J type offsets are in multiples of two bytes
+    if (this->fields.type == InstructionType::S || this->fields.type == InstructionType::I) {
+        this->fields.sign_extended_immediate = static_cast<uint32_t>(
+                static_cast<int32_t>(static_cast<uint32_t>(this->fields.immediate) << 20) >> 20
+        );
+    } else if (this->fields.type == InstructionType::B) {
+        this->fields.sign_extended_immediate = static_cast<uint32_t>(
+                static_cast<int32_t>(static_cast<uint32_t>(this->fields.immediate) << 20) >> 19
+        );
+    } else if (this->fields.type == InstructionType::J) {
+        this->fields.sign_extended_immediate = static_cast<uint32_t>(
+                static_cast<int32_t>(this->fields.immediate_j << 12) >> 11
+        );
+    }
 }
 
 std::bitset<Instruction::FUNCT7_BIT_COUNT> Instruction::getFunct7() const {  // bits 31 - 25
-    return std::bitset<FUNCT7_BIT_COUNT>(this->instruction.substr(FUNCT7_BASE_STRING_INDEX, FUNCT7_BIT_COUNT));
+    return {this->fields.funct7};
 }
 
 std::bitset<Instruction::FUNCT3_BIT_COUNT> Instruction::getFunct3() const {  // bits 14 - 12
-    return std::bitset<FUNCT3_BIT_COUNT>(this->instruction.substr(FUNCT3_BASE_STRING_INDEX, FUNCT3_BIT_COUNT));
+    return {this->fields.funct3};
 }
 
 std::bitset<Instruction::REGISTER_BIT_COUNT> Instruction::getRs1() const {  // bits 19 - 15
-    return std::bitset<REGISTER_BIT_COUNT>(this->instruction.substr(RS1_BASE_STRING_INDEX, REGISTER_BIT_COUNT));
+    return {this->fields.rs1};
 }
 
 std::bitset<Instruction::REGISTER_BIT_COUNT> Instruction::getRs2() const {  // bits 24 - 20
-    return std::bitset<REGISTER_BIT_COUNT>(this->instruction.substr(RS2_BASE_STRING_INDEX, REGISTER_BIT_COUNT));
+    return {this->fields.rs2};
 }
 
 std::bitset<Instruction::REGISTER_BIT_COUNT> Instruction::getRd() const {  // bits 11 - 7
-    return std::bitset<REGISTER_BIT_COUNT>(this->instruction.substr(RD_BASE_STRING_INDEX, REGISTER_BIT_COUNT));
+    return {this->fields.rd};
 }
 
 std::bitset<Instruction::OPCODE_BIT_COUNT> Instruction::getOpcode() const {  // bits 6 - 0
-    return std::bitset<OPCODE_BIT_COUNT>(this->instruction.substr(OPCODE_BASE_STRING_INDEX, OPCODE_BIT_COUNT));
+    return {this->fields.opcode};
 }
 
 std::bitset<Instruction::GENERAL_IMMEDIATE_BIT_COUNT> Instruction::getImmediate() const {
-    std::vector<std::pair<int, int>> segments;
-
-    if (this->getType() == InstructionType::I) {
-        segments = I_TYPE_IMMEDIATE_SEGMENTS;
-    } else if (this->getType() == InstructionType::S || this->getType() == InstructionType::B) {
-        segments = SB_TYPE_IMMEDIATE_SEGMENTS;
-    }
-
-    std::string immediate;
-
-    for (const std::pair<int, int> &segment: segments) {
-        immediate += this->instruction.substr(segment.first, segment.second);
-    }
-
-    return std::bitset<GENERAL_IMMEDIATE_BIT_COUNT>(immediate);
+    return {this->fields.immediate};
 }
 
 std::bitset<Instruction::J_TYPE_IMMEDIATE_BIT_COUNT> Instruction::getImmediateJ() const {
-    std::vector<std::pair<int, int>> segments;
-
-    if (this->getType() == InstructionType::J) {
-        segments = J_TYPE_IMMEDIATE_SEGMENTS;
-    }
-
-    std::string immediate;
+    return {this->fields.immediate_j};
+}
 
-    for (const std::pair<int, int> &segment: segments) {
-        immediate += this->instruction.substr(segment.first, segment.second);
-    }
+std::bitset<WORD_BIT_COUNT> Instruction::getSignExtendedImmediate() const {
+    return {this->fields.sign_extended_immediate};
+}
 
-    return std::bitset<J_TYPE_IMMEDIATE_BIT_COUNT>(immediate);
+uint32_t Instruction::getBits() const {
+    return this->instruction;
 }
 
 InstructionType Instruction::getType() const {
-    const auto element_iterator = this->opcode_to_type_mapping.find(this->getOpcode().to_string());
-
-    if (element_iterator == this->opcode_to_type_mapping.end()) {
+    if (this->fields.type == InstructionType::UNKNOWN) {
         std::cerr << "[Instruction] Unknown opcode" << std::endl;
-        return InstructionType::UNKNOWN;
     }
 
-    return element_iterator->second;
+    return this->fields.type;
 }
 
-Instruction *Instruction::deepCopy(const Instruction *source) {
-    if (!source) {
-        return nullptr;
-    }
+const Instruction *Instruction::getZeroInstruction() {
+    static const Instruction zero_instruction (0U);
 
-    return new Instruction(source->instruction);
+    return &zero_instruction;
 }
@@ -1,244 +1,403 @@
 #include "../../include/common/Logger.h"
 
-Logger *Logger::current_instance = nullptr;
+#include <iostream>
+
+LogFormat Logger::configured_log_format = LogFormat::Text;
+bool Logger::is_log_format_used = false;
+std::atomic<unsigned long> Logger::next_serial_number = 0;
 std::mutex Logger::initialization_mutex;
 
-Logger::Logger() {
+Logger::Logger(SimulationContext *context) {
+    {
+        std::lock_guard<std::mutex> logger_lock (Logger::initialization_mutex);
+
+        this->log_format = Logger::configured_log_format;
+        Logger::is_log_format_used = true;
+    }
+
+    // Loggers of named contexts write <Stage>-<name>.log so concurrent pipelines do not share files
+    const std::string &context_name = context->getName();
+    const std::string log_file_suffix = context_name.empty() ? "" : "-" + context_name;
+
+    this->serial_number = Logger::next_serial_number++;
     this->is_killed = false;
+    this->current_cycle = 0;
+    this->is_console_writing = false;
+
+    for (StageLog &stage_log: this->stage_logs) {
+        stage_log.dropped_messages_count = 0;
+    }
 
-    this->if_stage_log_file.open(LOG_DIRECTORY_PATH + IF_STAGE_LOG_FILE_NAME);
-    this->id_stage_log_file.open(LOG_DIRECTORY_PATH + ID_STAGE_LOG_FILE_NAME);
-    this->ex_stage_log_file.open(LOG_DIRECTORY_PATH + EX_STAGE_LOG_FILE_NAME);
-    this->mem_stage_log_file.open(LOG_DIRECTORY_PATH + MEM_STAGE_LOG_FILE_NAME);
-    this->wb_stage_log_file.open(LOG_DIRECTORY_PATH + WB_STAGE_LOG_FILE_NAME);
+    // A disabled Logger opens no files and starts no threads, console text is written by the calling thread
+    if (this->log_format == LogFormat::None) {
+        return;
+    }
 
-    std::thread if_stage_log_writer (&Logger::writeIFStageMessagesToFile, this);
-    std::thread id_stage_log_writer (&Logger::writeIDStageMessagesToFile, this);
-    std::thread ex_stage_log_writer (&Logger::writeEXStageMessagesToFile, this);
-    std::thread mem_stage_log_writer (&Logger::writeMEMStageMessagesToFile, this);
-    std::thread wb_stage_log_writer (&Logger::writeWBStageMessagesToFile, this);
+    const std::string &log_file_extension = this->log_format == LogFormat::Binary ?
+            BINARY_LOG_FILE_EXTENSION : TEXT_LOG_FILE_EXTENSION;
+
+    for (int i = 0; i < STAGE_COUNT; ++i) {
+        StageLog &stage_log = this->stage_logs.at(i);
+
+        stage_log.records = std::make_unique<LogRecord[]>(MESSAGE_RING_BUFFER_CAPACITY);
+
+        for (unsigned long j = 0; j < MESSAGE_RING_BUFFER_CAPACITY; ++j) {
+            stage_log.records[j].sequence.store(j, std::memory_order_relaxed);
+        }
+
+        stage_log.enqueue_position = 0;
+        stage_log.dequeue_position = 0;
+        stage_log.previous_cycle = 0;
+
+        // The stream buffer has to be installed before the file is opened to take effect
+        stage_log.log_file_buffer = std::make_unique<char[]>(LOG_FILE_BUFFER_SIZE);
+        stage_log.log_file.rdbuf()->pubsetbuf(stage_log.log_file_buffer.get(), LOG_FILE_BUFFER_SIZE);
+
+        if (this->log_format == LogFormat::Binary) {
+            stage_log.log_file.open(
+                    context->getLogDirectoryPath() + STAGE_LOG_FILE_NAMES.at(i) + log_file_suffix + log_file_extension,
+                    std::ios::binary
+            );
+
+            EventLogHeader header = EventLogFormat::makeHeader();
+            stage_log.log_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        } else {
+            stage_log.log_file.open(
+                    context->getLogDirectoryPath() + STAGE_LOG_FILE_NAMES.at(i) + log_file_suffix + log_file_extension
+            );
+        }
+    }
 
-    if_stage_log_writer.detach();
-    id_stage_log_writer.detach();
-    ex_stage_log_writer.detach();
-    mem_stage_log_writer.detach();
-    wb_stage_log_writer.detach();
+    for (int i = 0; i < STAGE_COUNT; ++i) {
+        StageLog &stage_log = this->stage_logs.at(i);
+
+        stage_log.writer = std::thread(
+                &Logger::writeStageMessagesToFile,
+                this,
+                std::ref(stage_log),
+                static_cast<Stage>(i),
+                "Logger " + STAGE_LOG_FILE_NAMES.at(i) + log_file_suffix
+        );
+    }
+
+    this->console_writer = std::thread(&Logger::writeConsoleTexts, this);
 }
 
 Logger::~Logger() {
-    this->if_stage_log_file.close();
-    this->id_stage_log_file.close();
-    this->ex_stage_log_file.close();
-    this->mem_stage_log_file.close();
-    this->wb_stage_log_file.close();
+    this->kill();
+
+    for (StageLog &stage_log: this->stage_logs) {
+        stage_log.log_file.close();
+    }
 }
 
-Logger *Logger::init() {
+void Logger::setLogFormat(LogFormat new_log_format) {
     std::lock_guard<std::mutex> logger_lock (Logger::initialization_mutex);
-    
-    if (Logger::current_instance == nullptr) {
-        Logger::current_instance = new Logger();
+
+    if (Logger::is_log_format_used) {
+        throw std::runtime_error("Logger::setLogFormat: the log files are already open.");
     }
 
-    return Logger::current_instance;
+    Logger::configured_log_format = new_log_format;
 }
 
-void Logger::log(Stage current_stage, const std::string &message) {
-    switch (current_stage) {
-        case Stage::IF:
-            this->enqueueIFStageMessage(message);
-            break;
+void Logger::log(Stage current_stage, uint8_t module_id, std::string_view message, uint32_t payload_1,
+                 uint32_t payload_2) {
+    if (this->log_format == LogFormat::None) {
+        return;
+    }
 
-        case Stage::ID:
-            this->enqueueIDStageMessage(message);
-            break;
+    StageLog &stage_log = this->stage_logs[static_cast<int>(current_stage)];
 
-        case Stage::EX:
-            this->enqueueEXStageMessage(message);
-            break;
+    EventLogRecord event {};
+    event.cycle = this->current_cycle.load(std::memory_order_relaxed);
+    event.payload_1 = payload_1;
+    event.payload_2 = payload_2;
+    event.event_id = this->internEvent(message);
+    event.module_id = module_id;
+    event.kind = EventLogRecordKind::Event;
 
-        case Stage::MEM:
-            this->enqueueMEMStageMessage(message);
-            break;
-
-        case Stage::WB:
-            this->enqueueWBStageMessage(message);
-            break;
+    if (!this->tryEnqueueEvent(stage_log, event)) {
+        stage_log.dropped_messages_count.fetch_add(1, std::memory_order_relaxed);
     }
 }
 
 void Logger::kill() {
-    std::lock_guard<std::mutex> if_logger_lock (this->if_stage_mutex);
-    std::lock_guard<std::mutex> id_logger_lock (this->id_stage_mutex);
-    std::lock_guard<std::mutex> ex_logger_lock (this->ex_stage_mutex);
-    std::lock_guard<std::mutex> mem_logger_lock (this->mem_stage_mutex);
-    std::lock_guard<std::mutex> wb_logger_lock (this->wb_stage_mutex);
-
-    this->is_killed = true;
-
-    this->if_stage_condition_variable.notify_all();
-    this->id_stage_condition_variable.notify_all();
-    this->ex_stage_condition_variable.notify_all();
-    this->mem_stage_condition_variable.notify_all();
-    this->wb_stage_condition_variable.notify_all();
-}
-
-void Logger::enqueueIFStageMessage(const std::string &message) {
-    std::unique_lock<std::mutex> if_stage_lock (this->if_stage_mutex);
-    this->if_stage_condition_variable.wait(
-            if_stage_lock,
-            [this] {
-                return this->if_stage_messages_queue.size() != MAX_MESSAGE_QUEUE_SIZE;
-            }
-    );
+    if (this->is_killed.exchange(true)) {
+        return;
+    }
+
+    for (StageLog &stage_log: this->stage_logs) {
+        if (stage_log.writer.joinable()) {
+            stage_log.writer.join();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> console_lock (this->console_mutex);
+        this->console_condition_variable.notify_all();
+    }
 
-    this->if_stage_messages_queue.push(message);
-    this->if_stage_condition_variable.notify_all();
+    if (this->console_writer.joinable()) {
+        this->console_writer.join();
+    }
 }
 
-void Logger::enqueueIDStageMessage(const std::string &message) {
-    std::unique_lock<std::mutex> id_stage_lock (this->id_stage_mutex);
-    this->id_stage_condition_variable.wait(
-            id_stage_lock,
-            [this] {
-                return this->id_stage_messages_queue.size() != MAX_MESSAGE_QUEUE_SIZE;
-            }
-    );
+uint8_t Logger::registerModule(std::string_view module_tag) {
+    std::lock_guard<std::mutex> registry_lock (this->registry_mutex);
+
+    for (unsigned long i = 0; i < this->module_tags.size(); ++i) {
+        if (this->module_tags.at(i) == module_tag) {
+            return i;
+        }
+    }
+
+    if (this->module_tags.size() == MAX_MODULE_COUNT) {
+        throw std::runtime_error("Logger::registerModule: too many modules to assign an id to.");
+    }
 
-    this->id_stage_messages_queue.push(message);
-    this->id_stage_condition_variable.notify_all();
+    this->module_tags.emplace_back(module_tag);
+
+    return this->module_tags.size() - 1;
 }
 
-void Logger::enqueueEXStageMessage(const std::string &message) {
-    std::unique_lock<std::mutex> ex_stage_lock (this->ex_stage_mutex);
-    this->ex_stage_condition_variable.wait(
-            ex_stage_lock,
-            [this] {
-                return this->ex_stage_messages_queue.size() != MAX_MESSAGE_QUEUE_SIZE;
-            }
-    );
+void Logger::setCurrentCycle(unsigned long cycle) {
+    this->current_cycle.store(cycle, std::memory_order_relaxed);
+}
+
+void Logger::writeToConsole(std::string text) {
+    std::lock_guard<std::mutex> console_lock (this->console_mutex);
 
-    this->ex_stage_messages_queue.push(message);
-    this->ex_stage_condition_variable.notify_all();
+    if (this->log_format == LogFormat::None) {
+        std::cout << text << std::flush;
+        return;
+    }
+
+    this->console_texts.push_back(std::move(text));
+    this->console_condition_variable.notify_all();
 }
 
-void Logger::enqueueMEMStageMessage(const std::string &message) {
-    std::unique_lock<std::mutex> mem_stage_lock (this->mem_stage_mutex);
-    this->mem_stage_condition_variable.wait(
-            mem_stage_lock,
-            [this] {
-                return this->mem_stage_messages_queue.size() != MAX_MESSAGE_QUEUE_SIZE;
-            }
-    );
+void Logger::waitForConsoleOutput() {
+    std::unique_lock<std::mutex> console_lock (this->console_mutex);
 
-    this->mem_stage_messages_queue.push(message);
-    this->mem_stage_condition_variable.notify_one();
+    this->console_condition_variable.wait(console_lock, [this] {
+        return this->console_texts.empty() && !this->is_console_writing;
+    });
 }
 
-void Logger::enqueueWBStageMessage(const std::string &message) {
-    std::unique_lock<std::mutex> wb_stage_lock (this->wb_stage_mutex);
-    this->wb_stage_condition_variable.wait(
-            wb_stage_lock,
-            [this] {
-                return this->wb_stage_messages_queue.size() != MAX_MESSAGE_QUEUE_SIZE;
+unsigned long Logger::getDroppedMessagesCount() const {
+    unsigned long dropped_messages_count = 0;
+
+    for (const StageLog &stage_log: this->stage_logs) {
+        dropped_messages_count += stage_log.dropped_messages_count.load(std::memory_order_relaxed);
+    }
+
+    return dropped_messages_count;
+}
+
+uint16_t Logger::internEvent(std::string_view message_format) {
+    // Per thread cache in front of the registry. Keys view the registry's copy, so they outlive the caller's message.
+    // A thread can log into several contexts' loggers over its lifetime, ids are only valid for one of them. Loggers
+    // are told apart by their serial number, a deleted Logger's address can be handed to the next one.
+    thread_local unsigned long cached_event_ids_owner = NO_LOGGER_SERIAL_NUMBER;
+    thread_local std::unordered_map<std::string_view, uint16_t> cached_event_ids;
+
+    if (cached_event_ids_owner != this->serial_number) {
+        cached_event_ids.clear();
+        cached_event_ids_owner = this->serial_number;
+    }
+
+    auto cached_event_id = cached_event_ids.find(message_format);
+
+    if (cached_event_id != cached_event_ids.end()) {
+        return cached_event_id->second;
+    }
+
+    std::lock_guard<std::mutex> registry_lock (this->registry_mutex);
+
+    auto event_id = this->event_ids.find(message_format);
+
+    if (event_id == this->event_ids.end()) {
+        if (this->event_formats.size() == MAX_EVENT_COUNT) {
+            throw std::runtime_error("Logger::internEvent: too many distinct log messages to assign an id to.");
+        }
+
+        const std::string &event_format = this->event_formats.emplace_back(message_format);
+        event_id = this->event_ids.emplace(event_format, this->event_formats.size() - 1).first;
+    }
+
+    cached_event_ids.emplace(event_id->first, event_id->second);
+
+    return event_id->second;
+}
+
+bool Logger::tryEnqueueEvent(StageLog &stage_log, const EventLogRecord &event) {
+    unsigned long position = stage_log.enqueue_position.load(std::memory_order_relaxed);
+    LogRecord *record;
+
+    while (true) {
+        record = &stage_log.records[position & (MESSAGE_RING_BUFFER_CAPACITY - 1)];
+        unsigned long sequence = record->sequence.load(std::memory_order_acquire);
+        long difference = static_cast<long>(sequence) - static_cast<long>(position);
+
+        if (difference == 0) {
+            if (stage_log.enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
             }
-    );
+        } else if (difference < 0) {  // The writer has not consumed this slot yet, the buffer is full
+            return false;
+        } else {
+            position = stage_log.enqueue_position.load(std::memory_order_relaxed);
+        }
+    }
+
+    record->event = event;
+    record->sequence.store(position + 1, std::memory_order_release);
 
-    this->wb_stage_messages_queue.push(message);
-    this->wb_stage_condition_variable.notify_all();
+    return true;
 }
 
-void Logger::writeIFStageMessagesToFile() {
-    while (!this->is_killed) {
-        std::unique_lock<std::mutex> if_stage_lock(this->if_stage_mutex);
-        this->if_stage_condition_variable.wait(
-                if_stage_lock,
-                [this] {
-                    return !this->if_stage_messages_queue.empty() || this->is_killed;
-                }
-        );
+std::string_view Logger::getWriterModuleTag(StageLog &stage_log, uint8_t module_id) {
+    if (module_id >= stage_log.module_tags.size()) {
+        stage_log.module_tags.resize(module_id + 1);
+    }
 
-        while (!this->if_stage_messages_queue.empty()) {
-            this->if_stage_log_file << this->if_stage_messages_queue.front() << std::endl;
-            this->if_stage_messages_queue.pop();
+    if (stage_log.module_tags.at(module_id).data() == nullptr) {
+        {
+            std::lock_guard<std::mutex> registry_lock (this->registry_mutex);
+            stage_log.module_tags.at(module_id) = this->module_tags.at(module_id);
         }
 
-        this->if_stage_condition_variable.notify_all();
+        this->writeDefinition(stage_log, EventLogRecordKind::ModuleDefinition, module_id,
+                              stage_log.module_tags.at(module_id));
     }
+
+    return stage_log.module_tags.at(module_id);
 }
 
-void Logger::writeIDStageMessagesToFile() {
-    while (!this->is_killed) {
-        std::unique_lock<std::mutex> id_stage_lock(this->id_stage_mutex);
-        this->id_stage_condition_variable.wait(
-                id_stage_lock,
-                [this] {
-                    return !this->id_stage_messages_queue.empty() || this->is_killed;
-                }
-        );
+std::string_view Logger::getWriterEventFormat(StageLog &stage_log, uint16_t event_id) {
+    if (event_id >= stage_log.event_formats.size()) {
+        stage_log.event_formats.resize(event_id + 1);
+    }
 
-        while (!this->id_stage_messages_queue.empty()) {
-            this->id_stage_log_file << this->id_stage_messages_queue.front() << std::endl;
-            this->id_stage_messages_queue.pop();
+    if (stage_log.event_formats.at(event_id).data() == nullptr) {
+        {
+            std::lock_guard<std::mutex> registry_lock (this->registry_mutex);
+            stage_log.event_formats.at(event_id) = this->event_formats.at(event_id);
         }
 
-        this->id_stage_condition_variable.notify_all();
+        this->writeDefinition(stage_log, EventLogRecordKind::EventDefinition, event_id,
+                              stage_log.event_formats.at(event_id));
     }
+
+    return stage_log.event_formats.at(event_id);
 }
 
-void Logger::writeEXStageMessagesToFile() {
-    while (!this->is_killed) {
-        std::unique_lock<std::mutex> ex_stage_lock(this->ex_stage_mutex);
-        this->ex_stage_condition_variable.wait(
-                ex_stage_lock,
-                [this] {
-                    return !this->ex_stage_messages_queue.empty() || this->is_killed;
-                }
-        );
+void Logger::writeDefinition(StageLog &stage_log, EventLogRecordKind kind, uint16_t id, std::string_view text) {
+    if (this->log_format != LogFormat::Binary) {
+        return;
+    }
+
+    EventLogRecord definition {};
+    definition.payload_1 = text.size();
+    definition.event_id = kind == EventLogRecordKind::EventDefinition ? id : 0;
+    definition.module_id = kind == EventLogRecordKind::ModuleDefinition ? id : 0;
+    definition.kind = kind;
+
+    EventLogFormat::writeRecord(stage_log.log_file, definition, stage_log.previous_cycle);
+    stage_log.log_file.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+void Logger::writeEvent(StageLog &stage_log, const EventLogRecord &event) {
+    std::string_view module_tag = this->getWriterModuleTag(stage_log, event.module_id);
+    std::string_view event_format = this->getWriterEventFormat(stage_log, event.event_id);
+
+    if (this->log_format == LogFormat::Binary) {
+        EventLogFormat::writeRecord(stage_log.log_file, event, stage_log.previous_cycle);
+    } else {
+        EventLogFormat::writeEventText(stage_log.log_file, module_tag, event_format, event.payload_1, event.payload_2);
+    }
+}
+
+bool Logger::writeQueuedMessagesToFile(StageLog &stage_log) {
+    bool is_message_written = false;
+
+    while (true) {
+        LogRecord &record = stage_log.records[stage_log.dequeue_position & (MESSAGE_RING_BUFFER_CAPACITY - 1)];
 
-        while (!this->ex_stage_messages_queue.empty()) {
-            this->ex_stage_log_file << this->ex_stage_messages_queue.front() << std::endl;
-            this->ex_stage_messages_queue.pop();
+        if (record.sequence.load(std::memory_order_acquire) != stage_log.dequeue_position + 1) {
+            break;
         }
 
-        this->ex_stage_condition_variable.notify_all();
+        this->writeEvent(stage_log, record.event);
+
+        record.sequence.store(stage_log.dequeue_position + MESSAGE_RING_BUFFER_CAPACITY, std::memory_order_release);
+        ++stage_log.dequeue_position;
+
+        is_message_written = true;
     }
+
+    return is_message_written;
 }
 
-void Logger::writeMEMStageMessagesToFile() {
-    while (!this->is_killed) {
-        std::unique_lock<std::mutex> mem_stage_lock(this->mem_stage_mutex);
-        this->mem_stage_condition_variable.wait(
-                mem_stage_lock,
-                [this] {
-                    return !this->mem_stage_messages_queue.empty() || this->is_killed;
-                }
-        );
+void Logger::writeStageMessagesToFile(StageLog &stage_log, Stage stage, const std::string &thread_name) {
+    ThreadPlacement::placeLoggerWriterThread(stage, thread_name);
 
-        while (!this->mem_stage_messages_queue.empty()) {
-            this->mem_stage_log_file << this->mem_stage_messages_queue.front() << std::endl;
-            this->mem_stage_messages_queue.pop();
+    while (!this->is_killed.load(std::memory_order_acquire)) {
+        if (!this->writeQueuedMessagesToFile(stage_log)) {
+            stage_log.log_file.flush();
+            std::this_thread::sleep_for(WRITER_IDLE_INTERVAL);
         }
+    }
+
+    this->writeQueuedMessagesToFile(stage_log);
 
-        this->mem_stage_condition_variable.notify_all();
+    unsigned long dropped_messages_count = stage_log.dropped_messages_count.load(std::memory_order_relaxed);
+
+    if (dropped_messages_count > 0) {
+        if (this->log_format == LogFormat::Binary) {
+            EventLogRecord dropped_messages {};
+            dropped_messages.cycle = this->current_cycle.load(std::memory_order_relaxed);
+            dropped_messages.payload_1 = dropped_messages_count;
+            dropped_messages.kind = EventLogRecordKind::DroppedMessages;
+
+            EventLogFormat::writeRecord(stage_log.log_file, dropped_messages, stage_log.previous_cycle);
+        } else {
+            EventLogFormat::writeDroppedMessagesText(stage_log.log_file, dropped_messages_count);
+        }
     }
+
+    stage_log.log_file.flush();
+    ThreadPlacement::removeCurrentThread();
 }
 
-void Logger::writeWBStageMessagesToFile() {
-    while (!this->is_killed) {
-        std::unique_lock<std::mutex> wb_stage_lock(this->wb_stage_mutex);
-        this->wb_stage_condition_variable.wait(
-                wb_stage_lock,
-                [this] {
-                    return !this->wb_stage_messages_queue.empty() || this->is_killed;
-                }
-        );
+void Logger::writeConsoleTexts() {
+    std::unique_lock<std::mutex> console_lock (this->console_mutex);
+
+    while (true) {
+        this->console_condition_variable.wait(console_lock, [this] {
+            return !this->console_texts.empty() || this->is_killed.load(std::memory_order_acquire);
+        });
+
+        if (this->console_texts.empty()) {
+            break;
+        }
+
+        std::deque<std::string> console_texts;
+        console_texts.swap(this->console_texts);
+        this->is_console_writing = true;
+
+        console_lock.unlock();
 
-        while (!this->wb_stage_messages_queue.empty()) {
-            this->wb_stage_log_file << this->wb_stage_messages_queue.front() << std::endl;
-            this->wb_stage_messages_queue.pop();
+        for (const std::string &text: console_texts) {
+            std::cout << text;
         }
 
-        this->wb_stage_condition_variable.notify_all();
+        std::cout.flush();
+
+        console_lock.lock();
+
+        this->is_console_writing = false;
+        this->console_condition_variable.notify_all();
     }
-}
\ No newline at end of file
+}
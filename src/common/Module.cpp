@@ -1,15 +1,85 @@
 #include "../../include/common/Module.h"
+#include "../../include/common/StageSynchronizer.h"
 
-Module::Module() {
+Module::Module(SimulationContext *context) {
     this->pipeline_type = PipelineType::Single;
     this->is_alive = true;
     this->logger = nullptr;
+    this->log_module_id = NO_LOG_MODULE_ID;
+    this->evaluation_count = 0UL;
+    this->skipped_evaluation_count = 0UL;
+    this->registration_index = NOT_REGISTERED;
+    this->context = context;
+    this->execution_engine = context->get<ExecutionEngine>();
+}
+
+void Module::resolveDependencies() {
+    this->initDependencies();
+}
+
+void Module::run() {
+    this->initDependencies();
+
+    const std::string &context_name = this->context->getName();
+    ThreadPlacement::placeModuleThread(
+            this->getModuleStage(),
+            context_name.empty() ? this->getModuleTag() : this->getModuleTag() + "-" + context_name
+    );
+
+    StageSynchronizer *stage_synchronizer = this->context->get<StageSynchronizer>();
+
+    while (this->isAlive()) {
+        this->log("Waiting to be woken up and acquire lock.");
+
+        std::unique_lock<std::mutex> module_lock (this->module_mutex, std::defer_lock);
+
+        if (this->readiness.isTracked()) {
+            this->readiness.waitUntilReady();
+            module_lock.lock();
+        } else {
+            module_lock.lock();
+            this->module_condition_variable.wait(
+                    module_lock,
+                    [this] { return this->isReadyToExecute() || this->isKilled(); }
+            );
+        }
+
+        if (this->isKilled()) {
+            this->log<LogLevel::Info>("Killed.");
+            break;
+        }
+
+        this->execute();
+
+        // Signals for the next cycle reach the module while it waits for the others
+        module_lock.unlock();
+        stage_synchronizer->waitForSingleStageArrival();
+    }
+
+    ThreadPlacement::removeCurrentThread();
+}
+
+/**
+ * Counterpart of run() for the coroutine mode. Instead of blocking on the condition variable the coroutine waits for a
+ * signal, and the ExecutionEngine resumes it with the module mutex held once that signal made isReadyToExecute() hold.
+ */
+ModuleCoroutine Module::runCoroutine() {
+    while (this->isAlive()) {
+        co_await this->execution_engine->waitForSignal(this);
+
+        this->log("Resumed by a signal.");
+        this->execute();
+    }
+
+    this->log<LogLevel::Info>("Killed.");
 }
 
 void Module::kill() {
     std::lock_guard<std::mutex> module_lock (this->module_mutex);
 
     this->is_alive = false;
+    this->readiness.set(ReadinessMask::KILLED);
+    this->readiness.notify();
     this->notifyModuleConditionVariable();
 }
 
@@ -38,20 +108,99 @@ PipelineType Module::getPipelineType() {
     return this->pipeline_type;
 }
 
+unsigned long Module::getEvaluationCount() const {
+    return this->evaluation_count;
+}
+
+unsigned long Module::getSkippedEvaluationCount() const {
+    return this->skipped_evaluation_count;
+}
+
+bool Module::isEvaluationSkippable() {
+    return false;
+}
+
+void Module::markInputsEvaluated() {}
+
+void Module::connectInput(SignalBase &input, Module *driver) {
+    this->execution_engine->connectInput(input, this, driver);
+}
+
+void Module::holdInput(SignalBase &input) {
+    std::lock_guard<std::mutex> module_lock (this->module_mutex);
+
+    input.hold();
+    this->notifyModuleConditionVariable();
+}
+
 void Module::notifyModuleConditionVariable() {
+    if (this->execution_engine->isCoroutineDriven()) {
+        this->execution_engine->scheduleModule(this);
+        return;
+    }
+
     this->getModuleConditionVariable().notify_all();
 }
 
-void Module::log(const std::string &message) {
-    std::lock_guard<std::mutex> log_lock (this->log_mutex);
+void Module::setReadiness(uint32_t bits) {
+    if (this->readiness.set(bits)) {
+        this->wakeUp();
+    }
+}
 
-    if (!this->logger) {
+void Module::clearReadiness(uint32_t bits) {
+    if (this->readiness.clear(bits)) {
+        this->wakeUp();
+    }
+}
+
+void Module::requireReadiness(uint32_t bits) {
+    if (this->readiness.require(bits)) {
+        this->wakeUp();
+    }
+}
+
+void Module::wakeUp() {
+    if (this->execution_engine->isCoroutineDriven()) {
+        this->execution_engine->scheduleModule(this);
+        return;
+    }
+
+    this->readiness.notify();
+}
+
+void Module::writeLog(std::string_view message, uint32_t payload_1, uint32_t payload_2) {
+    Logger *current_logger = this->resolveLogger();
+
+    int module_id = this->log_module_id.load(std::memory_order_relaxed);
+
+    if (module_id == NO_LOG_MODULE_ID) {
+        module_id = current_logger->registerModule(this->getModuleTag());
+        this->log_module_id.store(module_id, std::memory_order_relaxed);
+    }
+
+    current_logger->log(this->getModuleStage(), module_id, message, payload_1, payload_2);
+}
+
+void Module::printToConsole(std::string text) {
+    this->resolveLogger()->writeToConsole(std::move(text));
+}
+
+Logger *Module::resolveLogger() {
+    Logger *current_logger = this->logger.load(std::memory_order_acquire);
+
+    if (!current_logger) {
         this->initDependencies();
+        current_logger = this->logger.load(std::memory_order_acquire);
     }
 
-    this->logger->log(this->getModuleStage(), "[" + this->getModuleTag() + "] " + message);
+    return current_logger;
 }
 
 std::mutex &Module::getModuleDependencyMutex() {
     return this->dependency_mutex;
+}
+
+void Module::dispatchAndWait(std::initializer_list<std::function<void()>> signals) {
+    this->execution_engine->dispatchAndWait(signals);
 }
\ No newline at end of file
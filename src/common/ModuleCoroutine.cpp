@@ -0,0 +1,62 @@
+#include "../../include/common/ModuleCoroutine.h"
+
+#include <stdexcept>
+#include <utility>
+
+ModuleCoroutine ModuleCoroutine::promise_type::get_return_object() {
+    return ModuleCoroutine(std::coroutine_handle<promise_type>::from_promise(*this));
+}
+
+std::suspend_never ModuleCoroutine::promise_type::initial_suspend() noexcept {
+    return {};
+}
+
+std::suspend_always ModuleCoroutine::promise_type::final_suspend() noexcept {
+    return {};
+}
+
+void ModuleCoroutine::promise_type::return_void() {}
+
+void ModuleCoroutine::promise_type::unhandled_exception() {
+    this->exception = std::current_exception();
+}
+
+ModuleCoroutine::ModuleCoroutine() : handle(nullptr) {}
+
+ModuleCoroutine::ModuleCoroutine(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+ModuleCoroutine::~ModuleCoroutine() {
+    if (this->handle) {
+        this->handle.destroy();
+    }
+}
+
+ModuleCoroutine::ModuleCoroutine(ModuleCoroutine &&other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+
+ModuleCoroutine &ModuleCoroutine::operator=(ModuleCoroutine &&other) noexcept {
+    if (this != &other) {
+        if (this->handle) {
+            this->handle.destroy();
+        }
+
+        this->handle = std::exchange(other.handle, nullptr);
+    }
+
+    return *this;
+}
+
+bool ModuleCoroutine::isDone() const {
+    return !this->handle || this->handle.done();
+}
+
+void ModuleCoroutine::resume() {
+    if (this->isDone()) {
+        throw std::runtime_error("ModuleCoroutine::resume: coroutine is not running");
+    }
+
+    this->handle.resume();
+
+    if (this->handle.promise().exception) {
+        std::rethrow_exception(std::exchange(this->handle.promise().exception, nullptr));
+    }
+}
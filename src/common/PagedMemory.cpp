@@ -0,0 +1,170 @@
+#include "../../include/common/PagedMemory.h"
+
+#include <algorithm>
+#include <cstring>
+
+PagedMemory::PagedMemory() {
+    this->resident_page_count = 0;
+}
+
+const PagedMemory::Page *PagedMemory::findPage(unsigned long address) const {
+    const std::unique_ptr<PageTable> &page_table =
+            this->page_directory[address >> (PAGE_OFFSET_BIT_COUNT + PAGE_TABLE_INDEX_BIT_COUNT)];
+
+    if (!page_table) {
+        return nullptr;
+    }
+
+    return (*page_table)[(address >> PAGE_OFFSET_BIT_COUNT) & (PAGE_TABLE_SIZE - 1)].get();
+}
+
+PagedMemory::Page &PagedMemory::touchPage(unsigned long address) {
+    std::unique_ptr<PageTable> &page_table =
+            this->page_directory[address >> (PAGE_OFFSET_BIT_COUNT + PAGE_TABLE_INDEX_BIT_COUNT)];
+
+    if (!page_table) {
+        page_table = std::make_unique<PageTable>();
+    }
+
+    std::unique_ptr<Page> &page = (*page_table)[(address >> PAGE_OFFSET_BIT_COUNT) & (PAGE_TABLE_SIZE - 1)];
+
+    if (!page) {
+        page = std::make_unique<Page>();
+        ++this->resident_page_count;
+    }
+
+    return *page;
+}
+
+uint8_t PagedMemory::loadByte(unsigned long address) const {
+    const Page *page = this->findPage(address);
+
+    return page ? page->bytes[address & (PAGE_SIZE - 1)] : 0;
+}
+
+void PagedMemory::storeByte(unsigned long address, uint8_t byte) {
+    Page &page = this->touchPage(address);
+
+    page.bytes[address & (PAGE_SIZE - 1)] = byte;
+    page.is_dirty = true;
+}
+
+void PagedMemory::storeBytes(unsigned long address, std::span<const uint8_t> bytes) {
+    while (!bytes.empty()) {
+        unsigned long page_offset = address & (PAGE_SIZE - 1);
+        unsigned long chunk_size = std::min(bytes.size(), PAGE_SIZE - page_offset);
+
+        std::memcpy(this->touchPage(address).bytes.data() + page_offset, bytes.data(), chunk_size);
+
+        address += chunk_size;
+        bytes = bytes.subspan(chunk_size);
+    }
+}
+
+uint32_t PagedMemory::loadWord(unsigned long address) const {
+    unsigned long page_offset = address & (PAGE_SIZE - 1);
+
+    if (page_offset <= PAGE_SIZE - WORD_BYTE_COUNT) {
+        const Page *page = this->findPage(address);
+
+        if (!page) {
+            return 0;
+        }
+
+        const uint8_t *bytes = page->bytes.data() + page_offset;
+
+        return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+                (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+    }
+
+    uint32_t word = 0;
+
+    for (int i = 0; i < WORD_BYTE_COUNT; ++i) {
+        word = (word << 8) | this->loadByte(address + i);
+    }
+
+    return word;
+}
+
+void PagedMemory::storeWord(unsigned long address, uint32_t word) {
+    unsigned long page_offset = address & (PAGE_SIZE - 1);
+
+    if (page_offset <= PAGE_SIZE - WORD_BYTE_COUNT) {
+        Page &page = this->touchPage(address);
+        uint8_t *bytes = page.bytes.data() + page_offset;
+
+        bytes[0] = word >> 24;
+        bytes[1] = word >> 16;
+        bytes[2] = word >> 8;
+        bytes[3] = word;
+        page.is_dirty = true;
+        return;
+    }
+
+    for (int i = 0; i < WORD_BYTE_COUNT; ++i) {
+        this->storeByte(address + i, word >> (8 * (WORD_BYTE_COUNT - 1 - i)));
+    }
+}
+
+void PagedMemory::clear() {
+    for (std::unique_ptr<PageTable> &page_table: this->page_directory) {
+        page_table.reset();
+    }
+
+    this->resident_page_count = 0;
+}
+
+void PagedMemory::copyFrom(const PagedMemory &source) {
+    for (unsigned long i = 0; i < PAGE_DIRECTORY_SIZE; ++i) {
+        const std::unique_ptr<PageTable> &source_page_table = source.page_directory[i];
+        std::unique_ptr<PageTable> &page_table = this->page_directory[i];
+
+        if (!source_page_table) {
+            page_table.reset();
+            continue;
+        }
+
+        if (!page_table) {
+            page_table = std::make_unique<PageTable>();
+        }
+
+        for (unsigned long j = 0; j < PAGE_TABLE_SIZE; ++j) {
+            const std::unique_ptr<Page> &source_page = (*source_page_table)[j];
+            std::unique_ptr<Page> &page = (*page_table)[j];
+
+            if (!source_page) {
+                page.reset();
+            } else if (!page) {
+                page = std::make_unique<Page>(*source_page);
+            } else {
+                *page = *source_page;
+            }
+        }
+    }
+
+    this->resident_page_count = source.resident_page_count;
+}
+
+unsigned long PagedMemory::getResidentPageCount() const {
+    return this->resident_page_count;
+}
+
+std::vector<unsigned long> PagedMemory::getDirtyPageAddresses() const {
+    std::vector<unsigned long> dirty_page_addresses;
+
+    for (unsigned long i = 0; i < PAGE_DIRECTORY_SIZE; ++i) {
+        if (!this->page_directory[i]) {
+            continue;
+        }
+
+        for (unsigned long j = 0; j < PAGE_TABLE_SIZE; ++j) {
+            const std::unique_ptr<Page> &page = (*this->page_directory[i])[j];
+
+            if (page && page->is_dirty) {
+                dirty_page_addresses.push_back(((i << PAGE_TABLE_INDEX_BIT_COUNT) | j) << PAGE_OFFSET_BIT_COUNT);
+            }
+        }
+    }
+
+    return dirty_page_addresses;
+}
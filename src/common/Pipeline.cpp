@@ -0,0 +1,258 @@
+#include "../../include/common/Pipeline.h"
+#include "../../include/common/StageSynchronizer.h"
+#include "../../include/combinational/adder/EXAdder.h"
+#include "../../include/combinational/adder/IFAdder.h"
+#include "../../include/combinational/mux/forwarding/ALUInput1ForwardingMux.h"
+#include "../../include/combinational/mux/forwarding/ALUInput2ForwardingMux.h"
+#include "../../include/combinational/mux/EXMuxALUInput1.h"
+#include "../../include/combinational/mux/EXMuxALUInput2.h"
+#include "../../include/combinational/mux/IFMux.h"
+#include "../../include/combinational/mux/WBMux.h"
+#include "../../include/combinational/ALU.h"
+#include "../../include/combinational/ForwardingUnit.h"
+#include "../../include/combinational/ImmediateGenerator.h"
+
+void resetPipeline(Pipeline &pipeline) {
+    pipeline.ex_mem_stage_registers->reset();
+    pipeline.id_ex_stage_registers->reset();
+    pipeline.if_id_stage_registers->reset();
+    pipeline.mem_wb_stage_registers->reset();
+    pipeline.driver->reset();
+    pipeline.register_file->reset();
+    pipeline.data_memory->reset();
+    pipeline.stage_synchronizer->reset();
+    pipeline.alu->reset();
+    pipeline.hazard_detection_unit->reset();
+    pipeline.forwarding_unit->reset();
+//    pipeline.ex_mux_alu_input_1->reset();
+//    pipeline.ex_mux_alu_input_2->reset();
+//    pipeline.alu_input_1_forwarding_mux->reset();
+//    pipeline.alu_input_2_forwarding_mux->reset();
+}
+
+void pausePipeline(Pipeline &pipeline) {
+    pipeline.ex_mem_stage_registers->pause();
+    pipeline.id_ex_stage_registers->pause();
+    pipeline.if_id_stage_registers->pause();
+    pipeline.mem_wb_stage_registers->pause();
+    pipeline.driver->pause();
+}
+
+void resumePipeline(Pipeline &pipeline) {
+    pipeline.ex_mem_stage_registers->resume();
+    pipeline.id_ex_stage_registers->resume();
+    pipeline.if_id_stage_registers->resume();
+    pipeline.mem_wb_stage_registers->resume();
+    pipeline.driver->resume();
+    pipeline.register_file->resume();
+    pipeline.hazard_detection_unit->resume();
+}
+
+void changePipelineType(Pipeline &pipeline, const PipelineType &type) {
+    pipeline.ex_adder->setPipelineType(type);
+    pipeline.if_adder->setPipelineType(type);
+    pipeline.alu_input_1_forwarding_mux->setPipelineType(type);
+    pipeline.alu_input_2_forwarding_mux->setPipelineType(type);
+    pipeline.ex_mux_alu_input_1->setPipelineType(type);
+    pipeline.ex_mux_alu_input_2->setPipelineType(type);
+    pipeline.if_mux->setPipelineType(type);
+    pipeline.wb_mux->setPipelineType(type);
+    pipeline.alu->setPipelineType(type);
+    pipeline.forwarding_unit->setPipelineType(type);
+    pipeline.immediate_generator->setPipelineType(type);
+    pipeline.ex_mem_stage_registers->setPipelineType(type);
+    pipeline.id_ex_stage_registers->setPipelineType(type);
+    pipeline.if_id_stage_registers->setPipelineType(type);
+    pipeline.mem_wb_stage_registers->setPipelineType(type);
+    pipeline.data_memory->setPipelineType(type);
+    pipeline.driver->setPipelineType(type);
+    pipeline.instruction_memory->setPipelineType(type);
+    pipeline.register_file->setPipelineType(type);
+    pipeline.hazard_detection_unit->setPipelineType(type);
+    pipeline.stage_synchronizer->setPipelineType(type);
+}
+
+void killPipeline(Pipeline &pipeline) {
+    pipeline.register_file->flushRegisterFileOutputFile();
+
+    pipeline.ex_adder->kill();
+    pipeline.if_adder->kill();
+    pipeline.alu_input_1_forwarding_mux->kill();
+    pipeline.alu_input_2_forwarding_mux->kill();
+    pipeline.ex_mux_alu_input_1->kill();
+    pipeline.ex_mux_alu_input_2->kill();
+    pipeline.if_mux->kill();
+    pipeline.wb_mux->kill();
+    pipeline.alu->kill();
+    pipeline.logger->kill();
+    pipeline.forwarding_unit->kill();
+    pipeline.immediate_generator->kill();
+    pipeline.ex_mem_stage_registers->kill();
+    pipeline.id_ex_stage_registers->kill();
+    pipeline.if_id_stage_registers->kill();
+    pipeline.mem_wb_stage_registers->kill();
+    pipeline.data_memory->kill();
+    pipeline.driver->kill();
+    pipeline.instruction_memory->kill();
+    pipeline.register_file->kill();
+    pipeline.hazard_detection_unit->kill();
+}
+
+Pipeline initializePipeline(SimulationContext *context) {
+    Pipeline pipeline;
+
+    pipeline.ex_adder = context->get<EXAdder>();
+    pipeline.if_adder = context->get<IFAdder>();
+    pipeline.alu_input_1_forwarding_mux = context->get<ALUInput1ForwardingMux>();
+    pipeline.alu_input_2_forwarding_mux = context->get<ALUInput2ForwardingMux>();
+    pipeline.ex_mux_alu_input_1 = context->get<EXMuxALUInput1>();
+    pipeline.ex_mux_alu_input_2 = context->get<EXMuxALUInput2>();
+    pipeline.if_mux = context->get<IFMux>();
+    pipeline.wb_mux = context->get<WBMux>();
+    pipeline.alu = context->get<ALU>();
+    pipeline.logger = context->get<Logger>();
+    pipeline.forwarding_unit = context->get<ForwardingUnit>();
+    pipeline.immediate_generator = context->get<ImmediateGenerator>();
+    pipeline.stage_synchronizer = context->get<StageSynchronizer>();
+    pipeline.ex_mem_stage_registers = context->get<EXMEMStageRegisters>();
+    pipeline.id_ex_stage_registers = context->get<IDEXStageRegisters>();
+    pipeline.if_id_stage_registers = context->get<IFIDStageRegisters>();
+    pipeline.mem_wb_stage_registers = context->get<MEMWBStageRegisters>();
+    pipeline.data_memory = context->get<DataMemory>();
+    pipeline.driver = context->get<Driver>();
+    pipeline.instruction_memory = context->get<InstructionMemory>();
+    pipeline.register_file = context->get<RegisterFile>();
+    pipeline.hazard_detection_unit = context->get<HazardDetectionUnit>();
+    pipeline.execution_engine = context->get<ExecutionEngine>();
+
+    return pipeline;
+}
+
+void registerPipeline(const Pipeline &pipeline) {
+    // Registration order is the evaluation order of the cycle-driven engine: producers before consumers.
+    pipeline.execution_engine->registerModule(pipeline.driver);
+    pipeline.execution_engine->registerModule(pipeline.if_adder);
+    pipeline.execution_engine->registerModule(pipeline.instruction_memory);
+    pipeline.execution_engine->registerModule(pipeline.if_id_stage_registers);
+    pipeline.execution_engine->registerModule(pipeline.hazard_detection_unit);
+    pipeline.execution_engine->registerModule(pipeline.register_file);
+    pipeline.execution_engine->registerModule(pipeline.immediate_generator);
+    pipeline.execution_engine->registerModule(pipeline.id_ex_stage_registers);
+    pipeline.execution_engine->registerModule(pipeline.ex_adder);
+    pipeline.execution_engine->registerModule(pipeline.ex_mux_alu_input_1);
+    pipeline.execution_engine->registerModule(pipeline.ex_mux_alu_input_2);
+    pipeline.execution_engine->registerModule(pipeline.forwarding_unit);
+    pipeline.execution_engine->registerModule(pipeline.alu_input_1_forwarding_mux);
+    pipeline.execution_engine->registerModule(pipeline.alu_input_2_forwarding_mux);
+    pipeline.execution_engine->registerModule(pipeline.alu);
+    pipeline.execution_engine->registerModule(pipeline.ex_mem_stage_registers);
+    pipeline.execution_engine->registerModule(pipeline.data_memory);
+    pipeline.execution_engine->registerModule(pipeline.if_mux);
+    pipeline.execution_engine->registerModule(pipeline.mem_wb_stage_registers);
+    pipeline.execution_engine->registerModule(pipeline.wb_mux);
+}
+
+ActiveThreads runPipeline(const Pipeline &pipeline) {
+    ActiveThreads active_threads;
+
+    for (Module *module: std::initializer_list<Module *>{
+            pipeline.ex_adder, pipeline.if_adder, pipeline.alu_input_1_forwarding_mux,
+            pipeline.alu_input_2_forwarding_mux, pipeline.ex_mux_alu_input_1, pipeline.ex_mux_alu_input_2,
+            pipeline.if_mux, pipeline.wb_mux, pipeline.alu, pipeline.forwarding_unit, pipeline.immediate_generator,
+            pipeline.ex_mem_stage_registers, pipeline.id_ex_stage_registers, pipeline.if_id_stage_registers,
+            pipeline.mem_wb_stage_registers, pipeline.data_memory, pipeline.driver, pipeline.instruction_memory,
+            pipeline.register_file, pipeline.hazard_detection_unit}) {
+        module->resolveDependencies();
+    }
+
+    active_threads.ex_adder_thread = std::thread(&EXAdder::run, pipeline.ex_adder);
+    active_threads.if_adder_thread = std::thread(&IFAdder::run, pipeline.if_adder);
+
+    active_threads.alu_input_1_forwarding_mux_thread = std::thread(
+            &ALUInput1ForwardingMux::run,
+            pipeline.alu_input_1_forwarding_mux
+    );
+
+    active_threads.alu_input_2_forwarding_mux_thread = std::thread(
+            &ALUInput2ForwardingMux::run,
+            pipeline.alu_input_2_forwarding_mux
+    );
+
+    active_threads.ex_mux_alu_input_1_thread = std::thread(&EXMuxALUInput1::run, pipeline.ex_mux_alu_input_1);
+    active_threads.ex_mux_alu_input_2_thread = std::thread(&EXMuxALUInput2::run, pipeline.ex_mux_alu_input_2);
+    active_threads.if_mux_thread = std::thread(&IFMux::run, pipeline.if_mux);
+    active_threads.wb_mux_thread = std::thread(&WBMux::run, pipeline.wb_mux);
+    active_threads.alu_thread = std::thread(&ALU::run, pipeline.alu);
+    active_threads.forwarding_unit_thread = std::thread(&ForwardingUnit::run, pipeline.forwarding_unit);
+    active_threads.immediate_generator_thread = std::thread(&ImmediateGenerator::run, pipeline.immediate_generator);
+    active_threads.ex_mem_stage_registers_thread = std::thread(
+            &EXMEMStageRegisters::run,
+            pipeline.ex_mem_stage_registers
+    );
+
+    active_threads.id_ex_stage_registers_thread = std::thread(
+            &IDEXStageRegisters::run,
+            pipeline.id_ex_stage_registers
+    );
+
+    active_threads.if_id_stage_registers_thread = std::thread(
+            &IFIDStageRegisters::run,
+            pipeline.if_id_stage_registers
+    );
+
+    active_threads.mem_wb_stage_registers_thread = std::thread(
+            &MEMWBStageRegisters::run,
+            pipeline.mem_wb_stage_registers
+    );
+
+    active_threads.data_memory_thread = std::thread(&DataMemory::run, pipeline.data_memory);
+    active_threads.driver_thread = std::thread(&Driver::run, pipeline.driver);
+    active_threads.instruction_memory_thread = std::thread(&InstructionMemory::run, pipeline.instruction_memory);
+    active_threads.register_file_thread = std::thread(&RegisterFile::run, pipeline.register_file);
+    active_threads.hazard_detection_unit_thread = std::thread(&HazardDetectionUnit::run, pipeline.hazard_detection_unit);
+
+    active_threads.ex_adder_thread.detach();
+    active_threads.if_adder_thread.detach();
+    active_threads.alu_input_1_forwarding_mux_thread.detach();
+    active_threads.alu_input_2_forwarding_mux_thread.detach();
+    active_threads.ex_mux_alu_input_1_thread.detach();
+    active_threads.ex_mux_alu_input_2_thread.detach();
+    active_threads.if_mux_thread.detach();
+    active_threads.wb_mux_thread.detach();
+    active_threads.alu_thread.detach();
+    active_threads.forwarding_unit_thread.detach();
+    active_threads.immediate_generator_thread.detach();
+    active_threads.ex_mem_stage_registers_thread.detach();
+    active_threads.id_ex_stage_registers_thread.detach();
+    active_threads.if_id_stage_registers_thread.detach();
+    active_threads.mem_wb_stage_registers_thread.detach();
+    active_threads.data_memory_thread.detach();
+    active_threads.driver_thread.detach();
+    active_threads.instruction_memory_thread.detach();
+    active_threads.register_file_thread.detach();
+    active_threads.hazard_detection_unit_thread.detach();
+
+    return active_threads;
+}
+
+void printStagesState(Pipeline &pipeline) {
+    pipeline.driver->assertVerboseExecutionFlag();
+    pipeline.if_id_stage_registers->assertVerboseExecutionFlag();
+    pipeline.id_ex_stage_registers->assertVerboseExecutionFlag();
+    pipeline.ex_mem_stage_registers->assertVerboseExecutionFlag();
+    pipeline.mem_wb_stage_registers->assertVerboseExecutionFlag();
+}
+
+void changeInstructionMemoryFile(Pipeline &pipeline, const std::string &new_file_path) {
+    pipeline.instruction_memory->setInstructionMemoryInputFilePath(new_file_path);
+    pipeline.driver->setEntryProgramCounter(pipeline.instruction_memory->getEntryProgramCounter());
+}
+
+void changeDataMemoryFile(Pipeline &pipeline, const std::string &new_file_path) {
+    pipeline.data_memory->setDataMemoryInputFilePath(new_file_path);
+}
+
+void clearOutputFiles(Pipeline &pipeline) {
+    pipeline.register_file->clearRegisterFileOutputFile();
+    pipeline.data_memory->clearDataMemoryOutputFile();
+}
@@ -0,0 +1,312 @@
+#include "../../include/common/ProgramImage.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ELF headers and the RVSIMIMG header are read by copying them straight out of the file
+static_assert(std::endian::native == std::endian::little, "ProgramImage reads little endian file headers");
+
+ProgramImage::ProgramImage(const std::string &file_path) {
+    this->file_path = file_path;
+    this->format = ProgramImageFormat::Text;
+
+    this->mapping = nullptr;
+    this->mapping_size = 0UL;
+
+    this->entry_program_counter = 0;
+
+    this->map();
+
+    std::span<const uint8_t> file_bytes (static_cast<const uint8_t *>(this->mapping), this->mapping_size);
+
+    if (file_bytes.size() >= SELFMAG && std::memcmp(file_bytes.data(), ELFMAG, SELFMAG) == 0) {
+        this->format = ProgramImageFormat::Elf;
+        this->decodeElf(file_bytes);
+    } else if (file_bytes.size() >= sizeof(ProgramImageHeader) &&
+            std::memcmp(file_bytes.data(), ProgramImage::MAGIC, sizeof(ProgramImage::MAGIC)) == 0) {
+        ProgramImageHeader header {};
+        std::memcpy(&header, file_bytes.data(), sizeof(header));
+
+        if (header.version != ProgramImage::VERSION) {
+            throw std::runtime_error("ProgramImage::ProgramImage: unsupported image version in " + file_path);
+        }
+
+        this->format = ProgramImageFormat::Binary;
+        this->entry_program_counter = header.entry_program_counter;
+        this->segments.push_back({header.base_address, file_bytes.subspan(sizeof(ProgramImageHeader)), true});
+    } else if (file_path.ends_with(ProgramImage::RAW_IMAGE_EXTENSION)) {
+        this->format = ProgramImageFormat::Raw;
+        this->segments.push_back({0, file_bytes, true});
+    } else {
+        this->decodeText(file_bytes);
+    }
+}
+
+ProgramImage::~ProgramImage() {
+    if (this->mapping) {
+        munmap(this->mapping, this->mapping_size);
+    }
+}
+
+void ProgramImage::map() {
+    int file_descriptor = open(this->file_path.c_str(), O_RDONLY);
+
+    if (file_descriptor < 0) {
+        throw std::runtime_error("ProgramImage::map: cannot open " + this->file_path);
+    }
+
+    struct stat file_status {};
+
+    if (fstat(file_descriptor, &file_status) != 0) {
+        close(file_descriptor);
+        throw std::runtime_error("ProgramImage::map: cannot stat " + this->file_path);
+    }
+
+    this->mapping_size = file_status.st_size;
+
+    if (this->mapping_size > 0) {  // mmap rejects empty mappings, an empty file is an empty image
+        void *file_mapping = mmap(nullptr, this->mapping_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+
+        if (file_mapping == MAP_FAILED) {
+            close(file_descriptor);
+            throw std::runtime_error("ProgramImage::map: cannot map " + this->file_path);
+        }
+
+        madvise(file_mapping, this->mapping_size, MADV_SEQUENTIAL);
+        this->mapping = file_mapping;
+    }
+
+    close(file_descriptor);  // The mapping stays valid without the descriptor
+}
+
+void ProgramImage::decodeText(std::span<const uint8_t> text) {
+    std::vector<uint8_t> &decoded_text_bytes = this->decoded_segment_bytes.emplace_back();
+    decoded_text_bytes.reserve(text.size() / (BYTE_BIT_COUNT + 1));
+
+    unsigned long line_start = 0;
+
+    while (line_start < text.size()) {
+        unsigned long line_end = line_start;
+
+        while (line_end < text.size() && text[line_end] != '\n') {
+            ++line_end;
+        }
+
+        unsigned long line_length = line_end - line_start;
+
+        if (line_length > 0 && text[line_end - 1] == '\r') {
+            --line_length;
+        }
+
+        // Like std::bitset, only the leading BYTE_BIT_COUNT characters of a line are read
+        uint8_t byte = 0;
+
+        for (unsigned long i = 0; i < line_length && i < BYTE_BIT_COUNT; ++i) {
+            uint8_t character = text[line_start + i];
+
+            if (character != '0' && character != '1') {
+                throw std::runtime_error("ProgramImage::decodeText: invalid byte in " + this->file_path);
+            }
+
+            byte = (byte << 1) | (character - '0');
+        }
+
+        decoded_text_bytes.push_back(byte);
+        line_start = line_end + 1;
+    }
+
+    this->segments.push_back({0, decoded_text_bytes, true});
+}
+
+void ProgramImage::decodeElf(std::span<const uint8_t> file_bytes) {
+    Elf32_Ehdr elf_header {};
+
+    if (file_bytes.size() < sizeof(elf_header)) {
+        throw std::runtime_error("ProgramImage::decodeElf: truncated ELF header in " + this->file_path);
+    }
+
+    std::memcpy(&elf_header, file_bytes.data(), sizeof(elf_header));
+
+    if (elf_header.e_ident[EI_CLASS] != ELFCLASS32 || elf_header.e_ident[EI_DATA] != ELFDATA2LSB ||
+            elf_header.e_machine != EM_RISCV || elf_header.e_type != ET_EXEC) {
+        throw std::runtime_error("ProgramImage::decodeElf: not a little endian RV32 executable: " + this->file_path);
+    }
+
+    this->entry_program_counter = elf_header.e_entry;
+
+    for (uint16_t i = 0; i < elf_header.e_phnum; ++i) {
+        unsigned long program_header_offset =
+                elf_header.e_phoff + static_cast<unsigned long>(i) * elf_header.e_phentsize;
+        Elf32_Phdr program_header {};
+
+        if (elf_header.e_phentsize < sizeof(program_header) ||
+                program_header_offset + sizeof(program_header) > file_bytes.size()) {
+            throw std::runtime_error("ProgramImage::decodeElf: truncated program header in " + this->file_path);
+        }
+
+        std::memcpy(&program_header, file_bytes.data() + program_header_offset, sizeof(program_header));
+
+        if (program_header.p_type != PT_LOAD || program_header.p_memsz == 0) {
+            continue;
+        }
+
+        if (static_cast<unsigned long>(program_header.p_offset) + program_header.p_filesz > file_bytes.size() ||
+                program_header.p_filesz > program_header.p_memsz ||
+                static_cast<unsigned long>(program_header.p_vaddr) + program_header.p_memsz > 1UL << 32) {
+            throw std::runtime_error("ProgramImage::decodeElf: malformed PT_LOAD segment in " + this->file_path);
+        }
+
+        if (program_header.p_vaddr % WORD_BYTE_COUNT != 0) {
+            throw std::runtime_error("ProgramImage::decodeElf: PT_LOAD segment is not word aligned in " +
+                                     this->file_path);
+        }
+
+        // Sections past p_filesz (.bss) are zero filled, the tail is padded to a whole word
+        std::vector<uint8_t> &segment_bytes = this->decoded_segment_bytes.emplace_back(
+                (program_header.p_memsz + WORD_BYTE_COUNT - 1) & ~(WORD_BYTE_COUNT - 1UL), 0
+        );
+
+        std::copy_n(file_bytes.begin() + program_header.p_offset, program_header.p_filesz, segment_bytes.begin());
+
+        // RISC-V is little endian, the simulated memories keep the most significant byte of a word first
+        for (auto word = segment_bytes.begin(); word != segment_bytes.end(); word += WORD_BYTE_COUNT) {
+            std::reverse(word, word + WORD_BYTE_COUNT);
+        }
+
+        this->segments.push_back({program_header.p_vaddr, segment_bytes, (program_header.p_flags & PF_X) != 0});
+    }
+
+    if (elf_header.e_shoff != 0) {
+        if (elf_header.e_shentsize < sizeof(Elf32_Shdr)) {
+            throw std::runtime_error("ProgramImage::decodeElf: malformed section headers in " + this->file_path);
+        }
+
+        this->readElfSections(file_bytes, elf_header.e_shoff, elf_header.e_shnum, elf_header.e_shentsize);
+    }
+}
+
+void ProgramImage::readElfSections(std::span<const uint8_t> file_bytes, uint32_t section_header_offset,
+                                   uint16_t section_header_count, uint16_t section_header_size) {
+    auto read_section_header = [&](uint32_t index) {
+        unsigned long offset = section_header_offset + static_cast<unsigned long>(index) * section_header_size;
+        Elf32_Shdr section_header {};
+
+        if (index >= section_header_count || offset + sizeof(section_header) > file_bytes.size()) {
+            throw std::runtime_error("ProgramImage::readElfSections: truncated section header in " + this->file_path);
+        }
+
+        std::memcpy(&section_header, file_bytes.data() + offset, sizeof(section_header));
+        return section_header;
+    };
+
+    for (uint16_t i = 0; i < section_header_count; ++i) {
+        Elf32_Shdr symbol_table = read_section_header(i);
+
+        if (symbol_table.sh_type == SHT_PROGBITS && (symbol_table.sh_flags & SHF_ALLOC) != 0 &&
+                (symbol_table.sh_flags & SHF_EXECINSTR) != 0) {
+            this->code_ranges.emplace_back(symbol_table.sh_addr, symbol_table.sh_size);
+            continue;
+        }
+
+        if (symbol_table.sh_type != SHT_SYMTAB) {
+            continue;
+        }
+
+        Elf32_Shdr string_table = read_section_header(symbol_table.sh_link);
+
+        if (static_cast<unsigned long>(symbol_table.sh_offset) + symbol_table.sh_size > file_bytes.size() ||
+                static_cast<unsigned long>(string_table.sh_offset) + string_table.sh_size > file_bytes.size()) {
+            throw std::runtime_error("ProgramImage::readElfSections: truncated symbol table in " + this->file_path);
+        }
+
+        std::string_view strings (reinterpret_cast<const char *>(file_bytes.data()) + string_table.sh_offset,
+                                  string_table.sh_size);
+
+        for (unsigned long offset = 0; offset + sizeof(Elf32_Sym) <= symbol_table.sh_size; offset += sizeof(Elf32_Sym)) {
+            Elf32_Sym symbol {};
+            std::memcpy(&symbol, file_bytes.data() + symbol_table.sh_offset + offset, sizeof(symbol));
+
+            if (symbol.st_name == 0 || symbol.st_name >= strings.size()) {
+                continue;
+            }
+
+            std::string_view name = strings.substr(symbol.st_name);
+            name = name.substr(0, name.find('\0'));
+
+            this->symbols.emplace_back(name, symbol.st_value);
+        }
+    }
+}
+
+ProgramImageFormat ProgramImage::getFormat() const {
+    return this->format;
+}
+
+std::vector<ProgramImageSegment> ProgramImage::getInstructionSegments() const {
+    if (this->format != ProgramImageFormat::Elf) {
+        return this->segments;
+    }
+
+    std::vector<ProgramImageSegment> instruction_segments;
+    std::copy_if(this->segments.begin(), this->segments.end(), std::back_inserter(instruction_segments),
+                 [](const ProgramImageSegment &segment) { return segment.is_executable; });
+
+    return instruction_segments;
+}
+
+std::vector<ProgramImageSegment> ProgramImage::getDataSegments() const {
+    if (this->format != ProgramImageFormat::Elf) {
+        return this->segments;
+    }
+
+    std::vector<ProgramImageSegment> data_segments;
+    std::copy_if(this->segments.begin(), this->segments.end(), std::back_inserter(data_segments),
+                 [](const ProgramImageSegment &segment) { return !segment.is_executable; });
+
+    return data_segments;
+}
+
+uint32_t ProgramImage::getEntryProgramCounter() const {
+    return this->entry_program_counter;
+}
+
+std::optional<uint32_t> ProgramImage::findSymbol(std::string_view name) const {
+    for (const auto &[symbol_name, address]: this->symbols) {
+        if (symbol_name == name) {
+            return address;
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> ProgramImage::getCodeRanges() const {
+    if (!this->code_ranges.empty()) {
+        return this->code_ranges;
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> segment_ranges;  // No section headers, every instruction byte is code
+
+    for (const ProgramImageSegment &segment: this->getInstructionSegments()) {
+        segment_ranges.emplace_back(segment.address, segment.bytes.size());
+    }
+
+    return segment_ranges;
+}
+
+ProgramImageHeader ProgramImage::makeHeader(uint32_t base_address, uint32_t entry_program_counter) {
+    ProgramImageHeader header {};
+
+    std::memcpy(header.magic, ProgramImage::MAGIC, sizeof(header.magic));
+    header.version = ProgramImage::VERSION;
+    header.base_address = base_address;
+    header.entry_program_counter = entry_program_counter;
+
+    return header;
+}
@@ -0,0 +1,96 @@
+#include "../../include/common/ReadinessMask.h"
+
+#include <stdexcept>
+
+ReadinessMask::ReadinessMask() {
+    this->bits = 0U;
+    this->required_bits = 0U;
+    this->blocking_bits = 0U;
+    this->forcing_bits = ReadinessMask::KILLED;
+}
+
+void ReadinessMask::track(uint32_t required, uint32_t blocking, uint32_t forcing) {
+    if ((blocking | forcing) & ReadinessMask::KILLED) {
+        throw std::runtime_error("ReadinessMask::track: the killed bit is reserved");
+    }
+
+    this->blocking_bits = blocking;
+    this->forcing_bits = forcing | ReadinessMask::KILLED;
+    this->require(required);
+}
+
+/**
+ * Modules whose inputs differ between the single and five stage pipelines swap their required bits when the pipeline
+ * type changes. Reports whether the module became ready, like set() and clear().
+ */
+bool ReadinessMask::require(uint32_t required) {
+    if (required == 0U) {
+        throw std::runtime_error("ReadinessMask::require: at least one bit has to be required");
+    }
+
+    if (required & ReadinessMask::KILLED) {
+        throw std::runtime_error("ReadinessMask::require: the killed bit is reserved");
+    }
+
+    uint32_t current_bits = this->bits.load(std::memory_order_acquire);
+    bool was_ready = this->isReady(current_bits);
+
+    this->required_bits.store(required, std::memory_order_release);
+
+    return !was_ready && this->isReady(current_bits);
+}
+
+bool ReadinessMask::isTracked() const {
+    return this->required_bits.load(std::memory_order_relaxed) != 0U;
+}
+
+bool ReadinessMask::isReady(uint32_t current_bits) const {
+    uint32_t current_required_bits = this->required_bits.load(std::memory_order_acquire);
+
+    return ((current_bits & (current_required_bits | this->blocking_bits)) == current_required_bits) ||
+           (current_bits & this->forcing_bits);
+}
+
+bool ReadinessMask::set(uint32_t set_bits) {
+    uint32_t previous_bits = this->bits.fetch_or(set_bits, std::memory_order_acq_rel);
+    return !this->isReady(previous_bits) && this->isReady(previous_bits | set_bits);
+}
+
+bool ReadinessMask::clear(uint32_t cleared_bits) {
+    uint32_t previous_bits = this->bits.fetch_and(~cleared_bits, std::memory_order_acq_rel);
+    return !this->isReady(previous_bits) && this->isReady(previous_bits & ~cleared_bits);
+}
+
+void ReadinessMask::keepOnly(uint32_t kept_bits) {
+    this->bits.fetch_and(kept_bits, std::memory_order_acq_rel);
+}
+
+bool ReadinessMask::isSet(uint32_t bit) const {
+    return this->bits.load(std::memory_order_acquire) & bit;
+}
+
+bool ReadinessMask::isReady() const {
+    return this->isReady(this->bits.load(std::memory_order_acquire));
+}
+
+void ReadinessMask::waitUntilReady() const {
+    uint32_t current_bits = this->bits.load(std::memory_order_acquire);
+
+    while (!this->isReady(current_bits)) {
+        this->bits.wait(current_bits, std::memory_order_acquire);
+        current_bits = this->bits.load(std::memory_order_acquire);
+    }
+}
+
+void ReadinessMask::waitUntilSet(uint32_t bit) const {
+    uint32_t current_bits = this->bits.load(std::memory_order_acquire);
+
+    while (!(current_bits & bit)) {
+        this->bits.wait(current_bits, std::memory_order_acquire);
+        current_bits = this->bits.load(std::memory_order_acquire);
+    }
+}
+
+void ReadinessMask::notify() {
+    this->bits.notify_all();
+}
@@ -0,0 +1,95 @@
+#include "../../include/common/RegisterFileTraceWriter.h"
+
+RegisterFileTraceWriter::RegisterFileTraceWriter() {
+    this->trace_mode = RegisterFileTraceMode::Full;
+    this->trace_file_buffer = std::make_unique<char[]>(TRACE_FILE_BUFFER_SIZE);
+    this->previous_registers = {};
+    this->is_previous_registers_set = false;
+}
+
+RegisterFileTraceWriter::~RegisterFileTraceWriter() {
+    this->close();
+}
+
+void RegisterFileTraceWriter::open(const std::string &file_path, RegisterFileTraceMode mode, bool is_truncated) {
+    this->close();
+
+    this->trace_mode = mode;
+    this->is_previous_registers_set = false;
+
+    // The stream buffer has to be installed before the file is opened to take effect
+    this->trace_file.rdbuf()->pubsetbuf(this->trace_file_buffer.get(), TRACE_FILE_BUFFER_SIZE);
+    this->trace_file.open(file_path, is_truncated ? std::ios::out | std::ios::trunc : std::ios::out | std::ios::app);
+
+    if (!this->trace_file) {
+        throw std::runtime_error("RegisterFileTraceWriter::open: cannot open " + file_path);
+    }
+
+    if (mode == RegisterFileTraceMode::Delta && this->trace_file.tellp() == 0) {
+        this->trace_file << DELTA_TRACE_FILE_HEADER << '\n';
+    }
+}
+
+void RegisterFileTraceWriter::close() {
+    if (this->trace_file.is_open()) {
+        this->trace_file.close();
+    }
+}
+
+void RegisterFileTraceWriter::flush() {
+    if (this->trace_file.is_open()) {
+        this->trace_file.flush();
+    }
+}
+
+void RegisterFileTraceWriter::writeCycle(unsigned long cycle,
+                                         const std::vector<std::bitset<WORD_BIT_COUNT>> &registers) {
+    RegisterValues register_values {};
+
+    for (int i = 0; i < REGISTERS_COUNT; ++i) {
+        register_values.at(i) = registers.at(i).to_ulong();
+    }
+
+    if (this->trace_mode == RegisterFileTraceMode::Delta) {
+        this->writeDeltaRecord(cycle, register_values);
+    } else {
+        RegisterFileTraceWriter::writeFullRecord(this->trace_file, cycle, register_values);
+    }
+}
+
+void RegisterFileTraceWriter::writeFullRecord(std::ostream &output, unsigned long cycle,
+                                              const RegisterValues &registers) {
+    output << FULL_TRACE_CYCLE_HEADER << cycle << '\n';
+
+    char line[WORD_BIT_COUNT + 1];
+    line[WORD_BIT_COUNT] = '\n';
+
+    for (uint32_t value: registers) {
+        for (int i = 0; i < WORD_BIT_COUNT; ++i) {
+            line[i] = (value >> (WORD_BIT_COUNT - 1 - i)) & 1U ? '1' : '0';
+        }
+
+        output.write(line, sizeof(line));
+    }
+}
+
+void RegisterFileTraceWriter::writeDeltaRecord(unsigned long cycle, const RegisterValues &registers) {
+    int changed_registers_count = 0;
+
+    for (int i = 0; i < REGISTERS_COUNT; ++i) {
+        if (!this->is_previous_registers_set || registers.at(i) != this->previous_registers.at(i)) {
+            ++changed_registers_count;
+        }
+    }
+
+    this->trace_file << DELTA_TRACE_CYCLE_HEADER << ' ' << cycle << ' ' << changed_registers_count << '\n';
+
+    for (int i = 0; i < REGISTERS_COUNT; ++i) {
+        if (!this->is_previous_registers_set || registers.at(i) != this->previous_registers.at(i)) {
+            this->trace_file << i << ' ' << registers.at(i) << '\n';
+        }
+    }
+
+    this->previous_registers = registers;
+    this->is_previous_registers_set = true;
+}
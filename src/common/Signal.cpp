@@ -0,0 +1,33 @@
+#include "../../include/common/Signal.h"
+
+SignalBase::SignalBase() {
+    this->is_set = false;
+    this->is_evaluated = false;
+    this->is_holdable = false;
+    this->owner = nullptr;
+}
+
+bool SignalBase::isSet() const {
+    return this->is_set;
+}
+
+bool SignalBase::isHoldable() const {
+    return this->is_holdable;
+}
+
+Module *SignalBase::getOwner() const {
+    return this->owner;
+}
+
+void SignalBase::setOwner(Module *new_owner) {
+    this->owner = new_owner;
+}
+
+void SignalBase::hold() {
+    this->is_set = true;
+}
+
+void SignalBase::discard() {
+    this->is_set = true;
+    this->is_holdable = false;
+}
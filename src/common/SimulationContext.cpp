@@ -0,0 +1,62 @@
+#include "../../include/common/SimulationContext.h"
+#include "../../include/common/ExecutionEngine.h"
+#include "../../include/common/Logger.h"
+#include "../../include/common/StageSynchronizer.h"
+#include "../../include/common/FunctionalSimulator.h"
+#include "../../include/combinational/adder/EXAdder.h"
+#include "../../include/combinational/adder/IFAdder.h"
+#include "../../include/combinational/mux/forwarding/ALUInput1ForwardingMux.h"
+#include "../../include/combinational/mux/forwarding/ALUInput2ForwardingMux.h"
+#include "../../include/combinational/mux/EXMuxALUInput1.h"
+#include "../../include/combinational/mux/EXMuxALUInput2.h"
+#include "../../include/combinational/mux/IFMux.h"
+#include "../../include/combinational/mux/WBMux.h"
+#include "../../include/combinational/ALU.h"
+#include "../../include/combinational/ForwardingUnit.h"
+#include "../../include/combinational/ImmediateGenerator.h"
+#include "../../include/combinational/HazardDetectionUnit.h"
+#include "../../include/state/stage-registers/EXMEMStageRegisters.h"
+#include "../../include/state/stage-registers/IDEXStageRegisters.h"
+#include "../../include/state/stage-registers/IFIDStageRegisters.h"
+#include "../../include/state/stage-registers/MEMWBStageRegisters.h"
+#include "../../include/state/DataMemory.h"
+#include "../../include/state/Driver.h"
+#include "../../include/state/InstructionMemory.h"
+#include "../../include/state/RegisterFile.h"
+
+#include <type_traits>
+#include <utility>
+
+SimulationContext::SimulationContext(std::string name)
+        : SimulationContext(std::move(name), DEFAULT_OUTPUT_DIRECTORY_PATH, DEFAULT_LOG_DIRECTORY_PATH) {}
+
+SimulationContext::SimulationContext(std::string name, std::string output_directory_path,
+                                     std::string log_directory_path) {
+    this->name = std::move(name);
+    this->output_directory_path = std::move(output_directory_path);
+    this->log_directory_path = std::move(log_directory_path);
+
+    std::apply([this](auto *&... instances) {
+        ((instances = new std::remove_pointer_t<std::remove_reference_t<decltype(instances)>>(this)), ...);
+    }, this->instances);
+}
+
+SimulationContext::~SimulationContext() {
+    // Reverse creation order, the Logger joins its writer threads and the ExecutionEngine goes last
+    [this]<std::size_t... indices>(std::index_sequence<indices...>) {
+        constexpr std::size_t instance_count = sizeof...(indices);
+        (delete std::get<instance_count - 1 - indices>(this->instances), ...);
+    }(std::make_index_sequence<std::tuple_size_v<decltype(this->instances)>>());
+}
+
+const std::string &SimulationContext::getName() const {
+    return this->name;
+}
+
+const std::string &SimulationContext::getOutputDirectoryPath() const {
+    return this->output_directory_path;
+}
+
+const std::string &SimulationContext::getLogDirectoryPath() const {
+    return this->log_directory_path;
+}
@@ -1,26 +1,24 @@
 #include "../../include/common/StageSynchronizer.h"
 
-StageSynchronizer *StageSynchronizer::current_instance = nullptr;
-std::mutex StageSynchronizer::initialization_mutex;
-
-StageSynchronizer::StageSynchronizer() {
-    std::function<void()> single_stage_on_completion = [this]() -> void { this->onCompletionSingleStage(); };
-    std::function<void()> five_stage_on_completion = [this]() -> void { this->onCompletionFiveStage(); };
-    std::function<void()> reset_on_completion = [this]() -> void { this->onCompletionReset(); };
-
-    this->single_stage_barrier = new std::barrier<std::function<void()>>(SINGLE_STAGE_THREAD_COUNT, single_stage_on_completion);
-    this->five_stage_barrier = new std::barrier<std::function<void()>>(FIVE_STAGE_THREAD_COUNT, five_stage_on_completion);
-    this->reset_barrier = new std::barrier<std::function<void()>>(RESET_THREAD_COUNT, reset_on_completion);
-
-    this->driver = Driver::init();
-    this->if_id_stage_registers = IFIDStageRegisters::init();
-    this->id_ex_stage_registers = IDEXStageRegisters::init();
-    this->ex_mem_stage_registers = EXMEMStageRegisters::init();
-    this->mem_wb_stage_registers = MEMWBStageRegisters::init();
-    this->hazard_detection_unit = HazardDetectionUnit::init();
-
-    this->register_file = RegisterFile::init();
-    this->data_memory = DataMemory::init();
+thread_local bool StageSynchronizer::is_single_stage_arrival_pending = false;
+
+StageSynchronizer::StageSynchronizer(SimulationContext *context)
+        : single_stage_barrier([this] { this->onCompletionSingleStage(); }),
+          five_stage_barrier([this] { this->onCompletionFiveStage(); }),
+          reset_barrier([] { StageSynchronizer::onCompletionReset(); }) {
+    this->context = context;
+
+    this->driver = this->context->get<Driver>();
+    this->if_id_stage_registers = this->context->get<IFIDStageRegisters>();
+    this->id_ex_stage_registers = this->context->get<IDEXStageRegisters>();
+    this->ex_mem_stage_registers = this->context->get<EXMEMStageRegisters>();
+    this->mem_wb_stage_registers = this->context->get<MEMWBStageRegisters>();
+    this->hazard_detection_unit = this->context->get<HazardDetectionUnit>();
+
+    this->register_file = this->context->get<RegisterFile>();
+    this->data_memory = this->context->get<DataMemory>();
+    this->execution_engine = this->context->get<ExecutionEngine>();
+    this->logger = this->context->get<Logger>();
     this->is_paused = false;
     this->halt_detected = false;
 
@@ -29,49 +27,125 @@ StageSynchronizer::StageSynchronizer() {
     this->is_print_id_ex_state_asserted = true;
     this->is_print_ex_mem_state_asserted = true;
     this->is_print_mem_wb_state_asserted = true;
+    this->is_print_cycle_asserted = true;
 
     this->current_cycle = 0;
 
+    const std::string &context_name = context->getName();
+    this->cycle_prefix = context_name.empty() ? "" : "[" + context_name + "] ";
+
     this->current_pipeline_type = PipelineType::Single;
 }
 
-void StageSynchronizer::conditionalArriveFiveStage() {
-    if (this->current_pipeline_type == PipelineType::Five) {
-        this->five_stage_barrier->arrive_and_wait();
+void StageSynchronizer::registerParticipant(bool is_single_stage_participant) {
+    std::lock_guard<std::mutex> stage_synchronizer_lock (this->module_mutex);
+
+    this->reset_barrier.registerParticipants(1);
+
+    if (is_single_stage_participant) {
+        this->single_stage_barrier.registerParticipants(1);
     }
 }
 
-StageSynchronizer* StageSynchronizer::init() {
-    std::lock_guard<std::mutex> stage_synchronizer_lock (StageSynchronizer::initialization_mutex);
-
-    if (StageSynchronizer::current_instance == nullptr) {
-        StageSynchronizer::current_instance = new StageSynchronizer();
+void StageSynchronizer::connectFiveStageInput(Module *driver) {
+    if (!driver) {
+        throw std::runtime_error("StageSynchronizer::connectFiveStageInput: five stage input has no driver");
     }
 
-    return StageSynchronizer::current_instance;
+    std::lock_guard<std::mutex> stage_synchronizer_lock (this->module_mutex);
+
+    this->five_stage_barrier.registerParticipants(1);
 }
 
 void StageSynchronizer::conditionalArriveSingleStage() {
-    if (this->current_pipeline_type == PipelineType::Single) {
-        this->single_stage_barrier->arrive_and_wait();
+    if (this->current_pipeline_type != PipelineType::Single) {
+        return;
     }
+
+    if (this->execution_engine->isCycleDriven()) {
+        this->execution_engine->arriveSingleStage();
+    } else {
+        StageSynchronizer::is_single_stage_arrival_pending = true;
+    }
+}
+
+void StageSynchronizer::waitForSingleStageArrival() {
+    if (!StageSynchronizer::is_single_stage_arrival_pending) {
+        return;
+    }
+
+    StageSynchronizer::is_single_stage_arrival_pending = false;
+    this->single_stage_barrier.arriveAndWait();
 }
 
 void StageSynchronizer::arriveReset() {
-    this->reset_barrier->arrive_and_wait();
+    if (this->execution_engine->isCycleDriven()) {
+        return;  // Every reset is processed within the first evaluation pass, there is nobody to wait for
+    }
+
+    this->reset_barrier.arriveAndWait();
 }
 
-void StageSynchronizer::onCompletionFiveStage() {
-    std::lock_guard<std::mutex> on_completion_lock (this->module_mutex);
+bool StageSynchronizer::deferUntilClockEdge(std::function<void()> update) {
+    return this->deferFiveStageUpdate(std::move(update), false);
+}
+
+bool StageSynchronizer::deferNopUntilClockEdge(std::function<void()> update) {
+    return this->deferFiveStageUpdate(std::move(update), true);
+}
 
-    if (this->current_cycle == 0) {
-        std::cout << std::endl << "Five Stage Execution: " << std::endl << std::string(20, '-') << std::endl;
+bool StageSynchronizer::deferFiveStageUpdate(std::function<void()> update, bool is_nop_update) {
+    if (this->current_pipeline_type != PipelineType::Five) {
+        return false;
     }
 
-    std::cout << "=> Cycle: " << this->current_cycle++ << std::endl;
+    if (!this->execution_engine->deferUntilClockEdge(std::move(update), is_nop_update)) {
+        return false;  // Applied at the clock edge
+    }
+
+    if (!this->execution_engine->isCycleDriven()) {
+        this->five_stage_barrier.arrive();
+    }
+
+    return true;
+}
+
+void StageSynchronizer::completeCycle() {
+    if (this->current_pipeline_type == PipelineType::Single) {
+        this->onCompletionSingleStage();
+    } else {
+        this->onCompletionFiveStage();
+    }
+}
+
+void StageSynchronizer::printCycle(const std::string &execution_title) {
+    int cycle = this->current_cycle++;
+
+    if (!this->is_print_cycle_asserted) {
+        return;
+    }
+
+    // Written in one piece, pipelines of other contexts print their cycles to the same stream
+    std::string cycle_text;
+
+    if (cycle == 0) {
+        cycle_text += "\n" + this->cycle_prefix + execution_title + "\n" + std::string(20, '-') + "\n";
+    }
+
+    cycle_text += this->cycle_prefix + "=> Cycle: " + std::to_string(cycle) + "\n";
+
+    // Written by the Logger's console thread, the barrier completion never waits on the terminal
+    this->logger->writeToConsole(std::move(cycle_text));
+}
+
+void StageSynchronizer::onCompletionFiveStage() {
+    std::lock_guard<std::mutex> on_completion_lock (this->module_mutex);
+
+    this->printCycle("Five Stage Execution: ");
+    this->logger->setCurrentCycle(this->current_cycle);
 
     if (this->mem_wb_stage_registers->isExecutingHaltInstruction()) {
-        if (!this->mem_wb_stage_registers->is_nop_asserted) {
+        if (!this->mem_wb_stage_registers->isNopAsserted()) {
             this->halt_detected = true;
         }
     }
@@ -93,19 +167,20 @@ void StageSynchronizer::onCompletionFiveStage() {
         this->ex_mem_stage_registers->pause();
         this->mem_wb_stage_registers->pause();
     }
+
+    if (!this->execution_engine->isCycleDriven()) {
+        this->execution_engine->submitClockEdge();
+    }
 }
 
 void StageSynchronizer::onCompletionSingleStage() {
     std::lock_guard<std::mutex> on_completion_lock (this->module_mutex);
 
-    if (this->current_cycle == 0) {
-        std::cout << std::endl << "Single Stage Execution: " << std::endl << std::string(20, '-') << std::endl;
-    }
-
-    std::cout << "=> Cycle: " << this->current_cycle++ << std::endl;
+    this->printCycle("Single Stage Execution: ");
+    this->logger->setCurrentCycle(this->current_cycle);
 
     if (this->mem_wb_stage_registers->isExecutingHaltInstruction()) {
-        if (!this->mem_wb_stage_registers->is_nop_asserted && !this->mem_wb_stage_registers->is_nop_passed_flag_asserted) {
+        if (!this->mem_wb_stage_registers->isNopAsserted() && !this->mem_wb_stage_registers->nop_passed_flag.get()) {
             this->halt_detected = true;
         }
     }
@@ -133,10 +208,19 @@ void StageSynchronizer::setPipelineType(PipelineType new_pipeline_type) {
 
 void StageSynchronizer::reset() {
     this->current_cycle = 0;
+    this->logger->setCurrentCycle(this->current_cycle);
     this->is_paused = false;
     this->halt_detected = false;
 }
 
+void StageSynchronizer::assertPrintCycleFlag(bool is_asserted) {
+    this->is_print_cycle_asserted = is_asserted;
+}
+
+int StageSynchronizer::getCurrentCycle() const {
+    return this->current_cycle;
+}
+
 bool StageSynchronizer::isPaused() {
     std::lock_guard<std::mutex> on_completion_lock (this->module_mutex);
 
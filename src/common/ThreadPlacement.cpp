@@ -0,0 +1,227 @@
+#include "../../include/common/ThreadPlacement.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <tuple>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+ThreadPlacementPolicy ThreadPlacement::policy = ThreadPlacementPolicy::None;
+std::mutex ThreadPlacement::placement_mutex;
+bool ThreadPlacement::is_planned = false;
+std::array<std::vector<int>, ThreadPlacement::STAGE_COUNT> ThreadPlacement::stage_cpus;
+std::vector<int> ThreadPlacement::pool_worker_cpus;
+std::vector<int> ThreadPlacement::logger_writer_cpus;
+std::vector<ThreadPlacement::Placement> &ThreadPlacement::placements = *new std::vector<ThreadPlacement::Placement>();
+
+void ThreadPlacement::setPolicy(ThreadPlacementPolicy new_policy) {
+    std::lock_guard<std::mutex> placement_lock (ThreadPlacement::placement_mutex);
+
+    if (ThreadPlacement::is_planned) {
+        throw std::runtime_error("ThreadPlacement::setPolicy: threads are already placed.");
+    }
+
+    ThreadPlacement::policy = new_policy;
+}
+
+ThreadPlacementPolicy ThreadPlacement::getPolicy() {
+    return ThreadPlacement::policy;
+}
+
+void ThreadPlacement::placeModuleThread(Stage stage, const std::string &thread_name) {
+    if (ThreadPlacement::policy == ThreadPlacementPolicy::None) {
+        return;
+    }
+
+    ThreadPlacement::place({thread_name, ThreadRole::Module, stage, std::this_thread::get_id(), {}, {}});
+}
+
+void ThreadPlacement::placePoolWorkerThread(const std::string &thread_name) {
+    if (ThreadPlacement::policy == ThreadPlacementPolicy::None) {
+        return;
+    }
+
+    ThreadPlacement::place({thread_name, ThreadRole::PoolWorker, Stage::IF, std::this_thread::get_id(), {}, {}});
+}
+
+void ThreadPlacement::placeLoggerWriterThread(Stage stage, const std::string &thread_name) {
+    if (ThreadPlacement::policy == ThreadPlacementPolicy::None) {
+        return;
+    }
+
+    ThreadPlacement::place({thread_name, ThreadRole::LoggerWriter, stage, std::this_thread::get_id(), {}, {}});
+}
+
+void ThreadPlacement::removeCurrentThread() {
+    if (ThreadPlacement::policy == ThreadPlacementPolicy::None) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> placement_lock (ThreadPlacement::placement_mutex);
+
+    std::erase_if(ThreadPlacement::placements, [](const Placement &placement) {
+        return placement.thread_id == std::this_thread::get_id();
+    });
+}
+
+void ThreadPlacement::place(Placement placement) {
+    std::lock_guard<std::mutex> placement_lock (ThreadPlacement::placement_mutex);
+
+    if (!ThreadPlacement::is_planned) {
+        ThreadPlacement::planPlacement();
+    }
+
+    switch (placement.role) {
+        case ThreadRole::Module:
+            placement.cpus = ThreadPlacement::stage_cpus.at(static_cast<int>(placement.stage));
+            break;
+        case ThreadRole::PoolWorker:
+            placement.cpus = ThreadPlacement::pool_worker_cpus;
+            break;
+        case ThreadRole::LoggerWriter:
+            placement.cpus = ThreadPlacement::logger_writer_cpus;
+            break;
+    }
+
+#ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+
+    for (int cpu: placement.cpus) {
+        CPU_SET(cpu, &cpu_set);
+    }
+
+    int error_number = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+
+    if (error_number != 0) {
+        placement.error = std::strerror(error_number);
+    }
+#else
+    placement.error = "pinning is not supported on this platform";
+#endif
+
+    ThreadPlacement::placements.push_back(std::move(placement));
+}
+
+/**
+ * Writers get one CPU per STAGE_COUNT + 1 CPUs, at least one. Stage s gets the module CPUs [s * n / 5, (s + 1) * n / 5)
+ * of the n left, with fewer module CPUs than stages neighbouring stages share one.
+ */
+void ThreadPlacement::planPlacement() {
+    std::vector<Cpu> cpus = ThreadPlacement::getAvailableCpus();
+
+    std::sort(cpus.begin(), cpus.end(), [](const Cpu &first, const Cpu &second) {
+        return std::tie(first.package_id, first.core_id, first.cpu_id) <
+               std::tie(second.package_id, second.core_id, second.cpu_id);
+    });
+
+    std::vector<int> cpu_ids;
+
+    for (const Cpu &cpu: cpus) {
+        cpu_ids.push_back(cpu.cpu_id);
+    }
+
+    if (cpu_ids.size() < 2) {
+        // Nothing to separate, the threads stay on whatever the process may run on
+        for (std::vector<int> &cpus_of_stage: ThreadPlacement::stage_cpus) {
+            cpus_of_stage = cpu_ids;
+        }
+
+        ThreadPlacement::pool_worker_cpus = cpu_ids;
+        ThreadPlacement::logger_writer_cpus = cpu_ids;
+        ThreadPlacement::is_planned = true;
+        return;
+    }
+
+    std::size_t logger_writer_cpu_count = std::max<std::size_t>(1, cpu_ids.size() / (STAGE_COUNT + 1));
+    std::size_t module_cpu_count = cpu_ids.size() - logger_writer_cpu_count;
+
+    for (int i = 0; i < STAGE_COUNT; ++i) {
+        std::size_t begin = i * module_cpu_count / STAGE_COUNT;
+        std::size_t end = std::max(begin + 1, (i + 1) * module_cpu_count / STAGE_COUNT);
+
+        ThreadPlacement::stage_cpus.at(i).assign(cpu_ids.begin() + begin, cpu_ids.begin() + end);
+    }
+
+    ThreadPlacement::pool_worker_cpus.assign(cpu_ids.begin(), cpu_ids.begin() + module_cpu_count);
+    ThreadPlacement::logger_writer_cpus.assign(cpu_ids.begin() + module_cpu_count, cpu_ids.end());
+    ThreadPlacement::is_planned = true;
+}
+
+std::vector<ThreadPlacement::Cpu> ThreadPlacement::getAvailableCpus() {
+    std::vector<Cpu> cpus;
+
+#ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+
+    if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+        throw std::runtime_error("ThreadPlacement::getAvailableCpus: cannot read the process affinity.");
+    }
+
+    for (int cpu_id = 0; cpu_id < CPU_SETSIZE; ++cpu_id) {
+        if (CPU_ISSET(cpu_id, &cpu_set)) {
+            cpus.push_back({
+                    ThreadPlacement::readTopologyId(cpu_id, "physical_package_id"),
+                    ThreadPlacement::readTopologyId(cpu_id, "core_id"),
+                    cpu_id
+            });
+        }
+    }
+#endif
+
+    return cpus;
+}
+
+// Missing topology files (containers, unusual kernels) leave the CPUs ordered by their id
+int ThreadPlacement::readTopologyId(int cpu_id, const std::string &name) {
+    std::ifstream topology_file ("/sys/devices/system/cpu/cpu" + std::to_string(cpu_id) + "/topology/" + name);
+    int id = 0;
+
+    if (!(topology_file >> id)) {
+        return 0;
+    }
+
+    return id;
+}
+
+void ThreadPlacement::printPlacements() {
+    const std::array<std::string, STAGE_COUNT> stage_names = {"IF", "ID", "EX", "MEM", "WB"};
+
+    std::lock_guard<std::mutex> placement_lock (ThreadPlacement::placement_mutex);
+
+    // Threads place themselves as they start, the report is ordered independently of that
+    std::vector<Placement> sorted_placements = ThreadPlacement::placements;
+
+    std::sort(sorted_placements.begin(), sorted_placements.end(), [](const Placement &first, const Placement &second) {
+        return std::tie(first.role, first.stage, first.thread_name) <
+               std::tie(second.role, second.stage, second.thread_name);
+    });
+
+    std::cout << std::endl << "Thread placement:" << std::endl;
+
+    for (const Placement &placement: sorted_placements) {
+        std::string cpu_list;
+
+        for (int cpu: placement.cpus) {
+            cpu_list += (cpu_list.empty() ? "" : ",") + std::to_string(cpu);
+        }
+
+        std::cout << "    " << std::left << std::setw(32) << placement.thread_name << std::setw(4)
+                  << (placement.role == ThreadRole::PoolWorker ? "-" : stage_names.at(static_cast<int>(placement.stage)))
+                  << std::right;
+
+        if (placement.error.empty()) {
+            std::cout << " CPUs " << cpu_list << std::endl;
+        } else {
+            std::cout << " not pinned, " << placement.error << std::endl;
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#include "../../include/common/WorkerPool.h"
+
+#include "../../include/common/ThreadPlacement.h"
+
+WorkerPool::WorkerPool(int worker_count, std::string thread_name) {
+    this->thread_name = std::move(thread_name);
+    this->is_stopped = false;
+    this->executed_tasks_count = 0;
+
+    for (int i = 0; i < worker_count; ++i) {
+        this->workers.emplace_back(&WorkerPool::work, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> tasks_lock (this->tasks_mutex);
+        this->is_stopped = true;
+    }
+
+    this->tasks_condition_variable.notify_all();
+
+    for (std::thread &worker: this->workers) {
+        worker.join();
+    }
+}
+
+void WorkerPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> tasks_lock (this->tasks_mutex);
+        this->tasks.push(std::move(task));
+    }
+
+    this->tasks_condition_variable.notify_one();
+}
+
+void WorkerPool::work(int worker_index) {
+    ThreadPlacement::placePoolWorkerThread(this->thread_name + " " + std::to_string(worker_index));
+
+    while (true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> tasks_lock (this->tasks_mutex);
+            this->tasks_condition_variable.wait(
+                    tasks_lock,
+                    [this] { return !this->tasks.empty() || this->is_stopped; }
+            );
+
+            if (this->tasks.empty()) {
+                break;
+            }
+
+            task = std::move(this->tasks.front());
+            this->tasks.pop();
+        }
+
+        task();
+        ++this->executed_tasks_count;
+    }
+
+    ThreadPlacement::removeCurrentThread();
+}
+
+unsigned long WorkerPool::getExecutedTasksCount() const {
+    return this->executed_tasks_count;
+}
+
+unsigned long WorkerPool::getQueueDepth() {
+    std::lock_guard<std::mutex> tasks_lock (this->tasks_mutex);
+
+    return this->tasks.size();
+}
+
+int WorkerPool::getWorkerCount() const {
+    return static_cast<int>(this->workers.size());
+}
@@ -1,310 +1,374 @@
+#include <iomanip>
+#include <iostream>
 #include <string>
+#include <thread>
+#include <tuple>
 
+#include "../include/common/Pipeline.h"
 #include "../include/common/StageSynchronizer.h"
-
-class EXAdder;
-class IFAdder;
-class ALUInput1ForwardingMux;
-class ALUInput2ForwardingMux;
-class EXMuxALUInput1;
-class EXMuxALUInput2;
-class IFMux;
-class WBMux;
-class ALU;
-class ForwardingUnit;
-class ImmediateGenerator;
-class StageSynchronizer;
-class EXMEMStageRegisters;
-class IDEXStageRegisters;
-class IFIDStageRegisters;
-class MEMWBStageRegisters;
-class DataMemory;
-class Driver;
-class InstructionMemory;
-class RegisterFile;
-class HazardDetectionUnit;
-
-struct Pipeline {
-    EXAdder *ex_adder = nullptr;
-    IFAdder *if_adder = nullptr;
-    ALUInput1ForwardingMux *alu_input_1_forwarding_mux = nullptr;
-    ALUInput2ForwardingMux *alu_input_2_forwarding_mux = nullptr;
-    EXMuxALUInput1 *ex_mux_alu_input_1 = nullptr;
-    EXMuxALUInput2 *ex_mux_alu_input_2 = nullptr;
-    IFMux *if_mux = nullptr;
-    WBMux *wb_mux = nullptr;
-    ALU *alu = nullptr;
-    Logger *logger = nullptr;
-    ForwardingUnit *forwarding_unit = nullptr;
-    ImmediateGenerator *immediate_generator = nullptr;
-    StageSynchronizer *stage_synchronizer = nullptr;
-    EXMEMStageRegisters *ex_mem_stage_registers = nullptr;
-    IDEXStageRegisters *id_ex_stage_registers = nullptr;
-    IFIDStageRegisters *if_id_stage_registers = nullptr;
-    MEMWBStageRegisters *mem_wb_stage_registers = nullptr;
-    DataMemory *data_memory = nullptr;
-    Driver *driver = nullptr;
-    InstructionMemory *instruction_memory = nullptr;
-    RegisterFile *register_file = nullptr;
-    HazardDetectionUnit *hazard_detection_unit = nullptr;
+#include "../include/common/FunctionalSimulator.h"
+
+struct SimulatorOptions {
+    ExecutionMode execution_mode = ExecutionMode::Threaded;
+    LogFormat log_format = LogFormat::Text;
+    RegisterFileTraceMode register_file_trace_mode = RegisterFileTraceMode::Full;
+    unsigned long data_memory_size = DataMemory::DEFAULT_DATA_MEMORY_SIZE;
+    DataMemoryModel data_memory_model = DataMemoryModel::Flat;
+    std::string instruction_memory_file_path = "../input/imem.txt";
+    std::string data_memory_file_path = "../input/dmem.txt";
+    std::string halt_symbol;
+    std::optional<uint32_t> halt_instruction;
+    ThreadPlacementPolicy thread_placement_policy = ThreadPlacementPolicy::None;
+    bool is_concurrent = false;
+    unsigned long fast_forward_instruction_count = 0UL;
 };
 
-struct ActiveThreads {
-    std::thread ex_adder_thread;
-    std::thread if_adder_thread;
-    std::thread alu_input_1_forwarding_mux_thread;
-    std::thread alu_input_2_forwarding_mux_thread;
-    std::thread ex_mux_alu_input_1_thread;
-    std::thread ex_mux_alu_input_2_thread;
-    std::thread if_mux_thread;
-    std::thread wb_mux_thread;
-    std::thread alu_thread;
-    std::thread forwarding_unit_thread;
-    std::thread immediate_generator_thread;
-    std::thread ex_mem_stage_registers_thread;
-    std::thread id_ex_stage_registers_thread;
-    std::thread if_id_stage_registers_thread;
-    std::thread mem_wb_stage_registers_thread;
-    std::thread data_memory_thread;
-    std::thread logger_thread;
-    std::thread driver_thread;
-    std::thread instruction_memory_thread;
-    std::thread register_file_thread;
-    std::thread hazard_detection_unit_thread;
-};
+void printDataMemoryStatistics(Pipeline &pipeline) {
+    unsigned long out_of_bounds_access_count = pipeline.data_memory->getOutOfBoundsAccessCount();
+
+    if (out_of_bounds_access_count > 0) {
+        std::cout << "Data memory: " << out_of_bounds_access_count << " out of bounds accesses" << std::endl;
+    }
+
+    if (pipeline.data_memory->getDataMemoryModel() == DataMemoryModel::Paged) {
+        unsigned long resident_page_count = pipeline.data_memory->getResidentPageCount();
 
-void resetPipeline(Pipeline &pipeline) {
-    pipeline.ex_mem_stage_registers->reset();
-    pipeline.id_ex_stage_registers->reset();
-    pipeline.if_id_stage_registers->reset();
-    pipeline.mem_wb_stage_registers->reset();
-    pipeline.driver->reset();
-    pipeline.register_file->reset();
-    pipeline.data_memory->reset();
-    pipeline.stage_synchronizer->reset();
-    pipeline.alu->reset();
-    pipeline.hazard_detection_unit->reset();
-    pipeline.forwarding_unit->reset();
-//    pipeline.ex_mux_alu_input_1->reset();
-//    pipeline.ex_mux_alu_input_2->reset();
-//    pipeline.alu_input_1_forwarding_mux->reset();
-//    pipeline.alu_input_2_forwarding_mux->reset();
+        std::cout << "Data memory: " << resident_page_count << " resident pages ("
+                  << resident_page_count * PagedMemory::PAGE_SIZE / 1024 << " KiB)" << std::endl;
+    }
 }
 
-void pausePipeline(Pipeline &pipeline) {
-    pipeline.ex_mem_stage_registers->pause();
-    pipeline.id_ex_stage_registers->pause();
-    pipeline.if_id_stage_registers->pause();
-    pipeline.mem_wb_stage_registers->pause();
-    pipeline.driver->pause();
+void printDecodedInstructionCacheStatistics(Pipeline &pipeline) {
+    std::cout << std::endl << "Decoded instruction cache: "
+              << pipeline.instruction_memory->getDecodedInstructionCacheHitCount() << " hits, "
+              << pipeline.instruction_memory->getDecodedInstructionCacheMissCount() << " misses" << std::endl;
 }
 
-void resumePipeline(Pipeline &pipeline) {
-    pipeline.ex_mem_stage_registers->resume();
-    pipeline.id_ex_stage_registers->resume();
-    pipeline.if_id_stage_registers->resume();
-    pipeline.mem_wb_stage_registers->resume();
-    pipeline.driver->resume();
-    pipeline.register_file->resume();
-    pipeline.hazard_detection_unit->resume();
+// Process wide, decoding allocates once per cache miss and stages pass Control by value
+void printAllocationStatistics() {
+    std::cout << "Instruction objects: " << Instruction::getAllocationCount() << " allocated, "
+              << Instruction::getLiveCount() << " live" << std::endl;
+    std::cout << "Control objects: " << Control::getAllocationCount() << " allocated, "
+              << Control::getLiveCount() << " live" << std::endl;
 }
 
-void changePipelineType(Pipeline &pipeline, const PipelineType &type) {
-    pipeline.ex_adder->setPipelineType(type);
-    pipeline.if_adder->setPipelineType(type);
-    pipeline.alu_input_1_forwarding_mux->setPipelineType(type);
-    pipeline.alu_input_2_forwarding_mux->setPipelineType(type);
-    pipeline.ex_mux_alu_input_1->setPipelineType(type);
-    pipeline.ex_mux_alu_input_2->setPipelineType(type);
-    pipeline.if_mux->setPipelineType(type);
-    pipeline.wb_mux->setPipelineType(type);
-    pipeline.alu->setPipelineType(type);
-    pipeline.forwarding_unit->setPipelineType(type);
-    pipeline.immediate_generator->setPipelineType(type);
-    pipeline.ex_mem_stage_registers->setPipelineType(type);
-    pipeline.id_ex_stage_registers->setPipelineType(type);
-    pipeline.if_id_stage_registers->setPipelineType(type);
-    pipeline.mem_wb_stage_registers->setPipelineType(type);
-    pipeline.data_memory->setPipelineType(type);
-    pipeline.driver->setPipelineType(type);
-    pipeline.instruction_memory->setPipelineType(type);
-    pipeline.register_file->setPipelineType(type);
-    pipeline.hazard_detection_unit->setPipelineType(type);
-    pipeline.stage_synchronizer->setPipelineType(type);
+// Threaded mode only, the cycle-driven modes deliver signals on the calling thread
+void printWorkerPoolStatistics(Pipeline &pipeline) {
+    if (pipeline.execution_engine->isCycleDriven()) {
+        return;
+    }
+
+    WorkerPool *worker_pool = pipeline.execution_engine->getWorkerPool();
+
+    std::cout << "Worker pool: " << worker_pool->getWorkerCount() << " threads, "
+              << worker_pool->getExecutedTasksCount() << " tasks executed, "
+              << worker_pool->getQueueDepth() << " queued" << std::endl;
 }
 
-void killPipeline(Pipeline &pipeline) {
-    pipeline.ex_adder->kill();
-    pipeline.if_adder->kill();
-    pipeline.alu_input_1_forwarding_mux->kill();
-    pipeline.alu_input_2_forwarding_mux->kill();
-    pipeline.ex_mux_alu_input_1->kill();
-    pipeline.ex_mux_alu_input_2->kill();
-    pipeline.if_mux->kill();
-    pipeline.wb_mux->kill();
-    pipeline.alu->kill();
-    pipeline.logger->kill();
-    pipeline.forwarding_unit->kill();
-    pipeline.immediate_generator->kill();
-    pipeline.ex_mem_stage_registers->kill();
-    pipeline.id_ex_stage_registers->kill();
-    pipeline.if_id_stage_registers->kill();
-    pipeline.mem_wb_stage_registers->kill();
-    pipeline.data_memory->kill();
-    pipeline.driver->kill();
-    pipeline.instruction_memory->kill();
-    pipeline.register_file->kill();
-    pipeline.hazard_detection_unit->kill();
+void printThreadPlacement() {
+    if (ThreadPlacement::getPolicy() != ThreadPlacementPolicy::None) {
+        ThreadPlacement::printPlacements();
+    }
 }
 
-Pipeline initializePipeline() {
-    Pipeline pipeline;
-
-    pipeline.ex_adder = EXAdder::init();
-    pipeline.if_adder = IFAdder::init();
-    pipeline.alu_input_1_forwarding_mux =  ALUInput1ForwardingMux::init();
-    pipeline.alu_input_2_forwarding_mux = ALUInput2ForwardingMux::init();
-    pipeline.ex_mux_alu_input_1 = EXMuxALUInput1::init();
-    pipeline.ex_mux_alu_input_2 = EXMuxALUInput2::init();
-    pipeline.if_mux = IFMux::init();
-    pipeline.wb_mux = WBMux::init();
-    pipeline.alu = ALU::init();
-    pipeline.logger = Logger::init();
-    pipeline.forwarding_unit = ForwardingUnit::init();
-    pipeline.immediate_generator = ImmediateGenerator::init();
-    pipeline.stage_synchronizer = StageSynchronizer::init();
-    pipeline.ex_mem_stage_registers = EXMEMStageRegisters::init();
-    pipeline.id_ex_stage_registers = IDEXStageRegisters::init();
-    pipeline.if_id_stage_registers = IFIDStageRegisters::init();
-    pipeline.mem_wb_stage_registers = MEMWBStageRegisters::init();
-    pipeline.data_memory = DataMemory::init();
-    pipeline.driver = Driver::init();
-    pipeline.instruction_memory = InstructionMemory::init();
-    pipeline.register_file = RegisterFile::init();
-    pipeline.hazard_detection_unit = HazardDetectionUnit::init();
-
-    return pipeline;
+void printEvaluationStatistics(Pipeline &pipeline) {
+    std::cout << std::endl << "Event-driven evaluation:" << std::endl;
+
+    for (const ModuleEvaluationStatistics &statistics: pipeline.execution_engine->getEvaluationStatistics()) {
+        std::cout << "    " << std::left << std::setw(24) << statistics.module_tag << std::right
+                  << std::setw(8) << statistics.evaluation_count << " evaluations, "
+                  << std::setw(8) << statistics.skipped_evaluation_count << " skipped" << std::endl;
+    }
 }
 
-ActiveThreads runPipeline(const Pipeline &pipeline) {
-    ActiveThreads active_threads;
-
-    active_threads.ex_adder_thread = std::thread(&EXAdder::run, pipeline.ex_adder);
-    active_threads.if_adder_thread = std::thread(&IFAdder::run, pipeline.if_adder);
-
-    active_threads.alu_input_1_forwarding_mux_thread = std::thread(
-            &ALUInput1ForwardingMux::run,
-            pipeline.alu_input_1_forwarding_mux
-    );
-
-    active_threads.alu_input_2_forwarding_mux_thread = std::thread(
-            &ALUInput2ForwardingMux::run,
-            pipeline.alu_input_2_forwarding_mux
-    );
-
-    active_threads.ex_mux_alu_input_1_thread = std::thread(&EXMuxALUInput1::run, pipeline.ex_mux_alu_input_1);
-    active_threads.ex_mux_alu_input_2_thread = std::thread(&EXMuxALUInput2::run, pipeline.ex_mux_alu_input_2);
-    active_threads.if_mux_thread = std::thread(&IFMux::run, pipeline.if_mux);
-    active_threads.wb_mux_thread = std::thread(&WBMux::run, pipeline.wb_mux);
-    active_threads.alu_thread = std::thread(&ALU::run, pipeline.alu);
-    active_threads.forwarding_unit_thread = std::thread(&ForwardingUnit::run, pipeline.forwarding_unit);
-    active_threads.immediate_generator_thread = std::thread(&ImmediateGenerator::run, pipeline.immediate_generator);
-    active_threads.ex_mem_stage_registers_thread = std::thread(
-            &EXMEMStageRegisters::run,
-            pipeline.ex_mem_stage_registers
-    );
-
-    active_threads.id_ex_stage_registers_thread = std::thread(
-            &IDEXStageRegisters::run,
-            pipeline.id_ex_stage_registers
-    );
-
-    active_threads.if_id_stage_registers_thread = std::thread(
-            &IFIDStageRegisters::run,
-            pipeline.if_id_stage_registers
-    );
-
-    active_threads.mem_wb_stage_registers_thread = std::thread(
-            &MEMWBStageRegisters::run,
-            pipeline.mem_wb_stage_registers
-    );
-
-    active_threads.data_memory_thread = std::thread(&DataMemory::run, pipeline.data_memory);
-    active_threads.driver_thread = std::thread(&Driver::run, pipeline.driver);
-    active_threads.instruction_memory_thread = std::thread(&InstructionMemory::run, pipeline.instruction_memory);
-    active_threads.register_file_thread = std::thread(&RegisterFile::run, pipeline.register_file);
-    active_threads.hazard_detection_unit_thread = std::thread(&HazardDetectionUnit::run, pipeline.hazard_detection_unit);
-
-    active_threads.ex_adder_thread.detach();
-    active_threads.if_adder_thread.detach();
-    active_threads.alu_input_1_forwarding_mux_thread.detach();
-    active_threads.alu_input_2_forwarding_mux_thread.detach();
-    active_threads.ex_mux_alu_input_1_thread.detach();
-    active_threads.ex_mux_alu_input_2_thread.detach();
-    active_threads.if_mux_thread.detach();
-    active_threads.wb_mux_thread.detach();
-    active_threads.alu_thread.detach();
-    active_threads.forwarding_unit_thread.detach();
-    active_threads.immediate_generator_thread.detach();
-    active_threads.ex_mem_stage_registers_thread.detach();
-    active_threads.id_ex_stage_registers_thread.detach();
-    active_threads.if_id_stage_registers_thread.detach();
-    active_threads.mem_wb_stage_registers_thread.detach();
-    active_threads.data_memory_thread.detach();
-    active_threads.driver_thread.detach();
-    active_threads.instruction_memory_thread.detach();
-    active_threads.register_file_thread.detach();
-    active_threads.hazard_detection_unit_thread.detach();
-
-    return active_threads;
+void loadProgram(Pipeline &pipeline, const SimulatorOptions &options) {
+    if (!options.halt_symbol.empty()) {
+        pipeline.instruction_memory->setHaltSymbol(options.halt_symbol);
+    }
+
+    if (options.halt_instruction) {
+        pipeline.instruction_memory->setHaltInstruction(*options.halt_instruction);
+    }
+
+    changeInstructionMemoryFile(pipeline, options.instruction_memory_file_path);
+    pipeline.data_memory->setDataMemorySize(options.data_memory_size);
+    pipeline.data_memory->setDataMemoryModel(options.data_memory_model);
+    changeDataMemoryFile(pipeline, options.data_memory_file_path);
 }
 
-void printStagesState(Pipeline &pipeline) {
-    pipeline.driver->assertVerboseExecutionFlag();
-    pipeline.if_id_stage_registers->assertVerboseExecutionFlag();
-    pipeline.id_ex_stage_registers->assertVerboseExecutionFlag();
-    pipeline.ex_mem_stage_registers->assertVerboseExecutionFlag();
-    pipeline.mem_wb_stage_registers->assertVerboseExecutionFlag();
+// Before the pipeline starts, its first cycle executes the instruction after the fast-forwarded ones
+void fastForwardPipeline(SimulationContext *context, const SimulatorOptions &options) {
+    if (options.fast_forward_instruction_count == 0) {
+        return;
+    }
+
+    FunctionalSimulator *functional_simulator = context->get<FunctionalSimulator>();
+    functional_simulator->fastForward(options.fast_forward_instruction_count);
+
+    std::cout << "Fast-forwarded " << functional_simulator->getExecutedInstructionCount() << " instructions to pc "
+              << functional_simulator->getProgramCounter() << std::endl;
 }
 
-void changeInstructionMemoryFile(Pipeline &pipeline, const std::string &new_file_path) {
-    pipeline.instruction_memory->setInstructionMemoryInputFilePath(new_file_path);
+void startPipeline(Pipeline &pipeline) {
+    if (pipeline.execution_engine->isCycleDriven()) {
+        registerPipeline(pipeline);
+    } else {
+        runPipeline(pipeline);
+    }
 }
 
-void changeDataMemoryFile(Pipeline &pipeline, const std::string &new_file_path) {
-    pipeline.data_memory->setDataMemoryInputFilePath(new_file_path);
+void runUntilPaused(Pipeline &pipeline) {
+    while (!pipeline.stage_synchronizer->isPaused()) {
+        if (pipeline.execution_engine->isCycleDriven()) {
+            pipeline.execution_engine->runUntilPaused();
+        } else {
+            sleep(1);
+        }
+    }
+
+    // The cycle lines and state dumps are still queued for the console, the statistics are printed after them
+    pipeline.logger->waitForConsoleOutput();
 }
 
-void clearOutputFiles(Pipeline &pipeline) {
-    pipeline.register_file->clearRegisterFileOutputFile();
-    pipeline.data_memory->clearDataMemoryOutputFile();
+/**
+ * Runs the single and five stage pipelines side by side, each in its own SimulationContext and on its own thread.
+ * Stage logs are written to <Stage>-SS.log and <Stage>-FS.log, the per cycle state dumps are left out since both
+ * pipelines would interleave them on the console.
+ */
+void runConcurrentPipelines(const SimulatorOptions &options) {
+    // Module threads are detached, so contexts live until the process exits
+    auto *single_stage_context = new SimulationContext("SS");
+    auto *five_stage_context = new SimulationContext("FS");
+
+    Pipeline single_stage_pipeline;
+    Pipeline five_stage_pipeline;
+
+    // Both pipelines are created before either runs, constructors truncate the single stage output files
+    for (auto [context, pipeline, type]: {std::tuple(single_stage_context, &single_stage_pipeline, PipelineType::Single),
+                                          std::tuple(five_stage_context, &five_stage_pipeline, PipelineType::Five)}) {
+        *pipeline = initializePipeline(context);
+        pipeline->execution_engine->setExecutionMode(options.execution_mode);
+
+        if (type == PipelineType::Five) {
+            // Same switch as the sequential run, the reset brings the stage registers into their five stage state
+            changePipelineType(*pipeline, type);
+            resetPipeline(*pipeline);
+        }
+
+        pipeline->register_file->setTraceMode(options.register_file_trace_mode);
+        clearOutputFiles(*pipeline);
+        loadProgram(*pipeline, options);
+        fastForwardPipeline(context, options);
+    }
+
+    auto run_pipeline = [](Pipeline *pipeline) {
+        startPipeline(*pipeline);
+        runUntilPaused(*pipeline);
+    };
+
+    std::thread single_stage_thread (run_pipeline, &single_stage_pipeline);
+    std::thread five_stage_thread (run_pipeline, &five_stage_pipeline);
+
+    single_stage_thread.join();
+    five_stage_thread.join();
+
+    // Placements are dropped as the threads exit, so they are printed before the pipelines are killed
+    printThreadPlacement();
+
+    for (Pipeline *pipeline: {&single_stage_pipeline, &five_stage_pipeline}) {
+        printDecodedInstructionCacheStatistics(*pipeline);
+        printDataMemoryStatistics(*pipeline);
+        printWorkerPoolStatistics(*pipeline);
+
+        if (options.execution_mode == ExecutionMode::EventDriven) {
+            printEvaluationStatistics(*pipeline);
+        }
+
+        killPipeline(*pipeline);
+    }
+
+    printAllocationStatistics();
 }
 
-int main() {
-    Pipeline pipeline = initializePipeline();
-    printStagesState(pipeline);
-    clearOutputFiles(pipeline);
+void runFunctionalSimulation(SimulationContext *context) {
+    FunctionalSimulator *functional_simulator = context->get<FunctionalSimulator>();
+    functional_simulator->reset();
+    functional_simulator->run();
 
-    changeInstructionMemoryFile(pipeline, "../input/imem.txt");
-    changeDataMemoryFile(pipeline, "../input/dmem.txt");
+    std::cout << std::endl << "Functional simulation: "
+              << functional_simulator->getExecutedInstructionCount() << " instructions executed" << std::endl;
+}
 
-    ActiveThreads active_threads = runPipeline(pipeline);
+bool parseArguments(int argc, char *argv[], SimulatorOptions &options) {
+    const std::string execution_mode_option = "--execution-mode=";
+    const std::string log_format_option = "--log-format=";
+    const std::string register_file_trace_option = "--register-file-trace=";
+    const std::string data_memory_size_option = "--data-memory-size=";
+    const std::string data_memory_model_option = "--data-memory-model=";
+    const std::string instruction_memory_file_option = "--instruction-memory-file=";
+    const std::string data_memory_file_option = "--data-memory-file=";
+    const std::string elf_option = "--elf=";
+    const std::string halt_symbol_option = "--halt-symbol=";
+    const std::string halt_instruction_option = "--halt-instruction=";
+    const std::string thread_placement_option = "--thread-placement=";
+    const std::string fast_forward_option = "--fast-forward=";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+
+        if (argument == execution_mode_option + "threaded") {
+            options.execution_mode = ExecutionMode::Threaded;
+        } else if (argument == execution_mode_option + "cycle-driven") {
+            options.execution_mode = ExecutionMode::CycleDriven;
+        } else if (argument == execution_mode_option + "event-driven") {
+            options.execution_mode = ExecutionMode::EventDriven;
+        } else if (argument == execution_mode_option + "coroutine") {
+            options.execution_mode = ExecutionMode::Coroutine;
+        } else if (argument == execution_mode_option + "functional") {
+            options.execution_mode = ExecutionMode::Functional;
+        } else if (argument == log_format_option + "text") {
+            options.log_format = LogFormat::Text;
+        } else if (argument == log_format_option + "binary") {
+            options.log_format = LogFormat::Binary;
+        } else if (argument == log_format_option + "none") {
+            options.log_format = LogFormat::None;
+        } else if (argument == register_file_trace_option + "full") {
+            options.register_file_trace_mode = RegisterFileTraceMode::Full;
+        } else if (argument == register_file_trace_option + "delta") {
+            options.register_file_trace_mode = RegisterFileTraceMode::Delta;
+        } else if (argument.starts_with(data_memory_size_option)) {
+            std::string size = argument.substr(data_memory_size_option.size());
+
+            if (size.empty() || size.find_first_not_of("0123456789") != std::string::npos) {
+                std::cerr << "Invalid data memory size: " << size << std::endl;
+                return false;
+            }
 
-    while (true) {
-        if (!pipeline.stage_synchronizer->isPaused()) {
-            sleep(1);
-        } else {
-            if (pipeline.driver->getPipelineType() == PipelineType::Single) {
-                resetPipeline(pipeline);
-                changePipelineType(pipeline, PipelineType::Five);
-                resetPipeline(pipeline);
-                clearOutputFiles(pipeline);
-                resumePipeline(pipeline);
-            } else {
-                break;
+            options.data_memory_size = std::stoul(size);
+        } else if (argument == data_memory_model_option + "flat") {
+            options.data_memory_model = DataMemoryModel::Flat;
+        } else if (argument == data_memory_model_option + "paged") {
+            options.data_memory_model = DataMemoryModel::Paged;
+        } else if (argument.starts_with(instruction_memory_file_option)) {
+            options.instruction_memory_file_path = argument.substr(instruction_memory_file_option.size());
+        } else if (argument.starts_with(data_memory_file_option)) {
+            options.data_memory_file_path = argument.substr(data_memory_file_option.size());
+        } else if (argument.starts_with(elf_option)) {
+            options.instruction_memory_file_path = argument.substr(elf_option.size());
+            options.data_memory_file_path = options.instruction_memory_file_path;
+        } else if (argument.starts_with(halt_symbol_option)) {
+            options.halt_symbol = argument.substr(halt_symbol_option.size());
+        } else if (argument.starts_with(halt_instruction_option)) {
+            std::string instruction = argument.substr(halt_instruction_option.size());
+            std::size_t parsed_length = 0;
+
+            try {
+                unsigned long encoding = std::stoul(instruction, &parsed_length, 0);
+
+                if (parsed_length != instruction.size() || encoding > UINT32_MAX) {
+                    throw std::out_of_range(instruction);
+                }
+
+                options.halt_instruction = encoding;
+            } catch (const std::logic_error &e) {
+                std::cerr << "Invalid halt instruction: " << instruction << std::endl;
+                return false;
+            }
+        } else if (argument == thread_placement_option + "none") {
+            options.thread_placement_policy = ThreadPlacementPolicy::None;
+        } else if (argument == thread_placement_option + "stage") {
+            options.thread_placement_policy = ThreadPlacementPolicy::Stage;
+        } else if (argument.starts_with(fast_forward_option)) {
+            std::string count = argument.substr(fast_forward_option.size());
+
+            if (count.empty() || count.find_first_not_of("0123456789") != std::string::npos) {
+                std::cerr << "Invalid fast-forward instruction count: " << count << std::endl;
+                return false;
             }
+
+            options.fast_forward_instruction_count = std::stoul(count);
+        } else if (argument == "--concurrent") {
+            options.is_concurrent = true;
+        } else {
+            std::cerr << "Unrecognized argument: " << argument << std::endl;
+            return false;
         }
     }
 
+    if (options.is_concurrent && options.execution_mode == ExecutionMode::Functional) {
+        std::cerr << "--concurrent runs both pipelines, it does not apply to the functional mode" << std::endl;
+        return false;
+    }
+
+    if (options.fast_forward_instruction_count > 0 && options.execution_mode == ExecutionMode::Functional) {
+        std::cerr << "--fast-forward hands over to a pipeline, it does not apply to the functional mode" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    SimulatorOptions options;
+
+    if (!parseArguments(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--execution-mode=threaded|cycle-driven|event-driven|coroutine|functional]"
+                  << " [--log-format=text|binary|none] [--register-file-trace=full|delta]"
+                  << " [--data-memory-size=<bytes>] [--data-memory-model=flat|paged]"
+                  << " [--instruction-memory-file=<path>] [--data-memory-file=<path>] [--elf=<path>]"
+                  << " [--halt-symbol=<name>] [--halt-instruction=<encoding>] [--thread-placement=none|stage]"
+                  << " [--fast-forward=<instructions>] [--concurrent]" << std::endl;
+        return 1;
+    }
+
+    ExecutionMode execution_mode = options.execution_mode;
+
+    Logger::setLogFormat(options.log_format);
+    ThreadPlacement::setPolicy(options.thread_placement_policy);  // Before the first Logger starts its writers
+
+    if (options.is_concurrent) {
+        runConcurrentPipelines(options);
+        return 0;
+    }
+
+    auto *context = new SimulationContext("");
+
+    Pipeline pipeline = initializePipeline(context);
+    pipeline.execution_engine->setExecutionMode(execution_mode);
+    pipeline.register_file->setTraceMode(options.register_file_trace_mode);
+    printStagesState(pipeline);
+    clearOutputFiles(pipeline);
+    loadProgram(pipeline, options);
+
+    if (execution_mode == ExecutionMode::Functional) {
+        runFunctionalSimulation(context);
+        printDataMemoryStatistics(pipeline);
+        printThreadPlacement();
+        killPipeline(pipeline);
+        return 0;
+    }
+
+    fastForwardPipeline(context, options);
+    startPipeline(pipeline);
+    runUntilPaused(pipeline);
+
+    resetPipeline(pipeline);
+    changePipelineType(pipeline, PipelineType::Five);
+    resetPipeline(pipeline);
+    clearOutputFiles(pipeline);
+    resumePipeline(pipeline);
+
+    runUntilPaused(pipeline);
+
+    printDecodedInstructionCacheStatistics(pipeline);
+    printAllocationStatistics();
+    printDataMemoryStatistics(pipeline);
+    printWorkerPoolStatistics(pipeline);
+    printThreadPlacement();
+
+    if (execution_mode == ExecutionMode::EventDriven) {
+        printEvaluationStatistics(pipeline);
+    }
+
     killPipeline(pipeline);
 }
\ No newline at end of file
@@ -1,42 +1,25 @@
 #include "../../include/state/DataMemory.h"
 
-DataMemory *DataMemory::current_instance = nullptr;
-std::mutex DataMemory::initialization_mutex;
+DataMemory::DataMemory(SimulationContext *context)
+        : Module(context), address(0UL), mem_write_signal(false), mem_read_signal(false) {
+    this->read_data = std::bitset<WORD_BIT_COUNT>();
 
-DataMemory::DataMemory() {
-    this->address = 0UL;
-    this->write_data = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->read_data = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
+    this->readiness.track(INPUT_BITS | INPUT_FILE_READ, 0U, RESET_FLAG_SET);
 
-    this->is_mem_write_asserted = false;
-    this->is_mem_read_asserted = false;
-
-    this->is_address_set = false;
-    this->is_write_data_set = false;
-    this->is_mem_write_flag_set = false;
-    this->is_mem_read_flag_set = false;
-    this->is_input_file_read = false;
-    this->is_reset_flag_set = false;
+    this->data_memory_size = DEFAULT_DATA_MEMORY_SIZE;
+    this->data_memory_model = DataMemoryModel::Flat;
+    this->is_data_memory_kept = false;
+    this->out_of_bounds_access_count = 0UL;
 
     this->mem_wb_stage_registers = nullptr;
     this->logger = nullptr;
     this->stage_synchronizer = nullptr;
 
-    this->output_file_path = "../output/DataMemory";
+    this->output_file_path = context->getOutputDirectoryPath() + "DataMemory";
     std::ofstream output_file (this->output_file_path + "-SS.log", std::ios::out);
     output_file.close();
 }
 
-DataMemory *DataMemory::init() {
-    std::lock_guard<std::mutex> data_memory_lock (DataMemory::initialization_mutex);
-
-    if (DataMemory::current_instance == nullptr) {
-        DataMemory::current_instance = new DataMemory();
-    }
-
-    return DataMemory::current_instance;
-}
-
 void DataMemory::initDependencies() {
     std::unique_lock<std::mutex> data_memory_lock (this->getModuleDependencyMutex());
 
@@ -44,68 +27,44 @@ void DataMemory::initDependencies() {
         return;
     }
 
-    this->mem_wb_stage_registers = MEMWBStageRegisters::init();
-    this->logger = Logger::init();
-    this->stage_synchronizer = StageSynchronizer::init();
-}
-
-void DataMemory::run() {
-    this->initDependencies();
+    this->mem_wb_stage_registers = this->context->get<MEMWBStageRegisters>();
+    this->logger = this->context->get<Logger>();
+    this->stage_synchronizer = this->context->get<StageSynchronizer>();
 
-    this->log("Waiting for data memory file to be set and acquire lock.");
-    {
-        std::unique_lock<std::mutex> data_memory_lock (this->getModuleMutex());
-        this->getModuleConditionVariable().wait(
-                data_memory_lock,
-                [this] { return !this->data_memory_file_path.empty(); }
-        );
-    }
+    this->stage_synchronizer->registerParticipant(false);
+}
 
-    while (this->isAlive()) {
-        this->log("Waiting to be woken up and acquire lock.");
-
-        std::unique_lock<std::mutex> data_memory_lock (this->getModuleMutex());
-        this->getModuleConditionVariable().wait(
-                data_memory_lock,
-                [this] {
-                    return (this->is_address_set && this->is_write_data_set &&
-                            this->is_mem_write_flag_set && this->is_mem_read_flag_set && this->is_input_file_read) ||
-                            this->is_reset_flag_set || this->isKilled();
-                }
-        );
+bool DataMemory::isReadyToExecute() {
+    return this->readiness.isReady();
+}
 
-        if (this->is_reset_flag_set) {
-            this->log("Resetting stage.");
+void DataMemory::execute() {
+    if (this->readiness.isSet(RESET_FLAG_SET)) {
+        this->log<LogLevel::Info>("Resetting stage.");
 
-            this->resetState();
-            this->is_reset_flag_set = false;
+        this->resetState();
+        this->readiness.clear(RESET_FLAG_SET);
 
-            this->stage_synchronizer->arriveReset();
+        this->stage_synchronizer->arriveReset();
 
-            this->log("Reset.");
-            continue;
-        }
+        this->log<LogLevel::Info>("Reset.");
+        return;
+    }
 
-        if (this->isKilled()) {
-            this->log("Killed.");
-            break;
-        }
+    this->log("Woken up and acquired lock.");
 
-        this->log("Woken up and acquired lock.");
+    this->writeData();
+    this->readData();
 
-        this->writeData();
-        this->readData();
+    std::bitset<WORD_BIT_COUNT> current_read_data = this->read_data;
 
-        std::thread pass_read_data_thread (&DataMemory::passReadData, this, this->read_data);
-        pass_read_data_thread.detach();
+    this->address.markEvaluated();
+    this->write_data.markEvaluated();
+    this->mem_write_signal.markEvaluated();
+    this->mem_read_signal.markEvaluated();
+    this->readiness.clear(INPUT_BITS);
 
-        this->is_mem_write_asserted = false;
-        this->is_mem_read_asserted = false;
-        this->is_address_set = false;
-        this->is_write_data_set = false;
-        this->is_mem_write_flag_set = false;
-        this->is_mem_read_flag_set =  false;
-    }
+    this->dispatch(&DataMemory::passReadData, this, current_read_data);
 }
 
 void DataMemory::setDataMemoryInputFilePath(const std::string &file_path) {
@@ -119,85 +78,126 @@ void DataMemory::setDataMemoryInputFilePath(const std::string &file_path) {
     this->readDataMemoryFile();
 
     this->log("setDataMemoryInputFilePath updated value.");
-    this->notifyModuleConditionVariable();
 }
 
-void DataMemory::setAddress(unsigned long value) {
-    this->log("setAddress waiting to acquire lock.");
+void DataMemory::setDataMemorySize(unsigned long size) {
+    std::lock_guard<std::mutex> data_memory_lock (this->getModuleMutex());
 
-    std::lock_guard<std::mutex> data_memory_guard (this->getModuleMutex());
+    this->data_memory_size = size;
 
-    this->log("setAddress acquired lock. Updating value.");
+    if (this->readiness.isSet(INPUT_FILE_READ)) {
+        this->readDataMemoryFile();
+    }
+}
 
-    this->address = value;
-    this->is_address_set = true;
+void DataMemory::setDataMemoryModel(DataMemoryModel model) {
+    std::lock_guard<std::mutex> data_memory_lock (this->getModuleMutex());
 
-    this->log("setAddress updated value.");
-    this->notifyModuleConditionVariable();
-}
+    this->data_memory_model = model;
 
-void DataMemory::setWriteData(std::bitset<WORD_BIT_COUNT> value) {
-    this->log("setWriteData waiting to acquire lock.");
+    if (this->readiness.isSet(INPUT_FILE_READ)) {
+        this->readDataMemoryFile();
+    }
+}
 
-    std::lock_guard<std::mutex> data_memory_guard (this->getModuleMutex());
+void DataMemory::setAddress(unsigned long value) {
+    this->address.set(value);
 
-    this->log("setWriteData acquired lock. Updating value.");
+    this->log("setAddress updated value.");
+    this->setReadiness(ADDRESS_SET);
+}
 
-    this->write_data = value;
-    this->is_write_data_set = true;
+void DataMemory::setWriteData(std::bitset<WORD_BIT_COUNT> value) {
+    this->write_data.set(value);
 
     this->log("setWriteData updated value.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(WRITE_DATA_SET);
 }
 
 void DataMemory::setMemWrite(bool is_asserted) {
-    this->log("setMemWrite waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> data_memory_guard (this->getModuleMutex());
-
-    this->log("setMemWrite acquired lock. Updating value.");
-
-    this->is_mem_write_asserted = is_asserted;
-    this->is_mem_write_flag_set = true;
+    this->mem_write_signal.set(is_asserted);
 
     this->log("setMemWrite updated value.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(MEM_WRITE_SIGNAL_SET);
 }
 
 void DataMemory::setMemRead(bool is_asserted) {
-    this->log("setMemRead waiting to acquire lock.");
+    this->mem_read_signal.set(is_asserted);
 
-    std::lock_guard<std::mutex> data_memory_guard (this->getModuleMutex());
+    this->log("setMemRead updated value.");
+    this->setReadiness(MEM_READ_SIGNAL_SET);
+}
 
-    this->log("setMemRead acquired lock. Updating value.");
+void DataMemory::readDataMemoryFile() {
+    this->data_memory_image = std::make_unique<ProgramImage>(this->data_memory_file_path);
 
-    this->is_mem_read_asserted = is_asserted;
-    this->is_mem_read_flag_set = true;
+    // A new file or model replaces the contents a fast-forward handed over
+    this->kept_data_memory.clear();
+    this->kept_paged_data_memory.clear();
+    this->is_data_memory_kept = false;
 
-    this->log("setMemRead updated value.");
-    this->notifyModuleConditionVariable();
+    this->restoreInitialDataMemory();
+    this->setReadiness(INPUT_FILE_READ);
+
+    this->log<LogLevel::Info>("Data memory file read.");
 }
 
-void DataMemory::readDataMemoryFile() {
-    std::ifstream data_memory_file (this->data_memory_file_path);
-    std::string byte_instruction;
+void DataMemory::restoreInitialDataMemory() {
+    if (this->is_data_memory_kept) {
+        this->data_memory = this->kept_data_memory;
+        this->paged_data_memory.copyFrom(this->kept_paged_data_memory);
+    } else {
+        this->loadDataMemoryImage();
+    }
+
+    this->out_of_bounds_access_count = 0UL;
+}
 
-    this->data_memory.clear();
+/**
+ * Copies the image segments straight out of the mapping into the selected model, the only copy the memory makes. Only
+ * the selected model holds contents, the other one is released.
+ */
+void DataMemory::loadDataMemoryImage() {
+    this->paged_data_memory.clear();
 
-    while (std::getline(data_memory_file, byte_instruction)) {
-        this->data_memory.push_back(byte_instruction);
+    if (!this->data_memory_image) {  // Reset before any file was read
+        this->data_memory.clear();
+        return;
     }
 
-    int data_memory_size = static_cast<int>(this->data_memory.size());
+    std::vector<ProgramImageSegment> segments = this->data_memory_image->getDataSegments();
+
+    if (this->data_memory_model == DataMemoryModel::Paged) {
+        this->data_memory.clear();
+
+        for (const ProgramImageSegment &segment: segments) {
+            this->paged_data_memory.storeBytes(segment.address, segment.bytes);
+        }
 
-    for (int i = 0; i < 1000 - data_memory_size; ++i) {
-        this->data_memory.emplace_back(8, '0');
+        return;
+    }
+
+    unsigned long data_memory_end_address = this->data_memory_size;
+
+    for (const ProgramImageSegment &segment: segments) {
+        data_memory_end_address = std::max<unsigned long>(
+                data_memory_end_address,
+                segment.address + segment.bytes.size()
+        );
     }
 
-    this->is_input_file_read = true;
-    data_memory_file.close();
+    // assign() reuses the storage left from the previous run
+    this->data_memory.assign(data_memory_end_address, 0);
+
+    for (const ProgramImageSegment &segment: segments) {
+        std::copy(segment.bytes.begin(), segment.bytes.end(), this->data_memory.begin() + segment.address);
+    }
+}
 
-    this->log("Data memory file read.");
+void DataMemory::keepDataMemoryContentsAcrossResets() {
+    this->kept_data_memory = this->data_memory;
+    this->kept_paged_data_memory.copyFrom(this->paged_data_memory);
+    this->is_data_memory_kept = true;
 }
 
 void DataMemory::passReadData(std::bitset<WORD_BIT_COUNT> data) {
@@ -207,56 +207,118 @@ void DataMemory::passReadData(std::bitset<WORD_BIT_COUNT> data) {
 }
 
 void DataMemory::readData() {
-    this->read_data = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
+    this->read_data = std::bitset<WORD_BIT_COUNT>();
+
+    if (this->mem_read_signal.get()) {
+        this->read_data = this->loadWord(this->address.get());
+        this->log("Data memory read.");
+    }
+}
+
+void DataMemory::writeData() {
+    if (this->write_data.isSet() && this->mem_write_signal.get()) {
+        this->storeWord(this->address.get(), this->write_data.get());
+        this->log("Data memory written.");
+    }
+}
+
+std::bitset<WORD_BIT_COUNT> DataMemory::loadWord(unsigned long word_address) {
+    uint32_t word = 0;
+
+    if (this->data_memory_model == DataMemoryModel::Paged) {
+        if (word_address <= PagedMemory::ADDRESS_SPACE_SIZE - WORD_BYTE_COUNT) {
+            word = this->paged_data_memory.loadWord(word_address);
+        } else {
+            this->recordOutOfBoundsAccess();
+        }
+    } else if (this->data_memory.size() >= WORD_BYTE_COUNT && word_address <= this->data_memory.size() - WORD_BYTE_COUNT) {
+        const uint8_t *bytes = this->data_memory.data() + word_address;
 
-    if (this->is_mem_read_asserted) {
-        std::string word;
+        word = (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+                (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+    } else {  // Bytes past the end of memory read as zero
+        for (int i = 0; i < WORD_BYTE_COUNT; ++i) {
+            uint32_t byte = 0;
 
-        for (unsigned long i = this->address; i < this->address + 4; ++i) {
-            if (this->data_memory.size() > i) {
-                word += this->data_memory.at(i);
-            } else {
-                std::cerr << "[DataMemory] Read address out of bounds." << std::endl;
+            if (word_address + i < this->data_memory.size()) {
+                byte = this->data_memory[word_address + i];
             }
+
+            word |= byte << (BYTE_BIT_COUNT * (WORD_BYTE_COUNT - 1 - i));
         }
 
-        this->read_data = std::bitset<WORD_BIT_COUNT>(word);
-        this->log("Data memory read.");
+        this->recordOutOfBoundsAccess();
     }
+
+    return {word};
 }
 
-void DataMemory::writeData() {
-    if (this->is_write_data_set && this->is_mem_write_asserted) {
-        std::string word = std::bitset<WORD_BIT_COUNT>(this->write_data).to_string();
+void DataMemory::storeWord(unsigned long word_address, std::bitset<WORD_BIT_COUNT> word) {
+    auto word_value = static_cast<uint32_t>(word.to_ulong());
 
-        for (int i = 0; i < 4; ++i) {
-            this->data_memory.at(this->address + i) = word.substr(i * 8, 8);
+    if (this->data_memory_model == DataMemoryModel::Paged) {
+        if (word_address <= PagedMemory::ADDRESS_SPACE_SIZE - WORD_BYTE_COUNT) {
+            this->paged_data_memory.storeWord(word_address, word_value);
+        } else {
+            this->recordOutOfBoundsAccess();
+        }
+    } else if (this->data_memory.size() >= WORD_BYTE_COUNT && word_address <= this->data_memory.size() - WORD_BYTE_COUNT) {
+        uint8_t *bytes = this->data_memory.data() + word_address;
+
+        bytes[0] = word_value >> 24;
+        bytes[1] = word_value >> 16;
+        bytes[2] = word_value >> 8;
+        bytes[3] = word_value;
+    } else {  // Bytes past the end of memory are dropped
+        for (int i = 0; i < WORD_BYTE_COUNT; ++i) {
+            if (word_address + i < this->data_memory.size()) {
+                this->data_memory[word_address + i] = word_value >> (BYTE_BIT_COUNT * (WORD_BYTE_COUNT - 1 - i));
+            }
         }
 
-        this->log("Data memory written.");
+        this->recordOutOfBoundsAccess();
     }
 }
 
-void DataMemory::reset() {
+void DataMemory::recordOutOfBoundsAccess() {
+    if (this->out_of_bounds_access_count++ == 0) {
+        this->log<LogLevel::Error>("Access past the end of data memory, reported once per run.");
+    }
+}
+
+unsigned long DataMemory::getOutOfBoundsAccessCount() {
+    std::lock_guard<std::mutex> data_memory_lock (this->getModuleMutex());
+
+    return this->out_of_bounds_access_count;
+}
+
+DataMemoryModel DataMemory::getDataMemoryModel() {
     std::lock_guard<std::mutex> data_memory_lock (this->getModuleMutex());
-    this->is_reset_flag_set = true;
-    this->notifyModuleConditionVariable();
+
+    return this->data_memory_model;
+}
+
+unsigned long DataMemory::getResidentPageCount() {
+    std::lock_guard<std::mutex> data_memory_lock (this->getModuleMutex());
+
+    return this->paged_data_memory.getResidentPageCount();
+}
+
+void DataMemory::reset() {
+    this->setReadiness(RESET_FLAG_SET);
 }
 
 void DataMemory::resetState() {
-    this->readDataMemoryFile();
+    this->restoreInitialDataMemory();
 
-    this->address = 0UL;
-    this->write_data = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->read_data = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-
-    this->is_address_set = false;
-    this->is_write_data_set = false;
-    this->is_mem_write_flag_set = false;
-    this->is_mem_read_flag_set = false;
-    this->is_mem_write_asserted = false;
-    this->is_mem_read_asserted = false;
-    this->is_input_file_read = true;
+    this->address.reset(0UL);
+    this->write_data.reset();
+    this->read_data = std::bitset<WORD_BIT_COUNT>();
+
+    this->mem_write_signal.reset(false);
+    this->mem_read_signal.reset(false);
+    this->readiness.clear(INPUT_BITS);
+    this->readiness.set(INPUT_FILE_READ);
 }
 
 void DataMemory::writeDataMemoryContentsToOutput() {
@@ -265,13 +327,49 @@ void DataMemory::writeDataMemoryContentsToOutput() {
             std::ios::app
     );
 
-    for (const std::string &data: this->data_memory) {
-        output_file << data << std::endl;
+    if (this->data_memory_model == DataMemoryModel::Paged) {
+        this->writePagedDataMemoryContents(output_file);
+    } else {
+        this->writeFlatDataMemoryContents(output_file);
     }
 
     output_file.close();
 }
 
+void DataMemory::writeFlatDataMemoryContents(std::ofstream &output_file) {
+    char line[BYTE_BIT_COUNT + 1];
+    line[BYTE_BIT_COUNT] = '\n';
+
+    for (uint8_t byte: this->data_memory) {
+        for (int i = 0; i < BYTE_BIT_COUNT; ++i) {
+            line[i] = (byte >> (BYTE_BIT_COUNT - 1 - i)) & 1U ? '1' : '0';
+        }
+
+        output_file.write(line, sizeof(line));
+    }
+}
+
+void DataMemory::writePagedDataMemoryContents(std::ofstream &output_file) {
+    char line[BYTE_BIT_COUNT + 1];
+    line[BYTE_BIT_COUNT] = '\n';
+
+    // Only pages the program stored to are written, each preceded by its base address so the sparse dump can be mapped
+    // back onto the address space. Pages a fast-forward stored to stay dirty across the reset that follows it.
+    for (unsigned long page_address: this->paged_data_memory.getDirtyPageAddresses()) {
+        const PagedMemory::Page *page = this->paged_data_memory.findPage(page_address);
+
+        output_file << "Page 0x" << std::hex << page_address << std::dec << '\n';
+
+        for (uint8_t byte: page->bytes) {
+            for (int i = 0; i < BYTE_BIT_COUNT; ++i) {
+                line[i] = (byte >> (BYTE_BIT_COUNT - 1 - i)) & 1U ? '1' : '0';
+            }
+
+            output_file.write(line, sizeof(line));
+        }
+    }
+}
+
 std::string DataMemory::getModuleTag() {
     return "DataMemory";
 }
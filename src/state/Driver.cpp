@@ -1,16 +1,16 @@
 #include "../../include/state/Driver.h"
 
-Driver *Driver::current_instance = nullptr;
-std::mutex Driver::initialization_mutex;
+#include <sstream>
 
-Driver::Driver() {
-    this->program_counter = 0UL;
+#include "../../include/combinational/mux/IFMux.h"
+
+Driver::Driver(SimulationContext *context) : Module(context), program_counter(0UL) {
+    this->entry_program_counter = 0UL;
+    this->program_counter.discard();  // The entry point is fetched without a signal from the IFMux
+
+    this->readiness.track(PROGRAM_COUNTER_SET | NOP_FLAG_SET, PAUSE_FLAG_SET, RESET_FLAG_SET);
+    this->readiness.set(PROGRAM_COUNTER_SET | NOP_FLAG_SET);
 
-    this->is_new_program_counter_set = true;
-    this->is_nop_asserted = false;
-    this->is_reset_flag_set = false;
-    this->is_pause_flag_set = false;
-    this->is_nop_flag_set = true;
     this->is_verbose_execution_flag_asserted = false;
 
     this->current_nop_set_operations = 0;
@@ -26,7 +26,7 @@ void Driver::changeStageAndReset(PipelineType new_stage) {
     {  // Limit lock guard scope to avoid deadlock
         std::lock_guard<std::mutex> driver_lock_guard (this->getModuleMutex());
 
-        this->log("PipelineType change." );
+        this->log<LogLevel::Info>("PipelineType change." );
         this->setPipelineType(new_stage);
     }
 
@@ -34,67 +34,61 @@ void Driver::changeStageAndReset(PipelineType new_stage) {
 }
 
 void Driver::reset() {
-    std::lock_guard<std::mutex> driver_lock_guard (this->getModuleMutex());
-
-    this->is_reset_flag_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(RESET_FLAG_SET);
 }
 
 void Driver::resetStage() {
-    this->program_counter = 0UL;
+    this->program_counter.reset(this->entry_program_counter);
+    this->program_counter.discard();
 
-    this->is_new_program_counter_set = true;
-    this->is_nop_asserted = false;
-    this->is_nop_flag_set = true;
+    this->current_nop_set_operations = 0;
+    this->readiness.clear(NOP_ASSERTED);
+    this->readiness.set(PROGRAM_COUNTER_SET | NOP_FLAG_SET);
 }
 
 void Driver::pause() {
-    this->log("Paused.");
+    this->log<LogLevel::Info>("Paused.");
 
-    this->is_pause_flag_set = true;
+    this->readiness.set(PAUSE_FLAG_SET);
 }
 
 void Driver::resume() {
-    std::lock_guard<std::mutex> driver_lock (this->getModuleMutex());
+    this->log<LogLevel::Info>("Resumed.");
 
-    this->log("Resumed.");
-
-    this->is_pause_flag_set = false;
-    this->notifyModuleConditionVariable();
+    this->clearReadiness(PAUSE_FLAG_SET);
 }
 
 void Driver::setProgramCounter(unsigned long value) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+    if (this->stage_synchronizer->deferUntilClockEdge([this, value] { this->setProgramCounter(value); })) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setProgramCounter waiting to acquire lock.");
-
-    std::unique_lock<std::mutex> driver_lock (this->getModuleMutex());
+    this->log("setProgramCounter updating value.");
 
-    this->log("setProgramCounter acquired lock. Updating value.");
-
-    if (!this->is_nop_asserted || this->program_counter > value) {
-        this->program_counter = value;
+    if (!this->readiness.isSet(NOP_ASSERTED) || this->program_counter.get() > value) {
+        this->program_counter.set(value);
         this->log("setProgramCounter updated value.");
     } else {
+        this->program_counter.discard();
         this->log("setProgramCounter update skipped. NOP asserted.");
     }
 
-    this->is_new_program_counter_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(PROGRAM_COUNTER_SET);
 }
 
-Driver *Driver::init() {
-    std::lock_guard<std::mutex> driver_lock (Driver::initialization_mutex);
+void Driver::setEntryProgramCounter(unsigned long value) {
+    std::lock_guard<std::mutex> driver_lock (this->getModuleMutex());
 
-    if (Driver::current_instance == nullptr) {
-        Driver::current_instance = new Driver();
-    }
+    this->entry_program_counter = value;
 
-    return Driver::current_instance;
+    // Only called before the first cycle, resets start from it again
+    this->program_counter.reset(value);
+    this->program_counter.discard();
+    this->readiness.set(PROGRAM_COUNTER_SET);
 }
 
 void Driver::initDependencies() {
@@ -105,88 +99,70 @@ void Driver::initDependencies() {
         return;
     }
 
-    this->instruction_memory = InstructionMemory::init();
-    this->if_id_stage_registers = IFIDStageRegisters::init();
-    this->if_adder = IFAdder::init();
-    this->logger = Logger::init();
-    this->stage_synchronizer = StageSynchronizer::init();
-}
-
-void Driver::run() {
-    this->initDependencies();
+    this->instruction_memory = this->context->get<InstructionMemory>();
+    this->if_id_stage_registers = this->context->get<IFIDStageRegisters>();
+    this->if_adder = this->context->get<IFAdder>();
+    this->logger = this->context->get<Logger>();
+    this->stage_synchronizer = this->context->get<StageSynchronizer>();
 
-    while (this->isAlive()) {
-        this->log("Waiting to be woken up and acquire lock.");
+    this->connectInput(this->program_counter, this->context->get<IFMux>());
 
-        std::unique_lock<std::mutex> driver_lock (this->getModuleMutex());
-        this->getModuleConditionVariable().wait(
-                driver_lock,
-                [this] {
-                    return (this->is_new_program_counter_set && this->is_nop_flag_set &&
-                        !this->is_pause_flag_set) || this->is_reset_flag_set || this->isKilled();
-                }
-        );
-
-        if (this->isKilled()) {
-            this->log("Killed.");
-            break;
-        }
-
-        if (this->is_reset_flag_set) {
-            this->log("Resetting stage.");
+    this->stage_synchronizer->registerParticipant(true);
+    this->stage_synchronizer->connectFiveStageInput(this->context->get<IFMux>());  // setProgramCounter
+    this->stage_synchronizer->connectFiveStageInput(this->context->get<HazardDetectionUnit>());  // setNop
+    this->stage_synchronizer->connectFiveStageInput(this->instruction_memory);  // setNop
+}
 
-            this->resetStage();
-            this->is_reset_flag_set = false;
+bool Driver::isReadyToExecute() {
+    return this->readiness.isReady();
+}
 
-            this->stage_synchronizer->arriveReset();
+void Driver::execute() {
+    if (this->readiness.isSet(RESET_FLAG_SET)) {
+        this->log<LogLevel::Info>("Resetting stage.");
 
-            this->log("Reset.");
-            continue;
-        }
+        this->resetStage();
+        this->readiness.clear(RESET_FLAG_SET);
 
-        this->log("Woken up and acquired lock.");
+        this->stage_synchronizer->arriveReset();
 
-        if (this->is_verbose_execution_flag_asserted) {
-            this->printState();
-        }
+        this->log<LogLevel::Info>("Reset.");
+        return;
+    }
 
-        std::thread pass_program_counter_to_if_adder(
-                &Driver::passProgramCounterToIFAdder,
-                this,
-                this->program_counter
-         );
+    this->log("Woken up and acquired lock.");
 
-        std::thread pass_program_counter_to_instruction_memory(
-                &Driver::passProgramCounterToInstructionMemory,
-                this,
-                this->program_counter
-        );
+    if (this->is_verbose_execution_flag_asserted) {
+        this->printState();
+    }
 
-        std::thread pass_program_counter_thread (
-                &Driver::passProgramCounterToIFIDStageRegisters,
-                this,
-                this->program_counter
-        );
+    // The instruction memory sets the NOP of the next cycle once it has the program counter
+    unsigned long pc = this->program_counter.get();
+    bool is_nop_asserted = this->readiness.isSet(NOP_ASSERTED);
 
-        std::thread pass_nop_thread (
-                &Driver::passNopToIFIDStageRegisters,
-                this,
-                this->is_nop_asserted
-        );
+    this->markInputsEvaluated();
+    this->readiness.clear(PROGRAM_COUNTER_SET | NOP_FLAG_SET | NOP_ASSERTED);
+    this->current_nop_set_operations = 0;
 
-        pass_program_counter_to_if_adder.detach();
-        pass_program_counter_to_instruction_memory.detach();
-        pass_program_counter_thread.detach();
-        pass_nop_thread.detach();
+    this->dispatch(&Driver::passProgramCounterToIFAdder, this, pc);
+    this->dispatch(&Driver::passProgramCounterToInstructionMemory, this, pc);
+    this->dispatch(&Driver::passProgramCounterToIFIDStageRegisters, this, pc);
+    this->dispatch(&Driver::passNopToIFIDStageRegisters, this, is_nop_asserted);
 
-        this->is_new_program_counter_set = false;
-        this->is_nop_asserted = false;
-        this->is_nop_flag_set = false;
+    this->stage_synchronizer->conditionalArriveSingleStage();
+}
 
-        this->current_nop_set_operations = 0;
+void Driver::markInputsEvaluated() {
+    this->program_counter.markEvaluated();
+}
 
-        this->stage_synchronizer->conditionalArriveSingleStage();
+void Driver::holdInput(SignalBase &input) {
+    if (this->stage_synchronizer->deferUntilClockEdge([this, &input] { this->holdInput(input); })) {
+        return;
     }
+
+    input.hold();
+    this->setReadiness(PROGRAM_COUNTER_SET);  // The program counter is the only input connected to a module
 }
 
 void Driver::passProgramCounterToInstructionMemory(unsigned long pc) {
@@ -197,7 +173,7 @@ void Driver::passProgramCounterToInstructionMemory(unsigned long pc) {
 
 void Driver::passProgramCounterToIFAdder(unsigned long pc) {
     this->log("Passing program counter to IFAdder.");
-    this->if_adder->setInput(IFAdderInputType::PCValue, pc);
+    this->if_adder->setInput<IFAdderInputType::PCValue>(pc);
     this->log("Passed program counter to IFAdder.");
 }
 
@@ -208,19 +184,20 @@ void Driver::passProgramCounterToIFIDStageRegisters(unsigned long pc) {
 }
 
 void Driver::setNop(bool is_asserted) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
-
-    this->log("setPassedNop waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> driver_lock (this->getModuleMutex());
+    if (this->stage_synchronizer->deferNopUntilClockEdge([this, is_asserted] { this->setNop(is_asserted); })) {
+        return;
+    }
 
-    this->log("setPassedNop acquired lock.");
+    this->log("setNop updating value.");
 
-    this->is_nop_asserted |= is_asserted;
+    if (is_asserted) {
+        this->readiness.set(NOP_ASSERTED);
+    }
 
-    if (++this->current_nop_set_operations == REQUIRED_NOP_FLAG_SET_OPERATIONS) {
-        this->is_nop_flag_set = true;
-        this->getModuleConditionVariable().notify_all();
+    if (this->current_nop_set_operations.fetch_add(1, std::memory_order_acq_rel) + 1 ==
+        REQUIRED_NOP_FLAG_SET_OPERATIONS) {
+        this->setReadiness(NOP_FLAG_SET);
+        this->readiness.notify();  // setProgramCounter waits for the flag in the five stage pipeline
     }
 }
 
@@ -231,17 +208,11 @@ void Driver::passNopToIFIDStageRegisters(bool is_asserted) {
 }
 
 void Driver::delayUpdateUntilNopFlagSet() {
-    std::unique_lock<std::mutex> driver_lock (this->getModuleMutex());
-    this->getModuleConditionVariable().wait(
-            driver_lock,
-            [this] {
-                return this->is_nop_flag_set;
-            }
-    );
+    this->readiness.waitUntilSet(NOP_FLAG_SET);
 }
 
 void Driver::assertSystemEnabledNop() {
-    this->is_nop_asserted = true;
+    this->readiness.set(NOP_ASSERTED);
 }
 
 std::string Driver::getModuleTag() {
@@ -252,17 +223,21 @@ Stage Driver::getModuleStage() {
     return Stage::IF;
 }
 
-void Driver::printState() const {
-    std::cout << std::string(20, '.') << std::endl;
-    std::cout << "Driver" << std::endl;
-    std::cout << std::string(20, '.') << std::endl;
-
-    std::cout << "program_counter: " << this->program_counter << std::endl;
-    std::cout << "is_new_program_counter_set: " << this->is_new_program_counter_set << std::endl;
-    std::cout << "is_nop_asserted: " << this->is_nop_asserted << std::endl;
-    std::cout << "is_reset_flag_set: " << this->is_reset_flag_set << std::endl;
-    std::cout << "is_pause_flag_set: " << this->is_pause_flag_set << std::endl;
-    std::cout << "is_nop_flag_set: " << this->is_nop_flag_set << std::endl;
+void Driver::printState() {
+    std::ostringstream state;
+
+    state << std::string(20, '.') << '\n';
+    state << "Driver" << '\n';
+    state << std::string(20, '.') << '\n';
+
+    state << "program_counter: " << this->program_counter.get() << '\n';
+    state << "is_new_program_counter_set: " << this->readiness.isSet(PROGRAM_COUNTER_SET) << '\n';
+    state << "is_nop_asserted: " << this->readiness.isSet(NOP_ASSERTED) << '\n';
+    state << "is_reset_flag_set: " << this->readiness.isSet(RESET_FLAG_SET) << '\n';
+    state << "is_pause_flag_set: " << this->readiness.isSet(PAUSE_FLAG_SET) << '\n';
+    state << "is_nop_flag_set: " << this->readiness.isSet(NOP_FLAG_SET) << '\n';
+
+    this->printToConsole(state.str());
 }
 
 void Driver::assertVerboseExecutionFlag() {
@@ -1,30 +1,21 @@
 #include "../../include/state/InstructionMemory.h"
 
-InstructionMemory *InstructionMemory::current_instance = nullptr;
-std::mutex InstructionMemory::initialization_mutex;
-
-InstructionMemory::InstructionMemory() {
+InstructionMemory::InstructionMemory(SimulationContext *context) : Module(context), program_counter(0UL) {
     this->instruction_memory_file_path = "";
-    this->is_instruction_file_read = false;
+    this->readiness.track(PROGRAM_COUNTER_SET | INSTRUCTION_FILE_READ, 0U, 0U);
+
+    this->base_address = 0UL;
+    this->entry_program_counter = 0UL;
 
-    this->program_counter = 0UL;
-    this->is_new_program_counter_set = false;
+    this->decoded_instruction_cache_pipeline_type = this->getPipelineType();
+    this->decoded_instruction_cache_hit_count = 0UL;
+    this->decoded_instruction_cache_miss_count = 0UL;
 
     this->if_id_stage_registers = nullptr;
     this->driver = nullptr;
     this->logger = nullptr;
 }
 
-InstructionMemory *InstructionMemory::init() {
-    std::lock_guard<std::mutex> instruction_memory_lock (InstructionMemory::initialization_mutex);
-
-    if (InstructionMemory::current_instance == nullptr) {
-        InstructionMemory::current_instance = new InstructionMemory();
-    }
-
-    return InstructionMemory::current_instance;
-}
-
 void InstructionMemory::initDependencies() {
     std::lock_guard<std::mutex> instruction_memory_lock (this->getModuleDependencyMutex());
 
@@ -32,51 +23,32 @@ void InstructionMemory::initDependencies() {
         return;
     }
 
-    this->if_id_stage_registers = IFIDStageRegisters::init();
-    this->logger = Logger::init();
-    this->driver = Driver::init();
+    this->if_id_stage_registers = this->context->get<IFIDStageRegisters>();
+    this->logger = this->context->get<Logger>();
+    this->driver = this->context->get<Driver>();
 }
 
-void InstructionMemory::run() {
-    this->initDependencies();
-
-    std::unique_lock<std::mutex> instruction_memory_lock(this->getModuleMutex());
-    this->getModuleConditionVariable().wait(
-            instruction_memory_lock,
-            [this] { return !this->instruction_memory_file_path.empty(); }
-    );
-
-    while (this->isAlive()) {
-        this->log("Waiting to be woken up and acquire lock.");
-
-        this->getModuleConditionVariable().wait(
-                instruction_memory_lock,
-                [this] {
-                    return (this->is_new_program_counter_set && this->is_instruction_file_read) || this->isKilled();
-                }
-        );
-
-        if (this->isKilled()) {
-            this->log("Killed.");
-            break;
-        }
+bool InstructionMemory::isReadyToExecute() {
+    return this->readiness.isReady();
+}
 
-        this->log("Woken up and acquired lock.");
+void InstructionMemory::execute() {
+    this->log("Woken up and acquired lock.");
 
-        this->fetchInstructionFromMemory();
+    this->fetchInstructionFromMemory();
 
-        std::thread pass_nop_thread (
-                &InstructionMemory::passNopToDriver,
-                this,
-                this->getPipelineType() == PipelineType::Five && this->program_counter >= this->data.size()
-        );
-        std::thread pass_instruction_thread (&InstructionMemory::passInstructionIntoIFIDStageRegisters, this);
+    // Program counters below the base address wrap around and are past the end as well
+    bool is_nop_asserted = this->getPipelineType() == PipelineType::Five &&
+            this->program_counter.get() - this->base_address >= this->data.size();
 
-        pass_instruction_thread.join();
-        pass_nop_thread.join();
+    // The program counter of the next cycle may be set once the instruction is passed on
+    this->program_counter.markEvaluated();
+    this->readiness.clear(PROGRAM_COUNTER_SET);
 
-        this->is_new_program_counter_set = false;
-    }
+    this->dispatchAndWait({
+            [this, is_nop_asserted] { this->passNopToDriver(is_nop_asserted); },
+            [this] { this->passInstructionIntoIFIDStageRegisters(); }
+    });
 }
 
 void InstructionMemory::setInstructionMemoryInputFilePath(const std::string &file_path) {
@@ -88,60 +60,223 @@ void InstructionMemory::setInstructionMemoryInputFilePath(const std::string &fil
     this->instruction_memory_file_path = file_path;
     this->readInstructionMemoryFile();
 
-    this->log("setInstructionMemoryInputFilePath has finished.");
-    this->notifyModuleConditionVariable();
+    this->log<LogLevel::Info>("setInstructionMemoryInputFilePath has finished.");
 }
 
 void InstructionMemory::setProgramCounter(unsigned long value) {
-    this->log("setProgramCounter waiting to acquire lock.");
+    this->program_counter.set(value);
 
-    std::lock_guard<std::mutex> instruction_memory_lock(this->getModuleMutex());
+    this->log("setProgramCounter value updated.");
+    this->setReadiness(PROGRAM_COUNTER_SET);
+}
 
-    this->log("setProgramCounter acquired lock. Updating value.");
+void InstructionMemory::setHaltSymbol(const std::string &symbol) {
+    std::lock_guard<std::mutex> instruction_memory_lock (this->getModuleMutex());
 
-    this->program_counter = value;
-    this->is_new_program_counter_set = true;
+    this->halt_symbol = symbol;
 
-    this->log("setProgramCounter value updated.");
-    this->notifyModuleConditionVariable();
+    if (this->readiness.isSet(INSTRUCTION_FILE_READ)) {
+        this->readInstructionMemoryFile();
+    }
+}
+
+void InstructionMemory::setHaltInstruction(uint32_t instruction) {
+    std::lock_guard<std::mutex> instruction_memory_lock (this->getModuleMutex());
+
+    this->halt_instruction = instruction;
+
+    if (this->readiness.isSet(INSTRUCTION_FILE_READ)) {
+        this->readInstructionMemoryFile();
+    }
+}
+
+unsigned long InstructionMemory::getEntryProgramCounter() {
+    std::lock_guard<std::mutex> instruction_memory_lock (this->getModuleMutex());
+
+    return this->entry_program_counter;
+}
+
+unsigned long InstructionMemory::getDecodedInstructionCacheHitCount() {
+    std::lock_guard<std::mutex> instruction_memory_lock (this->getModuleMutex());
+
+    return this->decoded_instruction_cache_hit_count;
+}
+
+unsigned long InstructionMemory::getDecodedInstructionCacheMissCount() {
+    std::lock_guard<std::mutex> instruction_memory_lock (this->getModuleMutex());
+
+    return this->decoded_instruction_cache_miss_count;
 }
 
 void InstructionMemory::fetchInstructionFromMemory() {
     this->log("Fetching instruction from data_memory.");
-    this->instruction.clear();
 
-    for (unsigned long i = this->program_counter; i < this->program_counter + 4; ++i) {
-        try {
-            this->instruction += this->data.at(i);
-        } catch (const std::out_of_range &e) {
-            this->instruction = std::string(32, '0');
-        }
+    if (this->decoded_instruction_cache_pipeline_type != this->getPipelineType()) {
+        this->invalidateDecodedInstructionCache();  // Control templates carry the pipeline type
+    }
+
+    auto element_iterator = this->decoded_instruction_cache.find(this->program_counter.get());
+
+    if (element_iterator != this->decoded_instruction_cache.end()) {
+        ++this->decoded_instruction_cache_hit_count;
+        this->decoded_instruction = element_iterator->second;
+
+        this->log("Instruction fetched from decoded instruction cache.");
+        return;
     }
 
+    ++this->decoded_instruction_cache_miss_count;
+
+    // Past the end of the instruction segments reads as zero
+    unsigned long byte_index = this->program_counter.get() - this->base_address;
+    uint32_t word = byte_index < this->data.size() && this->data.size() - byte_index >= 4 ?
+            this->readWord(byte_index) : 0U;
+
+    const Instruction *current_instruction = this->decoded_instructions.emplace_back(new Instruction(word)).get();
+    const Control *current_control = this->decoded_controls.emplace_back(
+            new Control(current_instruction, this->getPipelineType(), this->context)
+    ).get();
+
+    this->decoded_instruction = {current_instruction, current_control};
+    this->decoded_instruction_cache.emplace(this->program_counter.get(), this->decoded_instruction);
+
     this->log("Instruction fetched from data_memory.");
 }
 
+void InstructionMemory::invalidateDecodedInstructionCache() {
+    this->decoded_instruction_cache.clear();
+    this->decoded_instruction = {};
+    this->decoded_instructions.clear();
+    this->decoded_controls.clear();
+    this->decoded_instruction_cache_pipeline_type = this->getPipelineType();
+}
+
 void InstructionMemory::readInstructionMemoryFile() {
-    this->log("Reading instruction file.");
+    this->log<LogLevel::Info>("Reading instruction file.");
+
+    this->instruction_memory_image = std::make_unique<ProgramImage>(this->instruction_memory_file_path);
+    const ProgramImage &image = *this->instruction_memory_image;
+    std::vector<ProgramImageSegment> segments = image.getInstructionSegments();
+
+    // Segments are laid out in one contiguous block, gaps between them read as zero
+    unsigned long start_address = segments.empty() ? 0UL : ULONG_MAX;
+    unsigned long end_address = 0UL;
+
+    for (const ProgramImageSegment &segment: segments) {
+        start_address = std::min<unsigned long>(start_address, segment.address);
+        end_address = std::max<unsigned long>(end_address, segment.address + segment.bytes.size());
+    }
+
+    this->writable_data.clear();
+
+    if (segments.size() == 1) {  // Fetched straight from the mapping
+        this->data = segments.front().bytes;
+    } else {
+        this->writable_data.assign(end_address - start_address, 0);
+
+        for (const ProgramImageSegment &segment: segments) {
+            std::copy(
+                    segment.bytes.begin(),
+                    segment.bytes.end(),
+                    this->writable_data.begin() + (segment.address - start_address)
+            );
+        }
+
+        this->data = this->writable_data;
+    }
+
+    this->base_address = start_address;
+    this->entry_program_counter = image.getEntryProgramCounter();
+    this->patchHaltInstructions(image);
+    this->rejectUnsupportedInstructions(image);
+
+    this->invalidateDecodedInstructionCache();
+    this->setReadiness(INSTRUCTION_FILE_READ);
+
+    this->log<LogLevel::Info>("Instruction file read.");
+}
+
+void InstructionMemory::patchHaltInstructions(const ProgramImage &image) {
+    if (this->halt_instruction) {
+        for (unsigned long i = 0; i + 4 <= this->data.size(); i += 4) {
+            if (this->readWord(i) == *this->halt_instruction) {
+                this->writeWord(i, HALT_INSTRUCTION);
+            }
+        }
+    }
+
+    if (!this->halt_symbol.empty()) {
+        std::optional<uint32_t> halt_address = image.findSymbol(this->halt_symbol);
+
+        if (!halt_address) {
+            throw std::runtime_error("InstructionMemory::patchHaltInstructions: no symbol " + this->halt_symbol +
+                                     " in " + this->instruction_memory_file_path);
+        }
+
+        unsigned long byte_index = *halt_address - this->base_address;
 
-    std::ifstream instruction_memory_file (this->instruction_memory_file_path);
-    std::string byte_instruction;
+        if (*halt_address < this->base_address || byte_index + 4 > this->data.size()) {
+            throw std::runtime_error("InstructionMemory::patchHaltInstructions: symbol " + this->halt_symbol +
+                                     " is outside of the instruction segments");
+        }
 
-    this->data = std::vector<std::string> {};
+        this->writeWord(byte_index, HALT_INSTRUCTION);
+    }
+}
+
+void InstructionMemory::rejectUnsupportedInstructions(const ProgramImage &image) const {
+    // Text, raw and binary images are hand assembled for the supported subset and may hold data words, only compiled
+    // ELF code is checked. Halt patching runs first so the ebreak or ecall that ends a program is accepted.
+    if (image.getFormat() != ProgramImageFormat::Elf) {
+        return;
+    }
 
-    while (std::getline(instruction_memory_file, byte_instruction)) {
-        this->data.push_back(byte_instruction);
+    for (const auto &[address, size]: image.getCodeRanges()) {
+        for (unsigned long byte_index = address - this->base_address;
+                byte_index + 4 <= address - this->base_address + size; byte_index += 4) {
+            uint32_t word = this->readWord(byte_index);
+
+            if (!Instruction::isSupportedOpcode(word & ((1U << Instruction::OPCODE_BIT_COUNT) - 1U))) {
+                std::ostringstream message;
+                message << "InstructionMemory::rejectUnsupportedInstructions: unsupported instruction 0x" << std::hex
+                        << std::setw(8) << std::setfill('0') << word << " at 0x" << std::setw(8)
+                        << this->base_address + byte_index << " in " << this->instruction_memory_file_path
+                        << ", only R, I (arithmetic and loads), S, B and JAL instructions are simulated";
+                throw std::runtime_error(message.str());
+            }
+        }
     }
+}
+
+uint32_t InstructionMemory::readWord(unsigned long byte_index) const {
+    return (static_cast<uint32_t>(this->data[byte_index]) << 24) |
+            (static_cast<uint32_t>(this->data[byte_index + 1]) << 16) |
+            (static_cast<uint32_t>(this->data[byte_index + 2]) << 8) | static_cast<uint32_t>(this->data[byte_index + 3]);
+}
 
-    this->is_instruction_file_read = true;
+void InstructionMemory::writeWord(unsigned long byte_index, uint32_t word) {
+    this->makeDataWritable();
+
+    this->writable_data[byte_index] = word >> 24;
+    this->writable_data[byte_index + 1] = word >> 16;
+    this->writable_data[byte_index + 2] = word >> 8;
+    this->writable_data[byte_index + 3] = word;
+}
+
+void InstructionMemory::makeDataWritable() {
+    if (this->data.data() == this->writable_data.data() && this->data.size() == this->writable_data.size()) {
+        return;
+    }
 
-    this->log("Instruction file read.");
+    // The mapping is read only, a halt word to patch costs one copy of the segment
+    this->writable_data.assign(this->data.begin(), this->data.end());
+    this->data = this->writable_data;
 }
 
 void InstructionMemory::passInstructionIntoIFIDStageRegisters() {
     this->log("Passing instruction to IFIDStageRegisters.");
 
-    this->if_id_stage_registers->setInput(this->instruction);
+    this->if_id_stage_registers->setInput(this->decoded_instruction);
     this->log("Passed instruction to IFIDStageRegisters.");
 }
 
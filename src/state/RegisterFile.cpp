@@ -1,43 +1,23 @@
 #include "../../include/state/RegisterFile.h"
+#include "../../include/combinational/mux/WBMux.h"
 
-RegisterFile *RegisterFile::current_instance = nullptr;
-std::mutex RegisterFile::initialization_mutex;
+RegisterFile::RegisterFile(SimulationContext *context)
+        : Module(context), register_source1(0UL), register_destination(0UL), reg_write_signal(false) {
+    this->is_awaiting_write_items = false;
+    this->readiness.track(this->getRequiredBits(), PAUSE_FLAG_SET, RESET_FLAG_SET);
 
-RegisterFile::RegisterFile() {
-    this->is_single_read_register_set = false;
-    this->is_double_read_register_set = false;
-    this->is_reset_flag_set = false;
-
-    this->is_write_register_set = false;
-    this->is_write_data_set = false;
-    this->is_reg_write_signal_set = false;
-    this->is_pause_flag_set = false;
-
-    this->is_reg_write_signal_asserted = false;
     this->cycle_count = 0;
 
-    this->register_source1 = 0UL;
-    this->register_source2 = 0UL;
-
-    this->register_destination = 0UL;
+    this->registers = std::vector<std::bitset<WORD_BIT_COUNT>>(REGISTERS_COUNT);
+    this->initial_registers = this->registers;
 
     this->logger = nullptr;
     this->id_ex_stage_registers = nullptr;
     this->stage_synchronizer = nullptr;
 
-    this->output_file_path = "../output/RegisterFile";
-    std::ofstream output_file (this->output_file_path + "-SS.log", std::ios::out);
-    output_file.close();
-}
-
-RegisterFile *RegisterFile::init() {
-    std::lock_guard<std::mutex> register_file_lock (RegisterFile::initialization_mutex);
-
-    if (RegisterFile::current_instance == nullptr) {
-        RegisterFile::current_instance = new RegisterFile();
-    }
-
-    return RegisterFile::current_instance;
+    this->output_file_path = context->getOutputDirectoryPath() + "RegisterFile";
+    this->trace_mode = RegisterFileTraceMode::Full;
+    this->openRegisterFileOutputFile(PipelineType::Single, true);
 }
 
 void RegisterFile::initDependencies() {
@@ -47,256 +27,248 @@ void RegisterFile::initDependencies() {
         return;
     }
 
-    this->logger = Logger::init();
-    this->id_ex_stage_registers = IDEXStageRegisters::init();
-    this->stage_synchronizer = StageSynchronizer::init();
+    this->logger = this->context->get<Logger>();
+    this->id_ex_stage_registers = this->context->get<IDEXStageRegisters>();
+    this->stage_synchronizer = this->context->get<StageSynchronizer>();
+
+    this->connectInput(this->write_data, this->context->get<WBMux>());
+
+    this->stage_synchronizer->registerParticipant(true);
 }
 
 void RegisterFile::pause() {
-    this->log("Paused.");
-    this->is_pause_flag_set = true;
+    this->log<LogLevel::Info>("Paused.");
+    this->readiness.set(PAUSE_FLAG_SET);
 }
 
 void RegisterFile::resume() {
-    this->log("Resumed.");
-    this->is_pause_flag_set = false;
-    this->notifyModuleConditionVariable();
+    this->log<LogLevel::Info>("Resumed.");
+    this->clearReadiness(PAUSE_FLAG_SET);
 }
 
+void RegisterFile::setPipelineType(PipelineType current_type) {
+    Module::setPipelineType(current_type);
 
-void RegisterFile::run() {
-    this->initDependencies();
-    this->resetRegisterFileContents();
+    uint32_t required_bits;
 
-    while (this->isAlive()) {
-        this->log("Waiting to be woken up and acquire lock.");
+    {
+        std::lock_guard<std::mutex> register_file_lock (this->getModuleMutex());
+        required_bits = this->getRequiredBits();
+    }
 
-        std::unique_lock<std::mutex> register_file_lock (this->getModuleMutex());
-        this->getModuleConditionVariable().wait(
-                register_file_lock,
-                [this] {
-                    return ((this->getPipelineType() == PipelineType::Single || (this->is_write_register_set &&
-                            this->is_write_data_set && this->is_reg_write_signal_set)) &&
-                            (this->is_single_read_register_set || this->is_double_read_register_set) &&
-                            !this->is_pause_flag_set) || this->is_reset_flag_set || this->isKilled();
-                }
-        );
+    this->requireReadiness(required_bits);
+}
 
-        if (this->isKilled()) {
-            this->log("Killed.");
-            break;
-        }
+/**
+ * The single stage pipeline reads the registers as soon as the sources are set and writes back in a second execution
+ * later in the cycle, the five stage pipeline waits for both and writes before it reads.
+ */
+uint32_t RegisterFile::getRequiredBits() {
+    if (this->is_awaiting_write_items) {
+        return WRITE_ITEM_BITS;
+    }
 
-        if (this->is_reset_flag_set) {
-            this->log("Resetting stage.");
+    if (this->getPipelineType() == PipelineType::Single) {
+        return REGISTER_SOURCE_SET;
+    }
 
-            this->resetState();
-            this->resetRegisterFileContents();
+    return REGISTER_SOURCE_SET | WRITE_ITEM_BITS;
+}
 
-            this->is_reset_flag_set = false;
+bool RegisterFile::isReadyToExecute() {
+    return this->readiness.isReady();
+}
 
-            this->stage_synchronizer->arriveReset();
+void RegisterFile::execute() {
+    if (this->readiness.isSet(RESET_FLAG_SET)) {
+        this->log<LogLevel::Info>("Resetting stage.");
 
-            this->log("Reset.");
-            continue;
-        }
+        this->resetState();
+        this->resetRegisterFileContents();
 
-        this->log("Woken up and acquired lock.");
+        this->readiness.clear(RESET_FLAG_SET);
 
-        if (this->getPipelineType() == PipelineType::Single) {
-            this->passReadRegisterDataToIDEXStageRegister();
+        this->stage_synchronizer->arriveReset();
 
-            this->log("Waiting for write items.");
+        this->log<LogLevel::Info>("Reset.");
+        return;
+    }
 
-            this->getModuleConditionVariable().wait(
-                    register_file_lock,
-                    [this] {
-                        return this->is_write_register_set && this->is_write_data_set && this->is_reg_write_signal_set;
-                    }
-            );
+    if (this->is_awaiting_write_items) {  // Single stage: second half of the cycle
+        this->log("Write items set.");
 
-            this->log("Write items set.");
+        this->writeDataToRegisterFile();
+        this->is_awaiting_write_items = false;
+        this->requireReadiness(this->getRequiredBits());
 
-            this->writeDataToRegisterFile();
-            this->log("Write items set. Waiting on barrier.");
+        this->log("Write items set. Waiting on barrier.");
 
-            this->stage_synchronizer->conditionalArriveSingleStage();
-        } else {
-            this->writeDataToRegisterFile();
-            this->passReadRegisterDataToIDEXStageRegister();
-        }
+        this->stage_synchronizer->conditionalArriveSingleStage();
+    } else if (this->getPipelineType() == PipelineType::Single) {
+        this->log("Woken up and acquired lock.");
+
+        this->is_awaiting_write_items = true;
+        this->requireReadiness(this->getRequiredBits());
 
-        this->writeRegisterFileContentsToOutputFile();
+        this->passReadRegisterDataToIDEXStageRegister();
 
-        this->is_write_register_set = false;
-        this->is_reg_write_signal_set = false;
-        this->is_single_read_register_set = false;
-        this->is_double_read_register_set = false;
+        this->log("Waiting for write items.");
+        return;
+    } else {
+        this->log("Woken up and acquired lock.");
+
+        this->writeDataToRegisterFile();
+        this->passReadRegisterDataToIDEXStageRegister();
     }
+
+    this->writeRegisterFileContentsToOutputFile();
 }
 
 void RegisterFile::reset() {
-    std::lock_guard<std::mutex> register_file_lock (this->getModuleMutex());
-
-    this->is_reset_flag_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(RESET_FLAG_SET);
 }
 
 void RegisterFile::setReadRegister(unsigned long rs1) {
-    this->log("setReadRegister waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> register_file_lock (this->getModuleMutex());
-
-    this->log("setReadRegister acquired lock. Updating value.");
-
-    this->register_source1 = rs1;
-    this->register_source2 = 0UL;
-
-    this->is_single_read_register_set = true;
+    this->register_source1.set(rs1);
+    this->register_source2.set(std::nullopt);
 
     this->log("setReadRegister updated value.");
-
-    this->notifyModuleConditionVariable();
+    this->setReadiness(REGISTER_SOURCE_SET);
 }
 
 void RegisterFile::setReadRegisters(unsigned long rs1, unsigned long rs2) {
-    this->log("setReadRegister waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> register_file_lock (this->getModuleMutex());
-
-    this->log("setReadRegister acquired lock. Updating values.");
-
-    this->register_source1 = rs1;
-    this->register_source2 = rs2;
-
-    this->is_double_read_register_set = true;
+    this->register_source1.set(rs1);
+    this->register_source2.set(rs2);
 
     this->log("setReadRegister updated values.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(REGISTER_SOURCE_SET);
 }
 
 void RegisterFile::setWriteRegister(unsigned long rd) {
-    this->log("setWriteRegister waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> register_file_lock (this->getModuleMutex());
-
-    this->log("setWriteRegister acquired lock. Updating value.");
-
-    this->register_destination = rd;
-    this->is_write_register_set = true;
+    this->register_destination.set(rd);
 
     this->log("setWriteRegister updated value.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(REGISTER_DESTINATION_SET);
 }
 
 void RegisterFile::setRegWriteSignal(bool is_asserted) {
-    this->log("setRegWriteSignal waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> register_file_lock (this->getModuleMutex());
-
-    this->log("setRegWriteSignal acquired lock. Updating value.");
-
-    this->is_reg_write_signal_asserted = is_asserted;
-    this->is_reg_write_signal_set = true;
+    this->reg_write_signal.set(is_asserted);
 
     this->log("setRegWriteSignal updated value.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(REG_WRITE_SIGNAL_SET);
 }
 
 void RegisterFile::setWriteData(std::bitset<WORD_BIT_COUNT> value) {
-    this->log("setWriteData waiting to acquire lock.");
+    this->write_data.set(value);
 
-    std::lock_guard<std::mutex> register_file_lock (this->getModuleMutex());
-
-    this->log("setWriteData acquired lock. Updating value.");
+    this->log("setWriteData updated value.");
+    this->setReadiness(WRITE_DATA_SET);
+}
 
-    this->write_data = value;
-    this->is_write_data_set = true;
+void RegisterFile::holdInput(SignalBase &input) {
+    if (&input != &this->write_data) {
+        Module::holdInput(input);
+        return;
+    }
 
-    this->log("setWriteData updated value.");
-    this->notifyModuleConditionVariable();
+    input.hold();
+    this->setReadiness(WRITE_DATA_SET);
 }
 
 void RegisterFile::passReadRegisterDataToIDEXStageRegister() {
     this->log("passReadRegisterDataToIDEXStageRegister waiting to pass values to IDEXStageRegisters.");
 
-    if (!this->is_single_read_register_set && !this->is_double_read_register_set) {
+    if (!this->register_source1.isSet()) {
         throw std::runtime_error("[RegisterFile] no register read set for a cycle.");
     }
 
-    if (this->is_single_read_register_set) {
-        this->id_ex_stage_registers->setRegisterData(this->registers.at(this->register_source1));
+    // The sources of the next cycle can be set once the data is passed on
+    unsigned long rs1 = this->register_source1.get();
+    std::optional<unsigned long> rs2 = this->register_source2.get();
+
+    this->register_source1.markEvaluated();
+    this->register_source2.markEvaluated();
+    this->readiness.clear(REGISTER_SOURCE_SET);
+
+    if (!rs2) {
+        this->id_ex_stage_registers->setRegisterData(this->registers.at(rs1));
     } else {
-        this->id_ex_stage_registers->setRegisterData(
-                this->registers.at(this->register_source1),
-                this->registers.at(this->register_source2)
-        );
+        this->id_ex_stage_registers->setRegisterData(this->registers.at(rs1), this->registers.at(*rs2));
     }
 
-    this->is_single_read_register_set = false;
-    this->is_double_read_register_set = false;
-
     this->log("passReadRegisterDataToIDEXStageRegister Passed values to IDEXStageRegisters.");
 }
 
 void RegisterFile::writeDataToRegisterFile() {
     this->log("writeDataToRegisterFile Waiting to acquire lock to write to register file.");
 
-    if (this->is_reg_write_signal_set && this->is_reg_write_signal_asserted && this->register_destination != 0) {
-        this->registers.at(this->register_destination) = this->write_data;
+    if (this->reg_write_signal.isSet() && this->reg_write_signal.get() && this->register_destination.get() != 0) {
+        this->registers.at(this->register_destination.get()) = this->write_data.get();
         this->log("writeDataToRegisterFile Write complete.");
 
     }
 
-    this->is_write_register_set = false;
-    this->is_write_data_set = false;
-    this->is_reg_write_signal_set = false;
+    this->register_destination.markEvaluated();
+    this->write_data.markEvaluated();
+    this->reg_write_signal.markEvaluated();
+    this->readiness.clear(WRITE_ITEM_BITS);
 
     this->log("writeDataToRegisterFile Waking up thread to pass values to IDEXStageRegister.");
 }
 
 void RegisterFile::resetRegisterFileContents() {
-    this->registers.clear();
-
-    std::string empty_word = std::string(32, '0');
+    this->registers = this->initial_registers;
 
-    for (int i = 0; i < REGISTERS_COUNT; ++i) {
-        this->registers.emplace_back(empty_word);
-    }
+    this->log<LogLevel::Info>("Registers cleared.");
+}
 
-    this->log("Registers cleared.");
+void RegisterFile::keepRegisterFileContentsAcrossResets() {
+    this->initial_registers = this->registers;
 }
 
 void RegisterFile::resetState() {
-    this->is_write_register_set = false;
-    this->is_write_data_set = false;
-    this->is_reg_write_signal_set = false;
-    this->is_single_read_register_set = false;
-    this->is_double_read_register_set = false;
-    this->is_reg_write_signal_asserted = false;
+    this->register_source1.reset(0UL);
+    this->register_source2.reset(std::nullopt);
+    this->register_destination.reset(0UL);
+    this->write_data.reset();
+    this->reg_write_signal.reset(false);
+    this->is_awaiting_write_items = false;
+
+    this->readiness.clear(REGISTER_SOURCE_SET | WRITE_ITEM_BITS);
+    this->requireReadiness(this->getRequiredBits());
 
     this->cycle_count = 0;
 
-    std::ofstream output_file (
-            this->output_file_path + "-FS.log",
-            std::ios::out
-    );
-    output_file.close();
+    this->openRegisterFileOutputFile(PipelineType::Five, true);
 }
 
 void RegisterFile::writeRegisterFileContentsToOutputFile() {
-    std::ofstream output_file (
-            this->output_file_path + (this->getPipelineType() == PipelineType::Single ?  "-SS.log" : "-FS.log"),
-            std::ios::app
-    );
+    if (this->getPipelineType() != this->trace_pipeline_type) {
+        this->openRegisterFileOutputFile(this->getPipelineType(), false);
+    }
 
-    output_file << "State of RF after executing cycle:\t" << this->cycle_count++ << std::endl;
+    this->trace_writer.writeCycle(this->cycle_count++, this->registers);
+}
 
-    for (const std::bitset<WORD_BIT_COUNT> &data: this->registers) {
-        output_file << data.to_string() << std::endl;
-    }
+void RegisterFile::flushRegisterFileOutputFile() {
+    std::lock_guard<std::mutex> register_file_lock (this->getModuleMutex());
 
-    output_file.close();
+    this->trace_writer.flush();
+}
+
+void RegisterFile::setTraceMode(RegisterFileTraceMode mode) {
+    std::lock_guard<std::mutex> register_file_lock (this->getModuleMutex());
+
+    this->trace_mode = mode;
+    this->openRegisterFileOutputFile(this->getPipelineType(), true);
+}
+
+void RegisterFile::openRegisterFileOutputFile(PipelineType pipeline_type, bool is_truncated) {
+    std::string file_path = this->output_file_path + (pipeline_type == PipelineType::Single ? "-SS" : "-FS") +
+            (this->trace_mode == RegisterFileTraceMode::Delta ? ".delta" : ".log");
+
+    this->trace_writer.open(file_path, this->trace_mode, is_truncated);
+    this->trace_pipeline_type = pipeline_type;
 }
 
 std::string RegisterFile::getModuleTag() {
@@ -308,9 +280,7 @@ Stage RegisterFile::getModuleStage() {
 }
 
 void RegisterFile::clearRegisterFileOutputFile() {
-    std::ofstream output_file (
-            this->output_file_path + (this->getPipelineType() == PipelineType::Single ?  "-SS.log" : "-FS.log"),
-            std::ios::out
-    );
-    output_file.close();
+    std::lock_guard<std::mutex> register_file_lock (this->getModuleMutex());
+
+    this->openRegisterFileOutputFile(this->getPipelineType(), true);
 }
\ No newline at end of file
@@ -1,35 +1,21 @@
 #include "../../../include/state/stage-registers/EXMEMStageRegisters.h"
 
-EXMEMStageRegisters *EXMEMStageRegisters::current_instance = nullptr;
-std::mutex EXMEMStageRegisters::initialization_mutex;
-
-EXMEMStageRegisters::EXMEMStageRegisters() {
-    this->branch_program_counter = 0UL;
-    this->register_destination = 0UL;
-
-    this->alu_result = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->read_data_2 = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-
-    this->is_alu_result_zero = false;
-
-    this->is_branch_program_counter_set = false;
-    this->is_alu_result_set = false;
-    this->is_read_data_2_set = false;
-    this->is_register_destination_set = false;
-    this->is_alu_result_zero_flag_set = false;
-    this->is_control_set = false;
-    this->is_nop_asserted = false;
-    this->is_reset_flag_set = false;
-    this->is_pause_flag_set = false;
-    this->is_nop_passed_flag_asserted = false;
-    this->is_nop_passed_flag_set = false;
-    this->is_nop_flag_set = true;
+#include <sstream>
+
+#include "../../../include/state/DataMemory.h"
+#include "../../../include/combinational/ALU.h"
+#include "../../../include/combinational/adder/EXAdder.h"
+
+EXMEMStageRegisters::EXMEMStageRegisters(SimulationContext *context)
+        : Module(context), branch_program_counter(0UL), register_destination(0UL), alu_result_zero_flag(false),
+          control(Control(Instruction::getZeroInstruction(), PipelineType::Single, context)), nop_passed_flag(false) {
+    this->readiness.track(REQUIRED_BITS, PAUSE_FLAG_SET, RESET_FLAG_SET);
+    this->readiness.set(NOP_FLAG_SET);
+
     this->is_verbose_execution_flag_asserted = false;
 
     this->current_nop_set_operations = 0;
 
-    this->control = nullptr;
-
     this->data_memory = nullptr;
     this->mem_wb_stage_registers = nullptr;
     this->if_mux = nullptr;
@@ -44,7 +30,7 @@ void EXMEMStageRegisters::changeStageAndReset(PipelineType new_pipeline_type) {
     {  // Limit lock guard scope to avoid deadlock
         std::lock_guard<std::mutex> if_id_stage_registers_lock(this->getModuleMutex());
 
-        this->log("PipelineType change.");
+        this->log<LogLevel::Info>("PipelineType change.");
         this->setPipelineType(new_pipeline_type);
     }
 
@@ -52,414 +38,354 @@ void EXMEMStageRegisters::changeStageAndReset(PipelineType new_pipeline_type) {
 }
 
 void EXMEMStageRegisters::reset() {
-    std::lock_guard<std::mutex> if_id_stage_registers_lock(this->getModuleMutex());
-
-    this->is_reset_flag_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(RESET_FLAG_SET);
 }
 
 void EXMEMStageRegisters::resetStage() {
-    if (this->getPipelineType() == PipelineType::Single) {
-        this->is_branch_program_counter_set = false;
-        this->is_alu_result_set = false;
-        this->is_read_data_2_set = false;
-        this->is_register_destination_set = false;
-        this->is_alu_result_zero_flag_set = false;
-        this->is_control_set = false;
-        this->is_nop_passed_flag_set = false;
-        this->is_nop_asserted = false;
-    } else {
-        this->is_branch_program_counter_set = true;
-        this->is_alu_result_set = true;
-        this->is_read_data_2_set = true;
-        this->is_register_destination_set = true;
-        this->is_alu_result_zero_flag_set = true;
-        this->is_control_set = true;
-        this->is_nop_passed_flag_asserted = true;
-        this->is_nop_passed_flag_set = true;
-        this->is_nop_asserted = true;
-    }
+    bool is_five_stage = this->getPipelineType() == PipelineType::Five;
 
     this->current_nop_set_operations = 0;
 
-    this->is_nop_flag_set = true;
-    this->is_alu_result_zero = false;
-    this->branch_program_counter = 0UL;
-    this->register_destination = 0UL;
-
-    this->alu_result = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->read_data_2 = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-
-    this->control = new Control(new Instruction(std::string(32, '0')), this->getPipelineType());
+    this->readiness.keepOnly(PAUSE_FLAG_SET | RESET_FLAG_SET | ReadinessMask::KILLED);
+    this->readiness.set(is_five_stage ? NOP_FLAG_SET | NOP_ASSERTED : NOP_FLAG_SET);
+
+    this->branch_program_counter.reset(0UL);
+    this->register_destination.reset(0UL);
+    this->alu_result.reset();
+    this->read_data_2.reset();
+    this->alu_result_zero_flag.reset(false);
+    this->control.reset(Control(Instruction::getZeroInstruction(), this->getPipelineType(), this->context));
+    this->nop_passed_flag.reset(is_five_stage);
+
+    if (is_five_stage) {  // The first five stage cycle clocks a bubble, no module drives the inputs yet
+        this->branch_program_counter.discard();
+        this->register_destination.discard();
+        this->alu_result.discard();
+        this->read_data_2.discard();
+        this->alu_result_zero_flag.discard();
+        this->control.discard();
+        this->nop_passed_flag.discard();
+        this->readiness.set(INPUT_BITS);
+    }
 }
 
 void EXMEMStageRegisters::pause() {
-    this->log("Paused.");
-    this->is_pause_flag_set = true;
+    this->log<LogLevel::Info>("Paused.");
+    this->readiness.set(PAUSE_FLAG_SET);
 }
 
 void EXMEMStageRegisters::resume() {
-    std::lock_guard<std::mutex> ex_mem_stage_registers_lock (this->getModuleMutex());
+    this->log<LogLevel::Info>("Resumed.");
+    this->clearReadiness(PAUSE_FLAG_SET);
+}
+
+void EXMEMStageRegisters::initDependencies() {
+    std::unique_lock<std::mutex> ex_mem_stage_registers_lock (this->getModuleDependencyMutex());
+
+    if (this->data_memory && this->mem_wb_stage_registers && this->if_mux &&
+        this->stage_synchronizer && this->alu_input_1_forwarding_mux && this->alu_input_2_forwarding_mux &&
+        this->forwarding_unit && this->logger) {
+        return;
+    }
+
+    this->data_memory = this->context->get<DataMemory>();
+    this->mem_wb_stage_registers = this->context->get<MEMWBStageRegisters>();
+    this->if_mux = this->context->get<IFMux>();
+    this->stage_synchronizer = this->context->get<StageSynchronizer>();
+    this->alu_input_1_forwarding_mux = this->context->get<ALUInput1ForwardingMux>();
+    this->alu_input_2_forwarding_mux = this->context->get<ALUInput2ForwardingMux>();
+    this->forwarding_unit = this->context->get<ForwardingUnit>();
+    this->logger = this->context->get<Logger>();
+
+    this->connectInput(this->branch_program_counter, this->context->get<EXAdder>());
+    this->connectInput(this->alu_result, this->context->get<ALU>());
+    this->connectInput(this->alu_result_zero_flag, this->context->get<ALU>());
+
+    IDEXStageRegisters *id_ex_stage_registers = this->context->get<IDEXStageRegisters>();
+
+    this->stage_synchronizer->registerParticipant(true);
+    this->stage_synchronizer->connectFiveStageInput(this->context->get<EXAdder>());  // setBranchedProgramCounter
+    this->stage_synchronizer->connectFiveStageInput(this->context->get<ALU>());  // setALUResult
+    this->stage_synchronizer->connectFiveStageInput(this->context->get<ALU>());  // setIsResultZeroFlag
+    this->stage_synchronizer->connectFiveStageInput(id_ex_stage_registers);  // setRegisterDestination
+    this->stage_synchronizer->connectFiveStageInput(id_ex_stage_registers);  // setReadData2
+    this->stage_synchronizer->connectFiveStageInput(id_ex_stage_registers);  // setControl
+    this->stage_synchronizer->connectFiveStageInput(id_ex_stage_registers);  // setPassedNop
+    this->stage_synchronizer->connectFiveStageInput(this);  // setNop, MEM control
+    this->stage_synchronizer->connectFiveStageInput(this->mem_wb_stage_registers);  // setNop, WB control
+}
 
-    this->log("Resumed.");
-    this->is_pause_flag_set = false;
-    this->notifyModuleConditionVariable();
+bool EXMEMStageRegisters::isReadyToExecute() {
+    return this->readiness.isReady();
 }
 
-EXMEMStageRegisters *EXMEMStageRegisters::init() {
-    std::lock_guard<std::mutex> ex_mem_stage_registers_lock (EXMEMStageRegisters::initialization_mutex);
+void EXMEMStageRegisters::execute() {
+    if (this->readiness.isSet(RESET_FLAG_SET)) {
+        this->log<LogLevel::Info>("Resetting stage.");
 
-    if (EXMEMStageRegisters::current_instance == nullptr) {
-        EXMEMStageRegisters::current_instance = new EXMEMStageRegisters();
+        this->resetStage();
+        this->readiness.clear(RESET_FLAG_SET);
+
+        this->stage_synchronizer->arriveReset();
+
+        this->log<LogLevel::Info>("Reset.");
+        return;
+    }
+
+    this->log("Woken up and acquired lock.");
+
+    bool is_nop_passed = this->nop_passed_flag.get() || this->readiness.isSet(NOP_ASSERTED);
+
+    // The MEM control signals set the NOP of the next cycle, of this module as well
+    this->current_nop_set_operations = 0;
+    this->readiness.clear(NOP_FLAG_SET | NOP_ASSERTED);
+
+    Control current_control = this->control.get();
+    current_control.setNop(is_nop_passed);
+    current_control.setIsALUResultZero(this->alu_result_zero_flag.get());
+    current_control.toggleMEMStageControlSignals();
+
+    if (this->is_verbose_execution_flag_asserted) {
+        this->printState(current_control);
     }
 
-    return EXMEMStageRegisters::current_instance;
+    std::bitset<WORD_BIT_COUNT> alu_result_value = this->alu_result.get();
+    std::bitset<WORD_BIT_COUNT> write_data = this->read_data_2.get();
+    unsigned long rd = this->register_destination.get();
+    unsigned long branched_address = this->branch_program_counter.get();
+
+    this->markInputsEvaluated();
+    this->readiness.clear(INPUT_BITS);
+
+    this->dispatch(&EXMEMStageRegisters::passWriteDataToDataMemory, this, write_data);
+
+    this->dispatch(&EXMEMStageRegisters::passALUResultToDataMemory, this, alu_result_value);
+
+    this->dispatch(&EXMEMStageRegisters::passBranchedAddressToIFMux, this, branched_address);
+
+    this->dispatch(&EXMEMStageRegisters::passALUResultToALUInput1ForwardingMux, this, alu_result_value);
+
+    this->dispatch(&EXMEMStageRegisters::passALUResultToALUInput2ForwardingMux, this, alu_result_value);
+
+    this->dispatch(&EXMEMStageRegisters::passRegisterDestinationToForwardingUnit, this, rd);
+
+    this->dispatch(&EXMEMStageRegisters::passRegWriteToForwardingUnit, this, current_control.isRegWriteAsserted());
+
+    this->dispatch(&EXMEMStageRegisters::passALUResultToMEMWBStageRegisters, this, alu_result_value);
+
+    this->dispatch(&EXMEMStageRegisters::passRegisterDestinationToMEMWBStageRegisters, this, rd);
+
+    this->dispatch(
+            &EXMEMStageRegisters::passControlToMEMWBStageRegisters,
+            this,
+            current_control.getNextStageControl()
+    );
+
+    this->dispatch(&EXMEMStageRegisters::passNopToMEMWBStageRegisters, this, is_nop_passed);
+
+    this->stage_synchronizer->conditionalArriveSingleStage();
 }
 
-void EXMEMStageRegisters::initDependencies() {
-    std::unique_lock<std::mutex> ex_mem_stage_registers_lock (this->getModuleDependencyMutex());
+void EXMEMStageRegisters::markInputsEvaluated() {
+    this->branch_program_counter.markEvaluated();
+    this->alu_result.markEvaluated();
+    this->read_data_2.markEvaluated();
+    this->register_destination.markEvaluated();
+    this->alu_result_zero_flag.markEvaluated();
+    this->control.markEvaluated();
+    this->nop_passed_flag.markEvaluated();
+}
 
-    if (this->control && this->data_memory && this->mem_wb_stage_registers && this->if_mux &&
-        this->stage_synchronizer && this->alu_input_1_forwarding_mux && this->alu_input_2_forwarding_mux &&
-        this->forwarding_unit && this->logger) {
+void EXMEMStageRegisters::holdInput(SignalBase &input) {
+    if (this->stage_synchronizer->deferUntilClockEdge([this, &input] { this->holdInput(input); })) {
         return;
     }
 
-    this->control = new Control(new Instruction(std::string(32, '0')), this->getPipelineType());
-
-    this->data_memory = DataMemory::init();
-    this->mem_wb_stage_registers = MEMWBStageRegisters::init();
-    this->if_mux = IFMux::init();
-    this->stage_synchronizer = StageSynchronizer::init();
-    this->alu_input_1_forwarding_mux = ALUInput1ForwardingMux::init();
-    this->alu_input_2_forwarding_mux = ALUInput2ForwardingMux::init();
-    this->forwarding_unit = ForwardingUnit::init();
-    this->logger = Logger::init();
-}
-
-void EXMEMStageRegisters::run() {
-    this->initDependencies();
-
-    while (this->isAlive()) {
-        this->log("Waiting to be woken up and acquire lock.");
-
-        std::unique_lock<std::mutex> ex_mem_stage_registers_lock (this->getModuleMutex());
-        this->getModuleConditionVariable().wait(
-                ex_mem_stage_registers_lock,
-                [this] {
-                    return ((this->is_branch_program_counter_set && this->is_alu_result_set &&
-                            this->is_read_data_2_set && this->is_register_destination_set && this->is_nop_flag_set &&
-                            this->is_alu_result_zero_flag_set && this->is_control_set && this->is_nop_passed_flag_set) &&
-                            !this->is_pause_flag_set) || this->is_reset_flag_set || this->isKilled();
-                }
-        );
-
-        if (this->isKilled()) {
-            this->log("Killed.");
-            break;
-        }
-
-        if (this->is_reset_flag_set) {
-            this->log("Resetting stage.");
-
-            this->resetStage();
-            this->is_reset_flag_set = false;
-
-            this->stage_synchronizer->arriveReset();
-
-            this->log("Reset.");
-            continue;
-        }
-
-        this->log("Woken up and acquired lock.");
-
-        this->control->setNop(this->is_nop_passed_flag_asserted || this->is_nop_asserted);
-        this->control->setIsALUResultZero(this->is_alu_result_zero);
-        this->control->toggleMEMStageControlSignals();
-
-        if (this->is_verbose_execution_flag_asserted) {
-            this->printState();
-        }
-
-        std::thread pass_write_data_data_memory_thread (
-                &EXMEMStageRegisters::passWriteDataToDataMemory,
-                this,
-                this->read_data_2
-        );
-
-        std::thread pass_alu_result_data_memory_thread (
-                &EXMEMStageRegisters::passALUResultToDataMemory,
-                this,
-                this->alu_result
-        );
-
-        std::thread pass_branched_address_if_mux_thread (
-                &EXMEMStageRegisters::passBranchedAddressToIFMux,
-                this,
-                this->branch_program_counter
-        );
-
-        std::thread pass_alu_result_alu_input_1_forwarding_mux_thread (
-                &EXMEMStageRegisters::passALUResultToALUInput1ForwardingMux,
-                this,
-                this->alu_result
-        );
-
-        std::thread pass_alu_result_alu_input_2_forwarding_mux_thread (
-                &EXMEMStageRegisters::passALUResultToALUInput2ForwardingMux,
-                this,
-                this->alu_result
-        );
-
-        std::thread pass_register_destination_forwarding_unit_thread (
-                &EXMEMStageRegisters::passRegisterDestinationToForwardingUnit,
-                this,
-                this->register_destination
-        );
-
-        std::thread pass_reg_write_forwarding_unit_thread (
-                &EXMEMStageRegisters::passRegWriteToForwardingUnit,
-                this,
-                this->control->isRegWriteAsserted()
-        );
-
-        std::thread pass_alu_result_thread (
-                &EXMEMStageRegisters::passALUResultToMEMWBStageRegisters,
-                this,
-                this->alu_result
-        );
-        std::thread pass_register_destination_thread (
-                &EXMEMStageRegisters::passRegisterDestinationToMEMWBStageRegisters,
-                this,
-                this->register_destination
-        );
-
-        std::thread pass_control_thread (
-                &EXMEMStageRegisters::passControlToMEMWBStageRegisters,
-                this,
-                Control::deepCopy(this->control)
-        );
-
-        std::thread pass_nop_mem_wb_stage_registers_thread (
-                &EXMEMStageRegisters::passNopToMEMWBStageRegisters,
-                this,
-                this->is_nop_passed_flag_asserted || this->is_nop_asserted
-        );
-
-        pass_write_data_data_memory_thread.detach();
-        pass_alu_result_data_memory_thread.detach();
-        pass_branched_address_if_mux_thread.detach();
-        pass_alu_result_alu_input_1_forwarding_mux_thread.detach();
-        pass_alu_result_alu_input_2_forwarding_mux_thread.detach();
-        pass_register_destination_forwarding_unit_thread.detach();
-        pass_reg_write_forwarding_unit_thread.detach();
-        pass_alu_result_thread.detach();
-        pass_register_destination_thread.detach();
-        pass_control_thread.detach();
-        pass_nop_mem_wb_stage_registers_thread.detach();
-
-        this->is_branch_program_counter_set = false;
-        this->is_alu_result_set = false;
-        this->is_read_data_2_set = false;
-        this->is_register_destination_set = false;
-        this->is_alu_result_zero_flag_set = false;
-        this->is_control_set = false;
-        this->is_nop_asserted = false;
-        this->is_nop_passed_flag_set = false;
-        this->is_nop_passed_flag_asserted = false;
-        this->is_nop_flag_set = false;
-
-        this->current_nop_set_operations = 0;
-
-        this->stage_synchronizer->conditionalArriveSingleStage();
+    input.hold();
+
+    if (&input == &this->branch_program_counter) {
+        this->setReadiness(BRANCH_PROGRAM_COUNTER_SET);
+    } else if (&input == &this->alu_result) {
+        this->setReadiness(ALU_RESULT_SET);
+    } else if (&input == &this->alu_result_zero_flag) {
+        this->setReadiness(ALU_RESULT_ZERO_FLAG_SET);
+    } else {
+        throw std::runtime_error("EXMEMStageRegisters::holdInput: the held input is not connected to a module.");
     }
 }
 
 void EXMEMStageRegisters::setBranchedProgramCounter(unsigned long value) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+    if (this->stage_synchronizer->deferUntilClockEdge([this, value] { this->setBranchedProgramCounter(value); })) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setBranchedProgramCounter waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> ex_mem_stage_registers_lock (this->getModuleMutex());
-
-    this->log("setBranchedProgramCounter acquired lock. Updating value.");
+    this->log("setBranchedProgramCounter updating value.");
 
-    if (!this->is_nop_asserted) {
-        this->branch_program_counter = value;
+    if (!this->readiness.isSet(NOP_ASSERTED)) {
+        this->branch_program_counter.set(value);
         this->log("setBranchedProgramCounter updated value.");
     } else {
+        this->branch_program_counter.discard();
         this->log("setBranchedProgramCounter update skipped. NOP asserted.");
     }
 
-    this->is_branch_program_counter_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(BRANCH_PROGRAM_COUNTER_SET);
 }
 
 void EXMEMStageRegisters::setALUResult(std::bitset<WORD_BIT_COUNT> value) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+    if (this->stage_synchronizer->deferUntilClockEdge([this, value] { this->setALUResult(value); })) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setALUResult waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> ex_mem_stage_registers_lock (this->getModuleMutex());
+    this->log("setALUResult updating value.");
 
-    this->log("setALUResult acquired lock. Updating value.");
-
-    if (!this->is_nop_asserted) {
-        this->alu_result = value;
+    if (!this->readiness.isSet(NOP_ASSERTED)) {
+        this->alu_result.set(value);
         this->log("setALUResult updated value.");
     } else {
+        this->alu_result.discard();
         this->log("setALUResult update skipped. NOP asserted.");
     }
 
-    this->is_alu_result_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(ALU_RESULT_SET);
 }
 
 void EXMEMStageRegisters::setIsResultZeroFlag(bool asserted) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+    if (this->stage_synchronizer->deferUntilClockEdge([this, asserted] { this->setIsResultZeroFlag(asserted); })) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setIsResultZeroFlag waiting to acquire lock.");
+    this->log("setIsResultZeroFlag updating value.");
 
-    std::lock_guard<std::mutex> ex_mem_stage_registers_lock (this->getModuleMutex());
-
-    this->log("setIsResultZeroFlag acquired lock. Updating value.");
-
-    if (!this->is_nop_asserted) {
-        this->is_alu_result_zero = asserted;
+    if (!this->readiness.isSet(NOP_ASSERTED)) {
+        this->alu_result_zero_flag.set(asserted);
         this->log("setIsResultZeroFlag updated value.");
     } else {
+        this->alu_result_zero_flag.discard();
         this->log("setIsResultZeroFlag update skipped. NOP asserted.");
     }
 
-    this->is_alu_result_zero_flag_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(ALU_RESULT_ZERO_FLAG_SET);
 }
 
 void EXMEMStageRegisters::setReadData2(std::bitset<WORD_BIT_COUNT> value) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+    if (this->stage_synchronizer->deferUntilClockEdge([this, value] { this->setReadData2(value); })) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setReadData2 waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> ex_mem_stage_registers_lock (this->getModuleMutex());
+    this->log("setReadData2 updating value.");
 
-    this->log("setReadData2 acquired lock. Updating value.");
-
-    if (!this->is_nop_asserted) {
-        this->read_data_2 = value;
+    if (!this->readiness.isSet(NOP_ASSERTED)) {
+        this->read_data_2.set(value);
         this->log("setReadData2 updated value.");
     } else {
+        this->read_data_2.discard();
         this->log("setReadData2 update skipped. NOP asserted.");
     }
 
-    this->is_read_data_2_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(READ_DATA_2_SET);
 }
 
 void EXMEMStageRegisters::setRegisterDestination(unsigned long value) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+    if (this->stage_synchronizer->deferUntilClockEdge([this, value] { this->setRegisterDestination(value); })) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setRegisterDestination waiting to acquire lock.");
+    this->log("setRegisterDestination updating value.");
 
-    std::lock_guard<std::mutex> ex_mem_stage_registers_lock (this->getModuleMutex());
-
-    this->log("setRegisterDestination acquired lock. Updating value.");
-
-    if (!this->is_nop_asserted) {
-        this->register_destination = value;
+    if (!this->readiness.isSet(NOP_ASSERTED)) {
+        this->register_destination.set(value);
         this->log("setRegisterDestination updated value.");
     } else {
+        this->register_destination.discard();
         this->log("setRegisterDestination update skipped. NOP asserted.");
     }
 
-    this->is_register_destination_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(REGISTER_DESTINATION_SET);
 }
 
-void EXMEMStageRegisters::setControl(Control *new_control) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+void EXMEMStageRegisters::setControl(const Control &new_control) {
+    if (this->stage_synchronizer->deferUntilClockEdge([this, new_control] { this->setControl(new_control); })) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setControl waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> ex_mem_stage_registers_lock (this->getModuleMutex());
-
-    this->log("setControl acquired lock. Updating value.");
+    this->log("setControl updating value.");
 
-    if (this->is_nop_asserted) {
+    if (this->readiness.isSet(NOP_ASSERTED)) {
+        this->control.discard();
         this->log("setControl update skipped. NOP asserted.");
     } else {
-        this->control = new_control;
+        this->control.set(new_control);
         this->log("setControl updated value.");
     }
 
-    this->is_control_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(CONTROL_SET);
 }
 
 void EXMEMStageRegisters::setPassedNop(bool is_asserted) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+    if (this->stage_synchronizer->deferUntilClockEdge([this, is_asserted] { this->setPassedNop(is_asserted); })) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setPassedNop waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> ex_mem_stage_registers_lock (this->getModuleMutex());
+    this->log("setPassedNop updating value.");
 
-    this->log("setPassedNop acquired lock.");
-
-    if (!this->is_nop_asserted) {
-        this->is_nop_passed_flag_asserted = is_asserted;
+    if (!this->readiness.isSet(NOP_ASSERTED)) {
+        this->nop_passed_flag.set(is_asserted);
+    } else {
+        this->nop_passed_flag.discard();
     }
 
-    this->is_nop_passed_flag_set = true;
-
     this->log("setPassedNop updated value.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(NOP_PASSED_FLAG_SET);
 }
 
 void EXMEMStageRegisters::setNop(bool is_asserted) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
-
-    this->log("setPassedNop waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> ex_mem_stage_registers_lock (this->getModuleMutex());
+    if (this->stage_synchronizer->deferNopUntilClockEdge([this, is_asserted] { this->setNop(is_asserted); })) {
+        return;
+    }
 
-    this->log("setPassedNop acquired lock.");
+    this->log("setNop updating value.");
 
-    this->is_nop_asserted |= is_asserted;
+    if (is_asserted) {
+        this->readiness.set(NOP_ASSERTED);
+    }
 
-    if (++this->current_nop_set_operations == REQUIRED_NOP_FLAG_SET_OPERATIONS) {
-        this->is_nop_flag_set = true;
-        this->getModuleConditionVariable().notify_all();
+    if (this->current_nop_set_operations.fetch_add(1, std::memory_order_acq_rel) + 1 ==
+        REQUIRED_NOP_FLAG_SET_OPERATIONS) {
+        this->setReadiness(NOP_FLAG_SET);
+        this->readiness.notify();  // Wakes the setters delayed until the NOP flag is set as well
     }
 }
 
-void EXMEMStageRegisters::passControlToMEMWBStageRegisters(Control *current_control) {
+void EXMEMStageRegisters::passControlToMEMWBStageRegisters(const Control &current_control) {
     this->log("Passing ALU result to Data Memory.");
     this->mem_wb_stage_registers->setControl(current_control);
     this->log("Passed ALU result to Data Memory.");
@@ -491,23 +417,23 @@ void EXMEMStageRegisters::passRegisterDestinationToMEMWBStageRegisters(unsigned
 
 void EXMEMStageRegisters::passBranchedAddressToIFMux(unsigned long branched_address) {
     this->log("Passing branch address to IFMux.");
-    this->if_mux->setInput(IFStageMuxInputType::BranchedPc, branched_address);
+    this->if_mux->setInput<IFStageMuxInputType::BranchedPc>(branched_address);
     this->log("Passed branch address to IFMux.");
 }
 
 void EXMEMStageRegisters::assertSystemEnabledNop() {
-    this->is_nop_asserted = true;
+    this->readiness.set(NOP_ASSERTED);
 }
 
 void EXMEMStageRegisters::passALUResultToALUInput1ForwardingMux(std::bitset<WORD_BIT_COUNT> data) {
     this->log("Passing ALU result to ALUInput1ForwardingMux.");
-    this->alu_input_1_forwarding_mux->setInput(ALUInputMuxInputTypes::EXMEMStageRegisters, data);
+    this->alu_input_1_forwarding_mux->setInput<ALUInputMuxInputTypes::EXMEMStageRegisters>(data);
     this->log("Passed ALU result to ALUInput1ForwardingMux.");
 }
 
 void EXMEMStageRegisters::passALUResultToALUInput2ForwardingMux(std::bitset<WORD_BIT_COUNT> data) {
     this->log("Passing ALU result to ALUInput2ForwardingMux.");
-    this->alu_input_2_forwarding_mux->setInput(ALUInputMuxInputTypes::EXMEMStageRegisters, data);
+    this->alu_input_2_forwarding_mux->setInput<ALUInputMuxInputTypes::EXMEMStageRegisters>(data);
     this->log("Passed ALU result to ALUInput2ForwardingMux.");
 }
 
@@ -538,38 +464,36 @@ Stage EXMEMStageRegisters::getModuleStage() {
 }
 
 void EXMEMStageRegisters::delayUpdateUntilNopFlagSet() {
-    std::unique_lock<std::mutex> ex_mem_stage_registers_lock (this->getModuleMutex());
-    this->getModuleConditionVariable().wait(
-            ex_mem_stage_registers_lock,
-            [this] {
-                return this->is_nop_flag_set;
-            }
-    );
-}
-
-void EXMEMStageRegisters::printState() {
-    std::cout << std::string(20, '.') << std::endl;
-    std::cout << "EXMEMStageRegisters" << std::endl;
-    std::cout << std::string(20, '.') << std::endl;
-
-    std::cout << "branch_program_counter: " << this->branch_program_counter << std::endl;
-    std::cout << "register_destination: " << this->register_destination << std::endl;
-    std::cout << "alu_result: " << this->alu_result.to_ulong() << std::endl;
-    std::cout << "read_data_2: " << this->alu_result.to_ulong() << std::endl;
-    std::cout << "is_alu_result_zero: " << this->is_alu_result_zero << std::endl;
-    std::cout << "is_branch_program_counter_set: " << this->is_branch_program_counter_set << std::endl;
-    std::cout << "is_alu_result_set: " << this->is_alu_result_set << std::endl;
-    std::cout << "is_read_data_2_set: " << this->is_read_data_2_set << std::endl;
-    std::cout << "is_register_destination_set: " << this->is_register_destination_set << std::endl;
-    std::cout << "is_alu_result_zero_flag_set: " << this->is_alu_result_zero_flag_set << std::endl;
-    std::cout << "is_control_set: " << this->is_control_set << std::endl;
-    std::cout << "is_nop_asserted: " << this->is_nop_asserted << std::endl;
-    std::cout << "is_nop_passed_flag_asserted: " << this->is_nop_passed_flag_asserted << std::endl;
-    std::cout << "is_reset_flag_set: " << this->is_reset_flag_set << std::endl;
-    std::cout << "is_pause_flag_set: " << this->is_pause_flag_set << std::endl;
-    std::cout << "is_nop_passed_flag_set: " << this->is_nop_passed_flag_set << std::endl;
-
-    this->control->printState();
+    this->readiness.waitUntilSet(NOP_FLAG_SET);
+}
+
+void EXMEMStageRegisters::printState(Control &current_control) {
+    std::ostringstream state;
+
+    state << std::string(20, '.') << '\n';
+    state << "EXMEMStageRegisters" << '\n';
+    state << std::string(20, '.') << '\n';
+
+    state << "branch_program_counter: " << this->branch_program_counter.get() << '\n';
+    state << "register_destination: " << this->register_destination.get() << '\n';
+    state << "alu_result: " << this->alu_result.get().to_ulong() << '\n';
+    state << "read_data_2: " << this->alu_result.get().to_ulong() << '\n';
+    state << "is_alu_result_zero: " << this->alu_result_zero_flag.get() << '\n';
+    state << "is_branch_program_counter_set: " << this->readiness.isSet(BRANCH_PROGRAM_COUNTER_SET) << '\n';
+    state << "is_alu_result_set: " << this->readiness.isSet(ALU_RESULT_SET) << '\n';
+    state << "is_read_data_2_set: " << this->readiness.isSet(READ_DATA_2_SET) << '\n';
+    state << "is_register_destination_set: " << this->readiness.isSet(REGISTER_DESTINATION_SET) << '\n';
+    state << "is_alu_result_zero_flag_set: " << this->readiness.isSet(ALU_RESULT_ZERO_FLAG_SET) << '\n';
+    state << "is_control_set: " << this->readiness.isSet(CONTROL_SET) << '\n';
+    state << "is_nop_asserted: " << this->readiness.isSet(NOP_ASSERTED) << '\n';
+    state << "is_nop_passed_flag_asserted: " << this->nop_passed_flag.get() << '\n';
+    state << "is_reset_flag_set: " << this->readiness.isSet(RESET_FLAG_SET) << '\n';
+    state << "is_pause_flag_set: " << this->readiness.isSet(PAUSE_FLAG_SET) << '\n';
+    state << "is_nop_passed_flag_set: " << this->readiness.isSet(NOP_PASSED_FLAG_SET) << '\n';
+
+    current_control.printState(state);
+
+    this->printToConsole(state.str());
 }
 
 void EXMEMStageRegisters::assertVerboseExecutionFlag() {
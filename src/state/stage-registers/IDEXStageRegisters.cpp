@@ -1,33 +1,17 @@
 #include "../../../include/state/stage-registers/IDEXStageRegisters.h"
 
-IDEXStageRegisters *IDEXStageRegisters::current_instance = nullptr;
-std::mutex IDEXStageRegisters::initialization_mutex;
-
-IDEXStageRegisters::IDEXStageRegisters() {
-    this->register_source1 = 0UL;
-    this->register_source2 = 0UL;
-    this->register_destination = 0UL;
-    this->program_counter = 0UL;
-
-    this->is_single_read_register_data_set = false;
-    this->is_double_read_register_data_set = false;
-    this->is_immediate_set = false;
-    this->is_register_destination_set = false;
-    this->is_program_counter_set = false;
-    this->is_control_set = false;
-    this->is_nop_asserted = false;
-    this->is_reset_flag_set = false;
-    this->is_pause_flag_set = false;
-    this->is_register_source1_set = false;
-    this->is_register_source2_set = false;
-    this->is_instruction_set = false;
-    this->is_nop_flag_set = true;
-    this->is_nop_passed_flag_set = false;
-    this->is_nop_passed_flag_asserted = false;
-    this->is_verbose_execution_flag_asserted = false;
+#include <sstream>
+
+#include "../../../include/combinational/ImmediateGenerator.h"
 
-    this->instruction = nullptr;
-    this->control = nullptr;
+IDEXStageRegisters::IDEXStageRegisters(SimulationContext *context)
+        : Module(context), control(Control(Instruction::getZeroInstruction(), PipelineType::Single, context)),
+          instruction(Instruction::getZeroInstruction()), register_source1(0UL), register_source2(0UL),
+          register_destination(0UL), program_counter(0UL) {
+    this->readiness.track(REQUIRED_BITS, PAUSE_FLAG_SET, RESET_FLAG_SET);
+    this->readiness.set(NOP_FLAG_SET);
+
+    this->is_verbose_execution_flag_asserted = false;
 
     this->ex_mux_alu_input_1 = nullptr;
     this->ex_mux_alu_input_2 = nullptr;
@@ -45,7 +29,7 @@ void IDEXStageRegisters::changeStageAndReset(PipelineType new_pipeline_type) {
     {  // Limit lock guard scope to avoid deadlock
         std::lock_guard<std::mutex> if_id_stage_registers_lock(this->getModuleMutex());
 
-        this->log("PipelineType change.");
+        this->log<LogLevel::Info>("PipelineType change.");
         this->setPipelineType(new_pipeline_type);
     }
 
@@ -53,543 +37,462 @@ void IDEXStageRegisters::changeStageAndReset(PipelineType new_pipeline_type) {
 }
 
 void IDEXStageRegisters::reset() {
-    std::lock_guard<std::mutex> id_ex_stage_registers_lock (this->getModuleMutex());
-
-    this->is_reset_flag_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(RESET_FLAG_SET);
 }
 
 void IDEXStageRegisters::resetStage() {
     if (this->getPipelineType() == PipelineType::Single) {
-        this->is_single_read_register_data_set = false;
-        this->is_double_read_register_data_set = false;
-        this->is_immediate_set = false;
-        this->is_register_destination_set = false;
-        this->is_program_counter_set = false;
-        this->is_control_set = false;
-        this->is_register_source1_set = false;
-        this->is_register_source2_set = false;
-        this->is_instruction_set = false;
-        this->is_nop_passed_flag_set = false;
-        this->is_nop_asserted = false;
+        this->readiness.clear(INPUT_BITS | NOP_ASSERTED);
     } else {
-        this->is_single_read_register_data_set = true;
-        this->is_double_read_register_data_set = true;
-        this->is_immediate_set = true;
-        this->is_register_destination_set = true;
-        this->is_program_counter_set = true;
-        this->is_control_set = true;
-        this->is_register_source1_set = true;
-        this->is_register_source2_set = true;
-        this->is_instruction_set = true;
-        this->is_nop_passed_flag_set = true;
-        this->is_nop_asserted = true;
-    }
-
-    this->is_nop_flag_set = true;
-    this->instruction = new Instruction(std::string(32, '0'));
-    this->control = new Control(this->instruction, this->getPipelineType());
-
-    this->read_data_1 = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->read_data_2 = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->immediate = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-
-    this->program_counter = 0UL;
-    this->register_destination = 0UL;
-    this->register_source1 = 0UL;
-    this->register_source2 = 0UL;
+        this->readiness.set(INPUT_BITS | NOP_ASSERTED);
+    }
+
+    this->readiness.set(NOP_FLAG_SET);
+    this->instruction.reset(Instruction::getZeroInstruction());
+    this->control.reset(Control(Instruction::getZeroInstruction(), this->getPipelineType(), this->context));
+
+    this->read_data_1.reset();
+    this->read_data_2.reset();
+    this->immediate.reset();
+
+    this->program_counter.reset(0UL);
+    this->register_destination.reset(0UL);
+    this->register_source1.reset(0UL);
+    this->register_source2.reset(0UL);
     this->current_nop_set_operations = 0;
 }
 
 void IDEXStageRegisters::pause() {
-    this->is_pause_flag_set = true;
+    this->readiness.set(PAUSE_FLAG_SET);
 }
 
 void IDEXStageRegisters::resume() {
-    std::lock_guard<std::mutex> id_ex_stage_registers_lock (this->getModuleMutex());
-
-    this->is_pause_flag_set = false;
-    this->notifyModuleConditionVariable();
+    this->clearReadiness(PAUSE_FLAG_SET);
 }
 
-IDEXStageRegisters *IDEXStageRegisters::init() {
-    std::lock_guard<std::mutex> id_ex_stage_registers_lock (IDEXStageRegisters::initialization_mutex);
+void IDEXStageRegisters::initDependencies() {
+    std::lock_guard<std::mutex> id_ex_stage_registers_lock (this->getModuleDependencyMutex());
 
-    if (IDEXStageRegisters::current_instance == nullptr) {
-        IDEXStageRegisters::current_instance = new IDEXStageRegisters();
+    if (this->ex_mux_alu_input_1 && this->ex_mux_alu_input_2 && this->ex_adder && this->forwarding_unit &&
+        this->ex_mem_stage_register && this->stage_synchronizer && this->logger && this->hazard_detection_unit) {
+        return;
     }
 
-    return IDEXStageRegisters::current_instance;
+    this->ex_mux_alu_input_1 = this->context->get<EXMuxALUInput1>();
+    this->ex_mux_alu_input_2 = this->context->get<EXMuxALUInput2>();
+    this->ex_adder = this->context->get<EXAdder>();
+    this->forwarding_unit = this->context->get<ForwardingUnit>();
+    this->ex_mem_stage_register = this->context->get<EXMEMStageRegisters>();
+    this->stage_synchronizer = this->context->get<StageSynchronizer>();
+    this->logger = this->context->get<Logger>();
+    this->hazard_detection_unit = this->context->get<HazardDetectionUnit>();
+
+    this->connectInput(this->immediate, this->context->get<ImmediateGenerator>());
+
+    IFIDStageRegisters *if_id_stage_registers = this->context->get<IFIDStageRegisters>();
+
+    this->stage_synchronizer->registerParticipant(true);
+    this->stage_synchronizer->connectFiveStageInput(this->context->get<RegisterFile>());  // setRegisterData
+    this->stage_synchronizer->connectFiveStageInput(this->context->get<ImmediateGenerator>());  // setImmediate
+    this->stage_synchronizer->connectFiveStageInput(if_id_stage_registers);  // setProgramCounter
+    this->stage_synchronizer->connectFiveStageInput(if_id_stage_registers);  // setControlModule
+    this->stage_synchronizer->connectFiveStageInput(if_id_stage_registers);  // setRegisterDestination
+    this->stage_synchronizer->connectFiveStageInput(if_id_stage_registers);  // setRegisterSource1
+    this->stage_synchronizer->connectFiveStageInput(if_id_stage_registers);  // setRegisterSource2
+    this->stage_synchronizer->connectFiveStageInput(if_id_stage_registers);  // setInstruction
+    this->stage_synchronizer->connectFiveStageInput(if_id_stage_registers);  // setPassedNop
+    this->stage_synchronizer->connectFiveStageInput(this->hazard_detection_unit);  // setNop
+    this->stage_synchronizer->connectFiveStageInput(this->ex_mem_stage_register);  // setNop, MEM control
+    this->stage_synchronizer->connectFiveStageInput(this->context->get<MEMWBStageRegisters>());  // setNop, WB control
 }
 
-void IDEXStageRegisters::initDependencies() {
-    std::lock_guard<std::mutex> id_ex_stage_registers_lock (this->getModuleDependencyMutex());
+bool IDEXStageRegisters::isReadyToExecute() {
+    return this->readiness.isReady();
+}
 
-    if (this->ex_mux_alu_input_1 && this->ex_mux_alu_input_2 && this->ex_adder && this->forwarding_unit &&
-        this->ex_mem_stage_register && this->stage_synchronizer && this->logger && this->hazard_detection_unit) {
+void IDEXStageRegisters::execute() {
+    if (this->readiness.isSet(RESET_FLAG_SET)) {
+        this->log<LogLevel::Info>("Resetting.");
+
+        this->resetStage();
+        this->readiness.clear(RESET_FLAG_SET);
+
+        this->stage_synchronizer->arriveReset();
+
+        this->log<LogLevel::Info>("Reset.");
         return;
     }
 
-    this->ex_mux_alu_input_1 = EXMuxALUInput1::init();
-    this->ex_mux_alu_input_2 = EXMuxALUInput2::init();
-    this->ex_adder = EXAdder::init();
-    this->forwarding_unit = ForwardingUnit::init();
-    this->ex_mem_stage_register = EXMEMStageRegisters::init();
-    this->stage_synchronizer = StageSynchronizer::init();
-    this->logger = Logger::init();
-    this->hazard_detection_unit = HazardDetectionUnit::init();
-}
-
-void IDEXStageRegisters::run() {
-    this->initDependencies();
-
-    while (this->isAlive()) {
-        this->log("Waiting to be woken up and acquire lock.");
-
-        std::unique_lock<std::mutex> id_ex_stage_registers_lock (this->getModuleMutex());
-        this->getModuleConditionVariable().wait(
-                id_ex_stage_registers_lock,
-                [this] {
-                    return ((this->is_single_read_register_data_set || this->is_double_read_register_data_set) &&
-                           this->is_program_counter_set && this->is_register_destination_set &&
-                           this->is_immediate_set && this->is_control_set && this->is_register_source1_set &&
-                           this->is_register_source2_set && this->is_instruction_set && !this->is_pause_flag_set &&
-                           this->is_nop_flag_set && this->is_nop_passed_flag_set) || this->is_reset_flag_set ||
-                           this->isKilled();
-                }
-        );
-
-        if (this->isKilled()) {
-            this->log("Killed.");
-            break;
-        }
-
-        if (this->is_reset_flag_set) {
-            this->log("Resetting.");
-
-            this->resetStage();
-            this->is_reset_flag_set = false;
-
-            this->stage_synchronizer->arriveReset();
-
-            this->log("Reset.");
-            continue;
-        }
-
-        this->log("Woken up and acquired lock.");
-
-        if (!this->control || !this->instruction) {
-            this->instruction = new Instruction(std::string(32, '0'));
-            this->control = new Control(this->instruction, this->getPipelineType());
-        }
-
-        this->control->setNop(this->is_nop_asserted);
-        this->control->toggleEXStageControlSignals();
-
-        if (this->is_verbose_execution_flag_asserted) {
-            this->printState();
-        }
-
-        std::thread pass_program_counter_ex_adder_thread (
-                &IDEXStageRegisters::passProgramCounterToEXAdder,
-                this,
-                this->program_counter
-        );
-
-        std::thread pass_program_counter_ex_mux_alu_input_1_thread (
-                &IDEXStageRegisters::passProgramCounterToEXMuxALUInput1,
-                this,
-                this->program_counter
-        );
-
-        std::thread pass_read_data_1_ex_mux_alu_input_1_thread (
-                &IDEXStageRegisters::passReadData1ToExMuxALUInput1,
-                this,
-                this->read_data_1
-        );
-
-        std::thread pass_read_data_2_ex_mux_alu_input_2_thread (
-                &IDEXStageRegisters::passReadData2ToExMuxALUInput2,
-                this,
-                this->read_data_2
-        );
-
-        std::thread pass_immediate_ex_mux_alu_input_2_thread (
-                &IDEXStageRegisters::passImmediateToEXMuxALUInput2,
-                this,
-                this->immediate
-        );
-
-        std::thread pass_immediate_ex_adder_thread (
-                &IDEXStageRegisters::passImmediateToEXAdder,
-                this,
-                this->immediate
-        );
-
-        std::thread pass_register_source_forwarding_unit_thread (
-                &IDEXStageRegisters::passRegisterSourceToForwardingUnit,
-                this,
-                this->is_single_read_register_data_set,
-                this->register_source1,
-                this->register_source2
-        );
-
-        std::thread pass_mem_read_hazard_detection_unit_thread (
-                &IDEXStageRegisters::passMemReadToHazardDetectionUnit,
-                this,
-                this->control->isMemReadAsserted()
-        );
-
-        std::thread pass_register_destination_hazard_detection_unit_thread (
-                &IDEXStageRegisters::passRegisterDestinationToHazardDetectionUnit,
-                this,
-                this->register_destination
-        );
-
-        std::thread pass_register_destination_thread (
-                &IDEXStageRegisters::passRegisterDestinationToEXMEMStageRegisters,
-                this,
-                this->register_destination
-        );
-
-        std::thread pass_read_data2_thread (
-                &IDEXStageRegisters::passReadData2ToEXMEMStageRegisters,
-                this,
-                this->read_data_2
-        );
-
-        std::thread pass_control_thread (
-                &IDEXStageRegisters::passControlToEXMEMStageRegisters,
-                this,
-                Control::deepCopy(this->control)
-        );
-
-        std::thread pass_nop_ex_mem_stage_registers_thread (
-                &IDEXStageRegisters::passNopToEXMEMStageRegisters,
-                this,
-                this->is_nop_asserted
-        );
-
-        pass_program_counter_ex_adder_thread.detach();
-        pass_program_counter_ex_mux_alu_input_1_thread.detach();
-        pass_read_data_1_ex_mux_alu_input_1_thread.detach();
-        pass_read_data_2_ex_mux_alu_input_2_thread.detach();
-        pass_immediate_ex_mux_alu_input_2_thread.detach();
-        pass_immediate_ex_adder_thread.detach();
-        pass_register_source_forwarding_unit_thread.detach();
-        pass_mem_read_hazard_detection_unit_thread.detach();
-        pass_register_destination_hazard_detection_unit_thread.detach();
-        pass_register_destination_thread.detach();
-        pass_read_data2_thread.detach();
-        pass_control_thread.detach();
-        pass_nop_ex_mem_stage_registers_thread.detach();
-
-        this->is_single_read_register_data_set = false;
-        this->is_double_read_register_data_set = false;
-        this->is_immediate_set = false;
-        this->is_register_destination_set = false;
-        this->is_program_counter_set = false;
-        this->is_control_set = false;
-        this->is_nop_asserted = false;
-        this->is_instruction_set = false;
-        this->is_register_source1_set = false;
-        this->is_register_source2_set = false;
-        this->is_nop_passed_flag_set = false;
-        this->is_nop_passed_flag_asserted = false;
-        this->is_nop_flag_set = false;
-        this->current_nop_set_operations = 0;
-
-        this->stage_synchronizer->conditionalArriveSingleStage();
+    this->log("Woken up and acquired lock.");
+
+    bool is_nop_asserted = this->readiness.isSet(NOP_ASSERTED);
+
+    Control current_control = this->control.get();
+    current_control.setNop(is_nop_asserted);
+    current_control.toggleEXStageControlSignals();
+
+    if (this->is_verbose_execution_flag_asserted) {
+        this->printState(current_control);
     }
+
+    // The setters do not wait for the module mutex, once the inputs are cleared the next cycle may overwrite the
+    // members. What is dispatched below is read before, and nothing downstream sets the NOP before the first dispatch.
+    bool is_single_read_register_data_set = this->readiness.isSet(SINGLE_READ_REGISTER_DATA);
+    bool is_mem_read_asserted = current_control.isMemReadAsserted();
+    Control next_stage_control = current_control.getNextStageControl();
+
+    std::bitset<WORD_BIT_COUNT> current_read_data_1 = this->read_data_1.get();
+    std::bitset<WORD_BIT_COUNT> current_read_data_2 = this->read_data_2.get();
+    std::bitset<WORD_BIT_COUNT> current_immediate = this->immediate.get();
+
+    unsigned long current_register_source1 = this->register_source1.get();
+    unsigned long current_register_source2 = this->register_source2.get();
+    unsigned long current_register_destination = this->register_destination.get();
+    unsigned long current_program_counter = this->program_counter.get();
+
+    this->markInputsEvaluated();
+    this->readiness.keepOnly(PAUSE_FLAG_SET | RESET_FLAG_SET | ReadinessMask::KILLED);
+    this->current_nop_set_operations = 0;
+
+    this->dispatch(&IDEXStageRegisters::passProgramCounterToEXAdder, this, current_program_counter);
+
+    this->dispatch(&IDEXStageRegisters::passProgramCounterToEXMuxALUInput1, this, current_program_counter);
+
+    this->dispatch(&IDEXStageRegisters::passReadData1ToExMuxALUInput1, this, current_read_data_1);
+
+    this->dispatch(&IDEXStageRegisters::passReadData2ToExMuxALUInput2, this, current_read_data_2);
+
+    this->dispatch(&IDEXStageRegisters::passImmediateToEXMuxALUInput2, this, current_immediate);
+
+    this->dispatch(&IDEXStageRegisters::passImmediateToEXAdder, this, current_immediate);
+
+    this->dispatch(
+            &IDEXStageRegisters::passRegisterSourceToForwardingUnit,
+            this,
+            is_single_read_register_data_set,
+            current_register_source1,
+            current_register_source2
+    );
+
+    this->dispatch(&IDEXStageRegisters::passMemReadToHazardDetectionUnit, this, is_mem_read_asserted);
+
+    this->dispatch(
+            &IDEXStageRegisters::passRegisterDestinationToHazardDetectionUnit,
+            this,
+            current_register_destination
+    );
+
+    this->dispatch(
+            &IDEXStageRegisters::passRegisterDestinationToEXMEMStageRegisters,
+            this,
+            current_register_destination
+    );
+
+    this->dispatch(&IDEXStageRegisters::passReadData2ToEXMEMStageRegisters, this, current_read_data_2);
+
+    this->dispatch(&IDEXStageRegisters::passControlToEXMEMStageRegisters, this, next_stage_control);
+
+    this->dispatch(&IDEXStageRegisters::passNopToEXMEMStageRegisters, this, is_nop_asserted);
+
+    this->stage_synchronizer->conditionalArriveSingleStage();
+}
+
+void IDEXStageRegisters::markInputsEvaluated() {
+    this->control.markEvaluated();
+    this->read_data_1.markEvaluated();
+    this->read_data_2.markEvaluated();
+    this->immediate.markEvaluated();
+    this->instruction.markEvaluated();
+    this->register_source1.markEvaluated();
+    this->register_source2.markEvaluated();
+    this->register_destination.markEvaluated();
+    this->program_counter.markEvaluated();
+}
+
+void IDEXStageRegisters::holdInput(SignalBase &input) {
+    if (this->stage_synchronizer->deferUntilClockEdge([this, &input] { this->holdInput(input); })) {
+        return;
+    }
+
+    input.hold();
+    this->setReadiness(IMMEDIATE_SET);  // The immediate is the only input connected to a module that can be skipped
 }
 
 void IDEXStageRegisters::setRegisterData(std::bitset<WORD_BIT_COUNT> reg_data1) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+    if (this->stage_synchronizer->deferUntilClockEdge([this, reg_data1] { this->setRegisterData(reg_data1); })) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setRegisterData waiting to acquire lock.");
+    this->log("setRegisterData updating value.");
 
-    std::lock_guard<std::mutex> id_ex_stage_registers_lock (this->getModuleMutex());
-
-    this->log("setRegisterData acquired lock. Updating value.");
-
-    if (!this->is_nop_asserted) {
-        this->read_data_1 = reg_data1;
+    if (!this->readiness.isSet(NOP_ASSERTED)) {
+        this->read_data_1.set(reg_data1);
         this->log("setRegisterData value updated.");
     } else {
+        this->read_data_1.discard();
         this->log("setRegisterData update skipped. NOP asserted.");
     }
 
-    this->is_single_read_register_data_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(REGISTER_DATA_SET | SINGLE_READ_REGISTER_DATA);
 }
 
 void IDEXStageRegisters::setRegisterData(std::bitset<WORD_BIT_COUNT> reg_data1, std::bitset<WORD_BIT_COUNT> reg_data2) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+    if (this->stage_synchronizer->deferUntilClockEdge(
+            [this, reg_data1, reg_data2] { this->setRegisterData(reg_data1, reg_data2); }
+    )) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setRegisterData waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> id_ex_stage_registers_lock (this->getModuleMutex());
-
-    this->log("setRegisterData acquired lock. Updating value.");
+    this->log("setRegisterData updating value.");
 
-    if (!this->is_nop_asserted) {
-        this->read_data_1 = reg_data1;
-        this->read_data_2 = reg_data2;
+    if (!this->readiness.isSet(NOP_ASSERTED)) {
+        this->read_data_1.set(reg_data1);
+        this->read_data_2.set(reg_data2);
         this->log("setRegisterData value updated.");
     } else {
+        this->read_data_1.discard();
+        this->read_data_2.discard();
         this->log("setRegisterData update skipped. NOP asserted.");
     }
 
-    this->is_double_read_register_data_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(REGISTER_DATA_SET);
 }
 
 void IDEXStageRegisters::setImmediate(std::bitset<WORD_BIT_COUNT> imm) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+    if (this->stage_synchronizer->deferUntilClockEdge([this, imm] { this->setImmediate(imm); })) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setImmediate waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> id_ex_stage_registers_lock (this->getModuleMutex());
-
-    this->log("setImmediate acquired lock. Updating value.");
+    this->log("setImmediate updating value.");
 
-    if (!this->is_nop_asserted) {
-        this->immediate = imm;
+    if (!this->readiness.isSet(NOP_ASSERTED)) {
+        this->immediate.set(imm);
         this->log("setImmediate value updated.");
     } else {
+        this->immediate.discard();
         this->log("setImmediate update skipped. NOP asserted.");
     }
 
-    this->is_immediate_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(IMMEDIATE_SET);
 }
 
 void IDEXStageRegisters::setRegisterDestination(unsigned long rd) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+    if (this->stage_synchronizer->deferUntilClockEdge([this, rd] { this->setRegisterDestination(rd); })) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setRegisterDestination waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> id_ex_stage_registers_lock (this->getModuleMutex());
+    this->log("setRegisterDestination updating value.");
 
-    this->log("setRegisterDestination acquired lock. Updating value.");
-
-    if (!this->is_nop_asserted) {
-        this->register_destination = rd;
+    if (!this->readiness.isSet(NOP_ASSERTED)) {
+        this->register_destination.set(rd);
         this->log("setRegisterDestination value updated.");
     } else {
+        this->register_destination.discard();
         this->log("setRegisterDestination update skipped. NOP asserted.");
     }
 
-    this->is_register_destination_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(REGISTER_DESTINATION_SET);
 }
 
 void IDEXStageRegisters::setProgramCounter(unsigned long pc) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+    if (this->stage_synchronizer->deferUntilClockEdge([this, pc] { this->setProgramCounter(pc); })) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setProgramCounter waiting to acquire lock.");
+    this->log("setProgramCounter updating value.");
 
-    std::lock_guard<std::mutex> id_ex_stage_registers_lock (this->getModuleMutex());
-
-    this->log("setProgramCounter acquired lock. Updating value.");
-
-    if (!this->is_nop_asserted) {
-        this->program_counter = pc;
+    if (!this->readiness.isSet(NOP_ASSERTED)) {
+        this->program_counter.set(pc);
         this->log("setProgramCounter value updated.");
     } else {
+        this->program_counter.discard();
         this->log("setProgramCounter update skipped. NOP asserted.");
     }
 
-    this->is_program_counter_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(PROGRAM_COUNTER_SET);
 }
 
-void IDEXStageRegisters::setControlModule(Control *new_control) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+void IDEXStageRegisters::setControlModule(const Control &new_control) {
+    if (this->stage_synchronizer->deferUntilClockEdge([this, new_control] { this->setControlModule(new_control); })) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setControlModule waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> id_ex_stage_registers_lock (this->getModuleMutex());
+    this->log("setControlModule updating value.");
 
-    this->log("setControlModule acquired lock. Updating value.");
-
-    if (this->is_nop_asserted) {
+    if (this->readiness.isSet(NOP_ASSERTED)) {
+        this->control.discard();
         this->log("setControlModule update skipped. NOP asserted.");
     } else {
-        this->control = new_control;
+        this->control.set(new_control);
         this->log("setControlModule value updated.");
     }
 
-    this->is_control_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(CONTROL_SET);
 }
 
-void IDEXStageRegisters::setInstruction(Instruction *current_instruction) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+void IDEXStageRegisters::setInstruction(const Instruction *current_instruction) {
+    if (this->stage_synchronizer->deferUntilClockEdge(
+            [this, current_instruction] { this->setInstruction(current_instruction); }
+    )) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setInstruction waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> id_ex_stage_registers_lock (this->getModuleMutex());
-
-    this->log("setInstruction acquired lock. Updating value.");
+    this->log("setInstruction updating value.");
 
-    if (!this->is_nop_asserted) {
-        this->instruction = current_instruction;
-        this->log("setInstruction acquired lock. Updating value.");
+    if (!this->readiness.isSet(NOP_ASSERTED)) {
+        this->instruction.set(current_instruction);
+        this->log("setInstruction value updated.");
     } else {
+        this->instruction.discard();
         this->log("setInstruction update skipped. NOP asserted.");
     }
 
-    this->is_instruction_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(INSTRUCTION_SET);
 }
 
 void IDEXStageRegisters::setRegisterSource1(unsigned long rs1) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+    if (this->stage_synchronizer->deferUntilClockEdge([this, rs1] { this->setRegisterSource1(rs1); })) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setRegisterSource1 waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> id_ex_stage_registers_lock (this->getModuleMutex());
+    this->log("setRegisterSource1 updating value.");
 
-    this->log("setRegisterSource1 acquired lock. Updating value.");
-
-    if (!this->is_nop_asserted) {
-        this->register_source1 = rs1;
+    if (!this->readiness.isSet(NOP_ASSERTED)) {
+        this->register_source1.set(rs1);
         this->log("setRegisterSource1 value updated.");
     } else {
+        this->register_source1.discard();
         this->log("setRegisterSource1 update skipped. NOP asserted.");
     }
 
-    this->is_register_source1_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(REGISTER_SOURCE1_SET);
 }
 
 void IDEXStageRegisters::setPassedNop(bool is_asserted) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+    if (this->stage_synchronizer->deferUntilClockEdge([this, is_asserted] { this->setPassedNop(is_asserted); })) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setPassedNop waiting to acquire lock.");
+    this->log("setPassedNop updating value.");
 
-    std::lock_guard<std::mutex> id_ex_stage_registers_lock (this->getModuleMutex());
-
-    this->log("setPassedNop acquired lock. Updating value.");
-
-    this->is_nop_passed_flag_asserted = is_asserted;
-    this->is_nop_passed_flag_set = true;
+    if (is_asserted) {
+        this->readiness.set(NOP_PASSED_FLAG_ASSERTED);
+    }
 
     this->log("setPassedNop updated value.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(NOP_PASSED_FLAG_SET);
 }
 
 void IDEXStageRegisters::setNop(bool is_asserted) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
-
-    this->log("setPassedNop waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> id_ex_stage_registers_lock (this->getModuleMutex());
+    if (this->stage_synchronizer->deferNopUntilClockEdge([this, is_asserted] { this->setNop(is_asserted); })) {
+        return;
+    }
 
-    this->log("setPassedNop acquired lock.");
+    this->log("setNop updating value.");
 
-    this->is_nop_asserted |= is_asserted;
+    if (is_asserted) {
+        this->readiness.set(NOP_ASSERTED);
+    }
 
-    if (++this->current_nop_set_operations == REQUIRED_NOP_FLAG_SET_OPERATIONS) {
-        this->is_nop_flag_set = true;
-        this->getModuleConditionVariable().notify_all();
+    // The last operation acquires the NOP_ASSERTED bits of the others before it releases NOP_FLAG_SET
+    if (this->current_nop_set_operations.fetch_add(1, std::memory_order_acq_rel) + 1 ==
+        REQUIRED_NOP_FLAG_SET_OPERATIONS) {
+        this->setReadiness(NOP_FLAG_SET);
+        this->readiness.notify();  // Wakes the setters delayed until the NOP flag is set as well
     }
 }
 
 void IDEXStageRegisters::setRegisterSource2(unsigned long rs2) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+    if (this->stage_synchronizer->deferUntilClockEdge([this, rs2] { this->setRegisterSource2(rs2); })) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setRegisterSource2 waiting to acquire lock.");
+    this->log("setRegisterSource2 updating value.");
 
-    std::lock_guard<std::mutex> id_ex_stage_registers_lock (this->getModuleMutex());
-
-    this->log("setRegisterSource2 acquired lock. Updating value.");
-
-    if (!this->is_nop_asserted) {
-        this->register_source2 = rs2;
+    if (!this->readiness.isSet(NOP_ASSERTED)) {
+        this->register_source2.set(rs2);
         this->log("setRegisterSource2 value updated.");
     } else {
+        this->register_source2.discard();
         this->log("setRegisterSource2 update skipped. NOP asserted.");
     }
 
-    this->is_register_source2_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(REGISTER_SOURCE2_SET);
 }
 
 void IDEXStageRegisters::passProgramCounterToEXAdder(unsigned long pc) {
     this->log("Passing program counter to EXAdder.");
-    this->ex_adder->setInput(EXAdderInputType::PCValue, pc);
+    this->ex_adder->setInput<EXAdderInputType::PCValue>(pc);
     this->log("Passed program counter to EXAdder.");
 }
 
 void IDEXStageRegisters::passProgramCounterToEXMuxALUInput1(unsigned long pc) {
     this->log("Passing program counter to EXMuxALUInput1.");
-    this->ex_mux_alu_input_1->setInput(EXStageMuxALUInput1InputType::ProgramCounter, pc);
+    this->ex_mux_alu_input_1->setInput<EXStageMuxALUInput1InputType::ProgramCounter>(pc);
     this->log("Passed program counter to EXMuxALUInput1.");
 }
 
 void IDEXStageRegisters::passReadData1ToExMuxALUInput1(std::bitset<WORD_BIT_COUNT> data) {
     this->log("Passing read data 1 to EXMuxALUInput1.");
-    this->ex_mux_alu_input_1->setInput(EXStageMuxALUInput1InputType::ReadData1, data);
+    this->ex_mux_alu_input_1->setInput<EXStageMuxALUInput1InputType::ReadData1>(data);
     this->log("Passed read data 1 to EXMuxALUInput1.");
 }
 
 void IDEXStageRegisters::passReadData2ToExMuxALUInput2(std::bitset<WORD_BIT_COUNT> data) {
     this->log("Passing read data 2 to EXMuxALUInput2.");
-    this->ex_mux_alu_input_2->setInput(EXStageMuxALUInput2InputType::ReadData2, data);
+    this->ex_mux_alu_input_2->setInput<EXStageMuxALUInput2InputType::ReadData2>(data);
     this->log("Passed read data 2 to EXMuxALUInput2.");
 }
 
 void IDEXStageRegisters::passImmediateToEXMuxALUInput2(std::bitset<WORD_BIT_COUNT> imm) {
     this->log("Passing immediate to EXMuxALUInput2.");
-    this->ex_mux_alu_input_2->setInput(EXStageMuxALUInput2InputType::ImmediateValue, imm);
+    this->ex_mux_alu_input_2->setInput<EXStageMuxALUInput2InputType::ImmediateValue>(imm);
     this->log("Passed immediate to EXMuxALUInput2.");
 }
 
 void IDEXStageRegisters::passImmediateToEXAdder(std::bitset<WORD_BIT_COUNT> imm) {
     this->log("Passing immediate to EXAdder.");
-    this->ex_adder->setInput(EXAdderInputType::ImmediateValue, imm);
+    this->ex_adder->setInput<EXAdderInputType::ImmediateValue>(imm);
     this->log("Passed immediate to EXAdder.");
 }
 
@@ -605,14 +508,14 @@ void IDEXStageRegisters::passReadData2ToEXMEMStageRegisters(std::bitset<WORD_BIT
     this->log("Passed read data 2 to EXMEMStageRegisters.");
 }
 
-void IDEXStageRegisters::passControlToEXMEMStageRegisters(Control *current_control) {
+void IDEXStageRegisters::passControlToEXMEMStageRegisters(const Control &current_control) {
     this->log("Passing control to EXMEMStageRegisters.");
     this->ex_mem_stage_register->setControl(current_control);
     this->log("Passed control to EXMEMStageRegisters.");
 }
 
 void IDEXStageRegisters::assertSystemEnabledNop() {
-    this->is_nop_asserted = true;
+    this->readiness.set(NOP_ASSERTED);
 }
 
 void IDEXStageRegisters::passRegisterSourceToForwardingUnit(bool is_single_register_used,
@@ -648,13 +551,7 @@ void IDEXStageRegisters::passRegisterDestinationToHazardDetectionUnit(unsigned l
 }
 
 void IDEXStageRegisters::delayUpdateUntilNopFlagSet() {
-    std::unique_lock<std::mutex> id_ex_stage_registers_lock (this->getModuleMutex());
-    this->getModuleConditionVariable().wait(
-            id_ex_stage_registers_lock,
-            [this] {
-                return this->is_nop_flag_set;
-            }
-    );
+    this->readiness.waitUntilSet(NOP_FLAG_SET);
 }
 
 std::string IDEXStageRegisters::getModuleTag() {
@@ -665,34 +562,40 @@ Stage IDEXStageRegisters::getModuleStage() {
     return Stage::ID;
 }
 
-void IDEXStageRegisters::printState() {
-    std::cout << std::string(20, '.') << std::endl;
-    std::cout << "IDEXStageRegisters" << std::endl;
-    std::cout << std::string(20, '.') << std::endl;
-
-    std::cout << "read_data_1: " << this->read_data_1.to_ulong() << std::endl;
-    std::cout << "read_data_2: " << this->read_data_2.to_ulong() << std::endl;
-    std::cout << "immediate: " << this->immediate.to_ulong() << std::endl;
-    std::cout << "register_source1: " << this->register_source1 << std::endl;
-    std::cout << "register_source2: " << this->register_source2 << std::endl;
-    std::cout << "register_destination: " << this->register_destination << std::endl;
-    std::cout << "program_counter: " << this->program_counter << std::endl;
-    std::cout << "is_single_read_register_data_set: " << this->is_single_read_register_data_set << std::endl;
-    std::cout << "is_double_read_register_data_set: " << this->is_double_read_register_data_set << std::endl;
-    std::cout << "is_immediate_set: " << this->is_immediate_set << std::endl;
-    std::cout << "is_register_destination_set: " << this->is_register_destination_set << std::endl;
-    std::cout << "is_register_source1_set: " << this->is_register_source1_set << std::endl;
-    std::cout << "is_register_source2_set: " << this->is_register_source2_set << std::endl;
-    std::cout << "is_program_counter_set: " << this->is_program_counter_set << std::endl;
-    std::cout << "is_control_set: " << this->is_control_set << std::endl;
-    std::cout << "is_instruction_set: " << this->is_instruction_set << std::endl;
-    std::cout << "is_nop_passed_flag_set: " << this->is_nop_passed_flag_set << std::endl;
-    std::cout << "is_nop_asserted: " << this->is_nop_asserted << std::endl;
-    std::cout << "is_reset_flag_set: " << this->is_reset_flag_set << std::endl;
-    std::cout << "is_pause_flag_set: " << this->is_pause_flag_set << std::endl;
-    std::cout << "is_nop_passed_flag_asserted: " << this->is_nop_passed_flag_asserted << std::endl;
-
-    this->control->printState();
+void IDEXStageRegisters::printState(Control &current_control) {
+    std::ostringstream state;
+
+    state << std::string(20, '.') << '\n';
+    state << "IDEXStageRegisters" << '\n';
+    state << std::string(20, '.') << '\n';
+
+    state << "read_data_1: " << this->read_data_1.get().to_ulong() << '\n';
+    state << "read_data_2: " << this->read_data_2.get().to_ulong() << '\n';
+    state << "immediate: " << this->immediate.get().to_ulong() << '\n';
+    state << "register_source1: " << this->register_source1.get() << '\n';
+    state << "register_source2: " << this->register_source2.get() << '\n';
+    state << "register_destination: " << this->register_destination.get() << '\n';
+    state << "program_counter: " << this->program_counter.get() << '\n';
+    state << "is_single_read_register_data_set: " << this->readiness.isSet(SINGLE_READ_REGISTER_DATA) << '\n';
+    state << "is_double_read_register_data_set: "
+              << (this->readiness.isSet(REGISTER_DATA_SET) && !this->readiness.isSet(SINGLE_READ_REGISTER_DATA))
+              << '\n';
+    state << "is_immediate_set: " << this->readiness.isSet(IMMEDIATE_SET) << '\n';
+    state << "is_register_destination_set: " << this->readiness.isSet(REGISTER_DESTINATION_SET) << '\n';
+    state << "is_register_source1_set: " << this->readiness.isSet(REGISTER_SOURCE1_SET) << '\n';
+    state << "is_register_source2_set: " << this->readiness.isSet(REGISTER_SOURCE2_SET) << '\n';
+    state << "is_program_counter_set: " << this->readiness.isSet(PROGRAM_COUNTER_SET) << '\n';
+    state << "is_control_set: " << this->readiness.isSet(CONTROL_SET) << '\n';
+    state << "is_instruction_set: " << this->readiness.isSet(INSTRUCTION_SET) << '\n';
+    state << "is_nop_passed_flag_set: " << this->readiness.isSet(NOP_PASSED_FLAG_SET) << '\n';
+    state << "is_nop_asserted: " << this->readiness.isSet(NOP_ASSERTED) << '\n';
+    state << "is_reset_flag_set: " << this->readiness.isSet(RESET_FLAG_SET) << '\n';
+    state << "is_pause_flag_set: " << this->readiness.isSet(PAUSE_FLAG_SET) << '\n';
+    state << "is_nop_passed_flag_asserted: " << this->readiness.isSet(NOP_PASSED_FLAG_ASSERTED) << '\n';
+
+    current_control.printState(state);
+
+    this->printToConsole(state.str());
 }
 
 void IDEXStageRegisters::assertVerboseExecutionFlag() {
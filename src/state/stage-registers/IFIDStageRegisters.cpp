@@ -1,26 +1,20 @@
 #include "../../../include/state/stage-registers/IFIDStageRegisters.h"
 
-IFIDStageRegisters *IFIDStageRegisters::current_instance = nullptr;
-std::mutex IFIDStageRegisters::initialization_mutex;
-
-IFIDStageRegisters::IFIDStageRegisters() {
-    this->program_counter = 0UL;
-    this->instruction_bits = std::string(32, '0');
-
-    this->is_program_counter_set = false;
-    this->is_instruction_set = false;
-    this->is_nop_asserted = false;
-    this->is_reset_flag_set = false;
-    this->is_pause_flag_set = false;
-    this->is_nop_flag_set = true;
-    this->is_nop_passed_flag_asserted = false;
-    this->is_nop_passed_flag_set = false;
+#include <sstream>
+
+IFIDStageRegisters::IFIDStageRegisters(SimulationContext *context)
+        : Module(context), program_counter(0UL), nop_passed_flag(false),
+          control(Instruction::getZeroInstruction(), PipelineType::Single, context),
+          reset_control(Instruction::getZeroInstruction(), PipelineType::Single, context) {
+    this->readiness.track(REQUIRED_BITS, PAUSE_FLAG_SET, RESET_FLAG_SET);
+    this->readiness.set(NOP_FLAG_SET);
+
     this->is_verbose_execution_flag_asserted = false;
 
     this->current_nop_set_operations = 0;
 
-    this->instruction = nullptr;
-    this->control = nullptr;
+    this->instruction = Instruction::getZeroInstruction();
+    this->fetched_instruction.reset({this->instruction, &this->reset_control});
 
     this->register_file = nullptr;
     this->hazard_detection_unit = nullptr;
@@ -34,7 +28,7 @@ void IFIDStageRegisters::changeStageAndReset(PipelineType new_stage) {
     {  // Limit lock guard scope to avoid deadlock
         std::lock_guard<std::mutex> if_id_stage_registers_lock (this->getModuleMutex());
 
-        this->log("PipelineType change.");
+        this->log<LogLevel::Info>("PipelineType change.");
         this->setPipelineType(new_stage);
     }
 
@@ -46,260 +40,218 @@ void IFIDStageRegisters::reset() {
         this->initDependencies();
     }
 
-    std::lock_guard<std::mutex> if_id_stage_registers_lock (this->getModuleMutex());
-
     this->log("Reset flag set.");
-
-    this->is_reset_flag_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(RESET_FLAG_SET);
 }
 
 void IFIDStageRegisters::resetStage() {
-    if (this->getPipelineType() == PipelineType::Single) {
-        this->is_program_counter_set = false;
-        this->is_instruction_set = false;
-        this->is_nop_flag_set = true;
-        this->is_nop_asserted = false;
-        this->is_nop_passed_flag_set = false;
-    } else {
-        this->is_program_counter_set = true;
-        this->is_instruction_set = true;
-        this->is_nop_flag_set = true;
-        this->is_nop_asserted = true;
-        this->is_nop_passed_flag_set = true;
-    }
+    bool is_five_stage = this->getPipelineType() == PipelineType::Five;
+
+    this->readiness.keepOnly(RESET_FLAG_SET | ReadinessMask::KILLED);
+    this->readiness.set(is_five_stage ? NOP_FLAG_SET | NOP_ASSERTED : NOP_FLAG_SET);
+    this->current_nop_set_operations = 0;
+
+    this->instruction = Instruction::getZeroInstruction();
+    this->reset_control = Control(this->instruction, this->getPipelineType(), this->context);
+    this->control = this->reset_control;
 
-    this->is_reset_flag_set = false;
-    this->is_pause_flag_set = false;
+    this->program_counter.reset(0UL);
+    this->fetched_instruction.reset({this->instruction, &this->reset_control});
+    this->nop_passed_flag.reset(false);
 
-    this->program_counter = 0UL;
-    this->instruction_bits = std::string(32, '0');
-    this->instruction = new Instruction(this->instruction_bits);
-    this->control = new Control(this->instruction, this->getPipelineType());
+    if (is_five_stage) {  // The first five stage cycle clocks a bubble, no module drives the inputs yet
+        this->program_counter.discard();
+        this->fetched_instruction.discard();
+        this->nop_passed_flag.discard();
+        this->readiness.set(INPUT_BITS);
+    }
 }
 
 void IFIDStageRegisters::pause() {
-    this->log("Paused.");
-    this->is_pause_flag_set = true;
+    this->log<LogLevel::Info>("Paused.");
+    this->readiness.set(PAUSE_FLAG_SET);
 }
 
 void IFIDStageRegisters::resume() {
-    this->log("Resumed.");
-    this->is_pause_flag_set = false;
-    this->notifyModuleConditionVariable();
+    this->log<LogLevel::Info>("Resumed.");
+    this->clearReadiness(PAUSE_FLAG_SET);
 }
 
-IFIDStageRegisters *IFIDStageRegisters::init() {
-    std::lock_guard<std::mutex> if_id_stage_registers_lock (IFIDStageRegisters::initialization_mutex);
+void IFIDStageRegisters::initDependencies() {
+    std::unique_lock<std::mutex> if_id_stage_registers_lock (this->getModuleDependencyMutex());
 
-    if (IFIDStageRegisters::current_instance == nullptr) {
-        IFIDStageRegisters::current_instance = new IFIDStageRegisters();
+    if (this->register_file && this->id_ex_stage_registers && this->immediate_generator && this->stage_synchronizer &&
+        this->logger && this->hazard_detection_unit) {
+        return;
     }
 
-    return IFIDStageRegisters::current_instance;
+    this->register_file = this->context->get<RegisterFile>();
+    this->id_ex_stage_registers = this->context->get<IDEXStageRegisters>();
+    this->immediate_generator = this->context->get<ImmediateGenerator>();
+    this->stage_synchronizer = this->context->get<StageSynchronizer>();
+    this->logger = this->context->get<Logger>();
+    this->hazard_detection_unit = this->context->get<HazardDetectionUnit>();
+
+    this->stage_synchronizer->registerParticipant(true);
+    this->stage_synchronizer->connectFiveStageInput(this->context->get<Driver>());  // setInput, program counter
+    this->stage_synchronizer->connectFiveStageInput(this->context->get<InstructionMemory>());  // setInput, instruction
+    this->stage_synchronizer->connectFiveStageInput(this->context->get<Driver>());  // setPassedNop
+    this->stage_synchronizer->connectFiveStageInput(this->hazard_detection_unit);  // setNop
+    this->stage_synchronizer->connectFiveStageInput(this->context->get<EXMEMStageRegisters>());  // setNop, MEM control
 }
 
-void IFIDStageRegisters::initDependencies() {
-    std::unique_lock<std::mutex> if_id_stage_registers_lock (this->getModuleDependencyMutex());
+bool IFIDStageRegisters::isReadyToExecute() {
+    return this->readiness.isReady();
+}
+
+void IFIDStageRegisters::execute() {
+    if (this->readiness.isSet(RESET_FLAG_SET)) {
+        this->log<LogLevel::Info>("Resetting stage.");
+
+        this->resetStage();
+        this->readiness.clear(RESET_FLAG_SET);
 
-    if (this->instruction && this->control && this->register_file && this->id_ex_stage_registers &&
-        this->immediate_generator && this->stage_synchronizer && this->logger && this->hazard_detection_unit) {
+        this->stage_synchronizer->arriveReset();
+
+        this->log<LogLevel::Info>("Resetting stage.");
         return;
     }
 
-    this->instruction = new Instruction(std::string(32, '0'));
-    this->control = new Control(this->instruction, this->getPipelineType());
+    this->log("Woken up and acquired lock.");
 
-    this->register_file = RegisterFile::init();
-    this->id_ex_stage_registers = IDEXStageRegisters::init();
-    this->immediate_generator = ImmediateGenerator::init();
-    this->stage_synchronizer = StageSynchronizer::init();
-    this->logger = Logger::init();
-    this->hazard_detection_unit = HazardDetectionUnit::init();
-}
+    this->instruction = this->fetched_instruction.get().instruction;
+    this->control = *this->fetched_instruction.get().control_template;
+    this->control.setNop(this->readiness.isSet(NOP_ASSERTED) ||
+                           this->instruction->getType() == InstructionType::HALT);
 
-void IFIDStageRegisters::run() {
-    this->initDependencies();
-
-    while (this->isAlive()) {
-        this->log("Waiting to be woken up and acquire lock.");
-
-        std::unique_lock<std::mutex> if_id_stage_registers_lock (this->getModuleMutex());
-        this->getModuleConditionVariable().wait(
-                if_id_stage_registers_lock,
-                [this] {
-                    return (this->is_instruction_set && this->is_program_counter_set && this->is_nop_flag_set
-                            && this->is_nop_passed_flag_set && !this->is_pause_flag_set) || this->is_reset_flag_set ||
-                            this->isKilled();
-                }
-        );
-
-        if (this->isKilled()) {
-            this->log("Killed.");
-            break;
-        }
+    if (this->is_verbose_execution_flag_asserted) {
+        this->printState();
+    }
 
-        if (this->is_reset_flag_set) {
-            this->log("Resetting stage.");
+    // The hazard detection unit may set the NOP of the next cycle while the signals below are dispatched
+    const Instruction *current_instruction = this->instruction;
+    Control next_stage_control = this->control.getNextStageControl();
+    unsigned long current_program_counter = this->program_counter.get();
+    bool is_nop_passed_flag_asserted = this->nop_passed_flag.get();
 
-            this->resetStage();
-            this->is_reset_flag_set = false;
+    this->markInputsEvaluated();
+    this->readiness.keepOnly(PAUSE_FLAG_SET | RESET_FLAG_SET | ReadinessMask::KILLED);
+    this->current_nop_set_operations = 0;
 
-            this->stage_synchronizer->arriveReset();
+    // Signals are dispatched rather than called because the barrier will have them sleep until synchronization
+    // condition is met
+    this->dispatch(
+            &IFIDStageRegisters::passInstructionToHazardDetectionUnit,
+            this,
+            current_instruction
+    );
 
-            this->log("Resetting stage.");
-            continue;
-        }
+    this->dispatch(
+            &IFIDStageRegisters::passInstructionToImmediateGenerator,
+            this,
+            current_instruction
+    );
+
+    this->dispatch(
+            &IFIDStageRegisters::passControlToIDEXStageRegisters,
+            this,
+            next_stage_control
+    );
+    this->dispatch(&IFIDStageRegisters::passProgramCounterToIDEXStageRegisters, this, current_program_counter);
 
-        this->log("Woken up and acquired lock.");
+    this->dispatch(
+            &IFIDStageRegisters::passReadRegistersToRegisterFile,
+            this,
+            current_instruction
+    );
 
-        this->instruction = new Instruction(this->instruction_bits);
-        this->control = new Control(this->instruction, this->getPipelineType());
-        this->control->setNop(this->is_nop_asserted ||
-                                this->instruction->getType() == InstructionType::HALT);
+    this->dispatch(
+            &IFIDStageRegisters::passRegisterDestinationToIDEXStageRegisters,
+            this,
+            current_instruction
+    );
 
-        if (this->is_verbose_execution_flag_asserted) {
-            this->printState();
-        }
+    this->dispatch(
+            &IFIDStageRegisters::passRegisterSource1ToIDEXStageRegisters,
+            this,
+            current_instruction
+    );
 
-        // Popup threads to pass data because barrier will have them sleep until synchronization condition is met
-        std::thread pass_instruction_hazard_detection_unit_thread (
-                &IFIDStageRegisters::passInstructionToHazardDetectionUnit,
-                this,
-                Instruction::deepCopy(this->instruction)
-        );
-
-        std::thread pass_instruction_immediate_generator_thread (
-                &IFIDStageRegisters::passInstructionToImmediateGenerator,
-                this,
-                Instruction::deepCopy(this->instruction)
-        );
-
-        std::thread pass_control_thread (
-                &IFIDStageRegisters::passControlToIDEXStageRegisters,
-                this,
-                Control::deepCopy(this->control)
-        );
-
-        std::thread pass_program_counter_thread (
-                &IFIDStageRegisters::passProgramCounterToIDEXStageRegisters,
-                this,
-                this->program_counter
-        );
-
-        std::thread pass_read_registers_thread (
-                &IFIDStageRegisters::passReadRegistersToRegisterFile,
-                this,
-                Instruction::deepCopy(this->instruction)
-        );
-
-        std::thread pass_register_destination_thread (
-                &IFIDStageRegisters::passRegisterDestinationToIDEXStageRegisters,
-                this,
-                Instruction::deepCopy(this->instruction)
-        );
-
-        std::thread pass_register_source1_thread (
-                &IFIDStageRegisters::passRegisterSource1ToIDEXStageRegisters,
-                this,
-                Instruction::deepCopy(this->instruction)
-        );
-
-        std::thread pass_register_source2_thread (
-                &IFIDStageRegisters::passRegisterSource2ToIDEXStageRegisters,
-                this,
-                Instruction::deepCopy(this->instruction)
-        );
-
-        std::thread pass_instruction_id_ex_stage_registers_thread (
-                &IFIDStageRegisters::passInstructionToIDEXStageRegisters,
-                this,
-                Instruction::deepCopy(this->instruction)
-        );
-
-        std::thread pass_nop_id_ex_stage_registers_thread (
-                &IFIDStageRegisters::passNopToIDEXStageRegisters,
-                this,
-                this->is_nop_passed_flag_asserted
-        );
-
-        pass_instruction_hazard_detection_unit_thread.detach();
-        pass_instruction_immediate_generator_thread.detach();
-        pass_control_thread.detach();
-        pass_program_counter_thread.detach();
-        pass_read_registers_thread.detach();
-        pass_register_destination_thread.detach();
-        pass_register_source1_thread.detach();
-        pass_register_source2_thread.detach();
-        pass_instruction_id_ex_stage_registers_thread.detach();
-        pass_nop_id_ex_stage_registers_thread.detach();
-
-        this->is_instruction_set = false;
-        this->is_program_counter_set = false;
-        this->is_nop_asserted = false;
-        this->is_nop_flag_set = false;
-        this->is_nop_passed_flag_asserted = false;
-        this->is_nop_passed_flag_set = false;
-
-        this->current_nop_set_operations = 0;
-
-        this->stage_synchronizer->conditionalArriveSingleStage();
-    }
+    this->dispatch(
+            &IFIDStageRegisters::passRegisterSource2ToIDEXStageRegisters,
+            this,
+            current_instruction
+    );
+
+    this->dispatch(
+            &IFIDStageRegisters::passInstructionToIDEXStageRegisters,
+            this,
+            current_instruction
+    );
+
+    this->dispatch(&IFIDStageRegisters::passNopToIDEXStageRegisters, this, is_nop_passed_flag_asserted);
+
+    this->stage_synchronizer->conditionalArriveSingleStage();
 }
 
-void IFIDStageRegisters::setInput(std::variant<unsigned long, std::string> input) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+void IFIDStageRegisters::markInputsEvaluated() {
+    this->program_counter.markEvaluated();
+    this->fetched_instruction.markEvaluated();
+    this->nop_passed_flag.markEvaluated();
+}
+
+void IFIDStageRegisters::setInput(std::variant<unsigned long, DecodedInstruction> input) {
+    if (this->stage_synchronizer->deferUntilClockEdge([this, input] { this->setInput(input); })) {
+        return;
+    }
 
     if (this->getPipelineType() == PipelineType::Five) {
         this->delayUpdateUntilNopFlagSet();
     }
 
-    this->log("setInput waiting to acquire lock.");
-
-    std::unique_lock<std::mutex> if_id_stage_registers_lock (this->getModuleMutex());
-
-    this->log("setInput acquired lock. Updating value.");
+    this->log("setInput updating value.");
 
     if (std::holds_alternative<unsigned long>(input)) {
-        if (!this->is_nop_asserted) {
-            this->program_counter = std::get<unsigned long>(input);
+        if (!this->readiness.isSet(NOP_ASSERTED)) {
+            this->program_counter.set(std::get<unsigned long>(input));
             this->log("setInput updated value.");
         } else {
+            this->program_counter.discard();
             this->log("setInput update skipped. NOP asserted.");
         }
 
-        this->is_program_counter_set = true;
-    } else if (std::holds_alternative<std::string>(input)) {
-        if (!this->is_nop_asserted) {
-            this->instruction_bits = std::string(std::get<std::string>(input));
+        this->setReadiness(PROGRAM_COUNTER_SET);
+    } else if (std::holds_alternative<DecodedInstruction>(input)) {
+        if (!this->readiness.isSet(NOP_ASSERTED)) {
+            this->fetched_instruction.set(std::get<DecodedInstruction>(input));
             this->log("setInput updated value.");
         } else {
+            this->fetched_instruction.discard();
             this->log("setInput update skipped. NOP asserted.");
         }
 
-        this->is_instruction_set = true;
+        this->setReadiness(INSTRUCTION_SET);
     } else {
         throw std::runtime_error("IFStageRegisters::setInput for IFIDStageRegisters passed an unsupported value");
     }
-
-    this->notifyModuleConditionVariable();
 }
 
 
 void IFIDStageRegisters::setNop(bool is_asserted) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
-
-    this->log("setPassedNop waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> if_id_stage_registers_lock (this->getModuleMutex());
+    if (this->stage_synchronizer->deferNopUntilClockEdge([this, is_asserted] { this->setNop(is_asserted); })) {
+        return;
+    }
 
-    this->log("setPassedNop acquired lock.");
+    this->log("setNop updating value.");
 
-    this->is_nop_asserted |= is_asserted;
+    if (is_asserted) {
+        this->readiness.set(NOP_ASSERTED);
+    }
 
-    if (++this->current_nop_set_operations == REQUIRED_NOP_FLAG_SET_OPERATIONS) {
-        this->is_nop_flag_set = true;
-        this->getModuleConditionVariable().notify_all();
+    if (this->current_nop_set_operations.fetch_add(1, std::memory_order_acq_rel) + 1 ==
+        REQUIRED_NOP_FLAG_SET_OPERATIONS) {
+        this->setReadiness(NOP_FLAG_SET);
+        this->readiness.notify();  // setInput waits for the flag in the five stage pipeline
     }
 }
 
@@ -309,13 +261,13 @@ void IFIDStageRegisters::passProgramCounterToIDEXStageRegisters(unsigned long pc
     this->log("Passed program counter to IDEXStageRegisters.");
 }
 
-void IFIDStageRegisters::passControlToIDEXStageRegisters(Control *new_control) {
+void IFIDStageRegisters::passControlToIDEXStageRegisters(const Control &new_control) {
     this->log("Passing control to IDEXStageRegisters.");
     this->id_ex_stage_registers->setControlModule(new_control);
     this->log("Passed control to IDEXStageRegisters.");
 }
 
-void IFIDStageRegisters::passReadRegistersToRegisterFile(Instruction *current_instruction) {
+void IFIDStageRegisters::passReadRegistersToRegisterFile(const Instruction *current_instruction) {
     this->log("Passing read registers to RegisterFile.");
 
     InstructionType type = current_instruction->getType();
@@ -323,37 +275,38 @@ void IFIDStageRegisters::passReadRegistersToRegisterFile(Instruction *current_in
     if (type == InstructionType::I || type == InstructionType::S) {
         this->register_file->setReadRegister(current_instruction->getRs1().to_ulong());
     } else {
-        this->register_file->setReadRegisters(current_instruction->getRs1().to_ulong(), this->instruction->getRs2().to_ulong());
+        this->register_file->setReadRegisters(current_instruction->getRs1().to_ulong(),
+                                              current_instruction->getRs2().to_ulong());
     }
 
     this->log("Passed read registers to RegisterFile.");
 }
 
-void IFIDStageRegisters::passInstructionToImmediateGenerator(Instruction *current_instruction) {
+void IFIDStageRegisters::passInstructionToImmediateGenerator(const Instruction *current_instruction) {
     this->log("Passing instruction to ImmediateGenerator.");
     this->immediate_generator->setInstruction(current_instruction);
     this->log("Passed instruction to ImmediateGenerator.");
 }
 
-void IFIDStageRegisters::passRegisterDestinationToIDEXStageRegisters(Instruction *current_instruction) {
+void IFIDStageRegisters::passRegisterDestinationToIDEXStageRegisters(const Instruction *current_instruction) {
     this->log("Passing register destination to IDEXStageRegisters.");
     this->id_ex_stage_registers->setRegisterDestination(current_instruction->getRd().to_ulong());
     this->log("Passed register destination to IDEXStageRegisters.");
 }
 
-void IFIDStageRegisters::passRegisterSource1ToIDEXStageRegisters(Instruction *current_instruction) {
+void IFIDStageRegisters::passRegisterSource1ToIDEXStageRegisters(const Instruction *current_instruction) {
     this->log("Passing register source 1 to IDEXStageRegisters.");
     this->id_ex_stage_registers->setRegisterSource1(current_instruction->getRs1().to_ulong());
     this->log("Passed register source 1 to IDEXStageRegisters.");
 }
 
-void IFIDStageRegisters::passRegisterSource2ToIDEXStageRegisters(Instruction *current_instruction) {
+void IFIDStageRegisters::passRegisterSource2ToIDEXStageRegisters(const Instruction *current_instruction) {
     this->log("Passing register source 2 to IDEXStageRegisters.");
     this->id_ex_stage_registers->setRegisterSource2(current_instruction->getRs2().to_ulong());
     this->log("Passed register source 2 to IDEXStageRegisters.");
 }
 
-void IFIDStageRegisters::passInstructionToIDEXStageRegisters(Instruction *current_instruction) {
+void IFIDStageRegisters::passInstructionToIDEXStageRegisters(const Instruction *current_instruction) {
     this->log("Passing instruction to IDEXStageRegisters.");
     this->id_ex_stage_registers->setInstruction(current_instruction);
     this->log("Passed instruction to IDEXStageRegisters.");
@@ -365,40 +318,29 @@ void IFIDStageRegisters::passNopToIDEXStageRegisters(bool is_asserted) {
     this->log("Passed NOP to IDEXStageRegisters.");
 }
 
-void IFIDStageRegisters::passInstructionToHazardDetectionUnit(Instruction *current_instruction) {
+void IFIDStageRegisters::passInstructionToHazardDetectionUnit(const Instruction *current_instruction) {
     this->log("Passing instruction to hazard detection unit.");
     this->hazard_detection_unit->setInstruction(current_instruction);
     this->log("Passed instruction to hazard detection unit.");
 }
 
 void IFIDStageRegisters::delayUpdateUntilNopFlagSet() {
-    std::unique_lock<std::mutex> if_id_stage_registers_lock (this->getModuleMutex());
-    this->getModuleConditionVariable().wait(
-            if_id_stage_registers_lock,
-            [this] {
-                return this->is_nop_flag_set;
-            }
-    );
+    this->readiness.waitUntilSet(NOP_FLAG_SET);
 }
 
 void IFIDStageRegisters::setPassedNop(bool is_asserted) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
-
-    this->log("setPassedNop waiting to acquire lock.");
-
-    std::lock_guard<std::mutex> if_id_stage_registers_lock (this->getModuleMutex());
-
-    this->log("setPassedNop acquired lock.");
+    if (this->stage_synchronizer->deferUntilClockEdge([this, is_asserted] { this->setPassedNop(is_asserted); })) {
+        return;
+    }
 
-    this->is_nop_passed_flag_asserted = is_asserted;
-    this->is_nop_passed_flag_set = true;
+    this->nop_passed_flag.set(is_asserted);
 
     this->log("setPassedNop updated value.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(NOP_PASSED_FLAG_SET);
 }
 
 void IFIDStageRegisters::assertSystemEnabledNop() {
-    this->is_nop_asserted = true;
+    this->readiness.set(NOP_ASSERTED);
 }
 
 std::string IFIDStageRegisters::getModuleTag() {
@@ -410,22 +352,26 @@ Stage IFIDStageRegisters::getModuleStage() {
 }
 
 void IFIDStageRegisters::printState() {
-    std::cout << std::string(20, '.') << std::endl;
-    std::cout << "IFIDStageRegisters" << std::endl;
-    std::cout << std::string(20, '.') << std::endl;
-
-    std::cout << "program_counter: " << this->program_counter << std::endl;
-    std::cout << "instruction_bits: " << this->instruction_bits << std::endl;
-    std::cout << "is_nop_passed_flag_asserted: " << this->is_nop_passed_flag_asserted << std::endl;
-    std::cout << "is_nop_asserted: " << this->is_nop_asserted << std::endl;
-    std::cout << "is_program_counter_set: " << this->is_program_counter_set << std::endl;
-    std::cout << "is_instruction_set: " << this->is_instruction_set << std::endl;
-    std::cout << "is_nop_flag_set: " << this->is_nop_flag_set << std::endl;
-    std::cout << "is_nop_passed_flag_set: " << this->is_nop_passed_flag_set << std::endl;
-    std::cout << "is_reset_flag_set: " << this->is_reset_flag_set << std::endl;
-    std::cout << "is_pause_flag_set: " << this->is_pause_flag_set << std::endl;
-
-    this->control->printState();
+    std::ostringstream state;
+
+    state << std::string(20, '.') << '\n';
+    state << "IFIDStageRegisters" << '\n';
+    state << std::string(20, '.') << '\n';
+
+    state << "program_counter: " << this->program_counter.get() << '\n';
+    state << "instruction_bits: " << std::bitset<WORD_BIT_COUNT>(this->instruction->getBits()) << '\n';
+    state << "is_nop_passed_flag_asserted: " << this->nop_passed_flag.get() << '\n';
+    state << "is_nop_asserted: " << this->readiness.isSet(NOP_ASSERTED) << '\n';
+    state << "is_program_counter_set: " << this->readiness.isSet(PROGRAM_COUNTER_SET) << '\n';
+    state << "is_instruction_set: " << this->readiness.isSet(INSTRUCTION_SET) << '\n';
+    state << "is_nop_flag_set: " << this->readiness.isSet(NOP_FLAG_SET) << '\n';
+    state << "is_nop_passed_flag_set: " << this->readiness.isSet(NOP_PASSED_FLAG_SET) << '\n';
+    state << "is_reset_flag_set: " << this->readiness.isSet(RESET_FLAG_SET) << '\n';
+    state << "is_pause_flag_set: " << this->readiness.isSet(PAUSE_FLAG_SET) << '\n';
+
+    this->control.printState(state);
+
+    this->printToConsole(state.str());
 }
 
 void IFIDStageRegisters::assertVerboseExecutionFlag() {
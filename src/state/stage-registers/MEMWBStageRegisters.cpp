@@ -1,25 +1,13 @@
 #include "../../../include/state/stage-registers/MEMWBStageRegisters.h"
 
-MEMWBStageRegisters *MEMWBStageRegisters::current_instance = nullptr;
-std::mutex MEMWBStageRegisters::initialization_mutex;
-
-MEMWBStageRegisters::MEMWBStageRegisters() {
-    this->read_data = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->alu_result = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->register_destination = 0L;
-
-    this->is_read_data_set = false;
-    this->is_alu_result_set = false;
-    this->is_register_destination_set = false;
-    this->is_control_set = false;
-    this->is_reset_flag_set = false;
-    this->is_pause_flag_set = false;
-    this->is_nop_asserted = false;
-    this->is_nop_passed_flag_set = false;
-    this->is_nop_passed_flag_asserted = false;
-    this->is_verbose_execution_flag_asserted = false;
+#include <sstream>
+
+MEMWBStageRegisters::MEMWBStageRegisters(SimulationContext *context)
+        : Module(context), register_destination(0UL),
+          control(Control(Instruction::getZeroInstruction(), PipelineType::Single, context)), nop_passed_flag(false) {
+    this->readiness.track(INPUT_BITS, PAUSE_FLAG_SET, RESET_FLAG_SET);
 
-    this->control = nullptr;
+    this->is_verbose_execution_flag_asserted = false;
 
     this->register_file = nullptr;
     this->wb_mux = nullptr;
@@ -29,243 +17,181 @@ MEMWBStageRegisters::MEMWBStageRegisters() {
 }
 
 void MEMWBStageRegisters::reset() {
-    std::lock_guard<std::mutex> mem_wb_stage_registers_lock (this->getModuleMutex());
-
-    this->is_reset_flag_set = true;
-    this->notifyModuleConditionVariable();
+    this->setReadiness(RESET_FLAG_SET);
 }
 
 void MEMWBStageRegisters::resetStage() {
-    if (this->getPipelineType() == PipelineType::Single) {
-        this->is_read_data_set = false;
-        this->is_alu_result_set = false;
-        this->is_register_destination_set = false;
-        this->is_control_set = false;
-        this->is_nop_passed_flag_set = false;
-        this->is_nop_passed_flag_asserted = false;
-    } else {
-        this->is_read_data_set = true;
-        this->is_alu_result_set = true;
-        this->is_register_destination_set = true;
-        this->is_control_set = true;
-        this->is_nop_passed_flag_set = true;
-        this->is_nop_passed_flag_asserted = true;
+    bool is_five_stage = this->getPipelineType() == PipelineType::Five;
+
+    this->readiness.keepOnly(PAUSE_FLAG_SET | RESET_FLAG_SET | ReadinessMask::KILLED);
+
+    this->read_data.reset();
+    this->alu_result.reset();
+    this->register_destination.reset(0UL);
+    this->control.reset(Control(Instruction::getZeroInstruction(), this->getPipelineType(), this->context));
+    this->nop_passed_flag.reset(is_five_stage);
+
+    if (is_five_stage) {  // The first five stage cycle clocks a bubble, no module drives the inputs yet
+        this->read_data.discard();
+        this->alu_result.discard();
+        this->register_destination.discard();
+        this->control.discard();
+        this->nop_passed_flag.discard();
+        this->readiness.set(INPUT_BITS);
     }
-
-    this->is_nop_asserted = false;
-
-    this->read_data = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->alu_result = std::bitset<WORD_BIT_COUNT>(std::string(32, '0'));
-    this->register_destination = 0L;
-
-    this->control = new Control(new Instruction(std::string(32, '0')), this->getPipelineType());
 }
 
 void MEMWBStageRegisters::pause() {
-    this->is_pause_flag_set = true;
+    this->readiness.set(PAUSE_FLAG_SET);
 }
 
 void MEMWBStageRegisters::resume() {
-    std::lock_guard<std::mutex> mem_wb_stage_registers_lock (this->getModuleMutex());
-
-    this->is_pause_flag_set = false;
-    this->notifyModuleConditionVariable();
-}
-
-MEMWBStageRegisters *MEMWBStageRegisters::init() {
-    std::lock_guard<std::mutex> mem_wb_stage_registers_lock (MEMWBStageRegisters::initialization_mutex);
-
-    if (MEMWBStageRegisters::current_instance == nullptr) {
-        MEMWBStageRegisters::current_instance = new MEMWBStageRegisters();
-    }
-
-    return MEMWBStageRegisters::current_instance;
+    this->clearReadiness(PAUSE_FLAG_SET);
 }
 
 void MEMWBStageRegisters::initDependencies() {
     std::unique_lock<std::mutex> mem_wb_stage_registers_lock (this->getModuleDependencyMutex());
 
-    if (this->control && this->register_file && this->wb_mux && this->stage_synchronizer && this->forwarding_unit &&
+    if (this->register_file && this->wb_mux && this->stage_synchronizer && this->forwarding_unit &&
         this->logger) {
         return;
     }
 
-    this->control = new Control(new Instruction(std::string(32, '0')), this->getPipelineType());
+    this->register_file = this->context->get<RegisterFile>();
+    this->wb_mux = this->context->get<WBMux>();
+    this->stage_synchronizer = this->context->get<StageSynchronizer>();
+    this->forwarding_unit = this->context->get<ForwardingUnit>();
+    this->logger = this->context->get<Logger>();
+
+    EXMEMStageRegisters *ex_mem_stage_registers = this->context->get<EXMEMStageRegisters>();
 
-    this->register_file = RegisterFile::init();
-    this->wb_mux = WBMux::init();
-    this->stage_synchronizer = StageSynchronizer::init();
-    this->forwarding_unit = ForwardingUnit::init();
-    this->logger = Logger::init();
+    this->stage_synchronizer->registerParticipant(true);
+    this->stage_synchronizer->connectFiveStageInput(this->context->get<DataMemory>());  // setReadData
+    this->stage_synchronizer->connectFiveStageInput(ex_mem_stage_registers);  // setALUResult
+    this->stage_synchronizer->connectFiveStageInput(ex_mem_stage_registers);  // setRegisterDestination
+    this->stage_synchronizer->connectFiveStageInput(ex_mem_stage_registers);  // setControl
+    this->stage_synchronizer->connectFiveStageInput(ex_mem_stage_registers);  // setPassedNop
 }
 
-void MEMWBStageRegisters::run() {
-    this->initDependencies();
-    
-    while (this->isAlive()) {
-        this->log("Waiting to be woken up and acquire lock.");
-
-        std::unique_lock<std::mutex> mem_wb_stage_registers_lock (this->getModuleMutex());
-        this->getModuleConditionVariable().wait(
-                mem_wb_stage_registers_lock,
-                [this] {
-                    return (this->is_read_data_set && this->is_alu_result_set && this->is_register_destination_set &&
-                            this->is_control_set && !this->is_pause_flag_set && this->is_nop_passed_flag_set) ||
-                           this->is_reset_flag_set || this->isKilled();
-                }
-        );
-
-        if (this->isKilled()) {
-            this->log("Killed.");
-            break;
-        }
-
-        if (this->is_reset_flag_set) {
-            this->log("Resetting stage.");
-
-            this->resetStage();
-            this->is_reset_flag_set = false;
-
-            this->stage_synchronizer->arriveReset();
-
-            this->log("Reset.");
-            continue;
-        }
-
-        this->log("Woken up and acquired lock.");
-
-        this->control->setNop(this->is_nop_passed_flag_asserted);
-        this->control->toggleWBStageControlSignals();
-
-        if (this->is_verbose_execution_flag_asserted) {
-            this->printState();
-        }
-
-        this->passReadDataToWBMux();
-        this->passALUResultToWBMux();
-
-        std::thread pass_register_destination_register_file (
-                &MEMWBStageRegisters::passRegisterDestinationToRegisterFile,
-                this,
-                this->register_destination
-        );
-
-        std::thread pass_register_destination_forwarding_unit (
-                &MEMWBStageRegisters::passRegisterDestinationToForwardingUnit,
-                this,
-                this->register_destination
-        );
-
-        std::thread pass_reg_write_forwarding_unit (
-                &MEMWBStageRegisters::passRegWriteToForwardingUnit,
-                this,
-                this->control->isRegWriteAsserted()
-        );
-
-        pass_register_destination_register_file.detach();
-        pass_register_destination_forwarding_unit.detach();
-        pass_reg_write_forwarding_unit.detach();
-
-        this->is_read_data_set = false;
-        this->is_alu_result_set = false;
-        this->is_register_destination_set = false;
-        this->is_control_set = false;
-        this->is_nop_asserted = false;
-        this->is_nop_passed_flag_set = false;
-
-        this->stage_synchronizer->conditionalArriveSingleStage();
-    }
+bool MEMWBStageRegisters::isReadyToExecute() {
+    return this->readiness.isReady();
 }
 
-void MEMWBStageRegisters::setReadData(std::bitset<WORD_BIT_COUNT> value) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+void MEMWBStageRegisters::execute() {
+    if (this->readiness.isSet(RESET_FLAG_SET)) {
+        this->log<LogLevel::Info>("Resetting stage.");
 
-    this->log("setReadData waiting to acquire lock.");
+        this->resetStage();
+        this->readiness.clear(RESET_FLAG_SET);
 
-    std::lock_guard<std::mutex> mem_wb_stage_registers_lock (this->getModuleMutex());
+        this->stage_synchronizer->arriveReset();
 
-    this->log("setReadData acquired lock. Updating value.");
+        this->log<LogLevel::Info>("Reset.");
+        return;
+    }
 
-    this->read_data = value;
-    this->is_read_data_set = true;
+    this->log("Woken up and acquired lock.");
 
-    this->log("setReadData updated value.");
-    this->notifyModuleConditionVariable();
-}
+    Control current_control = this->control.get();
+    current_control.setNop(this->nop_passed_flag.get());
+    current_control.toggleWBStageControlSignals();
 
-void MEMWBStageRegisters::setALUResult(std::bitset<WORD_BIT_COUNT> value) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+    if (this->is_verbose_execution_flag_asserted) {
+        this->printState(current_control);
+    }
 
-    this->log("setALUResult waiting to acquire lock.");
+    std::bitset<WORD_BIT_COUNT> read_data_value = this->read_data.get();
+    std::bitset<WORD_BIT_COUNT> alu_result_value = this->alu_result.get();
+    unsigned long rd = this->register_destination.get();
 
-    std::lock_guard<std::mutex> mem_wb_stage_registers_lock (this->getModuleMutex());
+    this->markInputsEvaluated();
+    this->readiness.keepOnly(PAUSE_FLAG_SET | RESET_FLAG_SET | ReadinessMask::KILLED);
 
-    this->log("setALUResult acquired lock. Updating value.");
+    this->passReadDataToWBMux(read_data_value);
+    this->passALUResultToWBMux(alu_result_value);
 
-    this->alu_result = value;
-    this->is_alu_result_set = true;
+    this->dispatch(&MEMWBStageRegisters::passRegisterDestinationToRegisterFile, this, rd);
 
-    this->log("setALUResult updated value.");
-    this->notifyModuleConditionVariable();
-}
+    this->dispatch(&MEMWBStageRegisters::passRegisterDestinationToForwardingUnit, this, rd);
 
-void MEMWBStageRegisters::setRegisterDestination(unsigned long value) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+    this->dispatch(&MEMWBStageRegisters::passRegWriteToForwardingUnit, this, current_control.isRegWriteAsserted());
 
-    this->log("setRegisterDestination waiting to acquire lock.");
+    this->stage_synchronizer->conditionalArriveSingleStage();
+}
 
-    std::lock_guard<std::mutex> mem_wb_stage_registers_lock (this->getModuleMutex());
+void MEMWBStageRegisters::markInputsEvaluated() {
+    this->read_data.markEvaluated();
+    this->alu_result.markEvaluated();
+    this->register_destination.markEvaluated();
+    this->control.markEvaluated();
+    this->nop_passed_flag.markEvaluated();
+}
 
-    this->log("setRegisterDestination acquired lock. Updating value.");
 
-    this->register_destination = value;
-    this->is_register_destination_set = true;
+void MEMWBStageRegisters::setReadData(std::bitset<WORD_BIT_COUNT> value) {
+    if (this->stage_synchronizer->deferUntilClockEdge([this, value] { this->setReadData(value); })) {
+        return;
+    }
 
-    this->log("setRegisterDestination updated value.");
-    this->notifyModuleConditionVariable();
+    this->read_data.set(value);
+
+    this->log("setReadData updated value.");
+    this->setReadiness(READ_DATA_SET);
 }
 
-void MEMWBStageRegisters::setControl(Control *new_control) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+void MEMWBStageRegisters::setALUResult(std::bitset<WORD_BIT_COUNT> value) {
+    if (this->stage_synchronizer->deferUntilClockEdge([this, value] { this->setALUResult(value); })) {
+        return;
+    }
 
-    this->log("setControl waiting to acquire lock.");
+    this->alu_result.set(value);
 
-    std::lock_guard<std::mutex> mem_wb_stage_registers_lock (this->getModuleMutex());
+    this->log("setALUResult updated value.");
+    this->setReadiness(ALU_RESULT_SET);
+}
 
-    this->log("setControl acquired lock. Updating value.");
+void MEMWBStageRegisters::setRegisterDestination(unsigned long value) {
+    if (this->stage_synchronizer->deferUntilClockEdge([this, value] { this->setRegisterDestination(value); })) {
+        return;
+    }
 
-    this->control = new_control;
-    this->is_control_set = true;
+    this->register_destination.set(value);
 
-    this->log("setControl updated value.");
-    this->notifyModuleConditionVariable();
+    this->log("setRegisterDestination updated value.");
+    this->setReadiness(REGISTER_DESTINATION_SET);
 }
 
-void MEMWBStageRegisters::setPassedNop(bool is_asserted) {
-    this->stage_synchronizer->conditionalArriveFiveStage();
+void MEMWBStageRegisters::setControl(const Control &new_control) {
+    if (this->stage_synchronizer->deferUntilClockEdge([this, new_control] { this->setControl(new_control); })) {
+        return;
+    }
 
-    this->log("setPassedNop waiting to acquire lock.");
+    this->control.set(new_control);
 
-    std::lock_guard<std::mutex> if_id_stage_registers_lock (this->getModuleMutex());
+    this->log("setControl updated value.");
+    this->setReadiness(CONTROL_SET);
+}
 
-    this->log("setPassedNop acquired lock.");
+void MEMWBStageRegisters::setPassedNop(bool is_asserted) {
+    if (this->stage_synchronizer->deferUntilClockEdge([this, is_asserted] { this->setPassedNop(is_asserted); })) {
+        return;
+    }
 
-    this->is_nop_passed_flag_asserted = is_asserted;
-    this->is_nop_passed_flag_set = true;
+    this->nop_passed_flag.set(is_asserted);
 
     this->log("setPassedNop updated value.");
-    this->notifyModuleConditionVariable();
+    this->setReadiness(NOP_PASSED_FLAG_SET);
 }
 
-void MEMWBStageRegisters::passALUResultToWBMux() {
+void MEMWBStageRegisters::passALUResultToWBMux(std::bitset<WORD_BIT_COUNT> data) {
     this->log("Passing ALU result to WBMux.");
-    this->wb_mux->setInput(WBStageMuxInputType::ALUResult, this->alu_result);
+    this->wb_mux->setInput<WBStageMuxInputType::ALUResult>(data);
     this->log("Passed ALU result to WBMux.");
 }
 
-void MEMWBStageRegisters::passReadDataToWBMux() {
+void MEMWBStageRegisters::passReadDataToWBMux(std::bitset<WORD_BIT_COUNT> data) {
     this->log("Passing read data to WBMux.");
-    this->wb_mux->setInput(WBStageMuxInputType::ReadData, this->read_data);
+    this->wb_mux->setInput<WBStageMuxInputType::ReadData>(data);
     this->log("Passed read data to WBMux.");
 }
 
@@ -288,11 +214,15 @@ void MEMWBStageRegisters::passRegWriteToForwardingUnit(bool is_asserted) {
 }
 
 bool MEMWBStageRegisters::isExecutingHaltInstruction() {
-    return this->control->is_halt_instruction;
+    return this->control.get().is_halt_instruction;
+}
+
+bool MEMWBStageRegisters::isNopAsserted() {
+    return this->readiness.isSet(NOP_ASSERTED);
 }
 
 void MEMWBStageRegisters::assertNop() {
-    this->is_nop_asserted = true;
+    this->readiness.set(NOP_ASSERTED);
 }
 
 std::string MEMWBStageRegisters::getModuleTag() {
@@ -303,25 +233,29 @@ Stage MEMWBStageRegisters::getModuleStage() {
     return Stage::MEM;
 }
 
-void MEMWBStageRegisters::printState() {
-    std::cout << std::string(20, '.') << std::endl;
-    std::cout << "MEMWBStageRegisters" << std::endl;
-    std::cout << std::string(20, '.') << std::endl;
-
-    std::cout << "read_data: " << this->read_data.to_ulong() << std::endl;
-    std::cout << "alu_result: " << this->alu_result.to_ulong() << std::endl;
-    std::cout << "register_destination: " << this->register_destination << std::endl;
-    std::cout << "is_read_data_set: " << this->is_read_data_set << std::endl;
-    std::cout << "is_alu_result_set: " << this->is_alu_result_set << std::endl;
-    std::cout << "is_register_destination_set: " << this->is_register_destination_set << std::endl;
-    std::cout << "is_control_set: " << this->is_control_set << std::endl;
-    std::cout << "is_reset_flag_set: " << this->is_reset_flag_set << std::endl;
-    std::cout << "is_pause_flag_set: " << this->is_pause_flag_set << std::endl;
-    std::cout << "is_nop_asserted: " << this->is_nop_asserted << std::endl;
-    std::cout << "is_nop_passed_flag_set: " << this->is_nop_passed_flag_set << std::endl;
-    std::cout << "is_nop_passed_flag_asserted: " << this->is_nop_passed_flag_asserted << std::endl;
-
-    this->control->printState();
+void MEMWBStageRegisters::printState(Control &current_control) {
+    std::ostringstream state;
+
+    state << std::string(20, '.') << '\n';
+    state << "MEMWBStageRegisters" << '\n';
+    state << std::string(20, '.') << '\n';
+
+    state << "read_data: " << this->read_data.get().to_ulong() << '\n';
+    state << "alu_result: " << this->alu_result.get().to_ulong() << '\n';
+    state << "register_destination: " << this->register_destination.get() << '\n';
+    state << "is_read_data_set: " << this->readiness.isSet(READ_DATA_SET) << '\n';
+    state << "is_alu_result_set: " << this->readiness.isSet(ALU_RESULT_SET) << '\n';
+    state << "is_register_destination_set: " << this->readiness.isSet(REGISTER_DESTINATION_SET) << '\n';
+    state << "is_control_set: " << this->readiness.isSet(CONTROL_SET) << '\n';
+    state << "is_reset_flag_set: " << this->readiness.isSet(RESET_FLAG_SET) << '\n';
+    state << "is_pause_flag_set: " << this->readiness.isSet(PAUSE_FLAG_SET) << '\n';
+    state << "is_nop_asserted: " << this->readiness.isSet(NOP_ASSERTED) << '\n';
+    state << "is_nop_passed_flag_set: " << this->readiness.isSet(NOP_PASSED_FLAG_SET) << '\n';
+    state << "is_nop_passed_flag_asserted: " << this->nop_passed_flag.get() << '\n';
+
+    current_control.printState(state);
+
+    this->printToConsole(state.str());
 }
 
 void MEMWBStageRegisters::assertVerboseExecutionFlag() {
@@ -0,0 +1,236 @@
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/common/Logger.h"
+#include "../include/common/Pipeline.h"
+#include "../include/common/StageSynchronizer.h"
+
+/**
+ * Runs the jobs of a manifest on a fixed number of worker threads, every job in its own SimulationContext. Jobs are
+ * evaluated cycle-driven on the worker that picked them up, so a job starts no module threads of its own.
+ *
+ * The manifest holds one job per line, "<instruction memory file> <data memory file> single|five", blank lines and
+ * lines starting with '#' are skipped. The RegisterFile and DataMemory files of the n-th job are written to
+ * <output directory>/job-<n>/. Stage logs are off by default, every logging job would start its own Logger writer
+ * threads next to the workers; --log-format=text|binary writes them into the job directory as well.
+ *
+ * Usage: RISC_V_BatchRunner [--workers=<n>] [--output-directory=<path>] [--log-format=text|binary|none] <manifest>
+ */
+namespace {
+    struct BatchJob {
+        std::string instruction_memory_file_path;
+        std::string data_memory_file_path;
+        PipelineType pipeline_type = PipelineType::Single;
+        std::string directory_path;
+    };
+
+    struct BatchJobResult {
+        bool is_successful = false;
+        int cycle_count = 0;
+        std::chrono::duration<double, std::milli> wall_time {0};
+        std::string error;
+    };
+
+    bool readManifest(const std::string &manifest_path, const std::string &output_directory_path,
+                      std::vector<BatchJob> &jobs) {
+        std::ifstream manifest (manifest_path);
+
+        if (!manifest) {
+            std::cerr << manifest_path << ": cannot open file" << std::endl;
+            return false;
+        }
+
+        std::string line;
+        unsigned long line_number = 0;
+
+        while (std::getline(manifest, line)) {
+            ++line_number;
+
+            std::istringstream fields (line);
+            BatchJob job;
+            std::string pipeline_type;
+            std::string extra_field;
+
+            if (!(fields >> job.instruction_memory_file_path) || job.instruction_memory_file_path.starts_with('#')) {
+                continue;
+            }
+
+            if (!(fields >> job.data_memory_file_path >> pipeline_type) || (fields >> extra_field)) {
+                std::cerr << manifest_path << ":" << line_number << ": expected <imem> <dmem> single|five" << std::endl;
+                return false;
+            }
+
+            if (pipeline_type == "single") {
+                job.pipeline_type = PipelineType::Single;
+            } else if (pipeline_type == "five") {
+                job.pipeline_type = PipelineType::Five;
+            } else {
+                std::cerr << manifest_path << ":" << line_number << ": unknown pipeline type " << pipeline_type
+                          << std::endl;
+                return false;
+            }
+
+            job.directory_path = output_directory_path + "/job-" + std::to_string(jobs.size()) + "/";
+            jobs.push_back(job);
+        }
+
+        return true;
+    }
+
+    BatchJobResult runJob(const BatchJob &job) {
+        BatchJobResult result;
+
+        try {
+            std::filesystem::create_directories(job.directory_path);
+
+            // Every module has been evaluated on this thread once the pipeline is paused, so the context can go
+            auto context = std::make_unique<SimulationContext>("", job.directory_path, job.directory_path);
+            Pipeline pipeline = initializePipeline(context.get());
+
+            pipeline.execution_engine->setExecutionMode(ExecutionMode::CycleDriven);
+            pipeline.stage_synchronizer->assertPrintCycleFlag(false);
+
+            if (job.pipeline_type == PipelineType::Five) {
+                changePipelineType(pipeline, PipelineType::Five);
+                resetPipeline(pipeline);
+            }
+
+            clearOutputFiles(pipeline);
+            changeInstructionMemoryFile(pipeline, job.instruction_memory_file_path);
+            changeDataMemoryFile(pipeline, job.data_memory_file_path);
+
+            auto start_time = std::chrono::steady_clock::now();
+
+            registerPipeline(pipeline);
+            pipeline.execution_engine->runUntilPaused();
+
+            result.wall_time = std::chrono::steady_clock::now() - start_time;
+            result.cycle_count = pipeline.stage_synchronizer->getCurrentCycle();
+            result.is_successful = true;
+
+            killPipeline(pipeline);
+        } catch (const std::exception &e) {
+            result.error = e.what();
+        }
+
+        return result;
+    }
+
+    void printSummary(const std::vector<BatchJob> &jobs, const std::vector<BatchJobResult> &results,
+                      std::chrono::duration<double, std::milli> total_wall_time) {
+        std::cout << std::left << std::setw(8) << "Job" << std::setw(10) << "Pipeline" << std::right
+                  << std::setw(10) << "Cycles" << std::setw(16) << "Wall time (ms)" << "  Status" << std::endl;
+
+        unsigned long failed_job_count = 0;
+
+        for (unsigned long i = 0; i < jobs.size(); ++i) {
+            const BatchJobResult &result = results.at(i);
+
+            std::cout << std::left << std::setw(8) << i
+                      << std::setw(10) << (jobs.at(i).pipeline_type == PipelineType::Single ? "single" : "five")
+                      << std::right << std::setw(10) << result.cycle_count
+                      << std::setw(16) << std::fixed << std::setprecision(3) << result.wall_time.count() << "  "
+                      << (result.is_successful ? "ok" : "failed: " + result.error) << std::endl;
+
+            if (!result.is_successful) {
+                ++failed_job_count;
+            }
+        }
+
+        std::cout << std::endl << jobs.size() << " jobs, " << failed_job_count << " failed, "
+                  << std::fixed << std::setprecision(3) << total_wall_time.count() << " ms" << std::endl;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const std::string workers_option = "--workers=";
+    const std::string output_directory_option = "--output-directory=";
+    const std::string log_format_option = "--log-format=";
+
+    unsigned long worker_count = std::max(1U, std::thread::hardware_concurrency());
+    std::string output_directory_path = "batch-output";
+    std::string manifest_path;
+    LogFormat log_format = LogFormat::None;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+
+        if (argument.starts_with(workers_option)) {
+            try {
+                worker_count = std::stoul(argument.substr(workers_option.size()));
+            } catch (const std::logic_error &e) {
+                worker_count = 0;
+            }
+
+            if (worker_count == 0) {
+                std::cerr << "Invalid worker count: " << argument << std::endl;
+                return 1;
+            }
+        } else if (argument.starts_with(output_directory_option)) {
+            output_directory_path = argument.substr(output_directory_option.size());
+        } else if (argument == log_format_option + "text") {
+            log_format = LogFormat::Text;
+        } else if (argument == log_format_option + "binary") {
+            log_format = LogFormat::Binary;
+        } else if (argument == log_format_option + "none") {
+            log_format = LogFormat::None;
+        } else if (manifest_path.empty()) {
+            manifest_path = argument;
+        } else {
+            manifest_path.clear();
+            break;
+        }
+    }
+
+    if (manifest_path.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--workers=<n>] [--output-directory=<path>]"
+                  << " [--log-format=text|binary|none] <manifest>" << std::endl;
+        return 1;
+    }
+
+    std::vector<BatchJob> jobs;
+
+    if (!readManifest(manifest_path, output_directory_path, jobs)) {
+        return 1;
+    }
+
+    Logger::setLogFormat(log_format);
+
+    std::vector<BatchJobResult> results (jobs.size());
+    std::atomic<unsigned long> next_job_index = 0;
+
+    auto start_time = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+
+    for (unsigned long i = 0; i < std::min(worker_count, jobs.size()); ++i) {
+        workers.emplace_back([&jobs, &results, &next_job_index] {
+            for (unsigned long job_index = next_job_index++; job_index < jobs.size(); job_index = next_job_index++) {
+                results.at(job_index) = runJob(jobs.at(job_index));
+            }
+        });
+    }
+
+    for (std::thread &worker: workers) {
+        worker.join();
+    }
+
+    printSummary(jobs, results, std::chrono::steady_clock::now() - start_time);
+
+    for (const BatchJobResult &result: results) {
+        if (!result.is_successful) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../include/common/EventLogFormat.h"
+
+/**
+ * Renders binary stage logs (--log-format=binary) back into the text stage log format on standard output.
+ *
+ * Usage: RISC_V_EventLogDecoder [--cycles] <Stage>.bin...
+ */
+namespace {
+    bool readText(std::ifstream &input, uint32_t length, std::string &text) {
+        text.resize(length);
+
+        return static_cast<bool>(input.read(text.data(), length));
+    }
+
+    bool decodeEventLog(const std::string &file_path, bool is_cycle_printed) {
+        std::ifstream input (file_path, std::ios::binary);
+
+        if (!input) {
+            std::cerr << file_path << ": cannot open file" << std::endl;
+            return false;
+        }
+
+        EventLogHeader header {};
+
+        if (!input.read(reinterpret_cast<char *>(&header), sizeof(header)) || !EventLogFormat::isValidHeader(header)) {
+            std::cerr << file_path << ": not a version " << EventLogFormat::VERSION << " event log" << std::endl;
+            return false;
+        }
+
+        std::vector<std::string> module_tags;
+        std::vector<std::string> event_formats;
+        EventLogRecord record {};
+        uint64_t previous_cycle = 0;
+
+        while (EventLogFormat::readRecord(input, record, previous_cycle)) {
+            switch (record.kind) {
+                case EventLogRecordKind::ModuleDefinition:
+                    if (record.module_id >= module_tags.size()) {
+                        module_tags.resize(record.module_id + 1);
+                    }
+
+                    if (!readText(input, record.payload_1, module_tags.at(record.module_id))) {
+                        std::cerr << file_path << ": truncated module definition" << std::endl;
+                        return false;
+                    }
+
+                    break;
+
+                case EventLogRecordKind::EventDefinition:
+                    if (record.event_id >= event_formats.size()) {
+                        event_formats.resize(record.event_id + 1);
+                    }
+
+                    if (!readText(input, record.payload_1, event_formats.at(record.event_id))) {
+                        std::cerr << file_path << ": truncated event definition" << std::endl;
+                        return false;
+                    }
+
+                    break;
+
+                case EventLogRecordKind::Event:
+                    if (record.module_id >= module_tags.size() || record.event_id >= event_formats.size()) {
+                        std::cerr << file_path << ": event refers to an undefined module or message" << std::endl;
+                        return false;
+                    }
+
+                    if (is_cycle_printed) {
+                        std::cout << record.cycle << '\t';
+                    }
+
+                    EventLogFormat::writeEventText(std::cout, module_tags.at(record.module_id),
+                                                   event_formats.at(record.event_id),
+                                                   record.payload_1, record.payload_2);
+                    break;
+
+                case EventLogRecordKind::DroppedMessages:
+                    EventLogFormat::writeDroppedMessagesText(std::cout, record.payload_1);
+                    break;
+
+                default:
+                    std::cerr << file_path << ": unknown record kind " << static_cast<int>(record.kind) << std::endl;
+                    return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    bool is_cycle_printed = false;
+    std::vector<std::string> file_paths;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+
+        if (argument == "--cycles") {
+            is_cycle_printed = true;
+        } else {
+            file_paths.push_back(argument);
+        }
+    }
+
+    if (file_paths.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--cycles] <Stage>.bin..." << std::endl;
+        return 1;
+    }
+
+    for (const std::string &file_path: file_paths) {
+        if (!decodeEventLog(file_path, is_cycle_printed)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "../include/common/ProgramImage.h"
+
+/**
+ * Converts a memory image in any format ProgramImage reads (usually a text image from input/) into a binary image that
+ * --instruction-memory-file / --data-memory-file load through mmap.
+ *
+ * Usage: RISC_V_ProgramImageConverter [--base-address=<n>] [--entry-pc=<n>] <input> <output>.img
+ */
+namespace {
+    bool parseAddress(const std::string &text, uint32_t &address) {
+        try {
+            std::size_t parsed_length = 0;
+            unsigned long value = std::stoul(text, &parsed_length, 0);
+
+            if (parsed_length != text.size() || value > UINT32_MAX) {
+                return false;
+            }
+
+            address = value;
+            return true;
+        } catch (const std::exception &e) {
+            return false;
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const std::string base_address_option = "--base-address=";
+    const std::string entry_program_counter_option = "--entry-pc=";
+
+    uint32_t base_address = 0;
+    uint32_t entry_program_counter = 0;
+    std::string input_path;
+    std::string output_path;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+
+        if (argument.starts_with(base_address_option)) {
+            if (!parseAddress(argument.substr(base_address_option.size()), base_address)) {
+                std::cerr << "Invalid base address: " << argument << std::endl;
+                return 1;
+            }
+        } else if (argument.starts_with(entry_program_counter_option)) {
+            if (!parseAddress(argument.substr(entry_program_counter_option.size()), entry_program_counter)) {
+                std::cerr << "Invalid entry program counter: " << argument << std::endl;
+                return 1;
+            }
+        } else if (input_path.empty()) {
+            input_path = argument;
+        } else if (output_path.empty()) {
+            output_path = argument;
+        } else {
+            input_path.clear();
+            break;
+        }
+    }
+
+    if (input_path.empty() || output_path.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--base-address=<n>] [--entry-pc=<n>] <input> <output>.img"
+                  << std::endl;
+        return 1;
+    }
+
+    try {
+        ProgramImage image (input_path);
+
+        if (image.getFormat() == ProgramImageFormat::Elf) {
+            std::cerr << input_path << ": ELF executables are loaded directly, see --elf" << std::endl;
+            return 1;
+        }
+
+        std::span<const uint8_t> image_bytes = image.getDataSegments().front().bytes;
+        ProgramImageHeader header = ProgramImage::makeHeader(base_address, entry_program_counter);
+
+        std::ofstream output (output_path, std::ios::binary | std::ios::trunc);
+
+        if (!output) {
+            std::cerr << output_path << ": cannot open file" << std::endl;
+            return 1;
+        }
+
+        output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        output.write(reinterpret_cast<const char *>(image_bytes.data()),
+                     static_cast<std::streamsize>(image_bytes.size()));
+
+        if (!output) {
+            std::cerr << output_path << ": write failed" << std::endl;
+            return 1;
+        }
+    } catch (const std::runtime_error &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
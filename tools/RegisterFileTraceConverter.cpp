@@ -0,0 +1,92 @@
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "../include/common/RegisterFileTraceWriter.h"
+
+/**
+ * Expands a delta register file trace (--register-file-trace=delta) into the full per-cycle dump format, so it can be
+ * compared against output/ExpectedResults.
+ *
+ * Usage: RISC_V_RegisterFileTraceConverter <RegisterFile-XX.delta> [<RegisterFile-XX.log>]
+ */
+namespace {
+    bool expandDeltaTrace(std::istream &input, std::ostream &output) {
+        RegisterFileTraceWriter::RegisterValues registers {};
+
+        std::string line;
+        unsigned long line_number = 0;
+
+        while (std::getline(input, line)) {
+            ++line_number;
+
+            if (line.empty() || line == RegisterFileTraceWriter::DELTA_TRACE_FILE_HEADER) {
+                continue;
+            }
+
+            std::istringstream cycle_header (line);
+            std::string keyword;
+            unsigned long cycle;
+            int changed_registers_count;
+
+            if (!(cycle_header >> keyword >> cycle >> changed_registers_count) ||
+                    keyword != RegisterFileTraceWriter::DELTA_TRACE_CYCLE_HEADER) {
+                std::cerr << "line " << line_number << ": expected a cycle header" << std::endl;
+                return false;
+            }
+
+            for (int i = 0; i < changed_registers_count; ++i) {
+                int register_index;
+                uint32_t value;
+
+                if (!std::getline(input, line)) {
+                    std::cerr << "line " << line_number << ": cycle " << cycle << " is truncated" << std::endl;
+                    return false;
+                }
+
+                ++line_number;
+                std::istringstream register_change (line);
+
+                if (!(register_change >> register_index >> value) || register_index < 0 ||
+                        register_index >= RegisterFileTraceWriter::REGISTERS_COUNT) {
+                    std::cerr << "line " << line_number << ": expected a register index and value" << std::endl;
+                    return false;
+                }
+
+                registers.at(register_index) = value;
+            }
+
+            RegisterFileTraceWriter::writeFullRecord(output, cycle, registers);
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 2 && argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <RegisterFile-XX.delta> [<RegisterFile-XX.log>]" << std::endl;
+        return 1;
+    }
+
+    std::ifstream input (argv[1]);
+
+    if (!input) {
+        std::cerr << argv[1] << ": cannot open file" << std::endl;
+        return 1;
+    }
+
+    if (argc == 3) {
+        std::ofstream output (argv[2]);
+
+        if (!output) {
+            std::cerr << argv[2] << ": cannot open file" << std::endl;
+            return 1;
+        }
+
+        return expandDeltaTrace(input, output) ? 0 : 1;
+    }
+
+    return expandDeltaTrace(input, std::cout) ? 0 : 1;
+}